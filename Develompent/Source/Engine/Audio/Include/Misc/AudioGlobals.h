@@ -27,4 +27,10 @@ extern class CAudioDevice			g_AudioDevice;
  */
 extern class CAudioBufferManager	g_AudioBufferManager;
 
+/**
+ * @ingroup Audio
+ * Audio streaming manager
+ */
+extern class CAudioStreamingManager	g_AudioStreamingManager;
+
 #endif // !AUDIOGLOBALS_H
\ No newline at end of file
@@ -12,58 +12,68 @@
 #include <vector>
 
 #include "System/AudioSource.h"
+#include "System/AudioStreamingManager.h"
 #include "System/Threading.h"
 
 /**
  * @ingroup Audio
- * Runnable thread for audio stream
+ * @brief Audio stream source
+ *
+ * Audio is decoded by chunks into a queue of OpenAL buffers. Buffers are refilled by workers of the audio streaming manager
  */
-class CAudioStreamRunnable : public CRunnable
+class CAudioStreamSource : public CAudioSource
 {
 public:
-	friend class CAudioStreamSource;
+	friend class CAudioStreamingManager;
 
 	/**
 	 * Constructor
-	 * 
-	 * @param InStreamSource Owner stream source
 	 */
-	CAudioStreamRunnable( CAudioStreamSource* InStreamSource );
+	CAudioStreamSource();
 
 	/**
-	 * @brief Initialize
-	 *
-	 * Allows per runnable object initialization. NOTE: This is called in the
-	 * context of the thread object that aggregates this, not the thread that
-	 * passes this runnable to a new thread.
-	 *
-	 * @return True if initialization was successful, false otherwise
+	 * Destructor
 	 */
-	virtual bool Init() override;
+	~CAudioStreamSource();
 
 	/**
-	 * @brief Run
-	 *
-	 * This is where all per object thread work is done. This is only called
-	 * if the initialization was successful.
-	 *
-	 * @return The exit code of the runnable object
+	 * Play
 	 */
-	virtual uint32 Run() override;
+	virtual void Play() override;
 
 	/**
-	 * @brief Stop
-	 *
-	 * This is called if a thread is requested to terminate early
+	 * Pause
+	 */
+	virtual void Pause() override;
+
+	/**
+	 * Stop
 	 */
 	virtual void Stop() override;
 
 	/**
-	 * @brief Exit
-	 *
-	 * Called in the context of the aggregating thread to perform any cleanup.
+	 * Set loop
+	 * @param InIsLoop Is need loop sound
 	 */
-	virtual void Exit() override;
+	virtual void SetLoop( bool InIsLoop ) override;
+
+	/**
+	 * Set audio bank
+	 * @param InAudioBank Audio bank
+	 */
+	virtual void SetAudioBank( const TAssetHandle<CAudioBank>& InAudioBank ) override;
+
+	/**
+	 * Is looped
+	 * @return Return true if sound is looped, else return false
+	 */
+	virtual bool IsLooped() const override;
+
+	/**
+	 * Get audio source status
+	 * @return Return audio source status
+	 */
+	virtual EAudioSourceStatus GetStatus() const override;
 
 private:
 	/**
@@ -84,11 +94,29 @@ private:
 		uint32			numSamples;	/**< Number samples in array */
 	};
 
+	/**
+	 * Service the stream, called by a worker of the audio streaming manager
+	 * Starts the stream on the first call, after that refills processed OpenAL buffers
+	 *
+	 * @param InOutSamples	Buffer of samples of the worker
+	 * @param OutStats		Output stats of the service
+	 * @return Return FALSE if the stream is finished and mustn't be serviced anymore, else return TRUE
+	 */
+	bool ServiceStream( std::vector<byte>& InOutSamples, AudioStreamStats& OutStats );
+
+	/**
+	 * Stop playback and delete OpenAL buffers of the stream if it's started
+	 */
+	void FinishStream();
+
 	/**
 	 * Fill OpenAL queue buffers
-	 * @return Return true if need stop thread, else return false
+	 * 
+	 * @param InOutSamples	Buffer of samples
+	 * @param OutStats		Output stats of decoding
+	 * @return Return true if need stop stream, else return false
 	 */
-	bool FillQueue();
+	bool FillQueue( std::vector<byte>& InOutSamples, AudioStreamStats& OutStats );
 
 	/**
 	 * Clear OpenAL queue buffers
@@ -99,82 +127,21 @@ private:
 	 * Fill OpenAL buffer and push to queue
 	 * 
 	 * @param InBufferIndex Buffer index to update
-	 * @return Return true if need stop thread, else return false
+	 * @param InOutSamples	Buffer of samples
+	 * @param OutStats		Output stats of decoding
+	 * @return Return true if need stop stream, else return false
 	 */
-	bool FillAndPushBuffer( uint32 InBufferIndex );
+	bool FillAndPushBuffer( uint32 InBufferIndex, std::vector<byte>& InOutSamples, AudioStreamStats& OutStats );
 
 	/**
 	 * Get loaded data from bank
 	 * 
 	 * @param OutData Output loaded data
+	 * @param InOutSamples	Buffer of samples
 	 * @return Return true if seccussed loaded, else return false
 	 */
-	bool GetData( Chunk& OutData );
-	
-	class CAudioStreamSource*		streamSource;				/**< Stream source */
-	uint32							alBuffers[ BufferCount ];	/**< OpenAL buffers */
-	std::vector<byte>				samples;					/**< Buffer of samples for streamed to buffers */
-};
+	bool GetData( Chunk& OutData, std::vector<byte>& InOutSamples );
 
-/**
- * @ingroup Audio
- * @brief Audio stream source
- */
-class CAudioStreamSource : public CAudioSource
-{
-public:
-	friend class CAudioStreamRunnable;
-
-	/**
-	 * Constructor
-	 */
-	CAudioStreamSource();
-
-	/**
-	 * Destructor
-	 */
-	~CAudioStreamSource();
-
-	/**
-	 * Play
-	 */
-	virtual void Play() override;
-
-	/**
-	 * Pause
-	 */
-	virtual void Pause() override;
-
-	/**
-	 * Stop
-	 */
-	virtual void Stop() override;
-
-	/**
-	 * Set loop
-	 * @param InIsLoop Is need loop sound
-	 */
-	virtual void SetLoop( bool InIsLoop ) override;
-
-	/**
-	 * Set audio bank
-	 * @param InAudioBank Audio bank
-	 */
-	virtual void SetAudioBank( const TAssetHandle<CAudioBank>& InAudioBank ) override;
-
-	/**
-	 * Is looped
-	 * @return Return true if sound is looped, else return false
-	 */
-	virtual bool IsLooped() const override;
-
-	/**
-	 * Get audio source status
-	 * @return Return audio source status
-	 */
-	virtual EAudioSourceStatus GetStatus() const override;
-
-private:
 	/**
 	 * Open bank for stream
 	 * @param InAudioBank Audio bank
@@ -200,8 +167,15 @@ private:
 	AudioBankHandle_t			audioBankHandle;		/**< Handle to opened bank for streamed audio */
 	AudioBankInfo				audioBankInfo;			/**< Info about opened bank */
 	mutable CMutex				mutexStreamData;		/**< Critical section of stream data */
-	CAudioStreamRunnable*		audioStreamRunnable;	/**< Audio stream runnable */
-	CRunnableThread*			threadStreamData;		/**< Thread for streaming audio */
+	bool						bStreamStarted;			/**< Are OpenAL buffers of the stream created and queued */
+	bool						bRequestStop;			/**< Is the end of audio queued */
+	bool						bIsServiced;			/**< Is the stream serviced by a streaming worker now, guarded by the streaming manager */
+	uint32						chunkSize;				/**< Size of one streamed chunk */
+	float						serviceInterval;		/**< Time in seconds between services of the stream */
+	double						nextServiceTime;		/**< Time when the stream must be serviced next, guarded by the streaming manager */
+	uint32						alBuffers[ BufferCount ];	/**< OpenAL buffers */
+	std::wstring				streamName;				/**< Name of the streamed audio bank */
+	AudioStreamStats			streamStats;			/**< Stats of the stream, guarded by the streaming manager */
 };
 
 #endif // !AUDIOSTREAMSOURCE_H
\ No newline at end of file
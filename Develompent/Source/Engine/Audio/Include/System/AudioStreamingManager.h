@@ -0,0 +1,179 @@
+/**
+ * @file
+ * @addtogroup Audio Audio
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef AUDIOSTREAMINGMANAGER_H
+#define AUDIOSTREAMINGMANAGER_H
+
+#include <vector>
+#include <string>
+
+#include "Misc/Types.h"
+#include "System/Threading.h"
+
+/**
+ * @ingroup Audio
+ * @brief Stats of an audio stream
+ */
+struct AudioStreamStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	AudioStreamStats()
+		: numUnderruns( 0 )
+		, numDecodedChunks( 0 )
+		, decodeTime( 0.0 )
+		, maxDecodeTime( 0.0 )
+	{}
+
+	/**
+	 * @brief Add stats of one service of the stream
+	 * @param InStats	Stats of the service
+	 */
+	FORCEINLINE void Add( const AudioStreamStats& InStats )
+	{
+		numUnderruns		+= InStats.numUnderruns;
+		numDecodedChunks	+= InStats.numDecodedChunks;
+		decodeTime			+= InStats.decodeTime;
+		maxDecodeTime		= InStats.maxDecodeTime > maxDecodeTime ? InStats.maxDecodeTime : maxDecodeTime;
+	}
+
+	std::wstring	name;				/**< Name of the streamed audio bank */
+	uint32			numUnderruns;		/**< Number of times the source has played out all queued buffers */
+	uint32			numDecodedChunks;	/**< Number of decoded chunks */
+	double			decodeTime;			/**< Total time of decoding in ms */
+	double			maxDecodeTime;		/**< Max time of decoding one chunk in ms */
+};
+
+/**
+ * @ingroup Audio
+ * @brief Streaming service of audio stream sources
+ *
+ * A small fixed pool of worker threads services all playing stream sources. Each source has a deadline, the time when
+ * its queue of OpenAL buffers must be refilled, and workers always take the source with the earliest deadline.
+ * Samples are decoded into the sample buffer of the worker, so memory for samples doesn't grow with number of sources
+ */
+class CAudioStreamingManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CAudioStreamingManager();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CAudioStreamingManager();
+
+	/**
+	 * @brief Initialize the streaming manager and start worker threads
+	 */
+	void Init();
+
+	/**
+	 * @brief Stop worker threads
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Add a stream source to service
+	 * @param InStreamSource	Stream source
+	 */
+	void AddStream( class CAudioStreamSource* InStreamSource );
+
+	/**
+	 * @brief Remove a stream source from service
+	 * @note If a worker services the stream source now, it waits for the worker
+	 *
+	 * @param InStreamSource	Stream source
+	 */
+	void RemoveStream( class CAudioStreamSource* InStreamSource );
+
+	/**
+	 * @brief Get stats of streams which are serviced now
+	 * @note Thread safe
+	 *
+	 * @param OutStats	Output array of stats
+	 */
+	void GetStreamStats( std::vector<AudioStreamStats>& OutStats );
+
+	/**
+	 * @brief Get number of worker threads
+	 * @return Return number of worker threads
+	 */
+	FORCEINLINE uint32 GetNumThreads() const
+	{
+		return threads.size();
+	}
+
+private:
+	/**
+	 * @brief Worker thread of the streaming manager
+	 */
+	class CWorker : public CRunnable
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param InManager		Streaming manager
+		 */
+		CWorker( CAudioStreamingManager* InManager );
+
+		/**
+		 * @brief Initialize
+		 * @return Return TRUE if initialization was successful, FALSE otherwise
+		 */
+		virtual bool Init() override;
+
+		/**
+		 * @brief Run
+		 * @return Return the exit code of the runnable object
+		 */
+		virtual uint32 Run() override;
+
+		/**
+		 * @brief Stop
+		 */
+		virtual void Stop() override;
+
+		/**
+		 * @brief Exit
+		 */
+		virtual void Exit() override;
+
+	private:
+		CAudioStreamingManager*		manager;	/**< Streaming manager */
+		std::vector<byte>			samples;	/**< Buffer of samples which are decoded to fill OpenAL buffers */
+	};
+
+	/**
+	 * @brief Take the stream source with the earliest deadline which has come
+	 *
+	 * @param OutWaitTime	Output time in seconds until the nearest deadline, if there isn't a stream source to service now
+	 * @return Return the stream source to service, NULL if there isn't one
+	 */
+	class CAudioStreamSource* TakeStream( float& OutWaitTime );
+
+	/**
+	 * @brief Return the stream source after service
+	 *
+	 * @param InStreamSource	Stream source
+	 * @param InStats			Stats of the service
+	 * @param InIsFinished		Is the stream finished, then it's removed from service
+	 */
+	void ReturnStream( class CAudioStreamSource* InStreamSource, const AudioStreamStats& InStats, bool InIsFinished );
+
+	CMutex									mutex;			/**< Mutex of stream sources */
+	std::vector<class CAudioStreamSource*>	streams;		/**< Serviced stream sources */
+	std::vector<CRunnableThread*>			threads;		/**< Worker threads */
+	CEvent*									wakeUpEvent;	/**< Event to wake up workers */
+	volatile int32							bIsStopping;	/**< Are workers stopping */
+};
+
+#endif // !AUDIOSTREAMINGMANAGER_H
@@ -2,6 +2,7 @@
 #include "System/AudioEngine.h"
 #include "System/AudioDevice.h"
 #include "System/AudioBufferManager.h"
+#include "System/AudioStreamingManager.h"
 
 // -------------
 // GLOBALS
@@ -9,4 +10,5 @@
 
 CAudioEngine				g_AudioEngine;
 CAudioDevice				g_AudioDevice;
-CAudioBufferManager			g_AudioBufferManager;
\ No newline at end of file
+CAudioBufferManager			g_AudioBufferManager;
+CAudioStreamingManager		g_AudioStreamingManager;
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Misc/AudioGlobals.h"
 #include "System/AudioEngine.h"
+#include "System/AudioDevice.h"
+#include "System/AudioStreamingManager.h"
 
 /*
 ==================
@@ -9,6 +11,7 @@ CAudioEngine::Init
 void CAudioEngine::Init()
 {
 	g_AudioDevice.Init();
+	g_AudioStreamingManager.Init();
 }
 
 /*
@@ -18,5 +21,6 @@ CAudioEngine::Shutdown
 */
 void CAudioEngine::Shutdown()
 {
+	g_AudioStreamingManager.Shutdown();
 	g_AudioDevice.Shutdown();
 }
\ No newline at end of file
@@ -1,162 +1,302 @@
+#include "Misc/AudioGlobals.h"
 #include "System/AudioStreamSource.h"
+#include "System/AudioStreamingManager.h"
+#include "System/Profiler.h"
 #include "Logger/LoggerMacros.h"
 
+/* Min time in seconds between services of a stream */
+#define AUDIOSTREAM_MIN_SERVICE_INTERVAL	0.005f
+
 /*
 ==================
-CAudioStreamRunnable::CAudioStreamRunnable
+CAudioStreamSource::CAudioStreamSource
 ==================
 */
-CAudioStreamRunnable::CAudioStreamRunnable( CAudioStreamSource* InStreamSource )
-	: streamSource( InStreamSource )
-{}
+CAudioStreamSource::CAudioStreamSource()
+	: bIsStreaming( false )
+	, bIsLoop( false )
+	, status( ASS_Stoped )
+	, audioBankHandle( nullptr )
+	, bStreamStarted( false )
+	, bRequestStop( false )
+	, bIsServiced( false )
+	, chunkSize( 0 )
+	, serviceInterval( AUDIOSTREAM_MIN_SERVICE_INTERVAL )
+	, nextServiceTime( 0.0 )
+{
+	Memory::Memzero( alBuffers, sizeof( alBuffers ) );
+}
 
 /*
 ==================
-CAudioStreamRunnable::Init
+CAudioStreamSource::~CAudioStreamSource
 ==================
 */
-bool CAudioStreamRunnable::Init()
+CAudioStreamSource::~CAudioStreamSource()
 {
-	return true;
+	if ( audioBankHandle )
+	{
+		SetAudioBank( nullptr );
+	}
+
+	// The streaming manager mustn't keep the source even if it hasn't been stopped
+	g_AudioStreamingManager.RemoveStream( this );
+	FinishStream();
 }
 
 /*
 ==================
-CAudioStreamRunnable::Run
+CAudioStreamSource::Play
 ==================
 */
-uint32 CAudioStreamRunnable::Run()
+void CAudioStreamSource::Play()
 {
-	bool			bRequestStop = false;
-	Assert( streamSource );
+	// If audio bank handle is not valid or source is muted, do nothing
+	if ( !audioBankHandle || IsMuted() )
+	{
+		return;
+	}
+
+	bool					isStreaming = false;
+	EAudioSourceStatus		status = ASS_Stoped;
 
+	// Getting values state
 	{
-		// Check if the thread was launched is stopped
-		CScopeLock		scopeLock( &streamSource->mutexStreamData );
-		if ( streamSource->status == ASS_Stoped )
+		CScopeLock		scopeLock( &mutexStreamData );
+		isStreaming		= bIsStreaming;
+		status			= this->status;
+	}
+
+	// If sound is streaming and thread state is ASS_Paused - start play sound
+	// If sound is streaming and thread state is ASS_Playing - do nothing
+	if ( isStreaming && status == ASS_Paused )
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		this->status = ASS_Playing;
+		alSourcePlay( GetALHandle() );
+		return;
+	}
+	else if ( isStreaming && status == ASS_Playing )
+	{
+		return;
+	}
+
+	// The previous stream may have just ended on a streaming worker, wait for it and release its buffers
+	g_AudioStreamingManager.RemoveStream( this );
+	FinishStream();
+
+	// The stream is serviced twice per duration of a chunk, so the queue never runs low on buffers
+	TSharedPtr<CAudioBank>		audioBankRef	= audioBank.ToSharedPtr();
+	const uint32				bytesPerSecond	= audioBankInfo.rate * Sys_GetNumSampleBytes( audioBankInfo.format ) / 8;
+	streamName			= audioBankRef ? audioBankRef->GetAssetName() : TEXT( "" );
+	chunkSize			= audioBankInfo.rate * audioBankInfo.numChannels;
+	serviceInterval		= bytesPerSecond > 0 ? Max( chunkSize / ( float )bytesPerSecond * 0.5f, AUDIOSTREAM_MIN_SERVICE_INTERVAL ) : AUDIOSTREAM_MIN_SERVICE_INTERVAL;
+	bRequestStop		= false;
+
+	// Start streaming data by the streaming manager
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		bIsStreaming	= true;
+		this->status	= ASS_Playing;
+	}
+	g_AudioStreamingManager.AddStream( this );
+}
+
+/*
+==================
+CAudioStreamSource::Pause
+==================
+*/
+void CAudioStreamSource::Pause()
+{
+	// If audio source is muted, do nothing
+	if ( IsMuted() )
+	{
+		return;
+	}
+
+	// Set state to ASS_Paused
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		if ( !bIsStreaming )
 		{
-			streamSource->bIsStreaming = false;
-			return 0;
+			return;
 		}
+		status = ASS_Paused;
 	}
 
-	// Resize sample buffer for streaming audio
-	samples.resize( streamSource->audioBankInfo.rate * streamSource->audioBankInfo.numChannels );
+	alSourcePause( GetALHandle() );
+}
 
-	// Create the buffers
-	alGenBuffers( BufferCount, alBuffers );
+/*
+==================
+CAudioStreamSource::Stop
+==================
+*/
+void CAudioStreamSource::Stop()
+{
+	// If audio source is muted, do nothing
+	if ( IsMuted() )
+	{
+		return;
+	}
 
-	// Fill the queue
-	bRequestStop = FillQueue();
+	// Request the thread to terminate
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		bIsStreaming	= false;
+	}
 
-	// Play the sound
-	alSourcePlay( streamSource->GetALHandle() );
+	// Wait for the streaming worker and release buffers of the stream
+	g_AudioStreamingManager.RemoveStream( this );
+	FinishStream();
 
+	// Move to the beginning
+	TSharedPtr<CAudioBank>		audioBankRef = audioBank.ToSharedPtr();
+	if ( audioBankHandle && audioBankRef )
 	{
-		// Check if the thread was launched is paused
-		CScopeLock		scopeLock( &streamSource->mutexStreamData );
-		if ( streamSource->status == ASS_Paused )
+		audioBankRef->SeekBankPCM( audioBankHandle, 0 );
+	}
+}
+
+/*
+==================
+CAudioStreamSource::ServiceStream
+==================
+*/
+bool CAudioStreamSource::ServiceStream( std::vector<byte>& InOutSamples, AudioStreamStats& OutStats )
+{
+	SCOPED_PROFILER( TEXT( "Audio" ), TEXT( "ServiceStream" ) );
+	TSharedPtr<CAudioBank>		audioBankRef = audioBank.ToSharedPtr();		// Lock audio bank for him not unloaded ahead of time
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		if ( !bIsStreaming )
 		{
-			alSourcePause( streamSource->GetALHandle() );
+			// Stop releases buffers of the stream
+			return false;
+		}
+
+		// Check if the stream was launched is stopped or the bank is unloaded
+		if ( ( !bStreamStarted && status == ASS_Stoped ) || !audioBankRef )
+		{
+			bIsStreaming = false;
+			FinishStream();
+			return false;
 		}
 	}
 
-	while ( true )
+	// The buffer of samples is shared by all streams of the worker
+	if ( InOutSamples.size() < chunkSize )
 	{
-		TSharedPtr<CAudioBank>		audioBankRef = streamSource->audioBank.ToSharedPtr();		// Lock audio bank for him not unloaded ahead of time
+		InOutSamples.resize( chunkSize );
+	}
+	nextServiceTime = Sys_Seconds() + serviceInterval;
+
+	// Create and fill the buffers and play the sound on the first service
+	if ( !bStreamStarted )
+	{
+		alGenBuffers( BufferCount, alBuffers );
+		bStreamStarted	= true;
+		bRequestStop	= FillQueue( InOutSamples, OutStats );
+		alSourcePlay( GetALHandle() );
+
+		// Check if the stream was launched is paused
+		CScopeLock		scopeLock( &mutexStreamData );
+		if ( status == ASS_Paused )
 		{
-			CScopeLock		scopeLock( &streamSource->mutexStreamData );
-			if ( !streamSource->bIsStreaming || !audioBankRef )
-			{
-				break;
-			}
+			alSourcePause( GetALHandle() );
 		}
+		return true;
+	}
 
-		// The stream has been interrupted!
-		if ( streamSource->GetStatus() == ASS_Stoped )
+	// The source stops when it has played all queued buffers, it's the end of audio or an underrun
+	ALint		alState = AL_STOPPED;
+	alGetSourcei( GetALHandle(), AL_SOURCE_STATE, &alState );
+	if ( alState == AL_STOPPED && bRequestStop )
+	{
 		{
-			// If not request stop - just continue
-			if ( !bRequestStop )
-			{
-				alSourcePlay( streamSource->GetALHandle() );
-			}
-			else
-			{
-				// End streaming
-				CScopeLock		scopeLock( &streamSource->mutexStreamData );
-				streamSource->bIsStreaming = false;
-			}
+			CScopeLock		scopeLock( &mutexStreamData );
+			bIsStreaming = false;
 		}
+		FinishStream();
+		return false;
+	}
 
-		// Get the number of buffers that have been processed (i.e. ready for reuse)
-		ALint			processed = 0;
-		alGetSourcei( streamSource->GetALHandle(), AL_BUFFERS_PROCESSED, &processed );
+	const bool	bIsUnderrun = alState == AL_STOPPED;
+	if ( bIsUnderrun )
+	{
+		++OutStats.numUnderruns;
+		Warnf( TEXT( "Audio stream '%s' underrun, all queued buffers have been played\n" ), streamName.c_str() );
+	}
 
-		while ( processed-- )
-		{
-			// Pop the first unused buffer from the queue
-			ALuint			buffer = 0;
-			alSourceUnqueueBuffers( streamSource->GetALHandle(), 1, &buffer );
+	// Refill processed buffers and push them back into the playing queue
+	ALint		processed = 0;
+	alGetSourcei( GetALHandle(), AL_BUFFERS_PROCESSED, &processed );
+	while ( processed-- && !bRequestStop )
+	{
+		// Pop the first unused buffer from the queue
+		ALuint		buffer = 0;
+		alSourceUnqueueBuffers( GetALHandle(), 1, &buffer );
 
-			// Find its number
-			uint32		bufferID = 0;
-			for ( uint32 index = 0; index < BufferCount; ++index )
+		// Find its number
+		uint32		bufferID = 0;
+		for ( uint32 index = 0; index < BufferCount; ++index )
+		{
+			if ( alBuffers[ index ] == buffer )
 			{
-				if ( alBuffers[ index ] == buffer )
-				{
-					bufferID = index;
-					break;
-				}
+				bufferID = index;
+				break;
 			}
+		}
 
-			// Fill it and push it back into the playing queue
-			if ( FillAndPushBuffer( bufferID ) )
-			{
-				bRequestStop = true;
-			}
+		if ( FillAndPushBuffer( bufferID, InOutSamples, OutStats ) )
+		{
+			bRequestStop = true;
 		}
+	}
 
-		// Leave some time for the other threads if the stream is still playing
-		if ( streamSource->GetStatus() != ASS_Stoped )
+	// Resume the playback after the underrun, unless the source has been paused meanwhile
+	if ( bIsUnderrun )
+	{
+		CScopeLock		scopeLock( &mutexStreamData );
+		if ( status != ASS_Paused )
 		{
-			Sys_Sleep( 0.01f );		// 10 milliseconds
+			alSourcePlay( GetALHandle() );
 		}
 	}
+	return true;
+}
+
+/*
+==================
+CAudioStreamSource::FinishStream
+==================
+*/
+void CAudioStreamSource::FinishStream()
+{
+	if ( !bStreamStarted )
+	{
+		return;
+	}
 
 	// Stop the playback
-	alSourceStop( streamSource->GetALHandle() );
+	alSourceStop( GetALHandle() );
 
 	// Dequeue any buffer left in the queue
 	ClearQueue();
 
 	// Delete the buffers
-	alSourcei( streamSource->GetALHandle(), AL_BUFFER, 0 );
+	alSourcei( GetALHandle(), AL_BUFFER, 0 );
 	alDeleteBuffers( BufferCount, alBuffers );
-	return 0;
+	bStreamStarted = false;
 }
 
 /*
 ==================
-CAudioStreamRunnable::Stop
+CAudioStreamSource::FillQueue
 ==================
 */
-void CAudioStreamRunnable::Stop()
-{}
-
-/*
-==================
-CAudioStreamRunnable::Exit
-==================
-*/
-void CAudioStreamRunnable::Exit()
-{}
-
-/*
-==================
-CAudioStreamRunnable::FillQueue
-==================
-*/
-bool CAudioStreamRunnable::FillQueue()
+bool CAudioStreamSource::FillQueue( std::vector<byte>& InOutSamples, AudioStreamStats& OutStats )
 {	
 	// Fill and enqueue all the available buffers
 	bool			requestStop = false;
@@ -164,7 +304,7 @@ bool CAudioStreamRunnable::FillQueue()
 	{
 		// Since no sound has been loaded yet, we can't schedule loop seeks preemptively,
 		// So if we start on EOF or Loop End, we let FillAndPushBuffer() adjust the sample count
-		if ( FillAndPushBuffer( index ) )
+		if ( FillAndPushBuffer( index, InOutSamples, OutStats ) )
 		{
 			requestStop = true;
 		}
@@ -175,45 +315,46 @@ bool CAudioStreamRunnable::FillQueue()
 
 /*
 ==================
-CAudioStreamRunnable::ClearQueue
+CAudioStreamSource::ClearQueue
 ==================
 */
-void CAudioStreamRunnable::ClearQueue()
+void CAudioStreamSource::ClearQueue()
 {
 	// Get the number of buffers still in the queue
 	ALint			queued;
-	alGetSourcei( streamSource->GetALHandle(), AL_BUFFERS_QUEUED, &queued );
+	alGetSourcei( GetALHandle(), AL_BUFFERS_QUEUED, &queued );
 
 	// Dequeue them all
 	ALuint			buffer;
 	for ( ALint index = 0; index < queued; ++index )
 	{
-		alSourceUnqueueBuffers( streamSource->GetALHandle(), 1, &buffer );
+		alSourceUnqueueBuffers( GetALHandle(), 1, &buffer );
 	}
 }
 
 /*
 ==================
-CAudioStreamRunnable::FillAndPushBuffer
+CAudioStreamSource::FillAndPushBuffer
 ==================
 */
-bool CAudioStreamRunnable::FillAndPushBuffer( uint32 InBufferIndex )
+bool CAudioStreamSource::FillAndPushBuffer( uint32 InBufferIndex, std::vector<byte>& InOutSamples, AudioStreamStats& OutStats )
 {
-	bool		requestStop = false;
+	bool			requestStop = false;
+	const double	startTime	= Sys_Seconds();
 
 	// Acquire audio data, also address EOF and error cases if they occur
 	Chunk		data = { nullptr, 0 };
-	for ( uint32 retryCount = 0; !GetData( data ) && retryCount < BufferRetries; ++retryCount )
+	for ( uint32 retryCount = 0; !GetData( data, InOutSamples ) && retryCount < BufferRetries; ++retryCount )
 	{
 		// Check if the stream must loop or stop
-		if ( !streamSource->bIsLoop )
+		if ( !bIsLoop )
 		{
 			requestStop = true;
 			break;
 		}
 
 		//  If we looped - move to start file
-		streamSource->audioBank.ToSharedPtr()->SeekBankPCM( streamSource->audioBankHandle, 0 );
+		audioBank.ToSharedPtr()->SeekBankPCM( audioBankHandle, 0 );
 	}
 
 	// Fill the buffer if some data was returned
@@ -222,8 +363,8 @@ bool CAudioStreamRunnable::FillAndPushBuffer( uint32 InBufferIndex )
 		uint32			buffer = alBuffers[ InBufferIndex ];
 
 		// Fill the buffer and push it into the sound queue
-		alBufferData( buffer, Sys_SampleFormatToEngine( streamSource->audioBankInfo.format ), data.samples, data.numSamples, streamSource->audioBankInfo.rate );
-		alSourceQueueBuffers( streamSource->GetALHandle(), 1, &buffer );
+		alBufferData( buffer, Sys_SampleFormatToEngine( audioBankInfo.format ), data.samples, data.numSamples, audioBankInfo.rate );
+		alSourceQueueBuffers( GetALHandle(), 1, &buffer );
 	}
 	else
 	{
@@ -231,21 +372,26 @@ bool CAudioStreamRunnable::FillAndPushBuffer( uint32 InBufferIndex )
 		requestStop = true;
 	}
 
+	// Update cost of decoding
+	const double	decodeTime = ( Sys_Seconds() - startTime ) * 1000.0;
+	++OutStats.numDecodedChunks;
+	OutStats.decodeTime		+= decodeTime;
+	OutStats.maxDecodeTime	= Max( OutStats.maxDecodeTime, decodeTime );
 	return requestStop;
 }
 
 /*
 ==================
-CAudioStreamRunnable::GetData
+CAudioStreamSource::GetData
 ==================
 */
-bool CAudioStreamRunnable::GetData( Chunk& OutData )
+bool CAudioStreamSource::GetData( Chunk& OutData, std::vector<byte>& InOutSamples )
 {
-	CScopeLock	scopeLock( &streamSource->mutexStreamData );
-	TSharedPtr<CAudioBank>		audioBankRef	= streamSource->audioBank.ToSharedPtr();
-	uint32						toFill			= samples.size();
-	uint64						currentOffset	= audioBankRef->GetOffsetBankPCM( streamSource->audioBankHandle );
-	uint64						numSamples		= streamSource->audioBankInfo.numSamples;
+	// The bank isn't touched by other threads while the stream is serviced, so it's read without locks
+	TSharedPtr<CAudioBank>		audioBankRef	= audioBank.ToSharedPtr();
+	uint32						toFill			= chunkSize;
+	uint64						currentOffset	= audioBankRef->GetOffsetBankPCM( audioBankHandle );
+	uint64						numSamples		= audioBankInfo.numSamples;
 
 	// If there are less samples left than the buffer size, we count how many samples need to be read
 	if ( currentOffset + toFill > numSamples )
@@ -254,147 +400,14 @@ bool CAudioStreamRunnable::GetData( Chunk& OutData )
 	}
 
 	// Fill the chunk parameters
-	OutData.samples		= &samples[ 0 ];
-	OutData.numSamples	= audioBankRef->ReadBankPCM( streamSource->audioBankHandle, &samples[ 0 ], toFill );
+	OutData.samples		= &InOutSamples[ 0 ];
+	OutData.numSamples	= audioBankRef->ReadBankPCM( audioBankHandle, &InOutSamples[ 0 ], toFill );
 	currentOffset		+= OutData.numSamples;
 
 	// Check if we have stopped obtaining samples or reached either the EOF or the loop end point
 	return OutData.numSamples != 0 && currentOffset != numSamples;
 }
 
-
-/*
-==================
-CAudioStreamSource::CAudioStreamSource
-==================
-*/
-CAudioStreamSource::CAudioStreamSource()
-	: bIsStreaming( false )
-	, bIsLoop( false )
-	, status( ASS_Stoped )
-	, audioBankHandle( nullptr )
-	, audioStreamRunnable( nullptr )
-	, threadStreamData( nullptr )
-{}
-
-/*
-==================
-CAudioStreamSource::~CAudioStreamSource
-==================
-*/
-CAudioStreamSource::~CAudioStreamSource()
-{
-	if ( audioBankHandle )
-	{
-		SetAudioBank( nullptr );
-	}
-}
-
-/*
-==================
-CAudioStreamSource::Play
-==================
-*/
-void CAudioStreamSource::Play()
-{
-	// If audio bank handle is not valid or source is muted, do nothing
-	if ( !audioBankHandle || IsMuted() )
-	{
-		return;
-	}
-
-	bool					isStreaming = false;
-	EAudioSourceStatus		status = ASS_Stoped;
-
-	// Getting values state
-	{
-		CScopeLock		scopeLock( &mutexStreamData );
-		isStreaming		= bIsStreaming;
-		status			= this->status;
-	}
-
-	// If sound is streaming and thread state is ASS_Paused - start play sound
-	// If sound is streaming and thread state is ASS_Playing - do nothing
-	if ( isStreaming && status == ASS_Paused )
-	{
-		CScopeLock		scopeLock( &mutexStreamData );
-		this->status = ASS_Playing;
-		alSourcePlay( GetALHandle() );
-		return;
-	}
-	else if ( isStreaming && status == ASS_Playing )
-	{
-		return;
-	}
-
-	// Start thread for streaming data
-	bIsStreaming		= true;
-	this->status		= ASS_Playing;
-	audioStreamRunnable = new CAudioStreamRunnable( this );
-	threadStreamData	= CRunnableThread::Create( audioStreamRunnable, TEXT( "AudioStream" ), true, true, 0, TP_Normal );
-}
-
-/*
-==================
-CAudioStreamSource::Pause
-==================
-*/
-void CAudioStreamSource::Pause()
-{
-	// If audio source is muted, do nothing
-	if ( IsMuted() )
-	{
-		return;
-	}
-
-	// Set state to ASS_Paused
-	{
-		CScopeLock		scopeLock( &mutexStreamData );
-		if ( !bIsStreaming )
-		{
-			return;
-		}
-		status = ASS_Paused;
-	}
-
-	alSourcePause( GetALHandle() );
-}
-
-/*
-==================
-CAudioStreamSource::Stop
-==================
-*/
-void CAudioStreamSource::Stop()
-{
-	// If audio source is muted, do nothing
-	if ( IsMuted() )
-	{
-		return;
-	}
-
-	// Request the thread to terminate
-	{
-		CScopeLock		scopeLock( &mutexStreamData );
-		bIsStreaming	= false;
-	}
-
-	// Wait for the thread to terminate
-	if ( threadStreamData )
-	{
-		threadStreamData->WaitForCompletion();
-		audioStreamRunnable		= nullptr;
-		threadStreamData		= nullptr;
-	}
-
-	// Move to the beginning
-	TSharedPtr<CAudioBank>		audioBankRef = audioBank.ToSharedPtr();
-	if ( audioBankHandle && audioBankRef )
-	{
-		audioBankRef->SeekBankPCM( audioBankHandle, 0 );
-	}
-}
-
 /*
 ==================
 CAudioStreamSource::SetLoop
@@ -0,0 +1,274 @@
+#include <algorithm>
+
+#include "Logger/LoggerMacros.h"
+#include "Misc/Template.h"
+#include "System/Config.h"
+#include "System/AudioStreamSource.h"
+#include "System/AudioStreamingManager.h"
+
+/* Default number of worker threads */
+#define AUDIOSTREAMING_DEFAULT_NUM_THREADS		2
+
+/* Max number of worker threads */
+#define AUDIOSTREAMING_MAX_NUM_THREADS			8
+
+/* Max time in seconds which a worker sleeps, it's also the sleep time without streams */
+#define AUDIOSTREAMING_MAX_WAIT_TIME			0.1f
+
+/*
+==================
+CAudioStreamingManager::CWorker::CWorker
+==================
+*/
+CAudioStreamingManager::CWorker::CWorker( CAudioStreamingManager* InManager )
+	: manager( InManager )
+{}
+
+/*
+==================
+CAudioStreamingManager::CWorker::Init
+==================
+*/
+bool CAudioStreamingManager::CWorker::Init()
+{
+	return true;
+}
+
+/*
+==================
+CAudioStreamingManager::CWorker::Run
+==================
+*/
+uint32 CAudioStreamingManager::CWorker::Run()
+{
+	while ( !manager->bIsStopping )
+	{
+		float					waitTime = 0.f;
+		CAudioStreamSource*		streamSource = manager->TakeStream( waitTime );
+		if ( !streamSource )
+		{
+			// Round the deadline up to whole ms, Wait( 0 ) would spin the worker until it's reached
+			manager->wakeUpEvent->Wait( Max<uint32>( ( uint32 )( waitTime * 1000.f + 0.999f ), 1 ) );
+			continue;
+		}
+
+		AudioStreamStats	stats;
+		bool				bIsFinished = !streamSource->ServiceStream( samples, stats );
+		manager->ReturnStream( streamSource, stats, bIsFinished );
+	}
+
+	return 0;
+}
+
+/*
+==================
+CAudioStreamingManager::CWorker::Stop
+==================
+*/
+void CAudioStreamingManager::CWorker::Stop()
+{}
+
+/*
+==================
+CAudioStreamingManager::CWorker::Exit
+==================
+*/
+void CAudioStreamingManager::CWorker::Exit()
+{}
+
+/*
+==================
+CAudioStreamingManager::CAudioStreamingManager
+==================
+*/
+CAudioStreamingManager::CAudioStreamingManager()
+	: wakeUpEvent( nullptr )
+	, bIsStopping( 0 )
+{}
+
+/*
+==================
+CAudioStreamingManager::~CAudioStreamingManager
+==================
+*/
+CAudioStreamingManager::~CAudioStreamingManager()
+{
+	Shutdown();
+}
+
+/*
+==================
+CAudioStreamingManager::Init
+==================
+*/
+void CAudioStreamingManager::Init()
+{
+	Assert( threads.empty() );
+
+	// Get number of worker threads from config
+	const CJsonValue*	configNumThreads = CConfig::Get().GetValue( CT_Engine, TEXT( "Audio.Audio" ), TEXT( "NumStreamingThreads" ) );
+	uint32				numThreads = Clamp( configNumThreads ? configNumThreads->GetInt( AUDIOSTREAMING_DEFAULT_NUM_THREADS ) : AUDIOSTREAMING_DEFAULT_NUM_THREADS, 1, AUDIOSTREAMING_MAX_NUM_THREADS );
+
+	bIsStopping		= 0;
+	wakeUpEvent		= new CEvent( false, nullptr );
+	for ( uint32 index = 0; index < numThreads; ++index )
+	{
+		CRunnableThread*	thread = CRunnableThread::Create( new CWorker( this ), TEXT( "AudioStreaming" ), false, true, 0, TP_AboveNormal );
+		if ( thread )
+		{
+			threads.push_back( thread );
+		}
+	}
+
+	if ( threads.empty() )
+	{
+		Sys_Error( TEXT( "Failed to create audio streaming threads" ) );
+	}
+	Logf( TEXT( "Audio streaming: %i threads\n" ), threads.size() );
+}
+
+/*
+==================
+CAudioStreamingManager::Shutdown
+==================
+*/
+void CAudioStreamingManager::Shutdown()
+{
+	if ( threads.empty() )
+	{
+		return;
+	}
+
+	// Stop worker threads. Each of them takes the event once, so it's triggered for every thread
+	Sys_InterlockedExchange( &bIsStopping, 1 );
+	for ( uint32 index = 0, count = threads.size(); index < count; ++index )
+	{
+		wakeUpEvent->Trigger();
+	}
+
+	for ( uint32 index = 0, count = threads.size(); index < count; ++index )
+	{
+		threads[index]->WaitForCompletion();
+		delete threads[index];
+	}
+	threads.clear();
+
+	delete wakeUpEvent;
+	wakeUpEvent = nullptr;
+}
+
+/*
+==================
+CAudioStreamingManager::AddStream
+==================
+*/
+void CAudioStreamingManager::AddStream( CAudioStreamSource* InStreamSource )
+{
+	Assert( InStreamSource );
+	{
+		CScopeLock		scopeLock( mutex );
+		Assert( std::find( streams.begin(), streams.end(), InStreamSource ) == streams.end() );
+		InStreamSource->nextServiceTime	= 0.0;
+		InStreamSource->bIsServiced		= false;
+		InStreamSource->streamStats		= AudioStreamStats();
+		streams.push_back( InStreamSource );
+	}
+
+	// The new stream must be started right away
+	if ( wakeUpEvent )
+	{
+		wakeUpEvent->Trigger();
+	}
+}
+
+/*
+==================
+CAudioStreamingManager::RemoveStream
+==================
+*/
+void CAudioStreamingManager::RemoveStream( CAudioStreamSource* InStreamSource )
+{
+	Assert( InStreamSource );
+	mutex.Lock();
+	auto	itStream = std::find( streams.begin(), streams.end(), InStreamSource );
+	if ( itStream != streams.end() )
+	{
+		streams.erase( itStream );
+	}
+
+	// Wait for the worker which services the stream now, service of one chunk is short
+	while ( InStreamSource->bIsServiced )
+	{
+		mutex.Unlock();
+		Sys_Yield();
+		mutex.Lock();
+	}
+	mutex.Unlock();
+}
+
+/*
+==================
+CAudioStreamingManager::TakeStream
+==================
+*/
+CAudioStreamSource* CAudioStreamingManager::TakeStream( float& OutWaitTime )
+{
+	CScopeLock				scopeLock( mutex );
+	CAudioStreamSource*		earliestStream = nullptr;
+	for ( uint32 index = 0, count = streams.size(); index < count; ++index )
+	{
+		CAudioStreamSource*		streamSource = streams[index];
+		if ( !streamSource->bIsServiced && ( !earliestStream || streamSource->nextServiceTime < earliestStream->nextServiceTime ) )
+		{
+			earliestStream = streamSource;
+		}
+	}
+
+	// Nothing to service, sleep until the nearest deadline
+	const double	currentTime = Sys_Seconds();
+	if ( !earliestStream || earliestStream->nextServiceTime > currentTime )
+	{
+		OutWaitTime = earliestStream ? Min<float>( earliestStream->nextServiceTime - currentTime, AUDIOSTREAMING_MAX_WAIT_TIME ) : AUDIOSTREAMING_MAX_WAIT_TIME;
+		return nullptr;
+	}
+
+	earliestStream->bIsServiced = true;
+	return earliestStream;
+}
+
+/*
+==================
+CAudioStreamingManager::ReturnStream
+==================
+*/
+void CAudioStreamingManager::ReturnStream( CAudioStreamSource* InStreamSource, const AudioStreamStats& InStats, bool InIsFinished )
+{
+	CScopeLock		scopeLock( mutex );
+	InStreamSource->bIsServiced = false;
+	InStreamSource->streamStats.Add( InStats );
+	if ( InIsFinished )
+	{
+		auto	itStream = std::find( streams.begin(), streams.end(), InStreamSource );
+		if ( itStream != streams.end() )
+		{
+			streams.erase( itStream );
+		}
+	}
+}
+
+/*
+==================
+CAudioStreamingManager::GetStreamStats
+==================
+*/
+void CAudioStreamingManager::GetStreamStats( std::vector<AudioStreamStats>& OutStats )
+{
+	CScopeLock		scopeLock( mutex );
+	OutStats.resize( streams.size() );
+	for ( uint32 index = 0, count = streams.size(); index < count; ++index )
+	{
+		CAudioStreamSource*		streamSource = streams[index];
+		OutStats[index]			= streamSource->streamStats;
+		OutStats[index].name	= streamSource->streamName;
+	}
+}
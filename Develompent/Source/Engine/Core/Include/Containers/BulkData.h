@@ -78,7 +78,18 @@ public:
 		{
 			data.resize( sizeData );
 		}
-		InArchive.SerializeCompressed( data.data(), sizeof( TType ) * sizeData, compressionFlags );
+
+		// Codec is stored with the data, so while cooking it may be overridden per asset type
+		uint32			flags = compressionFlags;
+		if ( InArchive.Ver() >= VER_CompressionFlagsInBulkData )
+		{
+			if ( InArchive.IsCooking() && compressionFlags != CF_None && InArchive.GetCookingCompressionFlags() != CF_None )
+			{
+				flags = InArchive.GetCookingCompressionFlags();
+			}
+			InArchive << flags;
+		}
+		InArchive.SerializeCompressed( data.data(), sizeof( TType ) * sizeData, ( ECompressionFlags )flags );
 	}
 
 	/**
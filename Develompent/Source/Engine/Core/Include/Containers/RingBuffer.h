@@ -16,10 +16,33 @@
 /**
  * @ingroup Core
  * @brief A ring buffer for use with two threads: a reading thread and a writing thread
+ *
+ * The buffer is lock-free between the writer and the reader, they only share the read and write pointers.
+ * If the buffer is full the writer sleeps on an event till the reader frees enough space, and if the buffer is empty
+ * the reader can sleep on an event in WaitForRead till new data is committed
  */
 class CRingBuffer
 {
 public:
+	/**
+	 * @brief Statistics of the ring buffer
+	 */
+	struct Stats
+	{
+		/**
+		 * @brief Constructor
+		 */
+		Stats()
+			: numWriteStalls( 0 )
+			, writeStallTime( 0.0 )
+			, readIdleTime( 0.0 )
+		{}
+
+		uint32		numWriteStalls;		/**< Number of times the writer waited for free space */
+		double		writeStallTime;		/**< Time the writer waited for free space (in milliseconds) */
+		double		readIdleTime;		/**< Time the reader waited for data in WaitForRead (in milliseconds) */
+	};
+
 	/**
 	 * @brief Constructor
 	 * 
@@ -103,6 +126,31 @@ public:
 	 */
 	void WaitForRead( uint32 InWaitTime = ( uint32 )-1 );
 
+	/**
+	 * @brief Wake up the reader thread waiting in WaitForRead even if there is no new data
+	 */
+	FORCEINLINE void WakeUpReader()
+	{
+		dataWrittenEvent.Trigger();
+	}
+
+	/**
+	 * @brief Get statistics of the ring buffer
+	 * @return Return statistics accumulated since construction or the last ResetStats call
+	 */
+	FORCEINLINE const Stats& GetStats() const
+	{
+		return stats;
+	}
+
+	/**
+	 * @brief Reset statistics of the ring buffer
+	 */
+	FORCEINLINE void ResetStats()
+	{
+		stats = Stats();
+	}
+
 	/**
 	 * @brief Checks if some data has been written to or not
 	 * @return Return TRUE if the buffer isn't empty, otherwise returns FALSE
@@ -113,13 +161,29 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Acquire the right to write into the ring buffer
+	 * @note Usually there is only one writing thread and it costs one interlocked operation
+	 */
+	void AcquireWriter();
+
+	/**
+	 * @brief Release the right to write into the ring buffer
+	 */
+	void ReleaseWriter();
+
 	byte*				data;					/**< Data buffer */
 	byte*				dataEnd;				/**< The first byte after end the of the data buffer */
 	byte* volatile		writePointer;			/**< The next byte to be written to */
 	bool				isWriting;				/**< TRUE if there is an AllocationContext outstanding for this ring buffer */
 	byte* volatile		readPointer;			/**< The next byte to be read from */
 	uint32				alignment;				/**< Alignment of each allocation unit (in bytes) */
-	CEvent		dataWrittenEvent;		/**< The event used to signal the reader thread when the ring buffer has data to read */
+	volatile int32		writerLock;				/**< Not zero if some thread is writing into the ring buffer */
+	volatile int32		bWriterWaiting;			/**< Not zero if the writer sleeps waiting for free space */
+	volatile int32		bReaderWaiting;			/**< Not zero if the reader sleeps waiting for data */
+	CEvent				dataWrittenEvent;		/**< The event used to signal the reader thread when the ring buffer has data to read */
+	CEvent				dataReadEvent;			/**< The event used to signal the writer thread when the ring buffer has free space */
+	Stats				stats;					/**< Statistics */
 };
 
 #endif // !RINGBUFFER_H
@@ -239,6 +239,14 @@ std::wstring Sys_GetComputerName();
  */
 std::wstring Sys_GetUserName();
 
+/**
+ * @ingroup Core
+ * @brief Get number of logical processor cores
+ * @note Need implement on each platform
+ * @return Return number of logical processor cores
+ */
+uint32 Sys_GetNumberOfCores();
+
 /**
  * @ingroup Core
  * @brief Does per platform initialization of timing information and returns the current time
@@ -255,6 +263,14 @@ double Sys_InitTiming();
  */
 double Sys_Seconds();
 
+/**
+ * @ingroup Core
+ * @brief Get value of the high resolution CPU counter. Use g_SecondsPerCycle to convert cycles to seconds
+ * @note Need implement on each platform
+ * @return Return number of cycles
+ */
+uint64 Sys_Cycles();
+
 /**
  * @ingroup Core
  * @brief Print critical error and shutdown application
@@ -55,6 +55,11 @@
 	#define FRAME_CAPTURE_MARKERS	!SHIPPING_BUILD
 #endif // !FRAME_CAPTURE_MARKERS
 
+// Enable or disable CPU profiler
+#ifndef ENABLE_PROFILER
+	#define ENABLE_PROFILER			!SHIPPING_BUILD
+#endif // !ENABLE_PROFILER
+
 // Is instancing allowed? 
 #ifndef USE_INSTANCING
 	#define USE_INSTANCING			1
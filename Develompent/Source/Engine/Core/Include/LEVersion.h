@@ -63,6 +63,7 @@ enum ELifeEnginePackageVersion
 	VER_SerializeProperties					= 31,					/**< Implemented serialize properties by CObject */
 	VER_NewSerializeName					= 32,					/**< New CName serialization */
 	VER_CompressedPackage					= 33,					/**< Implemented compression of CObjectPackage */
+	VER_CompressionFlagsInBulkData			= 34,					/**< Added compression flags to CBulkData, so codec may be changed at cook time */
 
 	//
 	// New versions can be added here
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ASYNCLOGWRITER_H
+#define ASYNCLOGWRITER_H
+
+#include <string>
+
+#include "Core.h"
+#include "Logger/BaseLogger.h"
+#include "System/Threading.h"
+
+/**
+ * @ingroup Core
+ * @brief Writer of log messages in a background thread
+ *
+ * Threads push formatted messages into a bounded lock-free multi-producer queue, the log thread takes them out
+ * in batches, serializes them into the logger and flushes the logger once per batch.
+ * If the queue is full, plain messages are dropped, while warnings and errors wait for a free slot (they are delayed).
+ * Numbers of dropped and delayed messages are reported to the log
+ */
+class CAsyncLogWriter : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InLogger		Logger which serializes messages
+	 * @param InQueueSize	Max number of messages in the queue, rounded up to a power of two
+	 */
+	CAsyncLogWriter( CBaseLogger* InLogger, uint32 InQueueSize );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CAsyncLogWriter();
+
+	/**
+	 * @brief Start the log thread
+	 * @return Return TRUE if the thread has been started, otherwise returns FALSE
+	 */
+	bool Start();
+
+	/**
+	 * @brief Stop the log thread, all queued messages are written before it
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Push a message into the queue
+	 * @note Thread safe
+	 *
+	 * @param InMessage		Message, it's moved into the queue
+	 * @param InLogType		Type of message
+	 * @return Return FALSE if the message must be serialized by the caller, e.g. it's called from the log thread itself
+	 */
+	bool Push( std::wstring& InMessage, ELogType InLogType );
+
+	/**
+	 * @brief Block the caller until all messages pushed before this call are written
+	 * @note Thread safe. Does nothing if it's called from the log thread
+	 */
+	void Flush();
+
+	/**
+	 * @brief Get number of dropped messages
+	 * @return Return number of messages which have been dropped because the queue was full
+	 */
+	FORCEINLINE uint32 GetNumDropped() const
+	{
+		return numDropped;
+	}
+
+	/**
+	 * @brief Get number of delayed messages
+	 * @return Return number of messages which have waited for a free slot in the queue
+	 */
+	FORCEINLINE uint32 GetNumDelayed() const
+	{
+		return numDelayed;
+	}
+
+	/**
+	 * @brief Initialize
+	 * @return Return TRUE if initialization was successful, FALSE otherwise
+	 */
+	virtual bool Init() override;
+
+	/**
+	 * @brief Run
+	 * @return Return the exit code of the runnable object
+	 */
+	virtual uint32 Run() override;
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override;
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override;
+
+private:
+	/**
+	 * @brief Slot of the queue
+	 */
+	struct Slot
+	{
+		volatile int32		sequence;	/**< Sequence number, it tells whether the slot is free or filled for the current lap */
+		ELogType			logType;	/**< Type of message */
+		std::wstring		message;	/**< Message */
+	};
+
+	/**
+	 * @brief Try to push a message into the queue
+	 *
+	 * @param InMessage		Message
+	 * @param InLogType		Type of message
+	 * @return Return FALSE if the queue is full
+	 */
+	bool TryPush( std::wstring& InMessage, ELogType InLogType );
+
+	/**
+	 * @brief Write all queued messages
+	 * @note Must be called only from the log thread or after it has been stopped
+	 *
+	 * @return Return TRUE if at least one message has been written
+	 */
+	bool WriteBatch();
+
+	/**
+	 * @brief Begin a call which uses the queue or the event
+	 * @return Return FALSE if the writer is stopping or it's called from the log thread, in this case EndCall mustn't be called
+	 */
+	bool BeginCall();
+
+	/**
+	 * @brief End a call which has been begun by BeginCall
+	 */
+	FORCEINLINE void EndCall()
+	{
+		Sys_InterlockedDecrement( &numActiveCalls );
+	}
+
+	/**
+	 * @brief Wake up the log thread if it's waiting
+	 */
+	FORCEINLINE void WakeUp()
+	{
+		if ( bIsWaiting )
+		{
+			wakeUpEvent->Trigger();
+		}
+	}
+
+	CBaseLogger*			logger;				/**< Logger which serializes messages */
+	Slot*					slots;				/**< Slots of the queue */
+	uint32					queueMask;			/**< Mask of slot index, number of slots minus one */
+	volatile int32			enqueuePos;			/**< Position for the next pushed message */
+	volatile int32			dequeuePos;			/**< Position of the next message to write */
+	volatile int32			flushedPos;			/**< Position up to which messages are written and flushed */
+	volatile int32			bIsStopping;		/**< Is the writer stopping, new messages aren't pushed */
+	volatile int32			bIsExiting;			/**< Must the log thread exit, it's set when all pushes are finished */
+	volatile int32			bIsWaiting;			/**< Is the log thread waiting for messages */
+	volatile int32			numActiveCalls;		/**< Number of Push and Flush calls in progress */
+	volatile int32			numDropped;			/**< Number of dropped messages */
+	volatile int32			numDelayed;			/**< Number of delayed messages */
+	uint32					numReportedDropped;	/**< Number of dropped messages which have already been reported */
+	uint32					threadId;			/**< ID of the log thread */
+	CEvent*					wakeUpEvent;		/**< Event to wake up the log thread */
+	CRunnableThread*		thread;				/**< Log thread */
+};
+
+#endif // !ASYNCLOGWRITER_H
@@ -44,12 +44,14 @@ public:
     /**
      * @brief Constructor
      */
-    CBaseLogger() {}
+    CBaseLogger()
+        : asyncWriter( nullptr )
+    {}
 
     /**
      * @brief Destructor
      */
-    virtual ~CBaseLogger() {}
+    virtual ~CBaseLogger();
 
     /**
      * @brief Initialize logger
@@ -102,6 +104,38 @@ public:
      * @brief Reset color text to default
      */
     virtual void ResetTextColor() {}
+
+    /**
+     * @brief Start asynchronous logging
+     * Printf pushes formatted messages into a queue and a background thread serializes them in batches,
+     * so the calling thread doesn't wait for the output device
+     *
+     * @param InQueueSize   Max number of messages in the queue
+     */
+    void StartAsync( uint32 InQueueSize );
+
+    /**
+     * @brief Stop asynchronous logging, all queued messages are serialized before it
+     */
+    void StopAsync();
+
+    /**
+     * @brief Block the caller until all queued messages are serialized and flushed
+     * @note Call it before the application crashes or aborts, otherwise queued messages are lost
+     */
+    void FlushAsync();
+
+    /**
+     * @brief Is asynchronous logging enabled
+     * @return Return TRUE if messages are serialized in a background thread, otherwise returns FALSE
+     */
+    FORCEINLINE bool IsAsync() const
+    {
+        return asyncWriter;
+    }
+
+private:
+    class CAsyncLogWriter*      asyncWriter;        /**< Writer of messages in a background thread, NULL if logging is synchronous */
 };
 
 #endif // !BASELOGGER_H
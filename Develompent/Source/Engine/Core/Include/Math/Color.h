@@ -195,4 +195,7 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const CColor& InValue )
 	return InArchive;
 }
 
+static_assert( sizeof( CColor ) == 4, "CColor must be tightly packed to be bitwise serializable" );
+DECLARE_BITWISE_SERIALIZABLE( CColor )
+
 #endif // !COLOR_H
@@ -987,4 +987,10 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const Quaternion& InValue
 	return InArchive;
 }
 
+DECLARE_BITWISE_SERIALIZABLE( Vector2D )
+DECLARE_BITWISE_SERIALIZABLE( Vector )
+DECLARE_BITWISE_SERIALIZABLE( Vector4D )
+DECLARE_BITWISE_SERIALIZABLE( Matrix )
+DECLARE_BITWISE_SERIALIZABLE( Quaternion )
+
 #endif // !MATH_H
@@ -239,6 +239,21 @@ public:
 		return MatchesNoScale( InOtherTransform ) && scale == InOtherTransform.scale;
 	}
 
+	/**
+	 * @brief Set this transform to the blend of two transforms
+	 *
+	 * @param InAtom1	Transform at alpha 0
+	 * @param InAtom2	Transform at alpha 1
+	 * @param InAlpha	Blend alpha in range [0, 1]
+	 */
+	FORCEINLINE void Blend( const CTransform& InAtom1, const CTransform& InAtom2, float InAlpha )
+	{
+		translation		= glm::mix( InAtom1.translation, InAtom2.translation, InAlpha );
+		rotation		= glm::slerp( InAtom1.rotation, InAtom2.rotation, InAlpha );
+		scale			= glm::mix( InAtom1.scale, InAtom2.scale, InAlpha );
+		bDirtyMatrix	= true;
+	}
+
 	/**
 	 * Set location
 	 * 
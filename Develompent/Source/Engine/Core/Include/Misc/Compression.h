@@ -9,7 +9,9 @@
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
-#include "Misc/Types.h"
+#include <string>
+
+#include "Core.h"
 
 /**
  * @ingroup Core
@@ -29,10 +31,55 @@
  */
 enum ECompressionFlags
 {
-	CF_None = 0,		/**< No compression */
-	CF_ZLIB = 1 << 0,	/**< Compress with ZLIB */
+	CF_None			= 0,						/**< No compression */
+	CF_ZLIB			= 1 << 0,					/**< Compress with ZLIB */
+	CF_LZ4			= 1 << 1,					/**< Compress with LZ4 block format. Decompression is several times faster than ZLIB, but ratio is lower */
+	CF_BiasSpeed	= 1 << 4,					/**< Prefer compression speed over ratio. Decompression isn't affected */
+	CF_BiasSize		= 1 << 5,					/**< Prefer compression ratio over speed (best level of ZLIB, high compression mode of LZ4). Decompression isn't affected */
+
+	CF_CodecMask	= CF_ZLIB | CF_LZ4,			/**< Mask of flags selecting the codec */
+	CF_BiasMask		= CF_BiasSpeed | CF_BiasSize	/**< Mask of flags modifying the compression level */
 };
 
+/**
+ * @ingroup Core
+ * @brief Convert text to compression flags
+ * Text is name of the codec ("None", "ZLIB" or "LZ4") and optionally the modifier after '+' ("BiasSpeed" or "BiasSize"), e.g. "ZLIB+BiasSize"
+ *
+ * @param InText	Text
+ * @return Return compression flags, if the text isn't valid returns CF_None
+ */
+FORCEINLINE ECompressionFlags ConvertTextToCompressionFlags( const std::wstring& InText )
+{
+	std::size_t		delimiterPos	= InText.find( TEXT( '+' ) );
+	std::wstring	codec			= InText.substr( 0, delimiterPos );
+	std::wstring	modifier		= delimiterPos != std::wstring::npos ? InText.substr( delimiterPos + 1 ) : TEXT( "" );
+	uint32			flags			= CF_None;
+
+	if ( codec == TEXT( "ZLIB" ) )
+	{
+		flags = CF_ZLIB;
+	}
+	else if ( codec == TEXT( "LZ4" ) )
+	{
+		flags = CF_LZ4;
+	}
+	else
+	{
+		return CF_None;
+	}
+
+	if ( modifier == TEXT( "BiasSpeed" ) )
+	{
+		flags |= CF_BiasSpeed;
+	}
+	else if ( modifier == TEXT( "BiasSize" ) )
+	{
+		flags |= CF_BiasSize;
+	}
+	return ( ECompressionFlags )flags;
+}
+
 /**
  * @ingroup Core
  * @brief Helper structure for compression support, containing information on compressed and uncompressed size of a chunk of data
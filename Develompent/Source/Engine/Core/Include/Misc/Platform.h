@@ -14,6 +14,7 @@
 #define PLATFORM_USE__ALIGNED_MALLOC        0
 #define PLATFORM_IS_STD_MALLOC_THREADSAFE   0
 #define PLATFORM_SUPPORTS_MIMALLOC          0
+#define PLATFORM_SUPPORTS_SSE               0
 
 // Platform specific definitions
 #if _WIN32 || _WIN64        // Windows platform
@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ASYNCPACKAGELOADER_H
+#define ASYNCPACKAGELOADER_H
+
+#include <vector>
+#include <list>
+
+#include "System/Delegate.h"
+#include "System/ThreadPool.h"
+#include "Reflection/ObjectMacros.h"
+#include "Core.h"
+
+/**
+ * @ingroup Core
+ * @brief Delegate called when async loading of a package is finished
+ * @note Package is NULL if loading has failed
+ */
+DECLARE_DELEGATE( COnAsyncPackageLoaded, class CObjectPackage* /*InPackage*/ );
+
+/**
+ * @ingroup Core
+ * @brief Asynchronous loader of object packages
+ *
+ * Loading of a package is split into two stages. At first the package file is read into memory
+ * and decompressed on worker threads of the thread pool (see CPreloadedPackageReader). After that
+ * the linker is created and export objects are created, serialized and post loaded on the game thread
+ * in ProcessAsyncLoading, which is called once per frame and is limited by time. While the package is loading
+ * its objects are in the root set, so they aren't collected by the garbage collector
+ */
+class CAsyncPackageLoader
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CAsyncPackageLoader();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CAsyncPackageLoader();
+
+	/**
+	 * @brief Get instance of the async package loader
+	 * @return Return instance of the async package loader
+	 */
+	static FORCEINLINE CAsyncPackageLoader& Get()
+	{
+		static CAsyncPackageLoader	asyncPackageLoader;
+		return asyncPackageLoader;
+	}
+
+	/**
+	 * @brief Request async loading of a package
+	 * @note If the package is already loading asynchronously the callback and load flags are added to existing request
+	 *
+	 * @param InFilename	File name on disk
+	 * @param InCallback	Callback called on the game thread when loading is finished
+	 * @param InLoadFlags	Flags controlling loading behavior (see ELoadFlags)
+	 * @return Return ID of the request
+	 */
+	uint32 LoadPackage( const tchar* InFilename, const COnAsyncPackageLoaded::DelegateType_t& InCallback, uint32 InLoadFlags );
+
+	/**
+	 * @brief Process async loading requests
+	 * @note Must be called from the game thread
+	 *
+	 * @param InIsUseTimeLimit	Whether the time limit parameter should be used
+	 * @param InTimeLimit		If InIsUseTimeLimit is TRUE, time limit for loading, if it's less or equal to zero will be used default
+	 */
+	void ProcessAsyncLoading( bool InIsUseTimeLimit, float InTimeLimit = 0.f );
+
+	/**
+	 * @brief Blocks till all pending requests are finished
+	 */
+	void FlushAsyncLoading();
+
+	/**
+	 * @brief Is any package loading asynchronously
+	 * @return Return TRUE if any package is loading asynchronously, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsAsyncLoading() const
+	{
+		return !requests.empty();
+	}
+
+	/**
+	 * @brief Is a request still loading
+	 *
+	 * @param InRequestId	ID of the request
+	 * @return Return TRUE if the request still loading, otherwise returns FALSE
+	 */
+	bool IsAsyncLoading( uint32 InRequestId ) const;
+
+	/**
+	 * @brief Set time limit per ProcessAsyncLoading call
+	 * @param InTimeLimit	Time limit in seconds
+	 */
+	FORCEINLINE void SetTimeLimitPerProcessAsyncLoadingCall( float InTimeLimit )
+	{
+		timeLimitPerProcessAsyncLoadingCall = InTimeLimit;
+	}
+
+	/**
+	 * @brief Get time limit per ProcessAsyncLoading call
+	 * @return Return time limit per ProcessAsyncLoading call in seconds
+	 */
+	FORCEINLINE float GetTimeLimitPerProcessAsyncLoadingCall() const
+	{
+		return timeLimitPerProcessAsyncLoadingCall;
+	}
+
+private:
+	/**
+	 * @brief Stage of async package request
+	 */
+	enum EAsyncLoadingStage
+	{
+		ALS_Preloading,			/**< Reading the package file on a worker thread */
+		ALS_CreateLinker,		/**< Creating the linker on the game thread */
+		ALS_LoadingExports,		/**< Loading export objects on the game thread */
+		ALS_Finished			/**< Loading is finished */
+	};
+
+	/**
+	 * @brief Task of preloading a package file on a worker thread
+	 */
+	class CPreloadTask : public CThreadPoolTask
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param InFilename	Path to package file
+		 */
+		CPreloadTask( const std::wstring& InFilename );
+
+		/**
+		 * @brief Destructor
+		 */
+		~CPreloadTask();
+
+		/**
+		 * @brief Do work
+		 */
+		virtual void DoWork() override;
+
+		/**
+		 * @brief Release preloaded package reader
+		 * @return Return preloaded package reader, if preloading has failed returns NULL. Caller is responsible for deleting it
+		 */
+		class CPreloadedPackageReader* ReleaseReader();
+
+	private:
+		class CPreloadedPackageReader*		reader;		/**< Preloaded package reader */
+	};
+
+	/**
+	 * @brief Async package request
+	 */
+	struct AsyncPackageRequest
+	{
+		uint32												id;					/**< ID of the request */
+		std::wstring										filename;			/**< Path to package file */
+		uint32												loadFlags;			/**< Flags controlling loading behavior (see ELoadFlags) */
+		EAsyncLoadingStage									stage;				/**< Current stage */
+		CPreloadTask*										preloadTask;		/**< Task of preloading the package file */
+		class CLinkerLoad*									linker;				/**< Linker of the package */
+		class CObjectPackage*								package;			/**< Loaded package */
+		uint32												nextExportIndex;	/**< Index of the next export to load */
+		uint32												nextRootExportIndex;	/**< Index of the next export to add to the root set */
+		std::vector<class CObject*>							rootedObjects;		/**< Objects added to the root set by the loader, they weren't in the root set before */
+		std::vector<COnAsyncPackageLoaded::DelegateType_t>	callbacks;			/**< Callbacks to call when loading is finished */
+	};
+
+	/**
+	 * @brief Process request
+	 *
+	 * @param InRequest			Request
+	 * @param InIsUseTimeLimit	Whether the time limit parameter should be used
+	 * @param InStartTime		Time when processing was started
+	 * @param InTimeLimit		Time limit
+	 * @return Return TRUE if the request is finished, otherwise returns FALSE
+	 */
+	bool ProcessRequest( AsyncPackageRequest* InRequest, bool InIsUseTimeLimit, double InStartTime, float InTimeLimit );
+
+	/**
+	 * @brief Add objects which were loaded since the last call to the root set
+	 * @param InRequest		Request
+	 */
+	void AddObjectsToRoot( AsyncPackageRequest* InRequest );
+
+	/**
+	 * @brief Finish the request
+	 * @param InRequest		Request
+	 */
+	void FinishRequest( AsyncPackageRequest* InRequest );
+
+	uint32								nextRequestId;							/**< ID of the next request */
+	float								timeLimitPerProcessAsyncLoadingCall;	/**< Time limit per ProcessAsyncLoading call (in seconds) */
+	std::list<AsyncPackageRequest*>		requests;								/**< Pending requests */
+};
+
+#endif // !ASYNCPACKAGELOADER_H
@@ -147,6 +147,85 @@ private:
 	PrecacheChunk						precacheChunk;			/**< Precache chunk */
 };
 
+/**
+ * @ingroup Core
+ * @brief Archive that reads package from memory
+ *
+ * Whole package file is read into memory by Preload, which is safe to call from any thread.
+ * If the package is stored compressed its chunks are decompressed in parallel on worker threads
+ * of the thread pool, so CLinkerLoad only copies data from memory. It's used by async package loading
+ */
+class CPreloadedPackageReader : public CArchive
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InPath	Path to package file
+	 */
+	CPreloadedPackageReader( const std::wstring& InPath );
+
+	/**
+	 * @brief Read the package file into memory and decompress it if need
+	 * @note Thread safe, usually it's called from a worker thread
+	 *
+	 * @return Return TRUE if the package was successfully read, otherwise returns FALSE
+	 */
+	bool Preload();
+
+	/**
+	 * @brief Serialize data
+	 * @param InBuffer	Pointer to buffer for serialize
+	 * @param InSize	Size of buffer
+	 */
+	virtual void Serialize( void* InBuffer, uint32 InSize ) override;
+
+	/**
+	 * @brief Set mapping from offsets/size that are going to be used for seeking and serialization to what
+	 * is actually stored on disk
+	 *
+	 * @param InCompressedChunks	Pointer to array containing information about (un)compressed chunks
+	 * @param InCompressionFlags	Flags determining compression format associated with mapping
+	 * @return Return TRUE if the package already was decompressed by Preload, otherwise FALSE
+	 */
+	virtual bool SetCompressionMap( std::vector<CompressedChunk>* InCompressedChunks, ECompressionFlags InCompressionFlags ) override;
+
+	/**
+	 * @brief Get current position in archive
+	 * @return Current position in archive
+	 */
+	virtual uint32 Tell() override;
+
+	/**
+	 * @brief Set current position in archive
+	 * @param InPosition	New position in archive
+	 */
+	virtual void Seek( uint32 InPosition ) override;
+
+	/**
+	 * @breif Is loading archive
+	 * @return Return TRUE if archive loading, FALSE if archive saving
+	 */
+	virtual bool IsLoading() const override;
+
+	/**
+	 * Is end of file
+	 * @return Return TRUE if end of file, otherwise FALSE
+	 */
+	virtual bool IsEndOfFile() override;
+
+	/**
+	 * @brief Get size of archive
+	 * @return Return size of archive
+	 */
+	virtual uint32 GetSize() override;
+
+private:
+	uint32					currentPos;			/**< Current position of archive */
+	bool					bUncompressed;		/**< Is reading from uncompressed data */
+	std::vector<byte>		fileData;			/**< Raw data of the package file */
+	std::vector<byte>		uncompressedData;	/**< Uncompressed data of the package. Empty if the package isn't compressed */
+};
+
 /**
  * @ingroup Core
  * @brief Handles loading LifeEngine package files, including reading CObject data from disk
@@ -160,8 +239,9 @@ public:
 	 * @param InRoot		The top-level CObjectPackage object for the package associated with this linker
 	 * @param InFilename	The name of the file for this package
 	 * @param InLoadFlags	Load flags determining behavior (see ELoadFlags)
+	 * @param InLoader		Archive to read the package from. If it's NULL the file will be opened by the linker. The linker takes ownership of it
 	 */
-	CLinkerLoad( CObjectPackage* InRoot, const tchar* InFilename, uint32 InLoadFlags );
+	CLinkerLoad( CObjectPackage* InRoot, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader = nullptr );
 
 	/**
 	 * @brief Destructor
@@ -174,9 +254,10 @@ public:
 	 * @param InOuter			Package if known, can be null
 	 * @param InFilename		Package resource to load, can be empty if InOuter is valid
 	 * @param InLoadFlags		Load flags determining behavior (see ELoadFlags)
+	 * @param InLoader			Archive to read the package from if a new linker will be created, can be NULL. Takes ownership of it
 	 * @return Return pointer to the loaded linker or NULL if the file didn't exist
 	 */
-	static CLinkerLoad* GetPackageLinker( CObjectPackage* InOuter, const tchar* InFilename, uint32 InLoadFlags );
+	static CLinkerLoad* GetPackageLinker( CObjectPackage* InOuter, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader = nullptr );
 
 	/**
 	 * @brief Create linker
@@ -184,9 +265,10 @@ public:
 	 * @param InParent		Parent object to load into, can be NULL (most likely case)
 	 * @param InFilename	Name of file on disk to load
 	 * @param InLoadFlags	Load flags determining behavior (see ELoadFlags)
+	 * @param InLoader		Archive to read the package from, can be NULL. Takes ownership of it
 	 * @return Return a new CLinkerLoad object for InParent/InFilename
 	 */
-	static CLinkerLoad* CreateLinker( CObjectPackage* InParent, const tchar* InFilename, uint32 InLoadFlags );
+	static CLinkerLoad* CreateLinker( CObjectPackage* InParent, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader = nullptr );
 
 	/**
 	 * @brief Create the instance of an object as found in this linker
@@ -204,6 +286,16 @@ public:
 	 */
 	void LoadAllObjects( bool InIsForcePreload = false );
 
+	/**
+	 * @brief Load one export object
+	 * @note Must be called between CObjectPackage::BeginLoadPackage and CObjectPackage::EndLoadPackage
+	 *
+	 * @param InExportIndex			Export object index
+	 * @param InIsForcePreload		Whether to explicitly call Preload (serialize) right away instead of being called from EndLoadPackage()
+	 * @return Return loaded export object. If failed returns NULL
+	 */
+	CObject* LoadExport( uint32 InExportIndex, bool InIsForcePreload = false );
+
 	/**
 	 * @brief Detaches file loader and removes itself from array of loaders
 	 */
@@ -309,6 +401,17 @@ public:
 		return loader != nullptr;
 	}
 
+	/**
+	 * @brief Add load flags
+	 * @note New flags affect only imports which aren't resolved yet
+	 *
+	 * @param InLoadFlags	Load flags to add (see ELoadFlags)
+	 */
+	FORCEINLINE void AddLoadFlags( uint32 InLoadFlags )
+	{
+		loadFlags |= InLoadFlags;
+	}
+
 protected:
 	/**
 	 * @brief Initialize linker
@@ -14,6 +14,7 @@
 #include "Logger/LoggerMacros.h"
 #include "Core.h"
 #include "System/Name.h"
+#include "System/Threading.h"
 #include "Reflection/ObjectMacros.h"
 #include "Reflection/ObjectGC.h"
 #include "Reflection/ObjectHash.h"
@@ -173,6 +174,15 @@ public:
      */
     virtual void AddReferencedObjects( std::vector<CObject*>& InOutObjectArray );
 
+    /**
+     * @brief Can the object be grouped into a GC cluster
+     * References of a cluster are gathered once when it's created, so objects which change their references
+     * at runtime (e.g. worlds, actors and components) mustn't be clustered
+     * 
+     * @return Return TRUE if the object can be in a GC cluster, otherwise returns FALSE
+     */
+    virtual bool CanBeInCluster() const;
+
     /**
      * @brief Called from within CObjectPackage::SavePackage on the passed in base/root object
      * This is used to allow objects used as a base to perform required actions before saving and cleanup afterwards
@@ -216,6 +226,7 @@ public:
     FORCEINLINE void AddToRoot()
     {
         AddObjectFlag( OBJECT_RootSet );
+        CObjectGC::Get().WriteBarrier( this );
     }
 
     /**
@@ -253,6 +264,30 @@ public:
         flags &= ~InFlag;
     }
 
+    /**
+     * @brief Remove object flag atomically
+     * Used when several threads can try to remove the same flag at the same time (e.g. multi-threaded GC)
+     * 
+     * @param InFlag	Flag to remove
+     * @return Return TRUE if the flag was set and this call removed it, otherwise returns FALSE
+     */
+    FORCEINLINE bool ThreadSafeRemoveObjectFlag( ObjectFlags_t InFlag )
+    {
+        while ( true )
+        {
+            ObjectFlags_t   oldFlags = flags;
+            if ( !( oldFlags & InFlag ) )
+            {
+                return false;
+            }
+
+            if ( Sys_InterlockedCompareExchange( ( volatile int32* )&flags, ( int32 )( oldFlags & ~InFlag ), ( int32 )oldFlags ) == ( int32 )oldFlags )
+            {
+                return true;
+            }
+        }
+    }
+
     /**
      * @brief Rename object or change outer
      * 
@@ -378,6 +413,11 @@ public:
      */
     FORCEINLINE void SetClass( CClass* InNewClass )
     {
+        // Native objects may be registered in the GC before they get a class
+        if ( index != INDEX_NONE )
+        {
+            CObjectGC::Get().SetObjectClass( this, InNewClass );
+        }
         theClass = InNewClass;
     }
 
@@ -662,12 +702,10 @@ FORCEINLINE void HandleObjectReference( std::vector<CObject*>& InOutObjectArray,
         }
         else
         {
-            // Add encountered object reference to list of to be serialized objects if it hasn't already been added
-            if ( InOutObject->HasAnyObjectFlags( OBJECT_Unreachable ) )
+            // Add encountered object reference to list of to be serialized objects if it hasn't already been added.
+            // Reachability analysis can run on several threads, so only one of them must mark the object as reachable
+            if ( InOutObject->HasAnyObjectFlags( OBJECT_MASK_NotReached ) && InOutObject->ThreadSafeRemoveObjectFlag( OBJECT_MASK_NotReached ) )
             {
-                // Mark it as reachable
-                InOutObject->RemoveObjectFlag( OBJECT_Unreachable );
-
                 // Add it to the list of reachable objects
                 InOutObjectArray.push_back( InOutObject );
             }
@@ -11,8 +11,10 @@
 
 #include <vector>
 #include <list>
+#include <unordered_map>
 
 #include "Misc/Misc.h"
+#include "System/Threading.h"
 #include "Reflection/ObjectMacros.h"
 #include "Core.h"
 
@@ -380,6 +382,41 @@ public:
 	friend class CObject;
 	friend class CObjectIterator;
 
+	/**
+	 * @brief Statistics of the last garbage collection
+	 */
+	struct Stats
+	{
+		/**
+		 * @brief Constructor
+		 */
+		Stats()
+			: bMultiThreaded( false )
+			, bIncremental( false )
+			, numThreads( 1 )
+			, numIncrementalSteps( 0 )
+			, numReachableObjects( 0 )
+			, numUnreachableObjects( 0 )
+			, numClusters( 0 )
+			, numClusteredObjects( 0 )
+			, markUnreachableTime( 0.0 )
+			, traverseReferencesTime( 0.0 )
+			, beginDestroyTime( 0.0 )
+		{}
+
+		bool		bMultiThreaded;				/**< Whether reachability analysis was multi-threaded */
+		bool		bIncremental;				/**< Whether reachability analysis was spread over several frames */
+		uint32		numThreads;					/**< Number of threads used by reachability analysis */
+		uint32		numIncrementalSteps;		/**< Number of steps of incremental reachability analysis */
+		uint32		numReachableObjects;		/**< Number of reachable objects */
+		uint32		numUnreachableObjects;		/**< Number of unreachable objects */
+		uint32		numClusters;				/**< Number of GC clusters, each of them is counted in reachable objects only once */
+		uint32		numClusteredObjects;		/**< Number of objects in GC clusters */
+		double		markUnreachableTime;		/**< Time of marking objects as unreachable (in milliseconds) */
+		double		traverseReferencesTime;		/**< Time of traversing object references (in milliseconds), for incremental reachability analysis it's the sum of all steps */
+		double		beginDestroyTime;			/**< Time of routing BeginDestroy to unreachable objects (in milliseconds) */
+	};
+
 	/**
 	 * @brief Constructor
 	 */
@@ -425,6 +462,53 @@ public:
 	 */
 	void CollectGarbage( ObjectFlags_t InKeepFlags, bool InIsPerformFullPurge = true );
 
+	/**
+	 * @brief Collect garbage with incremental reachability analysis, which is spread over several calls
+	 * The first call marks all objects as not reached yet, each call traverses references within the time limit.
+	 * When traversing is finished unreachable objects are destroyed the same way as CollectGarbage does.
+	 * While reachability analysis is in progress, code which stores object references must call WriteBarrier
+	 * @note Reflected object properties, object lookups, loading, AddToRoot, spawning actors and adding components call the write barrier themselves
+	 *
+	 * @param InKeepFlags		Objects with those flags will be kept regardless of being referenced or not. Used only by the first call
+	 * @param InTimeLimit		Soft time limit for this function call (if 0 uses default time limit)
+	 * @return Return TRUE if reachability analysis is finished and unreachable objects are pending purge, otherwise returns FALSE
+	 */
+	bool IncrementalCollectGarbage( ObjectFlags_t InKeepFlags, float InTimeLimit = 0.f );
+
+	/**
+	 * @brief Write barrier for incremental reachability analysis
+	 * Must be called when a reference to InObject is stored into another object while incremental reachability analysis
+	 * is in progress, otherwise InObject may be destroyed if the object which has referenced it before has been already traversed
+	 *
+	 * @param InObject	Stored object, may be NULL
+	 */
+	FORCEINLINE void WriteBarrier( class CObject* InObject )
+	{
+		if ( bIncrementalMarkPending != 0 && InObject )
+		{
+			MarkObjectByWriteBarrier( InObject );
+		}
+	}
+
+	/**
+	 * @brief Write barrier for a reference which is stored into an object
+	 * References of a GC cluster are gathered once when it's created, so the cluster of InOwner is dissolved.
+	 * Otherwise InObject may be destroyed while the clustered owner still references it
+	 *
+	 * @param InOwner	Object which the reference is stored into
+	 * @param InObject	Stored object, may be NULL
+	 */
+	void WriteBarrier( class CObject* InOwner, class CObject* InObject );
+
+	/**
+	 * @brief Is incremental reachability analysis in progress
+	 * @return Return TRUE if incremental reachability analysis has been started and isn't finished yet, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsIncrementalMarkPending() const
+	{
+		return bIncrementalMarkPending != 0;
+	}
+
 	/**
 	 * @brief Incrementally purge garbage by deleting all unreferenced objects after routing destroy
 	 *
@@ -557,7 +641,186 @@ public:
 		return timeLimitPerIncrementalPurgeGarbageCall;
 	}
 
+	/**
+	 * @brief Set whether reachability analysis is allowed to use worker threads
+	 * @param InIsMultiThreaded		Is allowed multi-threaded reachability analysis. If FALSE the single-threaded path is used
+	 */
+	FORCEINLINE void SetMultiThreadedReachabilityAnalysis( bool InIsMultiThreaded )
+	{
+		bMultiThreadedReachabilityAnalysis = InIsMultiThreaded;
+	}
+
+	/**
+	 * @brief Is reachability analysis allowed to use worker threads
+	 * @return Return TRUE if multi-threaded reachability analysis is allowed, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsMultiThreadedReachabilityAnalysis() const
+	{
+		return bMultiThreadedReachabilityAnalysis;
+	}
+
+	/**
+	 * @brief Set whether the game collects garbage with incremental reachability analysis
+	 * @param InIsIncremental	Is allowed incremental reachability analysis. If FALSE the whole analysis is done in one frame
+	 */
+	FORCEINLINE void SetIncrementalReachabilityAnalysis( bool InIsIncremental )
+	{
+		bIncrementalReachabilityAnalysis = InIsIncremental;
+	}
+
+	/**
+	 * @brief Does the game collect garbage with incremental reachability analysis
+	 * @return Return TRUE if incremental reachability analysis is allowed, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsIncrementalReachabilityAnalysis() const
+	{
+		return bIncrementalReachabilityAnalysis;
+	}
+
+	/**
+	 * @brief Set time limit per incremental reachability analysis call
+	 * @param InTimeLimit	New time limit (in seconds)
+	 */
+	FORCEINLINE void SetTimeLimitPerIncrementalMarkCall( float InTimeLimit )
+	{
+		timeLimitPerIncrementalMarkCall = InTimeLimit;
+	}
+
+	/**
+	 * @brief Get time limit per incremental reachability analysis call
+	 * @return Return time limit per incremental reachability analysis call (in seconds)
+	 */
+	FORCEINLINE float GetTimeLimitPerIncrementalMarkCall() const
+	{
+		return timeLimitPerIncrementalMarkCall;
+	}
+
+	/**
+	 * @brief Set whether objects of loaded cooked packages are grouped into GC clusters
+	 * @param InIsCreateClusters	Is allowed to create GC clusters. Already created clusters aren't dissolved
+	 */
+	FORCEINLINE void SetCreateClusters( bool InIsCreateClusters )
+	{
+		bCreateClusters = InIsCreateClusters;
+	}
+
+	/**
+	 * @brief Are objects of loaded cooked packages grouped into GC clusters
+	 * @return Return TRUE if GC clusters are created, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsCreateClusters() const
+	{
+		return bCreateClusters;
+	}
+
+	/**
+	 * @brief Create a GC cluster from objects of a loaded package
+	 * Objects of a cluster are marked reachable or unreachable as one unit. Their references to objects outside
+	 * of the cluster are gathered once here, so reachability analysis doesn't traverse each object of the cluster.
+	 * @note Clusters are created only for cooked packages outside of the editor. Objects which change their references at runtime (see CObject::CanBeInCluster) aren't clustered
+	 *
+	 * @param InPackage		Loaded package
+	 */
+	void CreateCluster( class CObjectPackage* InPackage );
+
+	/**
+	 * @brief Dissolve the GC cluster of an object
+	 * Must be called before changing references of an object which has been loaded from a cooked package
+	 *
+	 * @param InObject	Object
+	 */
+	void DissolveObjectCluster( class CObject* InObject );
+
+	/**
+	 * @brief Get statistics of the last garbage collection
+	 * @return Return statistics of the last garbage collection
+	 */
+	FORCEINLINE const Stats& GetLastStats() const
+	{
+		return lastStats;
+	}
+
+	/**
+	 * @brief Get lists of instances of a class and all its subclasses
+	 * @note Lists may contain objects with the OBJECT_Unreachable flag. Lists are valid while their classes exist
+	 *
+	 * @param InClass	Class
+	 * @param OutLists	Output lists of instances, one list per class
+	 */
+	void GetClassInstanceLists( class CClass* InClass, std::vector<const std::vector<class CObject*>*>& OutLists ) const;
+
 private:
+	/**
+	 * @brief Entry of an object in the class index
+	 */
+	struct ClassIndexEntry
+	{
+		class CClass*	theClass;	/**< Class under which the object is indexed, NULL if the object isn't indexed */
+		uint32			position;	/**< Position of the object in the list of instances of the class */
+	};
+
+	/**
+	 * @brief Add an object into the class index
+	 *
+	 * @param InObject	Object
+	 * @param InClass	Class of the object
+	 */
+	void AddToClassIndex( class CObject* InObject, class CClass* InClass );
+
+	/**
+	 * @brief Remove an object from the class index
+	 * @param InObject	Object
+	 */
+	void RemoveFromClassIndex( class CObject* InObject );
+
+	/**
+	 * @brief Move an object in the class index when its class is changed
+	 * @note Called from CObject::SetClass
+	 *
+	 * @param InObject		Object
+	 * @param InNewClass	A new class of the object
+	 */
+	void SetObjectClass( class CObject* InObject, class CClass* InNewClass );
+
+	/**
+	 * @brief GC cluster, objects which are marked reachable or unreachable as one unit
+	 */
+	struct GCCluster
+	{
+		/**
+		 * @brief Constructor
+		 */
+		GCCluster()
+			: bMarked( 0 )
+			, bNeedsDissolve( 0 )
+		{}
+
+		std::vector<class CObject*>		objects;				/**< Objects of the cluster, an empty array means the cluster slot is free */
+		std::vector<class CObject*>		referencedObjects;		/**< Objects outside of the cluster which are referenced by token streams of its objects */
+		volatile int32					bMarked;				/**< Has the cluster been marked as reachable on the current garbage collection */
+		volatile int32					bNeedsDissolve;			/**< Is one of objects pending kill, so references to it must be eliminated one by one */
+	};
+
+	/**
+	 * @brief Dissolve a GC cluster
+	 * @param InClusterIndex	Cluster index
+	 */
+	void DissolveCluster( uint32 InClusterIndex );
+
+	/**
+	 * @brief Prepare GC clusters for traversing object references
+	 * Dissolves clusters which contain or reference pending kill objects and resets marks of the rest
+	 */
+	void PrepareClusters();
+
+	/**
+	 * @brief Mark all objects of a GC cluster as reachable and add objects referenced by the cluster
+	 *
+	 * @param InCluster						Cluster
+	 * @param InOutNewReachableObjects		Output array with new reachable objects
+	 */
+	void MarkClusterReachable( GCCluster& InCluster, std::vector<class CObject*>& InOutNewReachableObjects );
+
 	/**
 	 * @brief Helper struct for stack based approach
 	 */
@@ -569,19 +832,87 @@ private:
 		int32		loopStartIndex; /**< First token index in loop */
 	};
 
+	/**
+	 * @brief Context of a worker of multi-threaded reachability analysis
+	 */
+	struct ReachabilityWorkerContext
+	{
+		/**
+		 * @brief Constructor
+		 */
+		ReachabilityWorkerContext()
+			: numSharedObjects( 0 )
+			, numProcessedObjects( 0 )
+		{}
+
+		std::vector<class CObject*>		localObjects;			/**< Objects to process which are visible only for the owner worker */
+		std::vector<class CObject*>		sharedObjects;			/**< Objects to process which other workers can steal */
+		std::vector<class CObject*>		newObjects;				/**< Temporary array of new reachable objects */
+		std::vector<StackEntry>			stack;					/**< Stack for processing object references */
+		CMutex							sharedObjectsMutex;		/**< Mutex of shared objects */
+		volatile int32					numSharedObjects;		/**< Number of shared objects */
+		uint32							numProcessedObjects;	/**< Number of processed objects by the worker */
+	};
+
 	/**
 	* @brief Performs reachability analysis
 	* @param InKeepFlags	Objects with these flags will be kept regardless of being referenced or not
 	*/
 	void PerformReachabilityAnalysis( ObjectFlags_t InKeepFlags );
 
+	/**
+	 * @brief Call BeginDestroy in all unreachable objects and purge them
+	 * @param InIsPerformFullPurge	If TRUE, perform a full purge
+	 */
+	void BeginDestroyUnreachableObjects( bool InIsPerformFullPurge );
+
+	/**
+	 * @brief Start incremental reachability analysis
+	 * @param InKeepFlags	Objects with these flags will be kept regardless of being referenced or not
+	 */
+	void StartIncrementalMark( ObjectFlags_t InKeepFlags );
+
+	/**
+	 * @brief Traverse object references of incremental reachability analysis
+	 *
+	 * @param InIsUseTimeLimit	Whether the time limit parameter should be used
+	 * @param InTimeLimit		Soft time limit for this function call
+	 * @return Return TRUE if reachability analysis is finished, otherwise returns FALSE
+	 */
+	bool IncrementalMarkStep( bool InIsUseTimeLimit, float InTimeLimit );
+
+	/**
+	 * @brief Finish incremental reachability analysis, objects which haven't been reached are marked as unreachable
+	 */
+	void FinishIncrementalMark();
+
+	/**
+	 * @brief Mark an object as reached by the write barrier and queue it for traversing references
+	 * @param InObject	Object
+	 */
+	void MarkObjectByWriteBarrier( class CObject* InObject );
+
 	/**
 	 * @brief Mark objects as unreachable
 	 * 
 	 * @param InOutReachableObjects		Output array with reachable objects
 	 * @param InKeepFlags				Objects with these flags will be kept regardless of being referenced or not
+	 * @param InIsMultiThreaded			Is need split the work across worker threads
+	 * @param InUnreachableFlag			Flag to mark objects which aren't reached yet (OBJECT_Unreachable or OBJECT_PendingMark for incremental analysis)
 	 */
-	void MarkObjectsUnreachable( std::vector<class CObject*>& InOutReachableObjects, ObjectFlags_t InKeepFlags );
+	void MarkObjectsUnreachable( std::vector<class CObject*>& InOutReachableObjects, ObjectFlags_t InKeepFlags, bool InIsMultiThreaded, ObjectFlags_t InUnreachableFlag = OBJECT_Unreachable );
+
+	/**
+	 * @brief Mark objects as unreachable in range
+	 * 
+	 * @param InStartIndex				First object index
+	 * @param InEndIndex				Last object index (exclusive)
+	 * @param InOutReachableObjects		Output array with reachable objects
+	 * @param InOutClasses				Output array of classes which need to assemble the reference token stream
+	 * @param InKeepFlags				Objects with these flags will be kept regardless of being referenced or not
+	 * @param InUnreachableFlag			Flag to mark objects which aren't reached yet
+	 */
+	void MarkObjectsUnreachableInRange( uint32 InStartIndex, uint32 InEndIndex, std::vector<class CObject*>& InOutReachableObjects, std::vector<class CClass*>& InOutClasses, ObjectFlags_t InKeepFlags, ObjectFlags_t InUnreachableFlag );
 
 	/**
 	 * @brief Traverse object references
@@ -589,6 +920,35 @@ private:
 	 */
 	void TraverseObjectReferences( std::vector<class CObject*>& InOutReachableObjects );
 
+	/**
+	 * @brief Traverse object references on worker threads
+	 * 
+	 * @param InRootObjects		Array with initially reachable objects
+	 * @return Return number of reachable objects
+	 */
+	uint32 TraverseObjectReferencesMultiThreaded( const std::vector<class CObject*>& InRootObjects );
+
+	/**
+	 * @brief Worker of multi-threaded reachability analysis
+	 * Processes own objects and steals objects of other workers when runs out of work
+	 * 
+	 * @param InContexts					Array of worker contexts
+	 * @param InNumContexts					Number of worker contexts
+	 * @param InContextIndex				Index of the context of this worker
+	 * @param InOutNumPendingObjects		Number of reachable objects which still are not processed by all workers
+	 */
+	void ReachabilityWorker( ReachabilityWorkerContext* InContexts, uint32 InNumContexts, uint32 InContextIndex, volatile int32* InOutNumPendingObjects );
+
+	/**
+	 * @brief Steal objects from shared objects of a worker context
+	 * 
+	 * @param InVictim			Worker context to steal from
+	 * @param InIsOwner			Is the caller owner of InVictim. The owner takes all shared objects, others take half of them
+	 * @param OutObjects		Output array of stolen objects
+	 * @return Return TRUE if at least one object was stolen, otherwise returns FALSE
+	 */
+	bool StealObjects( ReachabilityWorkerContext& InVictim, bool InIsOwner, std::vector<class CObject*>& OutObjects );
+
 	/**
 	 * @brief Process object for references
 	 * 
@@ -598,6 +958,16 @@ private:
 	 */
 	void ProcessObjectForReferences( class CObject* InCurrentObject, std::vector<class CObject*>& InOutNewReachableObjects, std::vector<StackEntry>& InOutStack );
 
+	/**
+	 * @brief Parse reference token stream of an object and pass each found reference to a handler
+	 *
+	 * @param InCurrentObject		Current object
+	 * @param InOutStack			Stack
+	 * @param InReferenceHandler	Handler of references with signature void( CObject*& InOutObject, bool InIsAllowReferenceElimination )
+	 */
+	template<typename TReferenceHandler>
+	void ProcessTokenStreamReferences( class CObject* InCurrentObject, std::vector<StackEntry>& InOutStack, const TReferenceHandler& InReferenceHandler );
+
 	/**
 	 * @brief Is time limit exceeded
 	 * 
@@ -616,6 +986,10 @@ private:
 	bool						bDelayedBeginDestroyHasBeenRoutedToAllObjects;	/**< Whether delayed BeginDestroy has already been routed to all unreachable objects */
 	bool						bFinishDestroyHasBeenRoutedToAllObjects;		/**< Whether FinishDestroy has already been routed to all unreachable objects */
 	bool						bOpenForDisregardForGC;							/**< If TRUE this is the intial load and we should load objects into the disregarded for GC range */
+	bool						bMultiThreadedReachabilityAnalysis;				/**< Whether reachability analysis is allowed to use worker threads */
+	bool						bCreateClusters;								/**< Whether objects of loaded cooked packages are grouped into GC clusters */
+	bool						bIncrementalReachabilityAnalysis;				/**< Whether the game collects garbage with incremental reachability analysis */
+	volatile int32				bIncrementalMarkPending;						/**< Whether incremental reachability analysis is in progress */
 	uint32						maxObjectsNotConsideredByGC;					/**< Maximum number of objects in the disregard for GC Pool */
 	uint32						currentPurgeObjectIndex;						/**< Current object index for incremental purge */
 	uint32						objectsPendingDestructionCount;					/**< Number of objects actually still pending destruction */
@@ -623,10 +997,23 @@ private:
 	uint32						lastNonGCIndex;									/**< Index pointing to last object created in range disregarded for GC */
 	float						timeBetweenPurgingGarbage;						/**< Time between purging garbage (in seconds) */
 	float						timeLimitPerIncrementalPurgeGarbageCall;		/**< Time limit per incremental purge garbage call (in seconds) */
+	float						timeLimitPerIncrementalMarkCall;				/**< Time limit per incremental reachability analysis call (in seconds) */
 	std::vector<class CObject*>	allocatedObjects;								/**< List of all allocated objects */
 	std::vector<uint32>			objectsPendingDestruction;						/**< Array that we'll fill with indices to objects that are still pending destruction after the first GC sweep */
 	std::list<uint32>			availableGCObjectIndeces;						/**< Available object indices in GC range */
 	std::vector<uint32>			unreachableObjectsIndices;						/**< Index of objects with the OBJECT_Unreachable flag during garbage collection */
+	std::vector<ClassIndexEntry>	classIndexEntries;							/**< Entries of objects in the class index, parallel to allocatedObjects */
+	std::unordered_map<class CClass*, std::vector<class CObject*>>	classInstances;	/**< Class index, instances of every class without instances of subclasses */
+	std::vector<GCCluster>		clusters;										/**< GC clusters */
+	std::vector<uint32>			freeClusterIndices;								/**< Indices of free cluster slots */
+	std::vector<uint32>			objectClusterIndices;							/**< Cluster index of every object, INDEX_NONE if the object isn't in a cluster. Parallel to allocatedObjects */
+	std::unordered_map<class CObject*, std::vector<uint32>>		clusterReferencers;	/**< Indices of clusters which reference an object outside of them */
+	std::vector<uint32>			incrementalMarkObjects;							/**< Indices of reached objects which references aren't traversed yet by incremental reachability analysis */
+	std::vector<uint32>			writeBarrierObjects;							/**< Indices of objects reached by the write barrier */
+	std::vector<class CObject*>	incrementalNewObjects;							/**< Temporary array of new reachable objects of incremental reachability analysis */
+	std::vector<StackEntry>		incrementalMarkStack;							/**< Stack for processing object references by incremental reachability analysis */
+	CMutex						writeBarrierMutex;								/**< Mutex of objects reached by the write barrier */
+	Stats						lastStats;										/**< Statistics of the last garbage collection */
 };
 
 #endif // !OBJECTGC_H
\ No newline at end of file
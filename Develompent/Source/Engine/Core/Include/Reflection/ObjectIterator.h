@@ -13,9 +13,24 @@
 #include "Reflection/Class.h"
 #include "Reflection/ObjectGC.h"
 
+/**
+ * @ingroup Core
+ * @brief Enumeration of modes of object iterator
+ */
+enum EObjectIteratorMode
+{
+	OIM_ScanAllObjects,		/**< Scan all allocated objects and check their class */
+	OIM_ClassIndex			/**< Walk only instances of the class and its subclasses from the class index of the GC */
+};
+
 /**
  * @ingroup Core
  * @brief Class for iterating through all objects
+ *
+ * In OIM_ClassIndex mode the iterator doesn't touch objects of other classes, so iteration over a specific class costs
+ * only the number of its instances. Instances are visited class by class, not in order of object indices.
+ * Destroying the current object while iterating is safe in both modes. Instances of classes which are created while iterating
+ * aren't visited in OIM_ClassIndex mode
  */
 class CObjectIterator
 {
@@ -25,13 +40,23 @@ public:
 	 * 
 	 * @param InClass			Iterate over objects of this class
 	 * @param InOnlyGCObjects	Is iterate over only GC objects 
+	 * @param InMode			Iterator mode. Iteration over all objects (InClass is CObject) always scans all objects
 	 */
-	FORCEINLINE CObjectIterator( CClass* InClass = CObject::StaticClass(), bool InOnlyGCObjects = false )
+	FORCEINLINE CObjectIterator( CClass* InClass = CObject::StaticClass(), bool InOnlyGCObjects = false, EObjectIteratorMode InMode = OIM_ClassIndex )
 		: theClass( InClass )
 		, currentIndex( InOnlyGCObjects ? GetFirstGCIndex() : INDEX_NONE )
 		, exclusionFlags( OBJECT_Unreachable )
+		, bOnlyGCObjects( InOnlyGCObjects )
+		, bUseClassIndex( InMode == OIM_ClassIndex && InClass != CObject::StaticClass() )
+		, currentList( 0 )
+		, currentObject( nullptr )
 	{
 		Assert( InClass );
+		if ( bUseClassIndex )
+		{
+			CObjectGC::Get().GetClassInstanceLists( theClass, classLists );
+			currentIndex = INDEX_NONE;
+		}
 		++*this;
 	}
 
@@ -40,6 +65,12 @@ public:
 	 */
 	FORCEINLINE void operator++()
 	{
+		if ( bUseClassIndex )
+		{
+			NextInClassIndex();
+			return;
+		}
+
 		CObjectGC&		objectGC = CObjectGC::Get();
 		while ( ++currentIndex < objectGC.allocatedObjects.size() )
 		{
@@ -88,7 +119,7 @@ public:
 	 */
 	FORCEINLINE operator bool() const
 	{
-		return currentIndex < CObjectGC::Get().allocatedObjects.size();
+		return bUseClassIndex ? currentObject != nullptr : currentIndex < CObjectGC::Get().allocatedObjects.size();
 	}
 
 	/**
@@ -106,7 +137,39 @@ protected:
 	 */
 	FORCEINLINE CObject* GetObject() const
 	{
-		return CObjectGC::Get().allocatedObjects[currentIndex];
+		return bUseClassIndex ? currentObject : CObjectGC::Get().allocatedObjects[currentIndex];
+	}
+
+	/**
+	 * @brief Go to the next object in the class index
+	 */
+	FORCEINLINE void NextInClassIndex()
+	{
+		// If the current object has been removed, the last instance of the list has been moved into its place, so check the same position again
+		uint32		nextIndex = currentIndex + 1;
+		if ( currentObject && currentIndex < classLists[currentList]->size() && ( *classLists[currentList] )[currentIndex] != currentObject )
+		{
+			nextIndex = currentIndex;
+		}
+
+		for ( ; currentList < classLists.size(); ++currentList, nextIndex = 0 )
+		{
+			const std::vector<CObject*>&	instances = *classLists[currentList];
+			for ( ; nextIndex < instances.size(); ++nextIndex )
+			{
+				CObject*	object = instances[nextIndex];
+				if ( object->HasAnyObjectFlags( exclusionFlags ) || ( bOnlyGCObjects && object->IsDisregardedForGC() ) )
+				{
+					continue;
+				}
+
+				currentIndex	= nextIndex;
+				currentObject	= object;
+				return;
+			}
+		}
+
+		currentObject = nullptr;
 	}
 
 	/**
@@ -118,9 +181,14 @@ protected:
 		return CObjectGC::Get().firstGCIndex;
 	}
 
-	CClass*			theClass;		/**< We iterate over objects of this class */
-	uint32			currentIndex;	/**< Current object index */
-	ObjectFlags_t	exclusionFlags;	/**< Exclusion objects with this flags */
+	CClass*										theClass;		/**< We iterate over objects of this class */
+	uint32										currentIndex;	/**< Current object index, in OIM_ClassIndex mode it's position in the current list */
+	ObjectFlags_t								exclusionFlags;	/**< Exclusion objects with this flags */
+	bool										bOnlyGCObjects;	/**< Is iterate over only GC objects */
+	bool										bUseClassIndex;	/**< Is walk the class index instead of all objects */
+	uint32										currentList;	/**< Index of the current list of instances in OIM_ClassIndex mode */
+	CObject*									currentObject;	/**< Current object in OIM_ClassIndex mode */
+	std::vector<const std::vector<CObject*>*>	classLists;		/**< Lists of instances of the class and its subclasses in OIM_ClassIndex mode */
 };
 
 /**
@@ -133,10 +201,12 @@ class TObjectIterator : public CObjectIterator
 public:
 	/**
 	 * @brief Constructor
+	 *
 	 * @param InOnlyGCObjects	Is iterate over only GC objects
+	 * @param InMode			Iterator mode
 	 */
-	FORCEINLINE TObjectIterator( bool InOnlyGCObjects = false )
-		: CObjectIterator( TClass::StaticClass(), InOnlyGCObjects )
+	FORCEINLINE TObjectIterator( bool InOnlyGCObjects = false, EObjectIteratorMode InMode = OIM_ClassIndex )
+		: CObjectIterator( TClass::StaticClass(), InOnlyGCObjects, InMode )
 	{}
 
 	/**
@@ -423,10 +423,12 @@ enum EObjectFlags
     OBJECT_NeedPostLoad             = 1 << 10,  /**< Object needs to be postloaded */
     OBJECT_Public                   = 1 << 11,  /**< Object is visible outside its package */
     OBJECT_WasLoaded                = 1 << 12,  /**< Flagged on CObjects that were loaded */
+    OBJECT_PendingMark              = 1 << 13,  /**< Object hasn't been reached yet by the incremental mark of the garbage collector */
 
     // Combination masks and other combinations
     OBJECT_MASK_Load                 = OBJECT_Public | OBJECT_Native,       /**< Flags to load from LifeEngine files */
-    OBJECT_MASK_Keep                 = OBJECT_Native | OBJECT_RootSet       /**< Flags to persist across loads */
+    OBJECT_MASK_Keep                 = OBJECT_Native | OBJECT_RootSet,      /**< Flags to persist across loads */
+    OBJECT_MASK_NotReached           = OBJECT_Unreachable | OBJECT_PendingMark  /**< Flags of objects which haven't been reached yet by the garbage collector */
 };
 
 /**
@@ -12,6 +12,7 @@
 #include "Misc/Guid.h"
 #include "Reflection/Object.h"
 #include "Reflection/ObjectSerializeContext.h"
+#include "Reflection/AsyncPackageLoader.h"
 #include "System/BaseTargetPlatform.h"
 
 /**
@@ -59,6 +60,17 @@ public:
 	 */
 	static CObjectPackage* LoadPackage( CObjectPackage* InOuter, const tchar* InFilename, uint32 InLoadFlags );
 
+	/**
+	 * @brief Loads a package and all contained objects asynchronously
+	 * @note The package file is read and decompressed on worker threads, objects are created on the game thread in CAsyncPackageLoader::ProcessAsyncLoading
+	 *
+	 * @param InFilename	File name on disk
+	 * @param InCallback	Callback called on the game thread when loading is finished. Package is NULL if loading has failed
+	 * @param InLoadFlags	Flags controlling loading behavior (see ELoadFlags)
+	 * @return Return ID of the async loading request
+	 */
+	static uint32 LoadPackageAsync( const tchar* InFilename, const COnAsyncPackageLoaded::DelegateType_t& InCallback, uint32 InLoadFlags = LOAD_None );
+
 	/**
 	 * @brief Begin loading packages
 	 * @warning Objects may not be destroyed between BeginLoadPackage/EndLoadPackage call
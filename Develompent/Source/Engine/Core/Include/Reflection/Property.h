@@ -336,9 +336,10 @@ public:
 	 *
 	 * @param InObjectAddress		The address of a object where the value of this property is stored
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
+	 * @param InOwner				Object which owns the value. Stores of object references dissolve its GC cluster
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )			PURE_VIRTUAL( CProperty::SetPropertyValue, return false; );
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner )			PURE_VIRTUAL( CProperty::SetPropertyValue, return false; );
 
 	/**
 	 * @brief Is should serialize this value
@@ -658,7 +659,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -774,7 +775,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -878,7 +879,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -982,7 +983,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1086,7 +1087,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1202,7 +1203,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1346,7 +1347,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1462,7 +1463,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1578,7 +1579,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1710,7 +1711,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1854,7 +1855,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -1986,7 +1987,7 @@ public:
 	 * @param InPropertyValue		Contains the value that should be copied into InObjectAddress+Offset
 	 * @return Return TRUE if InPropertyValue was copied successfully into property value. FALSE if this CProperty type doesn't support the union (structs and maps) or the address is invalid
 	 */
-	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue ) override;
+	virtual bool SetPropertyValue( byte* InObjectAddress, const UPropertyValue & InPropertyValue, class CObject* InOwner ) override;
 
 	/**
 	 * @brief Get property's one element size
@@ -13,6 +13,7 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <type_traits>
 
 #include "Core.h"
 #include "Misc/Types.h"
@@ -34,6 +35,34 @@ enum EArchiveType
 	AT_Scripts			/**< Archive contains scripts */
 };
 
+/**
+ * @ingroup Core
+ * @brief Type trait whether an array of the type can be serialized by one CArchive::Serialize call
+ *
+ * It is TRUE only for types which operator<< writes exactly the memory of the value and nothing else.
+ * By default these are arithmetic types except bool (std::vector<bool> is packed), other types must be declared by DECLARE_BITWISE_SERIALIZABLE
+ */
+template<typename TType>
+struct TIsBitwiseSerializable
+{
+	static constexpr bool	value = std::is_arithmetic<TType>::value && !std::is_same<TType, bool>::value;
+};
+
+/**
+ * @ingroup Core
+ * @brief Declare type as bitwise serializable (see TIsBitwiseSerializable)
+ * @warning Operator<< of the type must serialize the whole value by one CArchive::Serialize call, otherwise data in archives will be broken
+ *
+ * @param TType		Type
+ */
+#define DECLARE_BITWISE_SERIALIZABLE( TType ) \
+	template<> \
+	struct TIsBitwiseSerializable<TType> \
+	{ \
+		static_assert( std::is_trivially_copyable<TType>::value, #TType " must be trivially copyable" ); \
+		static constexpr bool	value = true; \
+	};
+
 /**
  * @ingroup Core
  * @brief The base class for work with archive
@@ -300,6 +329,34 @@ public:
 #endif // WITH_EDITOR
 	}
 
+	/**
+	 * @brief Get compression flags for bulk data while cooking
+	 * @note In build without editor always returns CF_None
+	 *
+	 * @return Return compression flags which override ones of bulk data while cooking. If CF_None, bulk data keeps own compression flags
+	 */
+	FORCEINLINE ECompressionFlags GetCookingCompressionFlags() const
+	{
+#if WITH_EDITOR
+		return cookingCompressionFlags;
+#else
+		return CF_None;
+#endif // WITH_EDITOR
+	}
+
+	/**
+	 * @brief Set compression flags for bulk data while cooking
+	 * @note In build without editor do nothing
+	 *
+	 * @param InCompressionFlags	Compression flags which override ones of bulk data while cooking. If CF_None, bulk data keeps own compression flags
+	 */
+	FORCEINLINE void SetCookingCompressionFlags( ECompressionFlags InCompressionFlags )
+	{
+#if WITH_EDITOR
+		cookingCompressionFlags = InCompressionFlags;
+#endif // WITH_EDITOR
+	}
+
 	/**
 	 * @brief Is this archive only looking for CObject references
 	 * @return Return TRUE if this archive is only looking for CObject references, otherwise returns FALSE
@@ -342,6 +399,7 @@ protected:
 
 #if WITH_EDITOR
 	CBaseTargetPlatform*	cookingTargetPlatform;				/**< Holds the cooking target platform */
+	ECompressionFlags		cookingCompressionFlags;			/**< Compression flags overriding ones of bulk data while cooking */
 #endif // WITH_EDITOR
 };
 
@@ -595,6 +653,9 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const CompressedChunkInfo
 	return InArchive;
 }
 
+DECLARE_BITWISE_SERIALIZABLE( EArchiveType )
+DECLARE_BITWISE_SERIALIZABLE( CompressedChunkInfo )
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, achar& InValue )
 {
 	InArchive.Serialize( &InValue, sizeof( InValue ) );
@@ -755,9 +816,17 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, std::vector< TType >& InV
 			InValue.resize( arraySize );
 		}
 
-		for ( uint32 index = 0; index < arraySize; ++index )
+		// Serialize the whole array at one time if it's possible
+		if constexpr ( TIsBitwiseSerializable<TType>::value )
+		{
+			InArchive.Serialize( InValue.data(), arraySize * sizeof( TType ) );
+		}
+		else
 		{
-			InArchive << InValue[ index ];
+			for ( uint32 index = 0; index < arraySize; ++index )
+			{
+				InArchive << InValue[ index ];
+			}
 		}
 	}
 
@@ -774,9 +843,17 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const std::vector< TType
 
 	if ( arraySize > 0 )
 	{
-		for ( uint32 index = 0; index < arraySize; ++index )
+		// Serialize the whole array at one time if it's possible
+		if constexpr ( TIsBitwiseSerializable<TType>::value )
+		{
+			InArchive.Serialize( ( void* )InValue.data(), arraySize * sizeof( TType ) );
+		}
+		else
 		{
-			InArchive << InValue[ index ];
+			for ( uint32 index = 0; index < arraySize; ++index )
+			{
+				InArchive << InValue[ index ];
+			}
 		}
 	}
 
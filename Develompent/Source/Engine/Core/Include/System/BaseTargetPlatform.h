@@ -9,6 +9,7 @@
 #ifndef BASETARGETPLATFORM_H
 #define BASETARGETPLATFORM_H
 
+#include "Misc/Compression.h"
 #include "Core.h"
 
 /**
@@ -19,6 +20,30 @@
 class CBaseTargetPlatform
 {
 public:
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CBaseTargetPlatform() {}
+
+	/**
+	 * @brief Get compression flags for bulk data of assets
+	 *
+	 * @param InAssetType	Asset type (see EAssetType)
+	 * @return Return compression flags for bulk data of the asset type. If CF_None, bulk data keeps own compression flags
+	 */
+	virtual ECompressionFlags GetAssetCompressionFlags( uint32 InAssetType ) const
+	{
+		return CF_None;
+	}
+
+	/**
+	 * @brief Get compression flags for object packages (maps, classes)
+	 * @return Return compression flags for object packages
+	 */
+	virtual ECompressionFlags GetObjectPackageCompressionFlags() const
+	{
+		return CF_None;
+	}
 };
 
 #endif // !BASETARGETPLATFORM_H
\ No newline at end of file
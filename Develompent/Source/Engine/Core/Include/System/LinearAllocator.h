@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LINEARALLOCATOR_H
+#define LINEARALLOCATOR_H
+
+#include <new>
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "Misc/Template.h"
+#include "System/Threading.h"
+
+/**
+ * @ingroup Core
+ * @brief Linear (arena) allocator
+ *
+ * Memory is allocated by bumping an offset in one page, so an allocation is a single interlocked add and
+ * it's safe to allocate from any thread. Memory isn't freed one by one, all allocations are released at once by Reset.
+ * If the page is exhausted, allocations go to the general allocator until the next Reset, which grows the page
+ * to fit all of them. So after a few resets the allocator doesn't touch the heap anymore
+ */
+class CLinearAllocator
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InPageSize	Initial size of the page in bytes
+	 */
+	CLinearAllocator( uint32 InPageSize );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CLinearAllocator();
+
+	/**
+	 * @brief Allocate memory
+	 * @note Thread safe
+	 *
+	 * @param InSize		Size in bytes
+	 * @param InAlignment	Alignment, must be a power of two
+	 * @return Return pointer to allocated memory. It's valid until Reset
+	 */
+	void* Allocate( uint32 InSize, uint32 InAlignment = 16 );
+
+	/**
+	 * @brief Allocate an array of default constructed elements
+	 * @note Thread safe. Destructors of elements aren't called, so use it only for types which don't own resources
+	 *
+	 * @param InNum		Number of elements
+	 * @return Return pointer to the first element. It's valid until Reset
+	 */
+	template<typename TType>
+	FORCEINLINE TType* AllocateArray( uint32 InNum )
+	{
+		TType*	result = ( TType* )Allocate( InNum * sizeof( TType ), alignof( TType ) );
+		for ( uint32 index = 0; index < InNum; ++index )
+		{
+			new( result + index ) TType();
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Release all allocations
+	 * @note Not thread safe, nobody must allocate from the allocator or use its memory
+	 */
+	void Reset();
+
+	/**
+	 * @brief Get size of the page
+	 * @return Return size of the page in bytes
+	 */
+	FORCEINLINE uint32 GetPageSize() const
+	{
+		return pageSize;
+	}
+
+	/**
+	 * @brief Get size of memory allocated since the last reset
+	 * @return Return allocated size in bytes, including alignment padding
+	 */
+	FORCEINLINE uint32 GetUsedSize() const
+	{
+		return Min<uint32>( usedSize, pageSize ) + overflowSize;
+	}
+
+private:
+	byte*					page;				/**< Page of memory */
+	uint32					pageSize;			/**< Size of the page */
+	volatile int32			usedSize;			/**< Used size of the page, may be greater than the page size if it's exhausted */
+	uint32					overflowSize;		/**< Size of allocations which didn't fit into the page */
+	std::vector<void*>		overflowBlocks;		/**< Allocations which didn't fit into the page */
+	CMutex					overflowMutex;		/**< Mutex of overflow allocations */
+};
+
+#endif // !LINEARALLOCATOR_H
@@ -10,6 +10,7 @@
 #define NAME_H
 
 #include <string>
+#include <vector>
 
 #include "Misc/Types.h"
 #include "Misc/SharedPointer.h"
@@ -53,6 +54,7 @@ public:
 		 */
 		FORCEINLINE NameEntry()
 			: hash( INVALID_HASH )
+			, hashNext( INDEX_NONE )
 		{}
 
 		/**
@@ -63,10 +65,12 @@ public:
 		FORCEINLINE NameEntry( const std::wstring& InName, uint64 InHash = INVALID_HASH )
 			: name( InName )
 			, hash( InHash )
+			, hashNext( INDEX_NONE )
 		{}
 
 		std::wstring	name;		/**< Name in string */
 		uint64			hash;		/**< Hash name */
+		uint32			hashNext;	/**< Index of the next name entry in the same hash bucket of the global table */
 	};
 
 	/**
@@ -267,6 +271,17 @@ public:
 	 */
 	static NameEntry* GetEntry( uint32 InIndex );
 
+	/**
+	 * @brief Initialize an array of names in bulk
+	 * Hashes all strings up front, looks them up without locking the global name table
+	 * and takes the lock only once for the names which must be added
+	 * 
+	 * @param InStrings		Array of strings. Each string may contain number portion (<String>_<Number>)
+	 * @param OutNames		Output array of names. Must have at least InStrings.size() elements
+	 * @param InFindType	Action to take (see EFindName)
+	 */
+	static void InitNames( const std::vector<std::wstring>& InStrings, CName* OutNames, EFindName InFindType = CNAME_Add );
+
 	/**
 	 * @brief Is valid name
 	 * @return Return TRUE if name is valid
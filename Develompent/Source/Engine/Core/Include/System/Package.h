@@ -872,11 +872,13 @@ public:
 
 	/**
 	 * Save package
+	 * @note While cooking editor only assets are skipped and bulk data is compressed with codec of the target platform for the asset type
 	 * 
 	 * @param InPath Path to package
+	 * @param InCookingTarget Target platform to cook the package for. If NULL the package is saved without cooking
 	 * @return Return true if package is saved, else false
 	 */
-	bool Save( const std::wstring& InPath );
+	bool Save( const std::wstring& InPath, class CBaseTargetPlatform* InCookingTarget = nullptr );
 
 	/**
 	 * Add asset to package
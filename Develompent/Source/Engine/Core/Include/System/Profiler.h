@@ -0,0 +1,387 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "LEBuild.h"
+
+#if ENABLE_PROFILER
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/Threading.h"
+
+/* Number of scopes in one chunk of a thread buffer */
+#define PROFILER_EVENTS_PER_CHUNK		1024
+
+/**
+ * @ingroup Core
+ * @brief Description of a profiled scope
+ */
+struct ProfilerStatDesc
+{
+	const tchar*	group;		/**< Name of stat group */
+	const tchar*	name;		/**< Name of the scope */
+};
+
+/**
+ * @ingroup Core
+ * @brief Hierarchical CPU profiler
+ *
+ * Each thread records profiled scopes into its own buffer. Once per frame the game thread calls EndFrame, which
+ * gathers buffers of all threads and aggregates them into a tree of scopes per thread and times of stat groups.
+ * Recorded scopes can be captured over several frames and exported to a Chrome trace JSON file (chrome://tracing, Perfetto).
+ * Scopes are recorded only while the stats are shown or a capture is in progress
+ */
+class CProfiler
+{
+public:
+	/**
+	 * @brief Node of the tree of profiled scopes of one frame
+	 */
+	struct Node
+	{
+		const ProfilerStatDesc*		stat;			/**< Profiled scope */
+		uint32						numCalls;		/**< Number of calls */
+		double						time;			/**< Inclusive time in ms */
+		uint32						firstChild;		/**< Index of the first child, INDEX_NONE if there aren't children */
+		uint32						nextSibling;	/**< Index of the next sibling, INDEX_NONE if it's the last one */
+	};
+
+	/**
+	 * @brief Profiled scopes of one thread on the frame
+	 */
+	struct ThreadStats
+	{
+		uint32					threadId;		/**< Thread ID */
+		std::wstring			threadName;		/**< Thread name */
+		std::vector<Node>		nodes;			/**< Tree of scopes, the first node is the root of the thread */
+	};
+
+	/**
+	 * @brief Time of a stat group on the frame
+	 */
+	struct GroupStats
+	{
+		const tchar*	group;		/**< Name of stat group */
+		double			time;		/**< Time in ms, nested scopes of the same group aren't counted twice */
+	};
+
+	/**
+	 * @brief Stats of one frame
+	 */
+	struct FrameStats
+	{
+		/**
+		 * @brief Constructor
+		 */
+		FrameStats()
+			: frameTime( 0.0 )
+		{}
+
+		double							frameTime;		/**< Frame time in ms */
+		std::vector<ThreadStats>		threads;		/**< Stats per thread */
+		std::vector<GroupStats>			groups;			/**< Stats per group */
+	};
+
+	/**
+	 * @brief Constructor
+	 */
+	CProfiler();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CProfiler();
+
+	/**
+	 * @brief Get instance of the profiler
+	 * @return Return instance of the profiler
+	 */
+	static FORCEINLINE CProfiler& Get()
+	{
+		static CProfiler	s_Profiler;
+		return s_Profiler;
+	}
+
+	/**
+	 * @brief Aggregate scopes recorded since the last call
+	 * @note Must be called from the game thread outside of any profiled scope
+	 */
+	void EndFrame();
+
+	/**
+	 * @brief Set name of a thread
+	 *
+	 * @param InThreadId	Thread ID
+	 * @param InName		Thread name
+	 */
+	void SetThreadName( uint32 InThreadId, const tchar* InName );
+
+	/**
+	 * @brief Show or hide stats of frames
+	 * @param InIsShowStats		Is need aggregate stats of frames
+	 */
+	void SetShowStats( bool InIsShowStats );
+
+	/**
+	 * @brief Is stats of frames shown
+	 * @return Return TRUE if stats of frames are aggregated, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsShowStats() const
+	{
+		return bShowStats;
+	}
+
+	/**
+	 * @brief Begin capture of profiled scopes
+	 */
+	void BeginCapture();
+
+	/**
+	 * @brief End capture of profiled scopes and export them to a Chrome trace JSON file
+	 *
+	 * @param InPath	Path to the file
+	 * @return Return TRUE if the capture has been saved, otherwise returns FALSE
+	 */
+	bool EndCapture( const std::wstring& InPath );
+
+	/**
+	 * @brief Is capture in progress
+	 * @return Return TRUE if capture is in progress, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsCapturing() const
+	{
+		return bCapturing;
+	}
+
+	/**
+	 * @brief Get stats of the last frame
+	 * @note Thread safe
+	 *
+	 * @param OutFrameStats		Output stats of the last frame
+	 */
+	void GetLastFrameStats( FrameStats& OutFrameStats );
+
+	/**
+	 * @brief Is recording of scopes enabled
+	 * @return Return TRUE if scopes are recorded, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled != 0;
+	}
+
+	/**
+	 * @brief Record a profiled scope on the current thread
+	 *
+	 * @param InStat			Profiled scope
+	 * @param InStartCycles		Cycles when the scope begins
+	 * @param InEndCycles		Cycles when the scope ends
+	 */
+	void AddScope( const ProfilerStatDesc* InStat, uint64 InStartCycles, uint64 InEndCycles );
+
+private:
+	/**
+	 * @brief Recorded scope
+	 */
+	struct Event
+	{
+		const ProfilerStatDesc*		stat;			/**< Profiled scope */
+		uint64						startCycles;	/**< Cycles when the scope begins */
+		uint64						endCycles;		/**< Cycles when the scope ends */
+	};
+
+	/**
+	 * @brief Recorded scope in a capture
+	 */
+	struct CapturedEvent
+	{
+		Event		event;		/**< Recorded scope */
+		uint32		threadId;	/**< Thread ID */
+	};
+
+	/**
+	 * @brief Chunk of recorded scopes of one thread
+	 */
+	struct EventChunk
+	{
+		/**
+		 * @brief Constructor
+		 */
+		EventChunk()
+			: numEvents( 0 )
+			, next( nullptr )
+		{}
+
+		Event				events[PROFILER_EVENTS_PER_CHUNK];	/**< Recorded scopes */
+		volatile int32		numEvents;							/**< Number of published scopes, written only by the owner thread */
+		EventChunk*			next;								/**< Next chunk, published by the owner thread once the chunk is full */
+	};
+
+	/**
+	 * @brief Buffer of recorded scopes of one thread
+	 *
+	 * A single producer single consumer list of chunks without locks. The owner thread appends scopes into writeChunk,
+	 * the game thread reads published scopes from readChunk and frees chunks which the owner thread has left
+	 */
+	struct ThreadBuffer
+	{
+		/**
+		 * @brief Constructor
+		 */
+		ThreadBuffer()
+			: threadId( 0 )
+			, writeChunk( new EventChunk() )
+			, readChunk( writeChunk )
+			, numReadEvents( 0 )
+		{}
+
+		/**
+		 * @brief Destructor
+		 */
+		~ThreadBuffer()
+		{
+			while ( readChunk )
+			{
+				EventChunk*		next = readChunk->next;
+				delete readChunk;
+				readChunk = next;
+			}
+		}
+
+		uint32			threadId;		/**< Thread ID */
+		EventChunk*		writeChunk;		/**< Chunk which is filled by the owner thread */
+		EventChunk*		readChunk;		/**< Chunk which is read by the game thread */
+		uint32			numReadEvents;	/**< Number of scopes in readChunk which are already gathered */
+	};
+
+	/**
+	 * @brief Get buffer of the current thread
+	 * @return Return buffer of the current thread
+	 */
+	ThreadBuffer* GetThreadBuffer();
+
+	/**
+	 * @brief Move scopes published by a thread into tempEvents
+	 * @param InThreadBuffer	Buffer of the thread
+	 */
+	void GatherEvents( ThreadBuffer* InThreadBuffer );
+
+	/**
+	 * @brief Update recording flag
+	 */
+	void UpdateEnabled();
+
+	/**
+	 * @brief Aggregate recorded scopes of a thread into a tree
+	 *
+	 * @param InEvents				Recorded scopes, will be sorted
+	 * @param OutThreadStats		Output stats of the thread
+	 * @param InOutGroupTimes		Times of groups in cycles
+	 */
+	void AggregateEvents( std::vector<Event>& InEvents, ThreadStats& OutThreadStats, std::unordered_map<const tchar*, uint64>& InOutGroupTimes );
+
+	/**
+	 * @brief Get interned name of the stat group
+	 *
+	 * @param InStat	Profiled scope
+	 * @return Return pointer to the group name which is the same for all scopes of the group
+	 */
+	const tchar* InternGroup( const ProfilerStatDesc* InStat );
+
+	volatile int32										bEnabled;			/**< Are scopes recorded */
+	bool												bShowStats;			/**< Are stats of frames aggregated */
+	bool												bCapturing;			/**< Is capture in progress */
+	bool												bCaptureFull;		/**< Is capture full, it's warned only once per capture */
+	uint64												frameStartCycles;	/**< Cycles when the current frame began */
+	uint64												captureStartCycles;	/**< Cycles when the capture began */
+	CMutex												mutex;				/**< Mutex of thread buffers and names */
+	CMutex												frameStatsMutex;	/**< Mutex of stats of the last frame */
+	std::vector<ThreadBuffer*>							threadBuffers;		/**< Buffers of threads */
+	std::unordered_map<uint32, std::wstring>			threadNames;		/**< Names of threads */
+	std::vector<Event>									tempEvents;			/**< Temporary array of scopes which are aggregated */
+	std::vector<CapturedEvent>							capturedEvents;		/**< Captured scopes */
+	FrameStats											lastFrameStats;		/**< Stats of the last frame */
+	std::unordered_map<const ProfilerStatDesc*, const tchar*>	statGroups;		/**< Interned group names of scopes */
+	std::unordered_map<std::wstring, const tchar*>		groupNames;			/**< Interned group names */
+};
+
+/**
+ * @ingroup Core
+ * @brief Records a profiled scope from construction to destruction
+ */
+class CScopedProfilerCounter
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InStat	Profiled scope
+	 */
+	FORCEINLINE CScopedProfilerCounter( const ProfilerStatDesc& InStat )
+		: stat( CProfiler::Get().IsEnabled() ? &InStat : nullptr )
+		, startCycles( stat ? Sys_Cycles() : 0 )
+	{}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~CScopedProfilerCounter()
+	{
+		if ( stat )
+		{
+			CProfiler::Get().AddScope( stat, startCycles, Sys_Cycles() );
+		}
+	}
+
+private:
+	const ProfilerStatDesc*		stat;			/**< Profiled scope, NULL if the profiler is disabled */
+	uint64						startCycles;	/**< Cycles when the scope began */
+};
+
+/**
+ * @ingroup Core
+ * @brief Macro for profile a scope
+ *
+ * @param InGroup	Name of stat group
+ * @param InName	Name of the scope
+ *
+ * Example usage: @code SCOPED_PROFILER( TEXT( "World" ), TEXT( "Tick" ) ); @endcode
+ */
+#define SCOPED_PROFILER( InGroup, InName ) \
+	static const ProfilerStatDesc		PROFILER_CONCAT( s_ProfilerStat, __LINE__ ) = { InGroup, InName }; \
+	CScopedProfilerCounter				PROFILER_CONCAT( profilerCounter, __LINE__ )( PROFILER_CONCAT( s_ProfilerStat, __LINE__ ) );
+
+/**
+ * @ingroup Core
+ * @brief Macro for set name of a thread in the profiler
+ *
+ * @param InThreadId	Thread ID
+ * @param InName		Thread name
+ */
+#define PROFILER_THREAD_NAME( InThreadId, InName )		CProfiler::Get().SetThreadName( InThreadId, InName );
+
+/**
+ * @ingroup Core
+ * @brief Macro for end a frame in the profiler
+ */
+#define PROFILER_END_FRAME()							CProfiler::Get().EndFrame();
+
+#define PROFILER_CONCAT_INNER( InA, InB )		InA##InB
+#define PROFILER_CONCAT( InA, InB )				PROFILER_CONCAT_INNER( InA, InB )
+#else
+#define SCOPED_PROFILER( InGroup, InName )
+#define PROFILER_THREAD_NAME( InThreadId, InName )
+#define PROFILER_END_FRAME()
+#endif // ENABLE_PROFILER
+
+#endif // !PROFILER_H
@@ -0,0 +1,271 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+
+#include "Core.h"
+#include "System/Threading.h"
+
+/**
+ * @ingroup Core
+ * @brief Base class of task which executes in the thread pool
+ */
+class CThreadPoolTask
+{
+public:
+	friend class CThreadPool;
+
+	/**
+	 * @brief Constructor
+	 */
+	CThreadPoolTask();
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CThreadPoolTask();
+
+	/**
+	 * @brief Do work
+	 * This is where all task work is done. Called from one of the worker threads
+	 */
+	virtual void DoWork() = 0;
+
+	/**
+	 * @brief Block the caller until the task is done
+	 */
+	FORCEINLINE void Wait()
+	{
+		doneEvent->Wait();
+	}
+
+	/**
+	 * @brief Is the task done
+	 * @return Return TRUE if the task has been completed, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsDone() const
+	{
+		return bIsDone != 0;
+	}
+
+private:
+	/**
+	 * @brief Execute the task and mark it as done
+	 */
+	void Execute();
+
+	/**
+	 * @brief Reset the task state before adding it into the queue
+	 */
+	void Reset();
+
+	volatile int32		bIsDone;			/**< Whether the task has been completed */
+	CEvent*				doneEvent;			/**< Event is triggered when the task is done */
+	CThreadPoolTask*	nextQueuedTask;		/**< Next task in the queue of the thread pool, so queuing doesn't allocate memory */
+};
+
+/**
+ * @ingroup Core
+ * @brief Pool of worker threads
+ *
+ * Executes tasks in the queue on a fixed set of worker threads. Also provides
+ * ParallelFor helper where the calling thread participates in the work
+ */
+class CThreadPool
+{
+public:
+	/**
+	 * @brief Typedef of callback for ParallelFor
+	 * Takes pointer to the function object and index of the element to process
+	 */
+	typedef void( *ParallelForCallback_t )( const void*, uint32 );
+
+	/**
+	 * @brief Constructor
+	 */
+	CThreadPool();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CThreadPool();
+
+	/**
+	 * @brief Get global thread pool of the engine
+	 * @return Return global thread pool of the engine
+	 */
+	static FORCEINLINE CThreadPool& Get()
+	{
+		static CThreadPool	s_ThreadPool;
+		return s_ThreadPool;
+	}
+
+	/**
+	 * @brief Create worker threads
+	 *
+	 * @param InNumThreads		Number of worker threads. If 0 the thread pool will not create threads and all work will be done on the calling thread
+	 * @param InThreadName		Base name of worker threads
+	 * @param InThreadPriority	Priority of worker threads
+	 */
+	void Init( uint32 InNumThreads, const tchar* InThreadName = TEXT( "PoolThread" ), EThreadPriority InThreadPriority = TP_Normal );
+
+	/**
+	 * @brief Stop and destroy all worker threads
+	 * @note Tasks which are still in the queue will be executed on the calling thread
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Add task into the queue
+	 * If the thread pool has no worker threads the task will be executed immediately on the calling thread
+	 *
+	 * @param InTask	Task. The caller owns it and must not delete it until the task is done
+	 */
+	void AddTask( CThreadPoolTask* InTask );
+
+	/**
+	 * @brief Remove task from the queue if no one worker thread has started it yet
+	 *
+	 * @param InTask	Task
+	 * @return Return TRUE if the task was removed from the queue, otherwise returns FALSE
+	 */
+	bool RetractTask( CThreadPoolTask* InTask );
+
+	/**
+	 * @brief Execute function for each index in range [0, InNum) on worker threads and the calling thread
+	 * Blocks the caller until all indices are processed. Can be safely called from a worker thread
+	 *
+	 * @param InNum				Number of indices
+	 * @param InFunction		Function to execute for each index
+	 * @param InBatchSize		Number of indices which one thread takes at a time
+	 * @param InIsForceSingleThread	If TRUE all indices will be processed on the calling thread
+	 */
+	template<typename TFunction>
+	FORCEINLINE void ParallelFor( uint32 InNum, const TFunction& InFunction, uint32 InBatchSize = 1, bool InIsForceSingleThread = false )
+	{
+		// The function is passed by reference, so it isn't copied into std::function which may allocate memory
+		ParallelForInternal( InNum, &CallParallelForFunction<TFunction>, &InFunction, InBatchSize, InIsForceSingleThread );
+	}
+
+	/**
+	 * @brief Get number of worker threads
+	 * @return Return number of worker threads
+	 */
+	FORCEINLINE uint32 GetNumThreads() const
+	{
+		return threads.size();
+	}
+
+	/**
+	 * @brief Get key of the ParallelFor work item which the current thread is processing
+	 * The key doesn't depend on which thread processes the item, so keys give a deterministic order to results of work items
+	 * of ParallelFor calls made by the game thread and calls nested into them
+	 *
+	 * @return Return key of the current work item, 0 if the thread doesn't process a work item which has a key
+	 */
+	static uint64 GetCurrentWorkItemKey();
+
+	/**
+	 * @brief Is current thread is one of worker threads of this pool
+	 * @return Return TRUE if called from a worker thread of this pool, otherwise returns FALSE
+	 */
+	bool IsInWorkerThread() const;
+
+	/**
+	 * @brief Get index of the current worker thread in this pool
+	 * @return Return index of the current worker thread, if it isn't a worker thread of this pool returns INDEX_NONE
+	 */
+	uint32 GetCurrentWorkerIndex() const;
+
+private:
+	/**
+	 * @brief Worker thread of the pool
+	 */
+	class CWorker : public CRunnable
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * 
+		 * @param InThreadPool	Owner thread pool
+		 * @param InIndex		Index of the worker in the pool
+		 */
+		CWorker( CThreadPool* InThreadPool, uint32 InIndex );
+
+		/**
+		 * @brief Initialize
+		 * @return Return TRUE if initialization was successful, FALSE otherwise
+		 */
+		virtual bool Init() override;
+
+		/**
+		 * @brief Run
+		 * @return Return the exit code of the runnable object
+		 */
+		virtual uint32 Run() override;
+
+		/**
+		 * @brief Stop
+		 */
+		virtual void Stop() override;
+
+		/**
+		 * @brief Exit
+		 */
+		virtual void Exit() override;
+
+	private:
+		CThreadPool*		threadPool;		/**< Owner thread pool */
+		uint32				index;			/**< Index of the worker in the pool */
+	};
+
+	/**
+	 * @brief Call function object of ParallelFor
+	 *
+	 * @param InFunction	Pointer to the function object
+	 * @param InIndex		Index of the element to process
+	 */
+	template<typename TFunction>
+	static void CallParallelForFunction( const void* InFunction, uint32 InIndex )
+	{
+		( *( const TFunction* )InFunction )( InIndex );
+	}
+
+	/**
+	 * @brief Execute callback for each index in range [0, InNum) on worker threads and the calling thread
+	 * Helper tasks are taken from the pool of the thread pool, so in the steady state it doesn't allocate memory
+	 *
+	 * @param InNum				Number of indices
+	 * @param InCallback		Callback which calls the function object
+	 * @param InFunction		Pointer to the function object
+	 * @param InBatchSize		Number of indices which one thread takes at a time
+	 * @param InIsForceSingleThread	If TRUE all indices will be processed on the calling thread
+	 */
+	void ParallelForInternal( uint32 InNum, ParallelForCallback_t InCallback, const void* InFunction, uint32 InBatchSize, bool InIsForceSingleThread );
+
+	/**
+	 * @brief Pop next task from the queue
+	 * @return Return next task, if the queue is empty returns NULL
+	 */
+	CThreadPoolTask* PopTask();
+
+	volatile int32					bIsStopping;			/**< Whether worker threads must exit */
+	CMutex							mutex;					/**< Mutex of the task queue and free ParallelFor tasks */
+	CSemaphore*						workSemaphore;			/**< Semaphore with the number of queued tasks */
+	CThreadPoolTask*				queueHead;				/**< The first task in the queue */
+	CThreadPoolTask*				queueTail;				/**< The last task in the queue */
+	class CParallelForTask*			freeParallelForTasks;	/**< List of free helper tasks of ParallelFor, they are reused with their events */
+	std::vector<CRunnableThread*>	threads;				/**< Worker threads */
+	std::vector<CWorker*>			workers;				/**< Runnable objects of worker threads */
+	std::vector<uint32>				threadIds;				/**< IDs of worker threads */
+};
+
+#endif // !THREADPOOL_H
@@ -2,16 +2,17 @@
 #include "System/Threading.h"
 #include "Misc/Template.h"
 
-/* Critical section of ring buffer */
-static CMutex			s_RingBufferMutex;
-
 /*
 ==================
 CRingBuffer::CRingBuffer
 ==================
 */
 CRingBuffer::CRingBuffer( uint32 InBufferSize, uint32 InAlignment /*= 1*/ ) 
-	: alignment( InAlignment )
+	: isWriting( false )
+	, alignment( InAlignment )
+	, writerLock( 0 )
+	, bWriterWaiting( 0 )
+	, bReaderWaiting( 0 )
 {
 	data		= new byte[InBufferSize];
 	dataEnd		= data + InBufferSize;
@@ -36,7 +37,7 @@ CRingBuffer::CAllocationContext::CAllocationContext
 CRingBuffer::CAllocationContext::CAllocationContext( CRingBuffer& InRingBuffer, uint32 InAllocationSize ) 
 	: ringBuffer( InRingBuffer )
 {
-	s_RingBufferMutex.Lock();
+	ringBuffer.AcquireWriter();
 
 	// Only allow a single AllocationContext at a time for the ring buffer
 	Assert( !ringBuffer.isWriting );
@@ -55,29 +56,35 @@ CRingBuffer::CAllocationContext::CAllocationContext( CRingBuffer& InRingBuffer,
 	allocationEnd = Min( ringBuffer.dataEnd, allocationStart + alignedAllocationSize );
 
 	// Wait until the reading thread has finished reading the area of the buffer we want to allocate
-	while ( true )
+	auto	IsAllocationFree = [&]() -> bool
 	{
 		// Make a snapshot of a recent value of ReadPointer
 		byte*		currentReadPointer = ringBuffer.readPointer;
 
-		// If the ReadPointer and WritePointer are the same, the buffer is empty and there's no risk of overwriting unread data
-		if ( currentReadPointer == ringBuffer.writePointer )
-		{
-			break;
-		}
-		else
+		// If the ReadPointer and WritePointer are the same, the buffer is empty and there's no risk of overwriting unread data.
+		// Otherwise if the allocation doesn't contain the read pointer, the allocation won't overwrite unread data.
+		// Note that it needs to also prevent advancing WritePointer to match the current ReadPointer, since that would signal that the
+		// buffer is empty instead of the expected full
+		return currentReadPointer == ringBuffer.writePointer || !( allocationStart <= currentReadPointer && currentReadPointer <= allocationEnd );
+	};
+
+	if ( !IsAllocationFree() )
+	{
+		const double	startTime = Sys_Seconds();
+		++ringBuffer.stats.numWriteStalls;
+		while ( true )
 		{
-			// If the allocation doesn't contain the read pointer, the allocation won't overwrite unread data.
-			// Note that it needs to also prevent advancing WritePointer to match the current ReadPointer, since that would signal that the
-			// buffer is empty instead of the expected full
-			const bool		allocationContainsReadPointer = allocationStart <= currentReadPointer && currentReadPointer <= allocationEnd;
-			if ( !allocationContainsReadPointer )
+			// Tell the reader that we are going to sleep and check again, because the reader could free the space
+			// before it has seen the flag. Interlocked operations are full memory barriers, so one of us always sees the other
+			Sys_InterlockedExchange( &ringBuffer.bWriterWaiting, 1 );
+			if ( IsAllocationFree() )
 			{
+				Sys_InterlockedExchange( &ringBuffer.bWriterWaiting, 0 );
 				break;
 			}
+			ringBuffer.dataReadEvent.Wait();
 		}
-
-		Sys_Sleep( 0.1f );
+		ringBuffer.stats.writeStallTime += ( Sys_Seconds() - startTime ) * 1000.0;
 	}
 }
 
@@ -105,16 +112,43 @@ void CRingBuffer::CAllocationContext::Commit()
 
 		// Reset the IsWriting flag to allow other AllocationContexts to be created for the ring buffer
 		ringBuffer.isWriting = false;
-		s_RingBufferMutex.Unlock();
+		ringBuffer.ReleaseWriter();
 
 		// Clear the allocation pointer, to signal that it has been committed
 		allocationStart = nullptr;
 
-		// Trigger the data-written event to wake the reader thread
-		ringBuffer.dataWrittenEvent.Trigger();
+		// Trigger the data-written event only if the reader thread sleeps, it's much cheaper than trigger it for each command
+		if ( Sys_InterlockedCompareExchange( &ringBuffer.bReaderWaiting, 0, 1 ) == 1 )
+		{
+			ringBuffer.dataWrittenEvent.Trigger();
+		}
+	}
+}
+
+/*
+==================
+CRingBuffer::AcquireWriter
+==================
+*/
+void CRingBuffer::AcquireWriter()
+{
+	// The ring buffer has a single writer at a time. Mostly it is the game thread, so the lock is almost never contended
+	while ( Sys_InterlockedCompareExchange( &writerLock, 1, 0 ) != 0 )
+	{
+		Sys_Yield();
 	}
 }
 
+/*
+==================
+CRingBuffer::ReleaseWriter
+==================
+*/
+void CRingBuffer::ReleaseWriter()
+{
+	Sys_InterlockedExchange( &writerLock, 0 );
+}
+
 /*
 ==================
 CRingBuffer::BeginRead
@@ -165,6 +199,12 @@ CRingBuffer::FinishRead
 void CRingBuffer::FinishRead( uint32 InReadSize )
 {
 	readPointer += Align( InReadSize, alignment );
+
+	// Wake up the writer thread if it's waiting for free space
+	if ( Sys_InterlockedCompareExchange( &bWriterWaiting, 0, 1 ) == 1 )
+	{
+		dataReadEvent.Trigger();
+	}
 }
 
 /*
@@ -174,9 +214,17 @@ CRingBuffer::WaitForRead
 */
 void CRingBuffer::WaitForRead( uint32 InWaitTime /*= (uint32)-1*/ )
 {
-	// If the buffer is empty, wait for the data-written event to be triggered
+	// If the buffer is empty, wait for the data-written event to be triggered.
+	// Tell the writer that we are going to sleep and check again, because the writer could commit data before it has seen the flag
 	if ( readPointer == writePointer )
 	{
-		dataWrittenEvent.Wait( InWaitTime );
+		Sys_InterlockedExchange( &bReaderWaiting, 1 );
+		if ( readPointer == writePointer )
+		{
+			const double	startTime = Sys_Seconds();
+			dataWrittenEvent.Wait( InWaitTime );
+			stats.readIdleTime += ( Sys_Seconds() - startTime ) * 1000.0;
+		}
+		Sys_InterlockedExchange( &bReaderWaiting, 0 );
 	}
 }
\ No newline at end of file
@@ -60,6 +60,7 @@ void Sys_Error( const tchar* InFormat, ... )
 	Errorf( TEXT( "%s\n" ), message.c_str() );
 	Errorf( TEXT( "--------------------------------------------\n" ) );
 	Errorf( TEXT( "\n" ) );
+	g_Log->FlushAsync();
 	if ( Sys_IsDebuggerPresent() )
 	{
 		Sys_DebugBreak();
@@ -94,6 +95,7 @@ void Sys_FailAssertFunc( const tchar* InExpr, const achar* InFile, int InLine, c
 	Errorf( TEXT( "%s\n" ), message.c_str() );
 	Errorf( TEXT( "--------------------------------------------\n" ) );
 	Errorf( TEXT( "\n" ) );
+	g_Log->FlushAsync();
 	if ( Sys_IsDebuggerPresent() )
 	{
 		Sys_DebugBreak();
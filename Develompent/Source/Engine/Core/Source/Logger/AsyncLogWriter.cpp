@@ -0,0 +1,354 @@
+#include "Misc/StringTools.h"
+#include "Logger/AsyncLogWriter.h"
+
+/* Time in seconds which the log thread sleeps without messages */
+#define ASYNCLOGWRITER_IDLE_WAIT_TIME		0.1f
+
+/* Max time in seconds which Flush waits for the log thread, it mustn't hang a crashing application forever */
+#define ASYNCLOGWRITER_MAX_FLUSH_TIME		5.0
+
+/*
+==================
+CAsyncLogWriter::CAsyncLogWriter
+==================
+*/
+CAsyncLogWriter::CAsyncLogWriter( CBaseLogger* InLogger, uint32 InQueueSize )
+	: logger( InLogger )
+	, slots( nullptr )
+	, queueMask( 0 )
+	, enqueuePos( 0 )
+	, dequeuePos( 0 )
+	, flushedPos( 0 )
+	, bIsStopping( 1 )
+	, bIsExiting( 0 )
+	, bIsWaiting( 0 )
+	, numActiveCalls( 0 )
+	, numDropped( 0 )
+	, numDelayed( 0 )
+	, numReportedDropped( 0 )
+	, threadId( ( uint32 )-1 )
+	, wakeUpEvent( nullptr )
+	, thread( nullptr )
+{
+	Assert( logger );
+
+	// Size of the queue must be a power of two, so a position is mapped to a slot by mask
+	uint32		queueSize = 2;
+	while ( queueSize < InQueueSize )
+	{
+		queueSize <<= 1;
+	}
+
+	queueMask	= queueSize - 1;
+	slots		= new Slot[queueSize];
+	for ( uint32 index = 0; index < queueSize; ++index )
+	{
+		slots[index].sequence	= index;
+		slots[index].logType	= LT_Log;
+	}
+}
+
+/*
+==================
+CAsyncLogWriter::~CAsyncLogWriter
+==================
+*/
+CAsyncLogWriter::~CAsyncLogWriter()
+{
+	Shutdown();
+	delete[] slots;
+}
+
+/*
+==================
+CAsyncLogWriter::Start
+==================
+*/
+bool CAsyncLogWriter::Start()
+{
+	Assert( !thread );
+	bIsExiting	= 0;
+	wakeUpEvent	= new CEvent( false, nullptr );
+	thread		= CRunnableThread::Create( this, TEXT( "LogThread" ), false, false, 0, TP_BelowNormal );
+	if ( !thread )
+	{
+		delete wakeUpEvent;
+		wakeUpEvent = nullptr;
+		return false;
+	}
+
+	// Pushes are allowed only when the thread and the event are created
+	threadId = thread->GetThreadID();
+	Sys_InterlockedExchange( &bIsStopping, 0 );
+	return true;
+}
+
+/*
+==================
+CAsyncLogWriter::Shutdown
+==================
+*/
+void CAsyncLogWriter::Shutdown()
+{
+	if ( !thread )
+	{
+		return;
+	}
+
+	// Block new pushes and wait for calls in progress, they use the event and delayed pushes need the log thread to free slots
+	Sys_InterlockedExchange( &bIsStopping, 1 );
+	while ( numActiveCalls > 0 )
+	{
+		wakeUpEvent->Trigger();
+		Sys_Yield();
+	}
+
+	// Stop the log thread, it writes all queued messages before exit. Nobody can push a message after that
+	Sys_InterlockedExchange( &bIsExiting, 1 );
+	wakeUpEvent->Trigger();
+	thread->WaitForCompletion();
+	delete thread;
+	thread		= nullptr;
+	threadId	= ( uint32 )-1;
+
+	delete wakeUpEvent;
+	wakeUpEvent = nullptr;
+
+	if ( numDropped > 0 || numDelayed > 0 )
+	{
+		logger->Serialize( L_Sprintf( TEXT( "Async logging: %i messages were dropped, %i messages were delayed because the log queue was full\n" ), numDropped, numDelayed ).c_str(), LT_Warning );
+		logger->Flush();
+	}
+}
+
+/*
+==================
+CAsyncLogWriter::Push
+==================
+*/
+bool CAsyncLogWriter::Push( std::wstring& InMessage, ELogType InLogType )
+{
+	// The log thread writes its own messages immediately, it can't wait for itself. While the writer is stopping
+	// messages are serialized by callers too
+	if ( !BeginCall() )
+	{
+		return false;
+	}
+
+	if ( TryPush( InMessage, InLogType ) )
+	{
+		WakeUp();
+		EndCall();
+		return true;
+	}
+
+	// The queue is full. Plain messages are dropped, warnings and errors wait for a free slot
+	if ( InLogType == LT_Log )
+	{
+		Sys_InterlockedIncrement( &numDropped );
+		WakeUp();
+		EndCall();
+		return true;
+	}
+
+	Sys_InterlockedIncrement( &numDelayed );
+	do
+	{
+		wakeUpEvent->Trigger();
+		Sys_Yield();
+	}
+	while ( !TryPush( InMessage, InLogType ) );
+
+	WakeUp();
+	EndCall();
+	return true;
+}
+
+/*
+==================
+CAsyncLogWriter::BeginCall
+==================
+*/
+bool CAsyncLogWriter::BeginCall()
+{
+	// The call is registered before the stopping flag is checked, so Shutdown either waits for it or the call sees the flag
+	Sys_InterlockedIncrement( &numActiveCalls );
+	if ( bIsStopping || Sys_GetCurrentThreadId() == threadId )
+	{
+		Sys_InterlockedDecrement( &numActiveCalls );
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+CAsyncLogWriter::TryPush
+==================
+*/
+bool CAsyncLogWriter::TryPush( std::wstring& InMessage, ELogType InLogType )
+{
+	// Reserve a slot. A slot is free for a position when its sequence equals to the position
+	uint32		pos = ( uint32 )enqueuePos;
+	Slot*		slot = nullptr;
+	while ( true )
+	{
+		slot				= &slots[pos & queueMask];
+		int32		diff	= ( int32 )( ( uint32 )slot->sequence - pos );
+		if ( diff == 0 )
+		{
+			uint32		prevPos = ( uint32 )Sys_InterlockedCompareExchange( &enqueuePos, ( int32 )( pos + 1 ), ( int32 )pos );
+			if ( prevPos == pos )
+			{
+				break;
+			}
+			pos = prevPos;
+		}
+		else if ( diff < 0 )
+		{
+			// The slot still holds a message of the previous lap, so the queue is full
+			return false;
+		}
+		else
+		{
+			pos = ( uint32 )enqueuePos;
+		}
+	}
+
+	// Fill the slot and publish it to the log thread
+	slot->logType = InLogType;
+	slot->message = std::move( InMessage );
+	Sys_InterlockedExchange( &slot->sequence, ( int32 )( pos + 1 ) );
+	return true;
+}
+
+/*
+==================
+CAsyncLogWriter::Flush
+==================
+*/
+void CAsyncLogWriter::Flush()
+{
+	if ( !BeginCall() )
+	{
+		return;
+	}
+
+	// Wait until the log thread flushes everything which has been pushed so far
+	const uint32	targetPos = ( uint32 )enqueuePos;
+	const double	startTime = Sys_Seconds();
+	while ( ( int32 )( ( uint32 )flushedPos - targetPos ) < 0 && Sys_Seconds() - startTime < ASYNCLOGWRITER_MAX_FLUSH_TIME )
+	{
+		wakeUpEvent->Trigger();
+		Sys_Yield();
+	}
+	EndCall();
+}
+
+/*
+==================
+CAsyncLogWriter::WriteBatch
+==================
+*/
+bool CAsyncLogWriter::WriteBatch()
+{
+	bool	bWritten = false;
+	while ( true )
+	{
+		// A slot is filled for a position when its sequence is the position plus one
+		uint32		pos = ( uint32 )dequeuePos;
+		Slot&		slot = slots[pos & queueMask];
+		if ( ( uint32 )slot.sequence != pos + 1 )
+		{
+			break;
+		}
+
+		logger->Serialize( slot.message.c_str(), slot.logType );
+		slot.message.clear();
+
+		// Free the slot for the next lap
+		Sys_InterlockedExchange( &slot.sequence, ( int32 )( pos + queueMask + 1 ) );
+		Sys_InterlockedExchange( &dequeuePos, ( int32 )( pos + 1 ) );
+		bWritten = true;
+	}
+
+	// Report dropped messages into the log in place where they have been lost
+	uint32		currentDropped = ( uint32 )numDropped;
+	if ( currentDropped != numReportedDropped )
+	{
+		logger->Serialize( L_Sprintf( TEXT( "Async logging: the log queue is full, %i messages were dropped\n" ), currentDropped - numReportedDropped ).c_str(), LT_Warning );
+		numReportedDropped	= currentDropped;
+		bWritten			= true;
+	}
+
+	// Flush the logger once per batch
+	if ( bWritten )
+	{
+		logger->Flush();
+		Sys_InterlockedExchange( &flushedPos, dequeuePos );
+	}
+	return bWritten;
+}
+
+/*
+==================
+CAsyncLogWriter::Init
+==================
+*/
+bool CAsyncLogWriter::Init()
+{
+	return true;
+}
+
+/*
+==================
+CAsyncLogWriter::Run
+==================
+*/
+uint32 CAsyncLogWriter::Run()
+{
+	while ( !bIsExiting )
+	{
+		if ( WriteBatch() )
+		{
+			continue;
+		}
+
+		// Sleep until new messages. Check the queue again after the waiting flag is set, otherwise a message
+		// which has been pushed right before it may wait the whole idle time
+		Sys_InterlockedExchange( &bIsWaiting, 1 );
+		uint32		pos = ( uint32 )dequeuePos;
+		if ( ( uint32 )slots[pos & queueMask].sequence != pos + 1 && !bIsExiting )
+		{
+			wakeUpEvent->Wait( ( uint32 )( ASYNCLOGWRITER_IDLE_WAIT_TIME * 1000.f ) );
+		}
+		Sys_InterlockedExchange( &bIsWaiting, 0 );
+	}
+
+	// Write all left messages before exit
+	WriteBatch();
+	return 0;
+}
+
+/*
+==================
+CAsyncLogWriter::Stop
+==================
+*/
+void CAsyncLogWriter::Stop()
+{
+	Sys_InterlockedExchange( &bIsStopping, 1 );
+	Sys_InterlockedExchange( &bIsExiting, 1 );
+	if ( wakeUpEvent )
+	{
+		wakeUpEvent->Trigger();
+	}
+}
+
+/*
+==================
+CAsyncLogWriter::Exit
+==================
+*/
+void CAsyncLogWriter::Exit()
+{}
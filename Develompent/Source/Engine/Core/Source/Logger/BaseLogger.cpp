@@ -1,5 +1,16 @@
 #include "Misc/StringTools.h"
 #include "Logger/BaseLogger.h"
+#include "Logger/AsyncLogWriter.h"
+
+/*
+==================
+CBaseLogger::~CBaseLogger
+==================
+*/
+CBaseLogger::~CBaseLogger()
+{
+	StopAsync();
+}
 
 /*
 ==================
@@ -11,7 +22,68 @@ void CBaseLogger::Printf( ELogType InLogType, const tchar* InMessage, ... )
 #if !NO_LOGGING
 	va_list			arguments;
 	va_start( arguments, InMessage );
-    Serialize( L_Vsprintf( InMessage, arguments ).c_str(), InLogType );  
+	std::wstring	message = L_Vsprintf( InMessage, arguments );
 	va_end( arguments );
+
+	// In asynchronous mode the message is serialized by the log thread
+	if ( !asyncWriter || !asyncWriter->Push( message, InLogType ) )
+	{
+		Serialize( message.c_str(), InLogType );
+	}
 #endif // !NO_LOGGING
-}
\ No newline at end of file
+}
+
+/*
+==================
+CBaseLogger::StartAsync
+==================
+*/
+void CBaseLogger::StartAsync( uint32 InQueueSize )
+{
+#if !NO_LOGGING
+	if ( asyncWriter )
+	{
+		return;
+	}
+
+	CAsyncLogWriter*	writer = new CAsyncLogWriter( this, InQueueSize );
+	if ( !writer->Start() )
+	{
+		delete writer;
+		return;
+	}
+	asyncWriter = writer;
+#endif // !NO_LOGGING
+}
+
+/*
+==================
+CBaseLogger::StopAsync
+==================
+*/
+void CBaseLogger::StopAsync()
+{
+	if ( !asyncWriter )
+	{
+		return;
+	}
+
+	// Switch to synchronous mode first, so messages from the shutdown are serialized directly
+	CAsyncLogWriter*	writer = asyncWriter;
+	asyncWriter = nullptr;
+	writer->Shutdown();
+	delete writer;
+}
+
+/*
+==================
+CBaseLogger::FlushAsync
+==================
+*/
+void CBaseLogger::FlushAsync()
+{
+	if ( asyncWriter )
+	{
+		asyncWriter->Flush();
+	}
+}
@@ -1,21 +1,51 @@
 #include <zlib.h>
+#include <vector>
 
 #include "Logger/LoggerMacros.h"
 #include "Misc/Compression.h"
 
+// Min length of LZ4 match
+#define LZ4_MIN_MATCH				4
+
+// Number of bytes at the end of LZ4 block which are always literals
+#define LZ4_LAST_LITERALS			5
+
+// Last LZ4 match must start at least this number of bytes before the end of block
+#define LZ4_MF_LIMIT				12
+
+// Max distance of LZ4 match (offset is stored in two bytes)
+#define LZ4_MAX_DISTANCE			65535
+
+// Log2 of hash table size used by LZ4 compressor
+#define LZ4_HASH_LOG				16
+
+// Max number of candidates checked per position by high compression mode of LZ4
+#define LZ4_HC_MAX_ATTEMPTS			64
+
 /*
 ==================
 CompressMemoryZLIB
 ==================
 */
-static bool CompressMemoryZLIB( void* InCompressedBuffer, uint32& InOutCompressedSize, const void* InUncompressedBuffer, uint32 InUncompressedSize )
+static bool CompressMemoryZLIB( void* InCompressedBuffer, uint32& InOutCompressedSize, const void* InUncompressedBuffer, uint32 InUncompressedSize, uint32 InBiasFlags )
 {
 	// Zlib wants to use unsigned long
 	unsigned long		zCompressedSize = InOutCompressedSize;
 	unsigned long		zUncompressedSize = InUncompressedSize;
 
+	// Select compression level
+	int32				level = Z_DEFAULT_COMPRESSION;
+	if ( InBiasFlags & CF_BiasSpeed )
+	{
+		level = Z_BEST_SPEED;
+	}
+	else if ( InBiasFlags & CF_BiasSize )
+	{
+		level = Z_BEST_COMPRESSION;
+	}
+
 	// Compress data
-	bool bResult = compress( ( byte* )InCompressedBuffer, &zCompressedSize, ( const byte* )InUncompressedBuffer, zUncompressedSize ) == Z_OK ? true : false;
+	bool bResult = compress2( ( byte* )InCompressedBuffer, &zCompressedSize, ( const byte* )InUncompressedBuffer, zUncompressedSize, level ) == Z_OK ? true : false;
 	
 	// Propagate compressed size from intermediate variable back into out variable
 	InOutCompressedSize = zCompressedSize;
@@ -41,6 +71,320 @@ static bool UncompressMemoryZLIB( void* InUncompressedBuffer, uint32 InUncompres
 	return bResult;
 }
 
+/*
+==================
+ReadUInt32LZ4
+==================
+*/
+static FORCEINLINE uint32 ReadUInt32LZ4( const byte* InPtr )
+{
+	uint32	value;
+	memcpy( &value, InPtr, sizeof( uint32 ) );
+	return value;
+}
+
+/*
+==================
+HashLZ4
+==================
+*/
+static FORCEINLINE uint32 HashLZ4( uint32 InSequence )
+{
+	return ( InSequence * 2654435761u ) >> ( 32 - LZ4_HASH_LOG );
+}
+
+/*
+==================
+WriteLengthLZ4
+==================
+*/
+static FORCEINLINE bool WriteLengthLZ4( byte*& InOutDest, const byte* InDestEnd, uint32 InLength )
+{
+	// Lengths greater than 15 continue in additional bytes, each 255 means one more byte follows
+	for ( ; InLength >= 255; InLength -= 255 )
+	{
+		if ( InOutDest >= InDestEnd )
+		{
+			return false;
+		}
+		*InOutDest++ = 255;
+	}
+
+	if ( InOutDest >= InDestEnd )
+	{
+		return false;
+	}
+	*InOutDest++ = ( byte )InLength;
+	return true;
+}
+
+/*
+==================
+WriteSequenceLZ4
+==================
+*/
+static bool WriteSequenceLZ4( byte*& InOutDest, const byte* InDestEnd, const byte* InLiterals, uint32 InNumLiterals, uint32 InOffset, uint32 InMatchLength )
+{
+	// Token keeps number of literals in high 4 bits and length of the match in low 4 bits
+	if ( InOutDest >= InDestEnd )
+	{
+		return false;
+	}
+
+	byte*	token = InOutDest++;
+	*token = ( byte )( Min<uint32>( InNumLiterals, 15 ) << 4 );
+	if ( InNumLiterals >= 15 && !WriteLengthLZ4( InOutDest, InDestEnd, InNumLiterals - 15 ) )
+	{
+		return false;
+	}
+
+	if ( InNumLiterals > ( uint32 )( InDestEnd - InOutDest ) )
+	{
+		return false;
+	}
+	memcpy( InOutDest, InLiterals, InNumLiterals );
+	InOutDest += InNumLiterals;
+
+	// The last sequence of block has only literals
+	if ( InMatchLength == 0 )
+	{
+		return true;
+	}
+
+	if ( InDestEnd - InOutDest < 2 )
+	{
+		return false;
+	}
+	InOutDest[0] = ( byte )( InOffset & 0xFF );
+	InOutDest[1] = ( byte )( InOffset >> 8 );
+	InOutDest += 2;
+
+	uint32	matchLength = InMatchLength - LZ4_MIN_MATCH;
+	*token |= ( byte )Min<uint32>( matchLength, 15 );
+	if ( matchLength >= 15 && !WriteLengthLZ4( InOutDest, InDestEnd, matchLength - 15 ) )
+	{
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+CompressMemoryLZ4
+==================
+*/
+static bool CompressMemoryLZ4( void* InCompressedBuffer, uint32& InOutCompressedSize, const void* InUncompressedBuffer, uint32 InUncompressedSize, uint32 InBiasFlags )
+{
+	const byte*		src			= ( const byte* )InUncompressedBuffer;
+	byte*			dest		= ( byte* )InCompressedBuffer;
+	const byte*		destEnd		= dest + InOutCompressedSize;
+	uint32			anchor		= 0;
+
+	// Blocks shorter than LZ4_MF_LIMIT are stored as literals only
+	if ( InUncompressedSize > LZ4_MF_LIMIT )
+	{
+		// In high compression mode we keep chains of previous positions with the same hash and pick the longest match,
+		// otherwise only the last position is checked
+		const bool				bHighCompression	= ( InBiasFlags & CF_BiasSize ) != 0;
+		const uint32			maxAttempts			= bHighCompression ? LZ4_HC_MAX_ATTEMPTS : 1;
+		const uint32			matchLimit			= InUncompressedSize - LZ4_LAST_LITERALS;
+		const uint32			lastMatchStart		= InUncompressedSize - LZ4_MF_LIMIT;
+		std::vector<int32>		hashTable( 1 << LZ4_HASH_LOG, -1 );
+		std::vector<int32>		chainTable;
+		uint32					nextToInsert		= 0;
+		if ( bHighCompression )
+		{
+			chainTable.resize( InUncompressedSize, -1 );
+		}
+
+		uint32		pos = 0;
+		while ( pos <= lastMatchStart )
+		{
+			// Add skipped positions into the chains
+			if ( bHighCompression )
+			{
+				for ( ; nextToInsert < pos; ++nextToInsert )
+				{
+					uint32		hash = HashLZ4( ReadUInt32LZ4( src + nextToInsert ) );
+					chainTable[nextToInsert]	= hashTable[hash];
+					hashTable[hash]				= nextToInsert;
+				}
+			}
+
+			// Find the longest match among candidates
+			const uint32	sequence		= ReadUInt32LZ4( src + pos );
+			const uint32	hash			= HashLZ4( sequence );
+			int32			candidate		= hashTable[hash];
+			uint32			bestLength		= 0;
+			uint32			bestPos			= 0;
+			for ( uint32 attempt = 0; attempt < maxAttempts && candidate >= 0 && pos - candidate <= LZ4_MAX_DISTANCE; ++attempt )
+			{
+				if ( ReadUInt32LZ4( src + candidate ) == sequence )
+				{
+					uint32	length = LZ4_MIN_MATCH;
+					while ( pos + length < matchLimit && src[candidate + length] == src[pos + length] )
+					{
+						++length;
+					}
+
+					if ( length > bestLength )
+					{
+						bestLength	= length;
+						bestPos		= candidate;
+					}
+				}
+				candidate = bHighCompression ? chainTable[candidate] : -1;
+			}
+
+			if ( bHighCompression )
+			{
+				chainTable[pos]	= hashTable[hash];
+				nextToInsert	= pos + 1;
+			}
+			hashTable[hash] = pos;
+
+			// No match, move forward. In fast mode the step grows on incompressible data
+			if ( bestLength < LZ4_MIN_MATCH )
+			{
+				pos += bHighCompression ? 1 : 1 + ( ( pos - anchor ) >> 6 );
+				continue;
+			}
+
+			// Extend the match backwards over pending literals
+			while ( pos > anchor && bestPos > 0 && src[pos - 1] == src[bestPos - 1] )
+			{
+				--pos;
+				--bestPos;
+				++bestLength;
+			}
+
+			if ( !WriteSequenceLZ4( dest, destEnd, src + anchor, pos - anchor, pos - bestPos, bestLength ) )
+			{
+				return false;
+			}
+
+			pos		+= bestLength;
+			anchor	= pos;
+
+			// Remember a position inside the match, it's cheap and improves ratio of the fast mode
+			if ( !bHighCompression && pos - 2 <= InUncompressedSize - sizeof( uint32 ) )
+			{
+				hashTable[HashLZ4( ReadUInt32LZ4( src + pos - 2 ) )] = pos - 2;
+			}
+		}
+	}
+
+	// Write the rest as literals
+	if ( !WriteSequenceLZ4( dest, destEnd, src + anchor, InUncompressedSize - anchor, 0, 0 ) )
+	{
+		return false;
+	}
+
+	InOutCompressedSize = dest - ( byte* )InCompressedBuffer;
+	return true;
+}
+
+/*
+==================
+UncompressMemoryLZ4
+==================
+*/
+static bool UncompressMemoryLZ4( void* InUncompressedBuffer, uint32 InUncompressedSize, const void* InCompressedBuffer, uint32 InCompressedSize )
+{
+	const byte*		src			= ( const byte* )InCompressedBuffer;
+	const byte*		srcEnd		= src + InCompressedSize;
+	byte*			destStart	= ( byte* )InUncompressedBuffer;
+	byte*			dest		= destStart;
+	const byte*		destEnd		= dest + InUncompressedSize;
+
+	while ( src < srcEnd )
+	{
+		// Read literals
+		const uint32	token		= *src++;
+		uint32			numLiterals	= token >> 4;
+		if ( numLiterals == 15 )
+		{
+			byte	value;
+			do
+			{
+				if ( src >= srcEnd )
+				{
+					return false;
+				}
+				value			= *src++;
+				numLiterals		+= value;
+			}
+			while ( value == 255 );
+		}
+
+		if ( numLiterals > ( uint32 )( srcEnd - src ) || numLiterals > ( uint32 )( destEnd - dest ) )
+		{
+			return false;
+		}
+		memcpy( dest, src, numLiterals );
+		src		+= numLiterals;
+		dest	+= numLiterals;
+
+		// The last sequence has only literals
+		if ( src == srcEnd )
+		{
+			break;
+		}
+
+		// Read the match
+		if ( srcEnd - src < 2 )
+		{
+			return false;
+		}
+
+		const uint32	offset = src[0] | ( src[1] << 8 );
+		src += 2;
+		if ( offset == 0 || offset > ( uint32 )( dest - destStart ) )
+		{
+			return false;
+		}
+
+		uint32			matchLength = token & 15;
+		if ( matchLength == 15 )
+		{
+			byte	value;
+			do
+			{
+				if ( src >= srcEnd )
+				{
+					return false;
+				}
+				value			= *src++;
+				matchLength		+= value;
+			}
+			while ( value == 255 );
+		}
+		matchLength += LZ4_MIN_MATCH;
+
+		if ( matchLength > ( uint32 )( destEnd - dest ) )
+		{
+			return false;
+		}
+
+		// Overlapped matches repeat the last bytes, so they must be copied byte by byte
+		const byte*		match = dest - offset;
+		if ( offset >= matchLength )
+		{
+			memcpy( dest, match, matchLength );
+			dest += matchLength;
+		}
+		else
+		{
+			for ( uint32 index = 0; index < matchLength; ++index )
+			{
+				*dest++ = *match++;
+			}
+		}
+	}
+
+	return dest == destEnd;
+}
+
 /*
 ==================
 Sys_CompressMemory
@@ -49,13 +393,17 @@ Sys_CompressMemory
 bool Sys_CompressMemory( ECompressionFlags InFlags, void* InCompressedBuffer, uint32& InOutCompressedSize, const void* InUncompressedBuffer, uint32 InUncompressedSize )
 {
 	// Make sure a valid compression scheme was provided
-	Assert( InFlags | CF_ZLIB );
+	Assert( InFlags & CF_CodecMask );
 	bool	bResult = false;
 
-	switch ( InFlags )
+	switch ( InFlags & CF_CodecMask )
 	{
 	case CF_ZLIB:
-		bResult = CompressMemoryZLIB( InCompressedBuffer, InOutCompressedSize, InUncompressedBuffer, InUncompressedSize );
+		bResult = CompressMemoryZLIB( InCompressedBuffer, InOutCompressedSize, InUncompressedBuffer, InUncompressedSize, InFlags & CF_BiasMask );
+		break;
+
+	case CF_LZ4:
+		bResult = CompressMemoryLZ4( InCompressedBuffer, InOutCompressedSize, InUncompressedBuffer, InUncompressedSize, InFlags & CF_BiasMask );
 		break;
 
 	default:
@@ -75,15 +423,19 @@ Sys_UncompressMemory
 bool Sys_UncompressMemory( ECompressionFlags InFlags, void* InUncompressedBuffer, uint32 InUncompressedSize, const void* InCompressedBuffer, uint32 InCompressedSize )
 {
 	// Make sure a valid compression scheme was provided
-	Assert( InFlags | CF_ZLIB );
+	Assert( InFlags & CF_CodecMask );
 	bool	bResult = false;
 
-	switch ( InFlags )
+	switch ( InFlags & CF_CodecMask )
 	{
 	case CF_ZLIB:
 		bResult = UncompressMemoryZLIB( InUncompressedBuffer, InUncompressedSize, InCompressedBuffer, InCompressedSize );
 		break;
 
+	case CF_LZ4:
+		bResult = UncompressMemoryLZ4( InUncompressedBuffer, InUncompressedSize, InCompressedBuffer, InCompressedSize );
+		break;
+
 	default:
 		Warnf( TEXT( "Sys_UncompressMemory: Compression flags 0x%X, this compression type isn't supported\n" ), InFlags );
 		bResult = false;
@@ -0,0 +1,351 @@
+#include "Logger/LoggerMacros.h"
+#include "Reflection/AsyncPackageLoader.h"
+#include "Reflection/ObjectPackage.h"
+#include "Reflection/LinkerLoad.h"
+#include "System/PackageFileCache.h"
+
+/*
+==================
+CAsyncPackageLoader::CPreloadTask::CPreloadTask
+==================
+*/
+CAsyncPackageLoader::CPreloadTask::CPreloadTask( const std::wstring& InFilename )
+	: reader( new CPreloadedPackageReader( InFilename ) )
+{}
+
+/*
+==================
+CAsyncPackageLoader::CPreloadTask::~CPreloadTask
+==================
+*/
+CAsyncPackageLoader::CPreloadTask::~CPreloadTask()
+{
+	delete reader;
+}
+
+/*
+==================
+CAsyncPackageLoader::CPreloadTask::DoWork
+==================
+*/
+void CAsyncPackageLoader::CPreloadTask::DoWork()
+{
+	// If we failed to read the file then linker will try to open it by itself and will report about an error
+	if ( !reader->Preload() )
+	{
+		delete reader;
+		reader = nullptr;
+	}
+}
+
+/*
+==================
+CAsyncPackageLoader::CPreloadTask::ReleaseReader
+==================
+*/
+CPreloadedPackageReader* CAsyncPackageLoader::CPreloadTask::ReleaseReader()
+{
+	Assert( IsDone() );
+	CPreloadedPackageReader*	result = reader;
+	reader = nullptr;
+	return result;
+}
+
+
+/*
+==================
+CAsyncPackageLoader::CAsyncPackageLoader
+==================
+*/
+CAsyncPackageLoader::CAsyncPackageLoader()
+	: nextRequestId( 0 )
+	, timeLimitPerProcessAsyncLoadingCall( 0.005f )
+{}
+
+/*
+==================
+CAsyncPackageLoader::~CAsyncPackageLoader
+==================
+*/
+CAsyncPackageLoader::~CAsyncPackageLoader()
+{
+	AssertMsg( requests.empty(), TEXT( "All async loading requests must be flushed before exit" ) );
+}
+
+/*
+==================
+CAsyncPackageLoader::LoadPackage
+==================
+*/
+uint32 CAsyncPackageLoader::LoadPackage( const tchar* InFilename, const COnAsyncPackageLoaded::DelegateType_t& InCallback, uint32 InLoadFlags )
+{
+	Assert( IsInGameThread() && *InFilename != '\0' );
+
+	// Find the package file, if it isn't found we still create the request to report about the error from ProcessAsyncLoading
+	std::wstring	filename;
+	if ( !CPackageFileCache::Get().FindPackageFile( InFilename, filename ) )
+	{
+		filename = InFilename;
+	}
+
+	// If the package is already loading then we just add the callback and load flags to its request
+	for ( auto it = requests.begin(), itEnd = requests.end(); it != itEnd; ++it )
+	{
+		AsyncPackageRequest*	request = *it;
+		if ( request->filename == filename )
+		{
+			request->loadFlags |= InLoadFlags;
+			if ( request->linker )
+			{
+				request->linker->AddLoadFlags( InLoadFlags );
+			}
+
+			if ( InCallback )
+			{
+				request->callbacks.push_back( InCallback );
+			}
+			return request->id;
+		}
+	}
+
+	// Create a new request and start preloading the package file on a worker thread
+	AsyncPackageRequest*	request = new AsyncPackageRequest();
+	request->id						= nextRequestId++;
+	request->filename				= filename;
+	request->loadFlags				= InLoadFlags;
+	request->stage					= ALS_Preloading;
+	request->preloadTask			= new CPreloadTask( filename );
+	request->linker					= nullptr;
+	request->package				= nullptr;
+	request->nextExportIndex		= 0;
+	request->nextRootExportIndex	= 0;
+	if ( InCallback )
+	{
+		request->callbacks.push_back( InCallback );
+	}
+
+	requests.push_back( request );
+	CThreadPool::Get().AddTask( request->preloadTask );
+	Logf( TEXT( "Async load package '%s'\n" ), filename.c_str() );
+	return request->id;
+}
+
+/*
+==================
+CAsyncPackageLoader::ProcessAsyncLoading
+==================
+*/
+void CAsyncPackageLoader::ProcessAsyncLoading( bool InIsUseTimeLimit, float InTimeLimit /* = 0.f */ )
+{
+	Assert( IsInGameThread() );
+
+	// Early out if there is nothing to do
+	if ( requests.empty() )
+	{
+		return;
+	}
+
+	// Set to default time limit if InTimeLimit is less or equal to zero
+	if ( InTimeLimit <= 0.f )
+	{
+		InTimeLimit = timeLimitPerProcessAsyncLoadingCall;
+	}
+
+	// Process requests in order they were added. Callbacks are called after processing,
+	// because they may add new requests
+	const double						startTime = Sys_Seconds();
+	std::vector<AsyncPackageRequest*>	finishedRequests;
+	for ( auto it = requests.begin(); it != requests.end(); )
+	{
+		AsyncPackageRequest*	request = *it;
+		if ( ProcessRequest( request, InIsUseTimeLimit, startTime, InTimeLimit ) )
+		{
+			finishedRequests.push_back( request );
+			it = requests.erase( it );
+			continue;
+		}
+
+		// Objects created in this call must survive the garbage collection till the next one
+		AddObjectsToRoot( request );
+		if ( InIsUseTimeLimit && Sys_Seconds() - startTime >= InTimeLimit )
+		{
+			break;
+		}
+		++it;
+	}
+
+	for ( uint32 index = 0, count = finishedRequests.size(); index < count; ++index )
+	{
+		AsyncPackageRequest*	request = finishedRequests[index];
+		for ( uint32 callbackIndex = 0, numCallbacks = request->callbacks.size(); callbackIndex < numCallbacks; ++callbackIndex )
+		{
+			request->callbacks[callbackIndex]( request->package );
+		}
+		delete request;
+	}
+}
+
+/*
+==================
+CAsyncPackageLoader::FlushAsyncLoading
+==================
+*/
+void CAsyncPackageLoader::FlushAsyncLoading()
+{
+	// Callbacks may add new requests, so we loop till all of them are finished
+	while ( !requests.empty() )
+	{
+		ProcessAsyncLoading( false );
+	}
+}
+
+/*
+==================
+CAsyncPackageLoader::IsAsyncLoading
+==================
+*/
+bool CAsyncPackageLoader::IsAsyncLoading( uint32 InRequestId ) const
+{
+	for ( auto it = requests.begin(), itEnd = requests.end(); it != itEnd; ++it )
+	{
+		if ( ( *it )->id == InRequestId )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+==================
+CAsyncPackageLoader::ProcessRequest
+==================
+*/
+bool CAsyncPackageLoader::ProcessRequest( AsyncPackageRequest* InRequest, bool InIsUseTimeLimit, double InStartTime, float InTimeLimit )
+{
+	// Wait for the worker thread. Without time limit we block till the package file will be read
+	if ( InRequest->stage == ALS_Preloading )
+	{
+		if ( InIsUseTimeLimit && !InRequest->preloadTask->IsDone() )
+		{
+			return false;
+		}
+
+		// The task may be still signaling its done event, so we wait it before deleting
+		InRequest->preloadTask->Wait();
+		InRequest->stage = ALS_CreateLinker;
+	}
+
+	// Create the linker from preloaded data
+	if ( InRequest->stage == ALS_CreateLinker )
+	{
+		CPreloadedPackageReader*	reader = InRequest->preloadTask->ReleaseReader();
+		delete InRequest->preloadTask;
+		InRequest->preloadTask = nullptr;
+
+		CObjectPackage::BeginLoadPackage();
+		InRequest->linker = CLinkerLoad::GetPackageLinker( nullptr, InRequest->filename.c_str(), InRequest->loadFlags, reader );
+		if ( InRequest->linker )
+		{
+			// The linker must be alive till all exports will be loaded, so we close it by ourselves in FinishRequest
+			CObjectPackage::GetObjectSerializeContext().RemoveDelayedLinkerClosePackage( InRequest->linker );
+			InRequest->package = InRequest->linker->GetLinkerRoot();
+		}
+		CObjectPackage::EndLoadPackage();
+
+		if ( !InRequest->linker )
+		{
+			Errorf( TEXT( "Failed to async load package '%s', no linker\n" ), InRequest->filename.c_str() );
+			InRequest->stage = ALS_Finished;
+			return true;
+		}
+
+		InRequest->stage = ALS_LoadingExports;
+		AddObjectsToRoot( InRequest );
+	}
+
+	// Load exports one by one. Each export is serialized and post loaded together with objects it depends on
+	while ( InRequest->stage == ALS_LoadingExports )
+	{
+		if ( InRequest->nextExportIndex >= InRequest->linker->GetExports().size() )
+		{
+			FinishRequest( InRequest );
+			return true;
+		}
+
+		if ( InIsUseTimeLimit && Sys_Seconds() - InStartTime >= InTimeLimit )
+		{
+			return false;
+		}
+
+		CObjectPackage::BeginLoadPackage();
+		InRequest->linker->LoadExport( InRequest->nextExportIndex++ );
+		CObjectPackage::EndLoadPackage();
+	}
+
+	return InRequest->stage == ALS_Finished;
+}
+
+/*
+==================
+CAsyncPackageLoader::AddObjectsToRoot
+==================
+*/
+void CAsyncPackageLoader::AddObjectsToRoot( AsyncPackageRequest* InRequest )
+{
+	if ( InRequest->stage != ALS_LoadingExports )
+	{
+		return;
+	}
+
+	// Objects which are already in the root set belong to someone else, so we don't record them to not remove them from the root set in FinishRequest
+	if ( !InRequest->package->IsRootSet() )
+	{
+		InRequest->package->AddToRoot();
+		InRequest->rootedObjects.push_back( InRequest->package );
+	}
+
+	// Exports which are created out of order are referenced by the loaded exports which created them,
+	// so the garbage collector reaches them till they will be rooted here
+	const std::vector<ObjectExport>&	exportMap = InRequest->linker->GetExports();
+	for ( ; InRequest->nextRootExportIndex < InRequest->nextExportIndex; ++InRequest->nextRootExportIndex )
+	{
+		CObject*	object = exportMap[InRequest->nextRootExportIndex].object;
+		if ( object && !object->IsRootSet() )
+		{
+			object->AddToRoot();
+			InRequest->rootedObjects.push_back( object );
+		}
+	}
+}
+
+/*
+==================
+CAsyncPackageLoader::FinishRequest
+==================
+*/
+void CAsyncPackageLoader::FinishRequest( AsyncPackageRequest* InRequest )
+{
+	Assert( InRequest->stage == ALS_LoadingExports );
+
+	// Mark package as loaded and close the linker the same way as CObjectPackage::LoadPackage does
+	CObjectPackage::BeginLoadPackage();
+	InRequest->package->MarkAsFullyLoaded();
+	InRequest->package->AddObjectFlag( OBJECT_WasLoaded );
+	CObjectPackage::GetObjectSerializeContext().AddDelayedLinkerClosePackage( InRequest->linker );
+	CObjectPackage::EndLoadPackage();
+	InRequest->linker = nullptr;
+
+	// Objects are no longer need protection from the garbage collector. Now the owner of the request is responsible for them
+	for ( uint32 index = 0, count = InRequest->rootedObjects.size(); index < count; ++index )
+	{
+		InRequest->rootedObjects[index]->RemoveFromRoot();
+	}
+	InRequest->rootedObjects.clear();
+
+	// Group objects of the package into a GC cluster
+	CObjectGC::Get().CreateCluster( InRequest->package );
+
+	InRequest->stage = ALS_Finished;
+	Logf( TEXT( "Package '%s' is async loaded\n" ), InRequest->filename.c_str() );
+}
@@ -1,3 +1,5 @@
+#include <memory>
+
 #include "Logger/LoggerMacros.h"
 #include "Reflection/LinkerLoad.h"
 #include "Reflection/LinkerManager.h"
@@ -5,6 +7,9 @@
 #include "Reflection/ObjectRedirector.h"
 #include "Reflection/Class.h"
 #include "System/PackageFileCache.h"
+#include "System/MemoryArchive.h"
+#include "System/ThreadPool.h"
+#include "System/Profiler.h"
 
 /*
 ==================
@@ -115,7 +120,7 @@ void CCompressedPackageReader::PrecacheCompressedChunk( uint32 InChunkIndex )
 	Memory::Free( precacheChunk.buffer );
 	precacheChunk.buffer = ( byte* )Memory::Malloc( chunkToRead.uncompressedSize );
 
-	// Serialize compressed data
+	// Serialize compressed data. Blocks of the chunk are decompressed in parallel by SerializeCompressed
 	fileReader->Seek( chunkToRead.compressedOffset );
 	fileReader->SerializeCompressed( precacheChunk.buffer, chunkToRead.uncompressedSize, compressionFlags );
 }
@@ -222,12 +227,163 @@ uint32 CCompressedPackageReader::GetSize()
 }
 
 
+/*
+==================
+CPreloadedPackageReader::CPreloadedPackageReader
+==================
+*/
+CPreloadedPackageReader::CPreloadedPackageReader( const std::wstring& InPath )
+	: CArchive( InPath )
+	, currentPos( 0 )
+	, bUncompressed( false )
+{
+	SetType( AT_BinaryFile );
+}
+
+/*
+==================
+CPreloadedPackageReader::Preload
+==================
+*/
+bool CPreloadedPackageReader::Preload()
+{
+	// Read whole file into memory
+	CArchive*	fileReader = g_FileSystem->CreateFileReader( arPath );
+	if ( !fileReader )
+	{
+		return false;
+	}
+
+	fileData.resize( fileReader->GetSize() );
+	if ( !fileData.empty() )
+	{
+		fileReader->Serialize( fileData.data(), fileData.size() );
+	}
+	delete fileReader;
+
+	// Check the tag before serializing the package file summary, otherwise we will get an assert on broken files.
+	// CLinkerLoad will report about it
+	if ( fileData.size() < sizeof( uint32 ) || *( uint32* )fileData.data() != PACKAGE_FILE_TAG )
+	{
+		return true;
+	}
+
+	// Read the package file summary to know whether the package is compressed
+	PackageFileSummary		summary;
+	CMemoryReading			summaryReader( fileData, arPath );
+	summaryReader.SetType( AT_BinaryFile );
+	summaryReader << summary;
+	if ( !( summary.GetPackageFlags() & PKG_StoreCompressed ) || summary.compressedChunks.empty() )
+	{
+		return true;
+	}
+
+	// Chunks are independent from each other, so we decompress them in parallel.
+	// Data before the first chunk isn't used after the package file summary has been serialized
+	const CompressedChunk&		lastChunk = summary.compressedChunks.back();
+	uncompressedData.resize( lastChunk.uncompressedOffset + lastChunk.uncompressedSize );
+	CThreadPool::Get().ParallelFor( summary.compressedChunks.size(), [&]( uint32 InIndex )
+									{
+										const CompressedChunk&	chunk = summary.compressedChunks[InIndex];
+										CMemoryReading			chunkReader( fileData, arPath );
+										chunkReader.SetType( AT_BinaryFile );
+										chunkReader.Seek( chunk.compressedOffset );
+										chunkReader.SerializeCompressed( uncompressedData.data() + chunk.uncompressedOffset, chunk.uncompressedSize, ( ECompressionFlags )summary.compressionFlags );
+									} );
+	return true;
+}
+
+/*
+==================
+CPreloadedPackageReader::Serialize
+==================
+*/
+void CPreloadedPackageReader::Serialize( void* InBuffer, uint32 InSize )
+{
+	const std::vector<byte>&	data = bUncompressed ? uncompressedData : fileData;
+	AssertMsg( currentPos + InSize <= data.size(), TEXT( "Seeked past end of file %s (%d/%d)" ), arPath.c_str(), currentPos + InSize, data.size() );
+
+	Memory::Memcpy( InBuffer, data.data() + currentPos, InSize );
+	currentPos += InSize;
+}
+
+/*
+==================
+CPreloadedPackageReader::SetCompressionMap
+==================
+*/
+bool CPreloadedPackageReader::SetCompressionMap( std::vector<CompressedChunk>* InCompressedChunks, ECompressionFlags InCompressionFlags )
+{
+	// If the package wasn't decompressed by Preload then CLinkerLoad has to switch to CCompressedPackageReader
+	if ( uncompressedData.empty() )
+	{
+		return false;
+	}
+
+	// Raw data is no longer needed
+	bUncompressed = true;
+	std::vector<byte>().swap( fileData );
+	return true;
+}
+
+/*
+==================
+CPreloadedPackageReader::Tell
+==================
+*/
+uint32 CPreloadedPackageReader::Tell()
+{
+	return currentPos;
+}
+
+/*
+==================
+CPreloadedPackageReader::Seek
+==================
+*/
+void CPreloadedPackageReader::Seek( uint32 InPosition )
+{
+	Assert( InPosition <= GetSize() );
+	currentPos = InPosition;
+}
+
+/*
+==================
+CPreloadedPackageReader::IsLoading
+==================
+*/
+bool CPreloadedPackageReader::IsLoading() const
+{
+	return true;
+}
+
+/*
+==================
+CPreloadedPackageReader::IsEndOfFile
+==================
+*/
+bool CPreloadedPackageReader::IsEndOfFile()
+{
+	return currentPos >= GetSize();
+}
+
+/*
+==================
+CPreloadedPackageReader::GetSize
+==================
+*/
+uint32 CPreloadedPackageReader::GetSize()
+{
+	return bUncompressed ? uncompressedData.size() : fileData.size();
+}
+
+
 /*
 ==================
 CLinkerLoad::CLinkerLoad
 ==================
 */
-CLinkerLoad::CLinkerLoad( CObjectPackage* InRoot, const tchar* InFilename, uint32 InLoadFlags )
+CLinkerLoad::CLinkerLoad( CObjectPackage* InRoot, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader /* = nullptr */ )
 	: CLinker( InRoot, InFilename )
 	, CArchive( InFilename )
 	, bHasFinishedInitialization( false )
@@ -235,7 +391,7 @@ CLinkerLoad::CLinkerLoad( CObjectPackage* InRoot, const tchar* InFilename, uint3
 	, bHasFoundExistingExports( false )
 	, exportHashIndex( 0 )
 	, loadFlags( InLoadFlags )
-	, loader( nullptr )
+	, loader( InLoader )
 {
 	// We check that ExportHashCount must be power of two
 	static_assert( ( exportHashCount & ( exportHashCount - 1 ) ) == 0, "ExportHashCount must be power of two" );
@@ -267,8 +423,11 @@ CLinkerLoad::~CLinkerLoad()
 CLinkerLoad::GetPackageLinker
 ==================
 */
-CLinkerLoad* CLinkerLoad::GetPackageLinker( CObjectPackage* InOuter, const tchar* InFilename, uint32 InLoadFlags )
+CLinkerLoad* CLinkerLoad::GetPackageLinker( CObjectPackage* InOuter, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader /* = nullptr */ )
 {
+	// We take ownership of the loader, so it must be deleted if a new linker will not be created
+	std::unique_ptr<CArchive>	loaderOwner( InLoader );
+
 	// See if there is already a linker for this package
 	CLinkerLoad*	result = InOuter ? InOuter->GetLinker() : nullptr;
 	if ( result )
@@ -370,7 +529,7 @@ CLinkerLoad* CLinkerLoad::GetPackageLinker( CObjectPackage* InOuter, const tchar
 		Assert( !newFilename.empty() );
 		Assert( tagetPackage );
 		Assert( CObjectPackage::GetObjectSerializeContext().HasStartedLoading() );
-		result = CreateLinker( tagetPackage, newFilename.c_str(), InLoadFlags );
+		result = CreateLinker( tagetPackage, newFilename.c_str(), InLoadFlags, loaderOwner.release() );
 		if ( result )
 		{
 			// Remember linker and file path
@@ -388,20 +547,23 @@ CLinkerLoad* CLinkerLoad::GetPackageLinker( CObjectPackage* InOuter, const tchar
 CLinkerLoad::CreateLinker
 ==================
 */
-CLinkerLoad* CLinkerLoad::CreateLinker( CObjectPackage* InParent, const tchar* InFilename, uint32 InLoadFlags )
+CLinkerLoad* CLinkerLoad::CreateLinker( CObjectPackage* InParent, const tchar* InFilename, uint32 InLoadFlags, CArchive* InLoader /* = nullptr */ )
 {
+	SCOPED_PROFILER( TEXT( "Loading" ), TEXT( "CreateLinker" ) );
+
 	// See whether there already is a linker for this parent/linker root
 	CLinkerLoad*	linker = InParent ? InParent->GetLinker() : nullptr;
 	if ( linker )
 	{
 		Logf( TEXT( "CLinkerLoad::CreateLinker: Found existing linker for '%s'\n" ), InParent->GetName().c_str() );
+		delete InLoader;
 	}
 
 	// Create a new linker if there isn't an existing one
 	if ( !linker )
 	{
 		// If the linker failed on initialize we free allocated memory and return NULL
-		linker = new CLinkerLoad( InParent, InFilename, InLoadFlags );
+		linker = new CLinkerLoad( InParent, InFilename, InLoadFlags, InLoader );
 		if ( !linker->Init() )
 		{
 			// Detach linker and delete it
@@ -615,13 +777,15 @@ bool CLinkerLoad::SerializeNameMap()
 		loader->Precache( summary.nameOffset, summary.totalHeaderSize - summary.nameOffset );
 	}
 
-	// Serialize the name map
+	// Serialize the name map and intern all names in one go
+	std::vector<std::wstring>	nameStrings( summary.nameCount );
 	for ( uint32 nameObjIndex = 0; nameObjIndex < summary.nameCount; ++nameObjIndex )
 	{
 		CName::NameEntry	nameEntry;
 		*this << nameEntry;
-		nameMap[nameObjIndex] = CName( nameEntry.name );
+		nameStrings[nameObjIndex] = std::move( nameEntry.name );
 	}
+	CName::InitNames( nameStrings, nameMap.data() );
 
 	// We done
 	return true;
@@ -916,17 +1080,12 @@ CLinkerLoad::LoadAllObjects
 */
 void CLinkerLoad::LoadAllObjects( bool InIsForcePreload /* = false */ )
 {
+	SCOPED_PROFILER( TEXT( "Loading" ), TEXT( "LoadAllObjects" ) );
+
 	// Load all export objects
 	for ( uint32 exportObjId = 0, exportObjsCount = exportMap.size(); exportObjId < exportObjsCount; ++exportObjId )
 	{
-		CObject*	object = CreateExport( exportObjId );
-		if ( object && ( InIsForcePreload || object->GetClass() == CClass::StaticClass() ) )
-		{
-			if ( object->HasAnyObjectFlags( OBJECT_NeedLoad ) )
-			{
-				Preload( object );
-			}
-		}
+		LoadExport( exportObjId, InIsForcePreload );
 	}
 
 	// Mark package as having been fully loaded
@@ -936,6 +1095,25 @@ void CLinkerLoad::LoadAllObjects( bool InIsForcePreload /* = false */ )
 	}
 }
 
+/*
+==================
+CLinkerLoad::LoadExport
+==================
+*/
+CObject* CLinkerLoad::LoadExport( uint32 InExportIndex, bool InIsForcePreload /* = false */ )
+{
+	CObject*	object = CreateExport( InExportIndex );
+	if ( object && ( InIsForcePreload || object->GetClass() == CClass::StaticClass() ) )
+	{
+		if ( object->HasAnyObjectFlags( OBJECT_NeedLoad ) )
+		{
+			Preload( object );
+		}
+	}
+
+	return object;
+}
+
 /*
 ==================
 CLinkerLoad::CreateObject
@@ -1655,6 +1833,7 @@ CLinkerLoad::Preload
 */
 void CLinkerLoad::Preload( CObject* InObject )
 {
+	SCOPED_PROFILER( TEXT( "Loading" ), TEXT( "Preload" ) );
 	Assert( InObject );
 
 	// Preload the object if necessary
@@ -1893,6 +2072,9 @@ CArchive& CLinkerLoad::operator<<( class CObject*& InValue )
 	*this << index;
 
 	InValue = IndexToObject( index );
+
+	// Loaded objects may reference objects which aren't reached yet by incremental reachability analysis
+	CObjectGC::Get().WriteBarrier( InValue );
 	return *this;
 }
 
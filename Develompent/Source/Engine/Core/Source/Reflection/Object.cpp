@@ -9,6 +9,7 @@
 #include "Reflection/ObjectRedirector.h"
 #include "Reflection/LinkerLoad.h"
 #include "Reflection/LinkerManager.h"
+#include "Reflection/AsyncPackageLoader.h"
 #include "Reflection/Class.h"
 #include "System/Threading.h"
 #include "System/Config.h"
@@ -209,6 +210,16 @@ CObject::AddReferencedObjects
 void CObject::AddReferencedObjects( std::vector<CObject*>& InOutObjectArray )
 {}
 
+/*
+==================
+CObject::CanBeInCluster
+==================
+*/
+bool CObject::CanBeInCluster() const
+{
+	return true;
+}
+
 /*
 ==================
 CObject::PreSaveRoot
@@ -355,6 +366,11 @@ bool CObject::Rename( const tchar* InNewName /* = nullptr */, CObject* InNewOute
 	name = newName;
 	if ( InNewOuter )
 	{
+		// The outer is a reference of the object, so its GC cluster is out of date
+		if ( InNewOuter != oldOuter )
+		{
+			CObjectGC::Get().DissolveObjectCluster( this );
+		}
 		outer = InNewOuter;
 	}
 	HashObject( this );
@@ -681,21 +697,41 @@ void CObject::StaticInit()
 	const CJsonValue*	configMaxObjectsInGame							= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "MaxObjectsInGame" ) );
 	const CJsonValue*	configTimeBetweenPurgingGarbage					= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "TimeBetweenPurgingGarbage" ) );
 	const CJsonValue*	configTimeLimitPerIncrementalPurgeGarbageCall	= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "TimeLimitPerIncrementalPurgeGarbageCall" ) );
+	const CJsonValue*	configMultiThreadedReachabilityAnalysis			= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "MultiThreadedReachabilityAnalysis" ) );
+	const CJsonValue*	configCreateGCClusters							= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "CreateGCClusters" ) );
+	const CJsonValue*	configIncrementalReachabilityAnalysis			= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "IncrementalReachabilityAnalysis" ) );
+	const CJsonValue*	configTimeLimitPerIncrementalMarkCall			= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.GarbageCollectionSettings" ), TEXT( "TimeLimitPerIncrementalMarkCall" ) );
+	const CJsonValue*	configTimeLimitPerProcessAsyncLoadingCall		= CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.AsyncLoadingSettings" ), TEXT( "TimeLimitPerProcessAsyncLoadingCall" ) );
 	
 	const uint32		defaultMaxObjectsNotConsideredByGC				= 0;
 	const uint32		defaultMaxCObjects								= 2 * 1024 * 1024;
 	const float			defaultTimeBetweenPurgingGarbage				= CObjectGC::Get().GetTimeBetweenPurgingGarbage();
 	const float			defaultTimeLimitPerIncrementalPurgeGarbageCall	= CObjectGC::Get().GetTimeLimitPerIncrementalPurgeGarbageCall();
+	const bool			defaultMultiThreadedReachabilityAnalysis		= CObjectGC::Get().IsMultiThreadedReachabilityAnalysis();
+	const bool			defaultCreateGCClusters							= CObjectGC::Get().IsCreateClusters();
+	const bool			defaultIncrementalReachabilityAnalysis			= CObjectGC::Get().IsIncrementalReachabilityAnalysis();
+	const float			defaultTimeLimitPerIncrementalMarkCall			= CObjectGC::Get().GetTimeLimitPerIncrementalMarkCall();
+	const float			defaultTimeLimitPerProcessAsyncLoadingCall		= CAsyncPackageLoader::Get().GetTimeLimitPerProcessAsyncLoadingCall();
 	
 	uint32	maxObjectsNotConsideredByGC									= configMaxObjectsNotConsideredByGC ? configMaxObjectsNotConsideredByGC->GetNumber( defaultMaxObjectsNotConsideredByGC ) : defaultMaxObjectsNotConsideredByGC;
 	uint32	maxCObjects													= configMaxObjectsInGame ? configMaxObjectsInGame->GetNumber( defaultMaxCObjects ) : defaultMaxCObjects;	// Default to ~2M CObjects
 	float	timeBetweenPurgingGarbage									= configTimeBetweenPurgingGarbage ? configTimeBetweenPurgingGarbage->GetNumber( defaultTimeBetweenPurgingGarbage ) : defaultTimeBetweenPurgingGarbage;
 	float	timeLimitPerIncrementalPurgeGarbageCall						= configTimeLimitPerIncrementalPurgeGarbageCall ? configTimeLimitPerIncrementalPurgeGarbageCall->GetNumber( defaultTimeLimitPerIncrementalPurgeGarbageCall ) : defaultTimeLimitPerIncrementalPurgeGarbageCall;
+	bool	bMultiThreadedReachabilityAnalysis							= configMultiThreadedReachabilityAnalysis ? configMultiThreadedReachabilityAnalysis->GetBool( defaultMultiThreadedReachabilityAnalysis ) : defaultMultiThreadedReachabilityAnalysis;
+	bool	bCreateGCClusters											= configCreateGCClusters ? configCreateGCClusters->GetBool( defaultCreateGCClusters ) : defaultCreateGCClusters;
+	bool	bIncrementalReachabilityAnalysis							= configIncrementalReachabilityAnalysis ? configIncrementalReachabilityAnalysis->GetBool( defaultIncrementalReachabilityAnalysis ) : defaultIncrementalReachabilityAnalysis;
+	float	timeLimitPerIncrementalMarkCall								= configTimeLimitPerIncrementalMarkCall ? configTimeLimitPerIncrementalMarkCall->GetNumber( defaultTimeLimitPerIncrementalMarkCall ) : defaultTimeLimitPerIncrementalMarkCall;
+	float	timeLimitPerProcessAsyncLoadingCall							= configTimeLimitPerProcessAsyncLoadingCall ? configTimeLimitPerProcessAsyncLoadingCall->GetNumber( defaultTimeLimitPerProcessAsyncLoadingCall ) : defaultTimeLimitPerProcessAsyncLoadingCall;
 
 	// Log what we're doing to track down what really happens
 	CObjectGC::Get().AllocateObjectPool( maxCObjects, maxObjectsNotConsideredByGC );
 	CObjectGC::Get().SetTimeBetweenPurgingGarbage( timeBetweenPurgingGarbage );
 	CObjectGC::Get().SetTimeLimitPerIncrementalPurgeGarbageCall( timeLimitPerIncrementalPurgeGarbageCall );
+	CObjectGC::Get().SetMultiThreadedReachabilityAnalysis( bMultiThreadedReachabilityAnalysis );
+	CObjectGC::Get().SetCreateClusters( bCreateGCClusters );
+	CObjectGC::Get().SetIncrementalReachabilityAnalysis( bIncrementalReachabilityAnalysis );
+	CObjectGC::Get().SetTimeLimitPerIncrementalMarkCall( timeLimitPerIncrementalMarkCall );
+	CAsyncPackageLoader::Get().SetTimeLimitPerProcessAsyncLoadingCall( timeLimitPerProcessAsyncLoadingCall );
 	Logf( TEXT( "Presizing for max %d objects, including %i objects not considered by GC\n" ), maxCObjects, maxObjectsNotConsideredByGC );
 
 	// If statically linked, initialize registrants
@@ -728,6 +764,7 @@ CObject::StaticExit
 void CObject::StaticExit()
 {
 	Assert( GetCObjectSubsystemInitialised() );
+	CAsyncPackageLoader::Get().FlushAsyncLoading();
 	CObjectGC::Get().CollectGarbage( OBJECT_None );
 
 	GetCObjectSubsystemInitialised() = false;
@@ -1,3 +1,5 @@
+#include <unordered_set>
+
 #include "Logger/LoggerMacros.h"
 #include "System/Config.h"
 #include "Reflection/Object.h"
@@ -5,6 +7,40 @@
 #include "Reflection/ObjectIterator.h"
 #include "Reflection/Class.h"
 #include "Reflection/LinkerManager.h"
+#include "Reflection/LinkerLoad.h"
+#include "Reflection/ObjectPackage.h"
+#include "System/ThreadPool.h"
+#include "System/Profiler.h"
+
+/**
+ * @ingroup Core
+ * @brief Minimum number of objects in the GC range for multi-threaded reachability analysis
+ */
+#define GC_MIN_OBJECTS_FOR_MULTITHREADING		4096
+
+/**
+ * @ingroup Core
+ * @brief Number of objects per one batch in multi-threaded marking objects as unreachable
+ */
+#define GC_MARK_OBJECTS_BATCH_SIZE				2048
+
+/**
+ * @ingroup Core
+ * @brief Minimum number of local objects of a worker before it shares half of them with other workers
+ */
+#define GC_MIN_OBJECTS_TO_SHARE					64
+
+/**
+ * @ingroup Core
+ * @brief Minimum number of objects in a GC cluster, smaller packages aren't clustered
+ */
+#define GC_MIN_CLUSTER_SIZE						2
+
+/**
+ * @ingroup Core
+ * @brief Number of objects processed by incremental reachability analysis between checks of the time limit
+ */
+#define GC_INCREMENTAL_MARK_OBJECTS_PER_TIME_CHECK	32
 
 // End of token stream token
 const GCReferenceInfo		GCReferenceInfo::endOfStreamToken( GCRT_EndOfStream, 0 );
@@ -68,6 +104,10 @@ CObjectGC::CObjectGC()
 	, bDelayedBeginDestroyHasBeenRoutedToAllObjects( false )
 	, bFinishDestroyHasBeenRoutedToAllObjects( false )
 	, bOpenForDisregardForGC( true )
+	, bMultiThreadedReachabilityAnalysis( true )
+	, bCreateClusters( false )
+	, bIncrementalReachabilityAnalysis( false )
+	, bIncrementalMarkPending( 0 )
 	, maxObjectsNotConsideredByGC( 0 )
 	, currentPurgeObjectIndex( 0 )
 	, objectsPendingDestructionCount( 0 )
@@ -75,6 +115,7 @@ CObjectGC::CObjectGC()
 	, lastNonGCIndex( INDEX_NONE )
 	, timeBetweenPurgingGarbage( 60.f )
 	, timeLimitPerIncrementalPurgeGarbageCall( 0.005f )
+	, timeLimitPerIncrementalMarkCall( 0.002f )
 {}
 
 /*
@@ -100,6 +141,8 @@ void CObjectGC::AllocateObjectPool( uint32 InMaxObjects, uint32 InMaxObjectsNotC
 		Sys_Error( TEXT( "Max CObject count is invalid. It must be a number that is greater than 0" ) );
 	}
 	allocatedObjects.reserve( InMaxObjects );
+	classIndexEntries.reserve( InMaxObjects );
+	objectClusterIndices.reserve( InMaxObjects );
 
 	// Preallocate memory for objects which disregard for GC
 	if ( maxObjectsNotConsideredByGC > 0 )
@@ -219,6 +262,19 @@ void CObjectGC::AddObject( CObject* InObject )
 	// Add the object to the global table
 	allocatedObjects[index] = InObject;
 	InObject->index = index;
+	if ( objectClusterIndices.size() < allocatedObjects.size() )
+	{
+		objectClusterIndices.resize( allocatedObjects.size(), INDEX_NONE );
+	}
+
+	// Objects created while incremental reachability analysis is in progress are reachable, but their references
+	// set on construction must be traversed as well
+	if ( bIncrementalMarkPending )
+	{
+		CScopeLock		scopeLock( writeBarrierMutex );
+		writeBarrierObjects.push_back( index );
+	}
+	AddToClassIndex( InObject, InObject->GetClass() );
 }
 
 /*
@@ -246,10 +302,376 @@ void CObjectGC::RemoveObject( CObject* InObject )
 		Sys_Error( TEXT( "Removing object (0x%016llx) at index %d but the index points to a different object (0x%016llx)!" ), ( ptrint )InObject, InObject->index, ( ptrint )allocatedObjects[InObject->index] );
 	}
 
+	RemoveFromClassIndex( InObject );
+
+	// Objects of a cluster are killed together, so the first removed one dissolves the cluster
+	if ( objectClusterIndices[InObject->index] != INDEX_NONE )
+	{
+		DissolveCluster( objectClusterIndices[InObject->index] );
+	}
+
+	// Clusters mustn't keep a pointer to the removed object
+	if ( !clusterReferencers.empty() )
+	{
+		auto	itReferencers = clusterReferencers.find( InObject );
+		if ( itReferencers != clusterReferencers.end() )
+		{
+			std::vector<uint32>		referencers = itReferencers->second;
+			for ( uint32 index = 0, count = referencers.size(); index < count; ++index )
+			{
+				DissolveCluster( referencers[index] );
+			}
+		}
+	}
+
+	// If the object is a class, drop the list of its instances. Usually it's already empty
+	auto	itClass = classInstances.find( ( CClass* )InObject );
+	if ( itClass != classInstances.end() )
+	{
+		std::vector<CObject*>&		instances = itClass->second;
+		for ( uint32 index = 0, count = instances.size(); index < count; ++index )
+		{
+			classIndexEntries[instances[index]->index] = ClassIndexEntry{ nullptr, INDEX_NONE };
+		}
+		classInstances.erase( itClass );
+	}
+
 	allocatedObjects[InObject->index] = nullptr;
 	InObject->index = INDEX_NONE;
 }
 
+/*
+==================
+CObjectGC::AddToClassIndex
+==================
+*/
+void CObjectGC::AddToClassIndex( CObject* InObject, CClass* InClass )
+{
+	if ( classIndexEntries.size() < allocatedObjects.size() )
+	{
+		classIndexEntries.resize( allocatedObjects.size(), ClassIndexEntry{ nullptr, INDEX_NONE } );
+	}
+
+	// Native objects may be added before they get a class, they are indexed in SetObjectClass
+	ClassIndexEntry&	entry = classIndexEntries[InObject->index];
+	Assert( !entry.theClass );
+	if ( !InClass )
+	{
+		return;
+	}
+
+	std::vector<CObject*>&		instances = classInstances[InClass];
+	entry.theClass	= InClass;
+	entry.position	= instances.size();
+	instances.push_back( InObject );
+}
+
+/*
+==================
+CObjectGC::RemoveFromClassIndex
+==================
+*/
+void CObjectGC::RemoveFromClassIndex( CObject* InObject )
+{
+	ClassIndexEntry&	entry = classIndexEntries[InObject->index];
+	if ( entry.theClass )
+	{
+		// Move the last instance into place of the removed one
+		std::vector<CObject*>&		instances = classInstances[entry.theClass];
+		Assert( entry.position < instances.size() && instances[entry.position] == InObject );
+		CObject*	lastObject = instances.back();
+		instances[entry.position] = lastObject;
+		classIndexEntries[lastObject->index].position = entry.position;
+		instances.pop_back();
+
+		entry.theClass	= nullptr;
+		entry.position	= INDEX_NONE;
+	}
+}
+
+/*
+==================
+CObjectGC::SetObjectClass
+==================
+*/
+void CObjectGC::SetObjectClass( CObject* InObject, CClass* InNewClass )
+{
+	if ( classIndexEntries[InObject->index].theClass != InNewClass )
+	{
+		// The class is a reference of the object, so its cluster is out of date
+		DissolveObjectCluster( InObject );
+		RemoveFromClassIndex( InObject );
+		AddToClassIndex( InObject, InNewClass );
+	}
+}
+
+/*
+==================
+CObjectGC::GetClassInstanceLists
+==================
+*/
+void CObjectGC::GetClassInstanceLists( CClass* InClass, std::vector<const std::vector<CObject*>*>& OutLists ) const
+{
+	Assert( InClass );
+	for ( auto it = classInstances.begin(), itEnd = classInstances.end(); it != itEnd; ++it )
+	{
+		if ( !it->second.empty() && it->first->IsChildOf( InClass ) )
+		{
+			OutLists.push_back( &it->second );
+		}
+	}
+}
+
+/*
+==================
+CObjectGC::CreateCluster
+==================
+*/
+void CObjectGC::CreateCluster( CObjectPackage* InPackage )
+{
+	Assert( IsInGameThread() && InPackage );
+	if ( !bCreateClusters || g_IsEditor || g_IsCooker || !InPackage->HasAnyPackageFlags( PKG_Cooked ) )
+	{
+		return;
+	}
+
+	CLinkerLoad*	linker = InPackage->GetLinker();
+	if ( !linker )
+	{
+		return;
+	}
+
+	// Gather objects of the package. Objects which are already in a cluster or never collected are skipped,
+	// as well as objects which change their references at runtime and their subobjects
+	auto			IsClusterable = [&]( CObject* InObject ) -> bool
+	{
+		if ( InObject->IsDisregardedForGC() || InObject->HasAnyObjectFlags( OBJECT_Unreachable | OBJECT_PendingKill ) || objectClusterIndices[InObject->index] != INDEX_NONE )
+		{
+			return false;
+		}
+
+		for ( CObject* object = InObject; object && object != InPackage; object = object->GetOuter() )
+		{
+			if ( !object->CanBeInCluster() )
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	std::vector<CObject*>				objects;
+	const std::vector<ObjectExport>&	exportMap = linker->GetExports();
+	if ( IsClusterable( InPackage ) )
+	{
+		objects.push_back( InPackage );
+	}
+
+	for ( uint32 index = 0, count = exportMap.size(); index < count; ++index )
+	{
+		CObject*	object = exportMap[index].object;
+		if ( !object || !IsClusterable( object ) )
+		{
+			continue;
+		}
+
+		// The package is still loading (e.g. it's loaded recursively from another one), so references aren't final yet
+		if ( object->HasAnyObjectFlags( OBJECT_NeedLoad | OBJECT_NeedPostLoad ) )
+		{
+			return;
+		}
+		objects.push_back( object );
+	}
+
+	if ( objects.size() < GC_MIN_CLUSTER_SIZE )
+	{
+		return;
+	}
+
+	// Take a free cluster slot
+	uint32		clusterIndex = INDEX_NONE;
+	if ( !freeClusterIndices.empty() )
+	{
+		clusterIndex = freeClusterIndices.back();
+		freeClusterIndices.pop_back();
+	}
+	else
+	{
+		clusterIndex = clusters.size();
+		clusters.push_back( GCCluster() );
+	}
+
+	GCCluster&	cluster = clusters[clusterIndex];
+	for ( uint32 index = 0, count = objects.size(); index < count; ++index )
+	{
+		objectClusterIndices[objects[index]->index] = clusterIndex;
+	}
+	cluster.objects = std::move( objects );
+
+	// Gather references to objects outside of the cluster once, the mark phase uses them instead of token streams of the objects
+	std::unordered_set<CObject*>	referencedObjects;
+	std::vector<StackEntry>			stack;
+	stack.resize( 128 );
+	for ( uint32 index = 0, count = cluster.objects.size(); index < count; ++index )
+	{
+		CObject*	object = cluster.objects[index];
+		CClass*		theClass = object->GetClass();
+		if ( !theClass->IsAssembledReferenceTokenStream() )
+		{
+			theClass->AssembleReferenceTokenStream();
+		}
+
+		ProcessTokenStreamReferences( object, stack, [&]( CObject*& InOutObject, bool InIsAllowReferenceElimination )
+									  {
+										  if ( InOutObject && !InOutObject->IsDisregardedForGC() && objectClusterIndices[InOutObject->index] != clusterIndex )
+										  {
+											  referencedObjects.insert( InOutObject );
+										  }
+									  } );
+	}
+
+	cluster.referencedObjects.assign( referencedObjects.begin(), referencedObjects.end() );
+	for ( uint32 index = 0, count = cluster.referencedObjects.size(); index < count; ++index )
+	{
+		clusterReferencers[cluster.referencedObjects[index]].push_back( clusterIndex );
+	}
+}
+
+/*
+==================
+CObjectGC::DissolveObjectCluster
+==================
+*/
+void CObjectGC::DissolveObjectCluster( CObject* InObject )
+{
+	Assert( IsInGameThread() );
+	if ( InObject->index != INDEX_NONE && objectClusterIndices[InObject->index] != INDEX_NONE )
+	{
+		DissolveCluster( objectClusterIndices[InObject->index] );
+	}
+}
+
+/*
+==================
+CObjectGC::WriteBarrier
+==================
+*/
+void CObjectGC::WriteBarrier( CObject* InOwner, CObject* InObject )
+{
+	// Objects under construction on other threads are never clustered, so only clustered owners require the game thread
+	Assert( InOwner );
+	if ( InOwner->index != INDEX_NONE && objectClusterIndices[InOwner->index] != INDEX_NONE )
+	{
+		DissolveObjectCluster( InOwner );
+	}
+	WriteBarrier( InObject );
+}
+
+/*
+==================
+CObjectGC::DissolveCluster
+==================
+*/
+void CObjectGC::DissolveCluster( uint32 InClusterIndex )
+{
+	GCCluster&	cluster = clusters[InClusterIndex];
+	Assert( !cluster.objects.empty() );
+
+	// Objects are processed one by one from now on
+	for ( uint32 index = 0, count = cluster.objects.size(); index < count; ++index )
+	{
+		objectClusterIndices[cluster.objects[index]->index] = INDEX_NONE;
+	}
+
+	for ( uint32 index = 0, count = cluster.referencedObjects.size(); index < count; ++index )
+	{
+		auto	itReferencers = clusterReferencers.find( cluster.referencedObjects[index] );
+		Assert( itReferencers != clusterReferencers.end() );
+
+		std::vector<uint32>&	referencers = itReferencers->second;
+		for ( uint32 referencerIndex = 0, numReferencers = referencers.size(); referencerIndex < numReferencers; ++referencerIndex )
+		{
+			if ( referencers[referencerIndex] == InClusterIndex )
+			{
+				referencers[referencerIndex] = referencers.back();
+				referencers.pop_back();
+				break;
+			}
+		}
+
+		if ( referencers.empty() )
+		{
+			clusterReferencers.erase( itReferencers );
+		}
+	}
+
+	std::vector<CObject*>().swap( cluster.objects );
+	std::vector<CObject*>().swap( cluster.referencedObjects );
+	cluster.bMarked			= 0;
+	cluster.bNeedsDissolve	= 0;
+	freeClusterIndices.push_back( InClusterIndex );
+}
+
+/*
+==================
+CObjectGC::PrepareClusters
+==================
+*/
+void CObjectGC::PrepareClusters()
+{
+	for ( uint32 clusterIndex = 0, numClusters = clusters.size(); clusterIndex < numClusters; ++clusterIndex )
+	{
+		GCCluster&	cluster = clusters[clusterIndex];
+		if ( cluster.objects.empty() )
+		{
+			continue;
+		}
+
+		// References to pending kill objects must be eliminated, only the token stream traversal of each object can do it
+		bool	bDissolve = cluster.bNeedsDissolve != 0;
+		for ( uint32 index = 0, count = cluster.referencedObjects.size(); index < count && !bDissolve; ++index )
+		{
+			bDissolve = cluster.referencedObjects[index]->IsPendingKill();
+		}
+
+		if ( bDissolve )
+		{
+			DissolveCluster( clusterIndex );
+			continue;
+		}
+
+		cluster.bMarked = 0;
+		++lastStats.numClusters;
+		lastStats.numClusteredObjects += cluster.objects.size();
+	}
+}
+
+/*
+==================
+CObjectGC::MarkClusterReachable
+==================
+*/
+void CObjectGC::MarkClusterReachable( GCCluster& InCluster, std::vector<CObject*>& InOutNewReachableObjects )
+{
+	for ( uint32 index = 0, count = InCluster.objects.size(); index < count; ++index )
+	{
+		CObject*	object = InCluster.objects[index];
+		if ( object->HasAnyObjectFlags( OBJECT_MASK_NotReached ) )
+		{
+			object->ThreadSafeRemoveObjectFlag( OBJECT_MASK_NotReached );
+		}
+
+		// Native references aren't covered by the token stream, so they are gathered on each garbage collection
+		object->AddReferencedObjects( InOutNewReachableObjects );
+	}
+
+	for ( uint32 index = 0, count = InCluster.referencedObjects.size(); index < count; ++index )
+	{
+		CObject*	object = InCluster.referencedObjects[index];
+		HandleObjectReference( InOutNewReachableObjects, object, false );
+	}
+}
+
 /*
 ==================
 CObjectGC::CollectGarbage
@@ -257,22 +679,81 @@ CObjectGC::CollectGarbage
 */
 void CObjectGC::CollectGarbage( ObjectFlags_t InKeepFlags, bool InIsPerformFullPurge /* = true */ )
 {
+	SCOPED_PROFILER( TEXT( "GC" ), TEXT( "CollectGarbage" ) );
 	bIsGarbageCollecting = true;
 	Logf( TEXT( "Collecting garbage\n" ) );
 
-	// Make sure previous incremental purge has finished
-	if ( bPurgeIsRequired )
+	// Incremental reachability analysis in progress is finished without time limit
+	if ( bIncrementalMarkPending )
 	{
-		IncrementalPurgeGarbage( false );
+		IncrementalMarkStep( false, 0.f );
 	}
-
-	// Do perform reachability analysis
+	else
 	{
+		// Make sure previous incremental purge has finished
+		if ( bPurgeIsRequired )
+		{
+			IncrementalPurgeGarbage( false );
+		}
+
+		// Do perform reachability analysis
 		const double	startTime = Sys_Seconds();
 		PerformReachabilityAnalysis( InKeepFlags );
-		Logf( TEXT( "%f ms for realtime GC\n" ), ( Sys_Seconds() - startTime ) * 1000.f );
+		Logf( TEXT( "%f ms for realtime GC (mark %f ms, traverse %f ms, %i reachable objects, %i threads, %i clusters with %i objects)\n" ), ( Sys_Seconds() - startTime ) * 1000.f, lastStats.markUnreachableTime, lastStats.traverseReferencesTime, lastStats.numReachableObjects, lastStats.numThreads, lastStats.numClusters, lastStats.numClusteredObjects );
+	}
+
+	BeginDestroyUnreachableObjects( InIsPerformFullPurge );
+
+	// We're done collecting garbage. Note that IncrementalPurgeGarbage above might already clear it internally
+	bIsGarbageCollecting = false;
+}
+
+/*
+==================
+CObjectGC::IncrementalCollectGarbage
+==================
+*/
+bool CObjectGC::IncrementalCollectGarbage( ObjectFlags_t InKeepFlags, float InTimeLimit /* = 0.f */ )
+{
+	SCOPED_PROFILER( TEXT( "GC" ), TEXT( "IncrementalCollectGarbage" ) );
+	Assert( IsInGameThread() );
+
+	// Set to default time limit if InTimeLimit is less or equal to zero
+	if ( InTimeLimit <= 0.f )
+	{
+		InTimeLimit = timeLimitPerIncrementalMarkCall;
+	}
+
+	// Start a new reachability analysis. Objects of the previous one must be purged before it, because they use OBJECT_Unreachable
+	bIsGarbageCollecting = true;
+	if ( !bIncrementalMarkPending )
+	{
+		Logf( TEXT( "Collecting garbage incrementally\n" ) );
+		if ( bPurgeIsRequired )
+		{
+			IncrementalPurgeGarbage( false );
+		}
+		StartIncrementalMark( InKeepFlags );
 	}
 
+	// Traverse references within the time limit. When it's done unreachable objects are destroyed as usual
+	const bool	bFinished = IncrementalMarkStep( true, InTimeLimit );
+	if ( bFinished )
+	{
+		BeginDestroyUnreachableObjects( false );
+	}
+
+	bIsGarbageCollecting = false;
+	return bFinished;
+}
+
+/*
+==================
+CObjectGC::BeginDestroyUnreachableObjects
+==================
+*/
+void CObjectGC::BeginDestroyUnreachableObjects( bool InIsPerformFullPurge )
+{
 	// Call BeginDestroy in all objects with OBJECT_Unreachable flag
 	{
 		const double	startTime = Sys_Seconds();
@@ -291,7 +772,9 @@ void CObjectGC::CollectGarbage( ObjectFlags_t InKeepFlags, bool InIsPerformFullP
 			}
 		}
 
-		Logf( TEXT( "%f ms for unhashing unreachable objects\n" ), ( Sys_Seconds() - startTime ) * 1000.f );
+		lastStats.beginDestroyTime		= ( Sys_Seconds() - startTime ) * 1000.0;
+		lastStats.numUnreachableObjects = unreachableObjectsIndices.size();
+		Logf( TEXT( "%f ms for unhashing unreachable objects\n" ), lastStats.beginDestroyTime );
 	}
 
 	// Set flag to indicate that we are relying on a purge to be performed
@@ -305,9 +788,6 @@ void CObjectGC::CollectGarbage( ObjectFlags_t InKeepFlags, bool InIsPerformFullP
 
 	// Destroy all pending delete object loaders
 	CLinkerManager::Get().DeleteLoaders();
-
-	// We're done collecting garbage. Note that IncrementalPurgeGarbage above might already clear it internally
-	bIsGarbageCollecting = false;
 }
 
 /*
@@ -317,6 +797,8 @@ CObjectGC::IncrementalPurgeGarbage
 */
 void CObjectGC::IncrementalPurgeGarbage( bool InIsUseTimeLimit, float InTimeLimit /* = 0.f */ )
 {
+	SCOPED_PROFILER( TEXT( "GC" ), TEXT( "IncrementalPurgeGarbage" ) );
+
 	// Early out if there is nothing to do
 	if ( !bPurgeIsRequired )
 	{
@@ -510,12 +992,165 @@ CObjectGC::PerformReachabilityAnalysis
 */
 void CObjectGC::PerformReachabilityAnalysis( ObjectFlags_t InKeepFlags )
 {
+	SCOPED_PROFILER( TEXT( "GC" ), TEXT( "PerformReachabilityAnalysis" ) );
+
+	// Split the work across worker threads only when it's allowed and there are enough objects to pay off the synchronization
+	const uint32	numGCObjects		= allocatedObjects.size() - firstGCIndex;
+	const bool		bMultiThreaded		= bMultiThreadedReachabilityAnalysis && CThreadPool::Get().GetNumThreads() > 0 && numGCObjects >= GC_MIN_OBJECTS_FOR_MULTITHREADING;
+	lastStats							= Stats();
+	lastStats.bMultiThreaded			= bMultiThreaded;
+	lastStats.numThreads				= bMultiThreaded ? CThreadPool::Get().GetNumThreads() + 1 : 1;
+
 	// Presize array and add a bit of extra stack for prefetching
 	std::vector<CObject*>	reachableObjects;
-	reachableObjects.reserve( allocatedObjects.size() - firstGCIndex + 2 );
+	reachableObjects.reserve( numGCObjects + 2 );
+
+	double		startTime = Sys_Seconds();
+	MarkObjectsUnreachable( reachableObjects, InKeepFlags, bMultiThreaded );
+	PrepareClusters();
+	lastStats.markUnreachableTime = ( Sys_Seconds() - startTime ) * 1000.0;
 
-	MarkObjectsUnreachable( reachableObjects, InKeepFlags );
-	TraverseObjectReferences( reachableObjects );
+	startTime = Sys_Seconds();
+	if ( bMultiThreaded )
+	{
+		lastStats.numReachableObjects = TraverseObjectReferencesMultiThreaded( reachableObjects );
+	}
+	else
+	{
+		TraverseObjectReferences( reachableObjects );
+		lastStats.numReachableObjects = reachableObjects.size();
+	}
+	lastStats.traverseReferencesTime = ( Sys_Seconds() - startTime ) * 1000.0;
+}
+
+/*
+==================
+CObjectGC::StartIncrementalMark
+==================
+*/
+void CObjectGC::StartIncrementalMark( ObjectFlags_t InKeepFlags )
+{
+	Assert( !bIncrementalMarkPending && !bPurgeIsRequired );
+	const uint32	numGCObjects	= allocatedObjects.size() - firstGCIndex;
+	const bool		bMultiThreaded	= bMultiThreadedReachabilityAnalysis && CThreadPool::Get().GetNumThreads() > 0 && numGCObjects >= GC_MIN_OBJECTS_FOR_MULTITHREADING;
+	lastStats						= Stats();
+	lastStats.bIncremental			= true;
+
+	// Marking of all objects is done at once, so objects created after it are never marked as not reached
+	std::vector<CObject*>	reachableObjects;
+	const double			startTime = Sys_Seconds();
+	MarkObjectsUnreachable( reachableObjects, InKeepFlags, bMultiThreaded, OBJECT_PendingMark );
+	PrepareClusters();
+
+	incrementalMarkObjects.clear();
+	incrementalMarkObjects.reserve( numGCObjects );
+	for ( uint32 index = 0, count = reachableObjects.size(); index < count; ++index )
+	{
+		incrementalMarkObjects.push_back( reachableObjects[index]->index );
+	}
+
+	if ( incrementalMarkStack.empty() )
+	{
+		incrementalMarkStack.resize( 128 );
+	}
+
+	Sys_InterlockedExchange( &bIncrementalMarkPending, 1 );
+	lastStats.markUnreachableTime = ( Sys_Seconds() - startTime ) * 1000.0;
+}
+
+/*
+==================
+CObjectGC::IncrementalMarkStep
+==================
+*/
+bool CObjectGC::IncrementalMarkStep( bool InIsUseTimeLimit, float InTimeLimit )
+{
+	SCOPED_PROFILER( TEXT( "GC" ), TEXT( "IncrementalMarkStep" ) );
+	Assert( bIncrementalMarkPending );
+
+	const double	startTime = Sys_Seconds();
+	uint32			numProcessedObjects = 0;
+	++lastStats.numIncrementalSteps;
+	while ( true )
+	{
+		// Take objects reached by the write barrier when we're out of work
+		if ( incrementalMarkObjects.empty() )
+		{
+			CScopeLock		scopeLock( writeBarrierMutex );
+			if ( writeBarrierObjects.empty() )
+			{
+				// Nothing left. The write barrier is turned off under the lock, so it doesn't queue objects anymore
+				Sys_InterlockedExchange( &bIncrementalMarkPending, 0 );
+				break;
+			}
+			incrementalMarkObjects.swap( writeBarrierObjects );
+		}
+
+		// Objects are kept by index, so one destroyed while the analysis is in progress is just skipped
+		const uint32	objectIndex = incrementalMarkObjects.back();
+		incrementalMarkObjects.pop_back();
+		CObject*		object = allocatedObjects[objectIndex];
+		if ( !object )
+		{
+			continue;
+		}
+
+		ProcessObjectForReferences( object, incrementalNewObjects, incrementalMarkStack );
+		for ( uint32 index = 0, count = incrementalNewObjects.size(); index < count; ++index )
+		{
+			incrementalMarkObjects.push_back( incrementalNewObjects[index]->index );
+		}
+		incrementalNewObjects.clear();
+		++lastStats.numReachableObjects;
+
+		// Check time limit every so often to avoid calling Sys_Seconds too often
+		if ( InIsUseTimeLimit && ( ++numProcessedObjects % GC_INCREMENTAL_MARK_OBJECTS_PER_TIME_CHECK ) == 0 && IsTimeLimitExceeded( startTime, InTimeLimit ) )
+		{
+			lastStats.traverseReferencesTime += ( Sys_Seconds() - startTime ) * 1000.0;
+			return false;
+		}
+	}
+
+	lastStats.traverseReferencesTime += ( Sys_Seconds() - startTime ) * 1000.0;
+	FinishIncrementalMark();
+	return true;
+}
+
+/*
+==================
+CObjectGC::FinishIncrementalMark
+==================
+*/
+void CObjectGC::FinishIncrementalMark()
+{
+	// Objects which haven't been reached are unreachable now
+	const uint32	numObjects = allocatedObjects.size();
+	for ( uint32 objectIndex = firstGCIndex; objectIndex < numObjects; ++objectIndex )
+	{
+		CObject*	object = allocatedObjects[objectIndex];
+		if ( object && object->HasAnyObjectFlags( OBJECT_PendingMark ) )
+		{
+			object->RemoveObjectFlag( OBJECT_PendingMark );
+			object->AddObjectFlag( OBJECT_Unreachable );
+		}
+	}
+
+	Logf( TEXT( "Incremental GC is finished in %i steps (mark %f ms, traverse %f ms, %i reachable objects, %i clusters with %i objects)\n" ), lastStats.numIncrementalSteps, lastStats.markUnreachableTime, lastStats.traverseReferencesTime, lastStats.numReachableObjects, lastStats.numClusters, lastStats.numClusteredObjects );
+}
+
+/*
+==================
+CObjectGC::MarkObjectByWriteBarrier
+==================
+*/
+void CObjectGC::MarkObjectByWriteBarrier( CObject* InObject )
+{
+	// Only one thread removes the flag, so the object is queued once
+	if ( InObject->HasAnyObjectFlags( OBJECT_PendingMark ) && InObject->ThreadSafeRemoveObjectFlag( OBJECT_PendingMark ) )
+	{
+		CScopeLock		scopeLock( writeBarrierMutex );
+		writeBarrierObjects.push_back( InObject->index );
+	}
 }
 
 /*
@@ -523,13 +1158,57 @@ void CObjectGC::PerformReachabilityAnalysis( ObjectFlags_t InKeepFlags )
 CObjectGC::MarkObjectsUnreachable
 ==================
 */
-void CObjectGC::MarkObjectsUnreachable( std::vector<class CObject*>& InOutReachableObjects, ObjectFlags_t InKeepFlags )
+void CObjectGC::MarkObjectsUnreachable( std::vector<class CObject*>& InOutReachableObjects, ObjectFlags_t InKeepFlags, bool InIsMultiThreaded, ObjectFlags_t InUnreachableFlag /* = OBJECT_Unreachable */ )
+{
+	std::vector<CClass*>		classes;
+	const uint32				numObjects = allocatedObjects.size();
+	if ( !InIsMultiThreaded )
+	{
+		MarkObjectsUnreachableInRange( firstGCIndex, numObjects, InOutReachableObjects, classes, InKeepFlags, InUnreachableFlag );
+	}
+	else
+	{
+		// Each batch collects own reachable objects and classes, so we don't need any synchronization here
+		const uint32							numBatches = ( numObjects - firstGCIndex + GC_MARK_OBJECTS_BATCH_SIZE - 1 ) / GC_MARK_OBJECTS_BATCH_SIZE;
+		std::vector<std::vector<CObject*>>		batchReachableObjects( numBatches );
+		std::vector<std::vector<CClass*>>		batchClasses( numBatches );
+		CThreadPool::Get().ParallelFor( numBatches, [&]( uint32 InBatchIndex )
+										{
+											const uint32	startIndex = firstGCIndex + InBatchIndex * GC_MARK_OBJECTS_BATCH_SIZE;
+											MarkObjectsUnreachableInRange( startIndex, Min<uint32>( startIndex + GC_MARK_OBJECTS_BATCH_SIZE, numObjects ), batchReachableObjects[InBatchIndex], batchClasses[InBatchIndex], InKeepFlags, InUnreachableFlag );
+										} );
+
+		for ( uint32 batchIndex = 0; batchIndex < numBatches; ++batchIndex )
+		{
+			InOutReachableObjects.insert( InOutReachableObjects.end(), batchReachableObjects[batchIndex].begin(), batchReachableObjects[batchIndex].end() );
+			classes.insert( classes.end(), batchClasses[batchIndex].begin(), batchClasses[batchIndex].end() );
+		}
+	}
+
+	// Assemble token stream for CClass objects. This is only done once for each class.
+	// We do it here on the calling thread because token streams of parent classes may be assembled recursively
+	for ( uint32 index = 0, count = classes.size(); index < count; ++index )
+	{
+		CClass*		theClass = classes[index];
+		if ( !theClass->IsAssembledReferenceTokenStream() )
+		{
+			theClass->AssembleReferenceTokenStream();
+		}
+	}
+}
+
+/*
+==================
+CObjectGC::MarkObjectsUnreachableInRange
+==================
+*/
+void CObjectGC::MarkObjectsUnreachableInRange( uint32 InStartIndex, uint32 InEndIndex, std::vector<class CObject*>& InOutReachableObjects, std::vector<class CClass*>& InOutClasses, ObjectFlags_t InKeepFlags, ObjectFlags_t InUnreachableFlag )
 {
 	// The CClass class
 	const CClass*	CClassClass = CClass::StaticClass();
 
 	// Iterate over all objects
-	for ( uint32 objectIndex = firstGCIndex, numObjects = allocatedObjects.size(); objectIndex < numObjects; ++objectIndex )
+	for ( uint32 objectIndex = InStartIndex; objectIndex < InEndIndex; ++objectIndex )
 	{
 		CObject*	object = allocatedObjects[objectIndex];
 
@@ -558,11 +1237,18 @@ void CObjectGC::MarkObjectsUnreachable( std::vector<class CObject*>& InOutReacha
 			}
 			else
 			{
-				object->AddObjectFlag( OBJECT_Unreachable );
+				object->AddObjectFlag( InUnreachableFlag );
 			}
 		}
 
-		// Assemble token stream for CClass objects. This is only done once for each class
+		// A pending kill object can't be kept by its cluster, references to it are eliminated only by traversing objects one by one
+		const uint32	clusterIndex = objectClusterIndices[objectIndex];
+		if ( clusterIndex != INDEX_NONE && object->IsPendingKill() )
+		{
+			Sys_InterlockedExchange( &clusters[clusterIndex].bNeedsDissolve, 1 );
+		}
+
+		// Collect CClass objects which need to assemble token stream
 		if ( object->GetClass() == CClassClass )
 		{
 			CClass*		theClass = Cast<CClass>( object );
@@ -570,7 +1256,7 @@ void CObjectGC::MarkObjectsUnreachable( std::vector<class CObject*>& InOutReacha
 
 			if ( !theClass->IsAssembledReferenceTokenStream() )
 			{
-				theClass->AssembleReferenceTokenStream();
+				InOutClasses.push_back( theClass );
 			}
 		}
 	}
@@ -595,6 +1281,139 @@ void CObjectGC::TraverseObjectReferences( std::vector<class CObject*>& InOutReac
 	}
 }
 
+/*
+==================
+CObjectGC::TraverseObjectReferencesMultiThreaded
+==================
+*/
+uint32 CObjectGC::TraverseObjectReferencesMultiThreaded( const std::vector<class CObject*>& InRootObjects )
+{
+	// One context per worker thread and one for the calling thread
+	const uint32					numContexts = CThreadPool::Get().GetNumThreads() + 1;
+	ReachabilityWorkerContext*		contexts = new ReachabilityWorkerContext[numContexts];
+
+	// Distribute root objects between shared arrays of all contexts, so any worker can take them
+	for ( uint32 index = 0, count = InRootObjects.size(); index < count; ++index )
+	{
+		contexts[index % numContexts].sharedObjects.push_back( InRootObjects[index] );
+	}
+
+	for ( uint32 index = 0; index < numContexts; ++index )
+	{
+		contexts[index].numSharedObjects = contexts[index].sharedObjects.size();
+	}
+
+	// Each worker runs until all reachable objects are processed
+	volatile int32		numPendingObjects = InRootObjects.size();
+	CThreadPool::Get().ParallelFor( numContexts, [&]( uint32 InContextIndex )
+									{
+										ReachabilityWorker( contexts, numContexts, InContextIndex, &numPendingObjects );
+									} );
+	Assert( numPendingObjects == 0 );
+
+	uint32		numReachableObjects = 0;
+	for ( uint32 index = 0; index < numContexts; ++index )
+	{
+		numReachableObjects += contexts[index].numProcessedObjects;
+	}
+
+	delete[] contexts;
+	return numReachableObjects;
+}
+
+/*
+==================
+CObjectGC::ReachabilityWorker
+==================
+*/
+void CObjectGC::ReachabilityWorker( ReachabilityWorkerContext* InContexts, uint32 InNumContexts, uint32 InContextIndex, volatile int32* InOutNumPendingObjects )
+{
+	ReachabilityWorkerContext&		context = InContexts[InContextIndex];
+	std::vector<CObject*>&			localObjects = context.localObjects;
+	context.stack.resize( 128 );
+
+	while ( true )
+	{
+		// If we are out of work then take back own shared objects at first and after that try to steal from other workers
+		if ( localObjects.empty() )
+		{
+			bool	bHasWork = false;
+			for ( uint32 index = 0; index < InNumContexts && !bHasWork; ++index )
+			{
+				bHasWork = StealObjects( InContexts[( InContextIndex + index ) % InNumContexts], index == 0, localObjects );
+			}
+
+			if ( !bHasWork )
+			{
+				// Nothing to steal. We are done only when nobody is still processing objects, because it can share new ones
+				if ( *InOutNumPendingObjects == 0 )
+				{
+					break;
+				}
+
+				Sys_Yield();
+				continue;
+			}
+		}
+
+		// Process the object. HandleObjectReference atomically clears OBJECT_Unreachable, so each object is added only by one worker
+		CObject*	object = localObjects.back();
+		localObjects.pop_back();
+
+		context.newObjects.clear();
+		ProcessObjectForReferences( object, context.newObjects, context.stack );
+		++context.numProcessedObjects;
+
+		// Update the number of pending objects: this one is processed, the new ones are added
+		const int32		numNewObjects = context.newObjects.size();
+		if ( numNewObjects != 1 )
+		{
+			Sys_InterlockedAdd( InOutNumPendingObjects, numNewObjects - 1 );
+		}
+		localObjects.insert( localObjects.end(), context.newObjects.begin(), context.newObjects.end() );
+
+		// Share the oldest half of our work when the previous shared portion has been taken
+		if ( localObjects.size() >= GC_MIN_OBJECTS_TO_SHARE && context.numSharedObjects == 0 )
+		{
+			const uint32	numObjectsToShare = localObjects.size() / 2;
+			{
+				CScopeLock		scopeLock( context.sharedObjectsMutex );
+				context.sharedObjects.insert( context.sharedObjects.end(), localObjects.begin(), localObjects.begin() + numObjectsToShare );
+				Sys_InterlockedExchange( &context.numSharedObjects, context.sharedObjects.size() );
+			}
+			localObjects.erase( localObjects.begin(), localObjects.begin() + numObjectsToShare );
+		}
+	}
+}
+
+/*
+==================
+CObjectGC::StealObjects
+==================
+*/
+bool CObjectGC::StealObjects( ReachabilityWorkerContext& InVictim, bool InIsOwner, std::vector<class CObject*>& OutObjects )
+{
+	// Quick check without locking
+	if ( InVictim.numSharedObjects == 0 )
+	{
+		return false;
+	}
+
+	CScopeLock		scopeLock( InVictim.sharedObjectsMutex );
+	const uint32	numSharedObjects = InVictim.sharedObjects.size();
+	if ( numSharedObjects == 0 )
+	{
+		return false;
+	}
+
+	// The owner takes all shared objects, others take a half to leave work for the rest
+	const uint32	numObjectsToSteal = InIsOwner ? numSharedObjects : Max<uint32>( numSharedObjects / 2, 1 );
+	OutObjects.insert( OutObjects.end(), InVictim.sharedObjects.end() - numObjectsToSteal, InVictim.sharedObjects.end() );
+	InVictim.sharedObjects.resize( numSharedObjects - numObjectsToSteal );
+	Sys_InterlockedExchange( &InVictim.numSharedObjects, InVictim.sharedObjects.size() );
+	return true;
+}
+
 /*
 ==================
 CObjectGC::ProcessObjectForReferences
@@ -602,8 +1421,35 @@ CObjectGC::ProcessObjectForReferences
 */
 void CObjectGC::ProcessObjectForReferences( class CObject* InCurrentObject, std::vector<class CObject*>& InOutNewReachableObjects, std::vector<StackEntry>& InOutStack )
 {
+	// Objects of a cluster are processed as one unit. The first reached object marks the whole cluster,
+	// it's thread safe because only one worker wins the mark
+	const uint32	clusterIndex = objectClusterIndices[InCurrentObject->index];
+	if ( clusterIndex != INDEX_NONE )
+	{
+		GCCluster&	cluster = clusters[clusterIndex];
+		if ( Sys_InterlockedCompareExchange( &cluster.bMarked, 1, 0 ) == 0 )
+		{
+			MarkClusterReachable( cluster, InOutNewReachableObjects );
+		}
+		return;
+	}
+
 	// Add referenced objects to InOutNewReachableObjects
 	InCurrentObject->AddReferencedObjects( InOutNewReachableObjects );
+	ProcessTokenStreamReferences( InCurrentObject, InOutStack, [&]( CObject*& InOutObject, bool InIsAllowReferenceElimination )
+								  {
+									  HandleObjectReference( InOutNewReachableObjects, InOutObject, InIsAllowReferenceElimination );
+								  } );
+}
+
+/*
+==================
+CObjectGC::ProcessTokenStreamReferences
+==================
+*/
+template<typename TReferenceHandler>
+void CObjectGC::ProcessTokenStreamReferences( class CObject* InCurrentObject, std::vector<StackEntry>& InOutStack, const TReferenceHandler& InReferenceHandler )
+{
 
 	// Make sure that token stream has been assembled at this point as the below code relies on it
 	Assert( InCurrentObject->GetClass()->IsAssembledReferenceTokenStream() );
@@ -670,7 +1516,7 @@ void CObjectGC::ProcessObjectForReferences( class CObject* InCurrentObject, std:
 			CObject**	objectPtr	= ( CObject** )( stackEntryData + REFERENCE_INFO.offset );
 			CObject*&	object		= *objectPtr;
 			tokenReturnCount		= REFERENCE_INFO.returnCount;
-			HandleObjectReference( InOutNewReachableObjects, object, true );
+			InReferenceHandler( object, true );
 		}
 
 		// Persistent CObject (Outer, TheClass)
@@ -680,7 +1526,7 @@ void CObjectGC::ProcessObjectForReferences( class CObject* InCurrentObject, std:
 			CObject**	objectPtr	= ( CObject** )( stackEntryData + REFERENCE_INFO.offset );
 			CObject*&	object		= *objectPtr;
 			tokenReturnCount		= REFERENCE_INFO.returnCount;
-			HandleObjectReference( InOutNewReachableObjects, object, false );
+			InReferenceHandler( object, false );
 		}
 
 		// Array of CObject
@@ -693,7 +1539,7 @@ void CObjectGC::ProcessObjectForReferences( class CObject* InCurrentObject, std:
 			for ( uint32 objectIndex = 0, numObjects = objectArray.size(); objectIndex < numObjects; ++objectIndex )
 			{
 				CObject*&		object = objectArray[ objectIndex ];
-				HandleObjectReference( InOutNewReachableObjects, object, true );
+				InReferenceHandler( object, true );
 			}
 		}
 
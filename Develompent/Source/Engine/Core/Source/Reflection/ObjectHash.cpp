@@ -667,6 +667,8 @@ CObject* FindObjectFast( CClass* InClass, CObject* InOuter, const CName& InName,
 		}
 	}
 
+	// A found object may be stored anywhere, so it must be reached by incremental reachability analysis
+	objectGC.WriteBarrier( result );
 	return result;
 }
 
@@ -593,11 +593,24 @@ CObjectPackage* CObjectPackage::LoadPackage( CObjectPackage* InOuter, const tcha
 	// We end loading the package
 	EndLoadPackage();
 
+	// Group objects of the package into a GC cluster, their references are final after PostLoad
+	CObjectGC::Get().CreateCluster( resultPackage );
+
 	// Done!
 	Logf( TEXT( "Package '%s' is loaded\n" ), InFilename );
 	return resultPackage;
 }
 
+/*
+==================
+CObjectPackage::LoadPackageAsync
+==================
+*/
+uint32 CObjectPackage::LoadPackageAsync( const tchar* InFilename, const COnAsyncPackageLoaded::DelegateType_t& InCallback, uint32 InLoadFlags /* = LOAD_None */ )
+{
+	return CAsyncPackageLoader::Get().LoadPackage( InFilename, InCallback, InLoadFlags );
+}
+
 /*
 ==================
 CObjectPackage::BeginLoadPackage
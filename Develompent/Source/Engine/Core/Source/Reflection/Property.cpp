@@ -295,7 +295,7 @@ bool CByteProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Out
 CByteProperty::SetPropertyValue
 ==================
 */
-bool CByteProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CByteProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -400,7 +400,7 @@ bool CIntProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& OutP
 CIntProperty::SetPropertyValue
 ==================
 */
-bool CIntProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CIntProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -494,7 +494,7 @@ bool CFloatProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Ou
 CFloatProperty::SetPropertyValue
 ==================
 */
-bool CFloatProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CFloatProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -588,7 +588,7 @@ bool CBoolProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Out
 CFloatProperty::SetPropertyValue
 ==================
 */
-bool CBoolProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CBoolProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -683,7 +683,7 @@ bool CColorProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Ou
 CColorProperty::SetPropertyValue
 ==================
 */
-bool CColorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CColorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -795,12 +795,13 @@ bool CObjectProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& O
 CObjectProperty::SetPropertyValue
 ==================
 */
-bool CObjectProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CObjectProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
 	{
 		*( CObject** )( InObjectAddress + offset ) = InPropertyValue.objectValue;
+		CObjectGC::Get().WriteBarrier( InOwner, InPropertyValue.objectValue );
 		bResult = true;
 	}
 	return bResult;
@@ -931,7 +932,7 @@ bool CVectorProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& O
 CVectorProperty::SetPropertyValue
 ==================
 */
-bool CVectorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CVectorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -1043,7 +1044,7 @@ bool CRotatorProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue&
 CRotatorProperty::SetPropertyValue
 ==================
 */
-bool CRotatorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CRotatorProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -1144,7 +1145,7 @@ bool CAssetProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Ou
 CAssetProperty::SetPropertyValue
 ==================
 */
-bool CAssetProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CAssetProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -1274,7 +1275,7 @@ bool CArrayProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& Ou
 CArrayProperty::SetPropertyValue
 ==================
 */
-bool CArrayProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CArrayProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -1282,6 +1283,16 @@ bool CArrayProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyVal
 		std::vector<byte>*		dstArray = ( std::vector<byte>* )( InObjectAddress + offset );
 		dstArray->resize( InPropertyValue.arrayValue->size() );
 		Memory::Memcpy( dstArray->data(), InPropertyValue.arrayValue->data(), dstArray->size() );
+
+		// Copied object references must be known by GC the same way as CObjectProperty does
+		if ( IsA<CObjectProperty>( innerProperty ) )
+		{
+			CObject**	objects = ( CObject** )dstArray->data();
+			for ( uint32 index = 0, count = dstArray->size() / sizeof( CObject* ); index < count; ++index )
+			{
+				CObjectGC::Get().WriteBarrier( InOwner, objects[index] );
+			}
+		}
 		bResult = true;
 	}
 	return bResult;
@@ -1472,7 +1483,7 @@ bool CStructProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& O
 CStructProperty::SetPropertyValue
 ==================
 */
-bool CStructProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CStructProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	return false;
 }
@@ -1624,7 +1635,7 @@ bool CStringProperty::GetPropertyValue( byte* InObjectAddress, UPropertyValue& O
 CStringProperty::SetPropertyValue
 ==================
 */
-bool CStringProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue )
+bool CStringProperty::SetPropertyValue( byte* InObjectAddress, const UPropertyValue& InPropertyValue, CObject* InOwner )
 {
 	bool	bResult = false;
 	if ( !( flags & CPF_Const ) && InObjectAddress )
@@ -1,4 +1,7 @@
+#include <vector>
+
 #include "System/Archive.h"
+#include "System/ThreadPool.h"
 #include "Misc/Template.h"
 #include "Reflection/Object.h"
 #include "Reflection/ObjectPackage.h"
@@ -21,6 +24,7 @@ CArchive::CArchive( const std::wstring& InPath )
 
 #if WITH_EDITOR
 	, cookingTargetPlatform( nullptr )
+	, cookingCompressionFlags( CF_None )
 #endif // WITH_EDITOR
 {}
 
@@ -67,34 +71,34 @@ void CArchive::SerializeCompressed( void* InBuffer, uint32 InSize, ECompressionF
 		// Figure out how many chunks there are going to be based on uncompressed size and compression chunk size.
 		uint32	totalChunkCount = ( summary.uncompressedSize + loadingCompressionChunkSize - 1 ) / loadingCompressionChunkSize;
 
-		// Allocate compression chunk infos and serialize them, keeping track of max size of compression chunks used.
+		// Allocate compression chunk infos and serialize them, keeping track of offsets of each chunk in compressed and uncompressed data.
 		CompressedChunkInfo*	compressionChunks = new CompressedChunkInfo[ totalChunkCount ];
-		uint32					maxCompressedSize = 0;
+		std::vector<uint32>		compressedOffsets( totalChunkCount );
+		std::vector<uint32>		uncompressedOffsets( totalChunkCount );
+		uint32					totalCompressedSize = 0;
+		uint32					totalUncompressedSize = 0;
 		for ( uint32 chunkIndex = 0; chunkIndex < totalChunkCount; chunkIndex++ )
 		{
 			*this << compressionChunks[ chunkIndex ];
-			maxCompressedSize = Max( compressionChunks[ chunkIndex ].compressedSize, maxCompressedSize );
+			compressedOffsets[ chunkIndex ]		= totalCompressedSize;
+			uncompressedOffsets[ chunkIndex ]	= totalUncompressedSize;
+			totalCompressedSize					+= compressionChunks[ chunkIndex ].compressedSize;
+			totalUncompressedSize				+= compressionChunks[ chunkIndex ].uncompressedSize;
 		}
+		Assert( totalUncompressedSize <= InSize );
 
-		// Set up destination pointer and allocate memory for compressed chunk[s] (one at a time).
+		// Read all compressed chunks at once. Chunks are independent, so they are decompressed
+		// directly into the destination buffer in parallel on worker threads of the thread pool
 		byte*			dest = ( byte* )InBuffer;
-		void*			compressedBuffer = malloc( maxCompressedSize );
-
-		// Iterate over all chunks, serialize them into memory and decompress them directly into the destination pointer
-		for ( uint32 chunkIndex = 0; chunkIndex < totalChunkCount; chunkIndex++ )
-		{
-			const CompressedChunkInfo&			chunk = compressionChunks[ chunkIndex ];
-			
-			// Read compressed data.
-			Serialize( compressedBuffer, chunk.compressedSize );
-			
-			// Decompress into dest pointer directly.
-			bool		result = Sys_UncompressMemory( InFlags, dest, chunk.uncompressedSize, compressedBuffer, chunk.compressedSize );
-			Assert( result );
-			
-			// And advance it by read amount.
-			dest += chunk.uncompressedSize;
-		}
+		byte*			compressedBuffer = ( byte* )malloc( totalCompressedSize );
+		Serialize( compressedBuffer, totalCompressedSize );
+
+		CThreadPool::Get().ParallelFor( totalChunkCount, [&]( uint32 InChunkIndex )
+										{
+											const CompressedChunkInfo&		chunk = compressionChunks[ InChunkIndex ];
+											bool							result = Sys_UncompressMemory( InFlags, dest + uncompressedOffsets[ InChunkIndex ], chunk.uncompressedSize, compressedBuffer + compressedOffsets[ InChunkIndex ], chunk.compressedSize );
+											Assert( result );
+										} );
 
 		// Free up allocated memory.
 		free( compressedBuffer );
@@ -0,0 +1,86 @@
+#include "Misc/Template.h"
+#include "System/Memory.h"
+#include "System/LinearAllocator.h"
+
+/*
+==================
+CLinearAllocator::CLinearAllocator
+==================
+*/
+CLinearAllocator::CLinearAllocator( uint32 InPageSize )
+	: page( nullptr )
+	, pageSize( InPageSize )
+	, usedSize( 0 )
+	, overflowSize( 0 )
+{
+	Assert( pageSize > 0 );
+	page = ( byte* )Memory::Malloc( pageSize, 16 );
+}
+
+/*
+==================
+CLinearAllocator::~CLinearAllocator
+==================
+*/
+CLinearAllocator::~CLinearAllocator()
+{
+	for ( uint32 index = 0, count = overflowBlocks.size(); index < count; ++index )
+	{
+		Memory::Free( overflowBlocks[index] );
+	}
+	Memory::Free( page );
+}
+
+/*
+==================
+CLinearAllocator::Allocate
+==================
+*/
+void* CLinearAllocator::Allocate( uint32 InSize, uint32 InAlignment /* = 16 */ )
+{
+	Assert( InAlignment > 0 && ( InAlignment & ( InAlignment - 1 ) ) == 0 && InAlignment <= 16 );
+	if ( InSize == 0 )
+	{
+		return nullptr;
+	}
+
+	// Reserve enough space to align the allocation. The page is 16-byte aligned, so we may align offsets
+	const uint32	reserveSize = Align( InSize, InAlignment ) + InAlignment - 1;
+	const uint32	offset		= ( uint32 )Sys_InterlockedAdd( &usedSize, ( int32 )reserveSize );
+	if ( offset + reserveSize <= pageSize )
+	{
+		return page + Align( offset, InAlignment );
+	}
+
+	// The page is exhausted, allocate from the general allocator. The page will be grown on the next reset
+	CScopeLock		scopeLock( overflowMutex );
+	void*			result = Memory::Malloc( InSize, InAlignment );
+	overflowBlocks.push_back( result );
+	overflowSize += reserveSize;
+	return result;
+}
+
+/*
+==================
+CLinearAllocator::Reset
+==================
+*/
+void CLinearAllocator::Reset()
+{
+	// If the page was exhausted, grow it to fit all allocations of the last use
+	if ( !overflowBlocks.empty() )
+	{
+		for ( uint32 index = 0, count = overflowBlocks.size(); index < count; ++index )
+		{
+			Memory::Free( overflowBlocks[index] );
+		}
+
+		pageSize = Align( pageSize + overflowSize, 16 );
+		Memory::Free( page );
+		page = ( byte* )Memory::Malloc( pageSize, 16 );
+		overflowBlocks.clear();
+		overflowSize = 0;
+	}
+
+	usedSize = 0;
+}
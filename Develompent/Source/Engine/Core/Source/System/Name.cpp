@@ -2,10 +2,188 @@
 
 #include "Misc/Misc.h"
 #include "System/Name.h"
+#include "System/Threading.h"
 
-static std::vector<CName::NameEntry>& GetGlobalNameTable()
+/**
+ * @ingroup Core
+ * @brief Number of name entries in one chunk of the global name table
+ */
+#define NAME_CHUNK_SIZE			16384
+
+/**
+ * @ingroup Core
+ * @brief Maximum number of chunks in the global name table
+ */
+#define NAME_MAX_CHUNKS			1024
+
+/**
+ * @ingroup Core
+ * @brief Number of hash buckets in the global name table (must be power of two)
+ */
+#define NAME_NUM_HASH_BUCKETS	65536
+
+/**
+ * @ingroup Core
+ * @brief Global table of names
+ * 
+ * Entries are stored in fixed size chunks, so address of an entry never changes after it was added.
+ * Lookup by hash goes through the bucket chains and doesn't take the lock, only adding a new entry is serialized
+ */
+class CNameTable
 {
-	static std::vector<CName::NameEntry>		globalNameTable;
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CNameTable()
+		: numEntries( 0 )
+	{
+		Memory::Memzero( chunks, sizeof( chunks ) );
+		for ( uint32 index = 0; index < NAME_NUM_HASH_BUCKETS; ++index )
+		{
+			hashBuckets[index] = INDEX_NONE;
+		}
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	~CNameTable()
+	{
+		for ( uint32 index = 0; index < NAME_MAX_CHUNKS && chunks[index]; ++index )
+		{
+			delete[] chunks[index];
+		}
+	}
+
+	/**
+	 * @brief Find name entry by hash
+	 * This function is thread safe and doesn't lock the table
+	 * 
+	 * @param InHash	Hash of the name in upper case
+	 * @return Return index of the name entry, if not found returns INDEX_NONE
+	 */
+	FORCEINLINE uint32 Find( uint64 InHash ) const
+	{
+		for ( uint32 index = hashBuckets[InHash & ( NAME_NUM_HASH_BUCKETS - 1 )]; index != INDEX_NONE; )
+		{
+			const CName::NameEntry&		nameEntry = GetEntryChecked( index );
+			if ( nameEntry.hash == InHash )
+			{
+				return index;
+			}
+			index = nameEntry.hashNext;
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * @brief Find name entry by hash or add it if it doesn't exist
+	 * 
+	 * @param InName	Name
+	 * @param InHash	Hash of the name in upper case
+	 * @return Return index of the name entry
+	 */
+	uint32 FindOrAdd( const std::wstring& InName, uint64 InHash )
+	{
+		CScopeLock	scopeLock( mutex );
+		return FindOrAdd_NoLock( InName, InHash );
+	}
+
+	/**
+	 * @brief Find name entry by hash or add it if it doesn't exist without locking the table
+	 * @warning Need call only when the table is locked (see GetMutex)
+	 * 
+	 * @param InName	Name
+	 * @param InHash	Hash of the name in upper case
+	 * @return Return index of the name entry
+	 */
+	uint32 FindOrAdd_NoLock( const std::wstring& InName, uint64 InHash )
+	{
+		// Other thread may have already added this name while we waited the lock
+		uint32	index = Find( InHash );
+		if ( index != INDEX_NONE )
+		{
+			return index;
+		}
+
+		// Allocate a new chunk if it's need
+		index = numEntries;
+		uint32	chunkIndex = index / NAME_CHUNK_SIZE;
+		AssertMsg( chunkIndex < NAME_MAX_CHUNKS, TEXT( "Global name table is overflowed (%i names)" ), index );
+		if ( !chunks[chunkIndex] )
+		{
+			chunks[chunkIndex] = new CName::NameEntry[NAME_CHUNK_SIZE];
+		}
+
+		// Fill the name entry and publish it. Interlocked operations are full memory barriers,
+		// so readers will see the entry completely initialized
+		uint32				bucketIndex = InHash & ( NAME_NUM_HASH_BUCKETS - 1 );
+		CName::NameEntry&	nameEntry	= chunks[chunkIndex][index % NAME_CHUNK_SIZE];
+		nameEntry.name		= InName;
+		nameEntry.hash		= InHash;
+		nameEntry.hashNext	= hashBuckets[bucketIndex];
+		Sys_InterlockedExchange( ( volatile int32* )&numEntries, index + 1 );
+		Sys_InterlockedExchange( ( volatile int32* )&hashBuckets[bucketIndex], index );
+		return index;
+	}
+
+	/**
+	 * @brief Get name entry
+	 * This function is thread safe and doesn't lock the table
+	 * 
+	 * @param InIndex	Index
+	 * @return Return name entry, if InIndex isn't valid returns NULL
+	 */
+	FORCEINLINE CName::NameEntry* GetEntry( uint32 InIndex ) const
+	{
+		return InIndex != INDEX_NONE && InIndex < numEntries ? &GetEntryChecked( InIndex ) : nullptr;
+	}
+
+	/**
+	 * @brief Get name entry without checking index
+	 * 
+	 * @param InIndex	Index
+	 * @return Return name entry
+	 */
+	FORCEINLINE CName::NameEntry& GetEntryChecked( uint32 InIndex ) const
+	{
+		return chunks[InIndex / NAME_CHUNK_SIZE][InIndex % NAME_CHUNK_SIZE];
+	}
+
+	/**
+	 * @brief Get number of name entries
+	 * @return Return number of name entries
+	 */
+	FORCEINLINE uint32 Num() const
+	{
+		return numEntries;
+	}
+
+	/**
+	 * @brief Get mutex of the table
+	 * @return Return mutex of the table
+	 */
+	FORCEINLINE CMutex& GetMutex()
+	{
+		return mutex;
+	}
+
+private:
+	CName::NameEntry*	chunks[NAME_MAX_CHUNKS];				/**< Chunks of name entries */
+	volatile uint32		hashBuckets[NAME_NUM_HASH_BUCKETS];		/**< Index of the first name entry in each hash bucket */
+	volatile uint32		numEntries;								/**< Number of name entries */
+	CMutex				mutex;									/**< Mutex for adding new names */
+};
+
+/*
+==================
+GetGlobalNameTable
+==================
+*/
+static CNameTable& GetGlobalNameTable()
+{
+	static CNameTable		globalNameTable;
 	return globalNameTable;
 }
 
@@ -16,7 +194,7 @@ AllocateNameEntry
 */
 static FORCEINLINE void AllocateNameEntry( const std::wstring& InName, uint64 InHash )
 {
-	GetGlobalNameTable().push_back( CName::NameEntry( InName, InHash ) );
+	GetGlobalNameTable().FindOrAdd( InName, InHash );
 }
 
 /*
@@ -44,14 +222,14 @@ void CName::StaticInit()
 		return;
 	}
 
-	Assert( GetGlobalNameTable().empty() );
+	Assert( GetGlobalNameTable().Num() == 0 );
 	GetIsInitialized() = true;
 
 	// Register all hardcoded names
 	std::wstring		tmpBuffer;
 	#define REGISTER_NAME( InNum, InName )	\
 	{ \
-		Assert( InNum == GetGlobalNameTable().size() ); \
+		Assert( InNum == GetGlobalNameTable().Num() ); \
 		L_Strupr( TEXT( #InName ), tmpBuffer ); \
 		AllocateNameEntry( TEXT( #InName ), FastHash( tmpBuffer ) ); \
 	}
@@ -65,8 +243,7 @@ CName::GetMaxNames
 */
 uint32 CName::GetMaxNames()
 {
-	std::vector<CName::NameEntry>&	globalNameTable = GetGlobalNameTable();
-	return ( uint32 )globalNameTable.size();
+	return GetGlobalNameTable().Num();
 }
 
 /*
@@ -76,8 +253,7 @@ CName::GetEntry
 */
 CName::NameEntry* CName::GetEntry( uint32 InIndex )
 {
-	std::vector<CName::NameEntry>&	globalNameTable = GetGlobalNameTable();
-	return InIndex != INDEX_NONE && InIndex < globalNameTable.size() ? &globalNameTable[InIndex] : nullptr;
+	return GetGlobalNameTable().GetEntry( InIndex );
 }
 
 /*
@@ -97,9 +273,9 @@ bool CName::EndsWith( const CName& InSuffix ) const
 		return false;
 	}
 
-	std::vector<CName::NameEntry>&		globalNameTable = GetGlobalNameTable();
-	std::wstring*						name = IsValid() ? &globalNameTable[index].name : &globalNameTable[NAME_None].name;
-	std::wstring*						suffix = InSuffix.IsValid() ? &globalNameTable[InSuffix.index].name : &globalNameTable[NAME_None].name;
+	CNameTable&			globalNameTable = GetGlobalNameTable();
+	std::wstring*		name = &globalNameTable.GetEntryChecked( IsValid() ? index : NAME_None ).name;
+	std::wstring*		suffix = &globalNameTable.GetEntryChecked( InSuffix.IsValid() ? InSuffix.index : NAME_None ).name;
 	return name->size() >= suffix->size() && L_Strnicmp( name->data() + name->size() - suffix->size(), suffix->data(), suffix->size() );
 }
 
@@ -126,16 +302,12 @@ void CName::Init( const std::wstring& InString, uint32 InStringSize, uint32 InNu
 	uint64	hash = FastHash( L_Strupr( InString ).data(), ( uint64 )InStringSize * sizeof( std::wstring::value_type ), 0 );
 	
 	// Try find already exist name in global table
-	std::vector<CName::NameEntry>&		globalNameTable = GetGlobalNameTable();
-	for ( uint32 nameEntryId = 0, numNameEntries = globalNameTable.size(); nameEntryId < numNameEntries; ++nameEntryId )
+	CNameTable&		globalNameTable = GetGlobalNameTable();
+	index = globalNameTable.Find( hash );
+	if ( index != INDEX_NONE )
 	{
-		const CName::NameEntry&		nameEntry = globalNameTable[nameEntryId];
-		if ( nameEntry.hash == hash )
-		{
-			// Found it in the cache
-			index = nameEntryId;
-			return;
-		}
+		// Found it in the cache
+		return;
 	}
 
 	// Didn't find name
@@ -146,11 +318,77 @@ void CName::Init( const std::wstring& InString, uint32 InStringSize, uint32 InNu
 		return;
 	}
 
-	// Getting index of name
-	index = globalNameTable.size();
-
 	// Allocate new name entry
-	AllocateNameEntry( std::wstring( InString.data(), InString.data() + InStringSize ), hash);
+	index = globalNameTable.FindOrAdd( std::wstring( InString.data(), InString.data() + InStringSize ), hash );
+}
+
+/*
+==================
+CName::InitNames
+==================
+*/
+void CName::InitNames( const std::vector<std::wstring>& InStrings, CName* OutNames, EFindName InFindType /* = CNAME_Add */ )
+{
+	StaticInit();
+	Assert( OutNames || InStrings.empty() );
+
+	// Parse numbers, calculate hashes and find already exist names without locking the table
+	CNameTable&				globalNameTable = GetGlobalNameTable();
+	std::vector<uint64>		hashes( InStrings.size(), INVALID_HASH );
+	std::vector<uint32>		missingNames;
+	std::wstring			upperString;
+	for ( uint32 stringIndex = 0, numStrings = InStrings.size(); stringIndex < numStrings; ++stringIndex )
+	{
+		const std::wstring&		nameString		= InStrings[stringIndex];
+		CName&					name			= OutNames[stringIndex];
+		if ( nameString.empty() )
+		{
+			name = NAME_None;
+			continue;
+		}
+
+		uint32		idStartNumber	= INDEX_NONE;
+		uint32		strLength		= nameString.size();
+		name.number					= ParseNumber( nameString.c_str(), idStartNumber );
+		if ( idStartNumber != INDEX_NONE )
+		{
+			strLength = idStartNumber;
+		}
+
+		L_Strupr( nameString, upperString );
+		hashes[stringIndex] = FastHash( upperString.data(), ( uint64 )strLength * sizeof( std::wstring::value_type ), 0 );
+		name.index = globalNameTable.Find( hashes[stringIndex] );
+		if ( name.index == INDEX_NONE )
+		{
+			if ( InFindType == CNAME_Find )
+			{
+				name = NAME_None;
+			}
+			else
+			{
+				missingNames.push_back( stringIndex );
+			}
+		}
+	}
+
+	// Add all missing names under one lock
+	if ( !missingNames.empty() )
+	{
+		CScopeLock		scopeLock( globalNameTable.GetMutex() );
+		for ( uint32 index = 0, numMissingNames = missingNames.size(); index < numMissingNames; ++index )
+		{
+			uint32					stringIndex = missingNames[index];
+			const std::wstring&		nameString	= InStrings[stringIndex];
+			uint32					strLength	= nameString.size();
+			uint32					idStartNumber;
+			ParseNumber( nameString.c_str(), idStartNumber );
+			if ( idStartNumber != INDEX_NONE )
+			{
+				strLength = idStartNumber;
+			}
+			OutNames[stringIndex].index = globalNameTable.FindOrAdd_NoLock( std::wstring( nameString.data(), nameString.data() + strLength ), hashes[stringIndex] );
+		}
+	}
 }
 
 /*
@@ -194,14 +432,14 @@ CName::AppendString
 */
 void CName::AppendString( std::wstring& OutResult, bool InIsWithoutNumber /* = false */ ) const
 {
-	std::vector<CName::NameEntry>&		globalNameTable = GetGlobalNameTable();
+	CNameTable&		globalNameTable = GetGlobalNameTable();
 	if ( !IsValid() )
 	{
-		OutResult += globalNameTable[NAME_None].name;
+		OutResult += globalNameTable.GetEntryChecked( NAME_None ).name;
 	}
 	else
 	{
-		OutResult += globalNameTable[index].name;
+		OutResult += globalNameTable.GetEntryChecked( index ).name;
 	}
 
 	if ( !InIsWithoutNumber && number != NAME_NO_NUMBER )
@@ -227,6 +465,5 @@ bool CName::operator==( const tchar* InOther ) const
 	}
 
 	// Compare
-	std::vector<CName::NameEntry>&	globalNameTable = GetGlobalNameTable();
-	return tempNumber == number && !L_Strnicmp( tempName, globalNameTable[IsValid() ? index : NAME_None].name.c_str(), numCharsToCompare );
+	return tempNumber == number && !L_Strnicmp( tempName, GetGlobalNameTable().GetEntryChecked( IsValid() ? index : NAME_None ).name.c_str(), numCharsToCompare );
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "System/BaseFileSystem.h"
 #include "System/Archive.h"
 #include "System/Package.h"
+#include "System/BaseTargetPlatform.h"
 #include "System/BaseEngine.h"
 #include "Render/Texture.h"
 #include "Render/Material.h"
@@ -368,7 +369,7 @@ void CPackage::SetNameFromPath( const std::wstring& InPath )
 CPackage::Save
 ==================
 */
-bool CPackage::Save( const std::wstring& InPath )
+bool CPackage::Save( const std::wstring& InPath, CBaseTargetPlatform* InCookingTarget /* = nullptr */ )
 {
 	// Before saving package it needs to be fully loaded into memory
 	std::vector< TAssetHandle<CAsset> >		loadedAsset;
@@ -388,11 +389,17 @@ bool CPackage::Save( const std::wstring& InPath )
 
 	// Serialize header of archive
 	archive->SetType( AT_Package );
+	archive->SetCookingTarget( InCookingTarget );
 	archive->SerializeHeader();
 	Serialize( *archive );
 
 	delete archive;
-	filename = InPath;
+
+	// Cooked package is a copy for the target platform, so we keep working with the source one
+	if ( !InCookingTarget )
+	{
+		filename = InPath;
+	}
 	return true;
 }
 
@@ -502,22 +509,46 @@ void CPackage::Serialize( CArchive& InArchive )
 				continue;
 			}
 
+			// Editor only assets aren't cooked. Bulk data of the asset is compressed with codec selected by the target platform
+			if ( InArchive.IsCooking() )
+			{
+				if ( assetInfo.data->IsOnlyEditor() )
+				{
+					continue;
+				}
+				InArchive.SetCookingCompressionFlags( InArchive.GetCookingTarget()->GetAssetCompressionFlags( assetInfo.type ) );
+			}
+
 			// Serialize asset header	
+			uint32		assetSize = assetInfo.size;
 			InArchive << assetInfo.type;
 			InArchive << assetInfo.name;
 			InArchive << assetInfo.data->guid;
-			InArchive << assetInfo.size;
+			InArchive << assetSize;
 
 			// Serialize asset
-			assetInfo.offset = InArchive.Tell();
+			uint32		assetOffset = InArchive.Tell();
 			assetInfo.data->Serialize( InArchive );
 			uint32		currentOffset = InArchive.Tell();
 
 			// Update asset size in header
-			assetInfo.size = currentOffset - assetInfo.offset;
-			InArchive.Seek( assetInfo.offset - sizeof( assetInfo.size ) );
-			InArchive << assetInfo.size;
+			assetSize = currentOffset - assetOffset;
+			InArchive.Seek( assetOffset - sizeof( assetSize ) );
+			InArchive << assetSize;
 			InArchive.Seek( currentOffset );
+
+			// Cooked package is a copy for the target platform, so the table keeps pointing into the source file
+			if ( !InArchive.IsCooking() )
+			{
+				assetInfo.offset	= assetOffset;
+				assetInfo.size		= assetSize;
+			}
+		}
+
+		// Unsaved changes of the source package stay dirty after cooking
+		if ( InArchive.IsCooking() )
+		{
+			return;
 		}
 	}
 	else
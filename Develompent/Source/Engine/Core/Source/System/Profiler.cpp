@@ -0,0 +1,482 @@
+#include "System/Profiler.h"
+
+#if ENABLE_PROFILER
+#include <algorithm>
+
+#include "Misc/CoreGlobals.h"
+#include "Misc/StringConv.h"
+#include "Logger/LoggerMacros.h"
+#include "System/BaseFileSystem.h"
+#include "System/Archive.h"
+
+/* Max number of scopes in a capture, the capture stops recording when it's reached */
+#define PROFILER_MAX_CAPTURED_EVENTS		( 4 * 1024 * 1024 )
+
+/*
+==================
+JsonEscape
+==================
+*/
+static std::string JsonEscape( const tchar* InString )
+{
+	std::string		string = TCHAR_TO_ANSI( InString );
+	std::string		result;
+	char			buffer[8];
+	result.reserve( string.size() );
+	for ( uint32 index = 0, count = string.size(); index < count; ++index )
+	{
+		char	ch = string[index];
+		if ( ch == '"' || ch == '\\' )
+		{
+			result += '\\';
+			result += ch;
+		}
+		else if ( ( uint8 )ch < 0x20 )
+		{
+			snprintf( buffer, sizeof( buffer ), "\\u%04x", ( uint8 )ch );
+			result += buffer;
+		}
+		else
+		{
+			result += ch;
+		}
+	}
+	return result;
+}
+
+/*
+==================
+CProfiler::CProfiler
+==================
+*/
+CProfiler::CProfiler()
+	: bEnabled( 0 )
+	, bShowStats( false )
+	, bCapturing( false )
+	, bCaptureFull( false )
+	, frameStartCycles( Sys_Cycles() )
+	, captureStartCycles( 0 )
+{}
+
+/*
+==================
+CProfiler::~CProfiler
+==================
+*/
+CProfiler::~CProfiler()
+{
+	for ( uint32 index = 0, count = threadBuffers.size(); index < count; ++index )
+	{
+		delete threadBuffers[index];
+	}
+	threadBuffers.clear();
+}
+
+/*
+==================
+CProfiler::GetThreadBuffer
+==================
+*/
+CProfiler::ThreadBuffer* CProfiler::GetThreadBuffer()
+{
+	static thread_local ThreadBuffer*	s_ThreadBuffer = nullptr;
+	if ( !s_ThreadBuffer )
+	{
+		ThreadBuffer*	threadBuffer = new ThreadBuffer();
+		threadBuffer->threadId = Sys_GetCurrentThreadId();
+
+		CScopeLock		scopeLock( mutex );
+		threadBuffers.push_back( threadBuffer );
+		s_ThreadBuffer = threadBuffer;
+	}
+	return s_ThreadBuffer;
+}
+
+/*
+==================
+CProfiler::AddScope
+==================
+*/
+void CProfiler::AddScope( const ProfilerStatDesc* InStat, uint64 InStartCycles, uint64 InEndCycles )
+{
+	// Only this thread writes into its buffer, so a scope is published without locks
+	ThreadBuffer*	threadBuffer	= GetThreadBuffer();
+	EventChunk*		chunk			= threadBuffer->writeChunk;
+	if ( chunk->numEvents == PROFILER_EVENTS_PER_CHUNK )
+	{
+		EventChunk*		newChunk = new EventChunk();
+		Sys_InterlockedCompareExchangePointer( ( void** )&chunk->next, newChunk, nullptr );
+		threadBuffer->writeChunk = chunk = newChunk;
+	}
+
+	chunk->events[chunk->numEvents] = Event{ InStat, InStartCycles, InEndCycles };
+	Sys_InterlockedIncrement( &chunk->numEvents );
+}
+
+/*
+==================
+CProfiler::GatherEvents
+==================
+*/
+void CProfiler::GatherEvents( ThreadBuffer* InThreadBuffer )
+{
+	for ( ; ; )
+	{
+		EventChunk*		chunk		= InThreadBuffer->readChunk;
+		uint32			numEvents	= Sys_InterlockedAdd( &chunk->numEvents, 0 );
+		tempEvents.insert( tempEvents.end(), chunk->events + InThreadBuffer->numReadEvents, chunk->events + numEvents );
+		InThreadBuffer->numReadEvents = numEvents;
+		if ( numEvents < PROFILER_EVENTS_PER_CHUNK )
+		{
+			break;
+		}
+
+		// The chunk is full, it's freed once the owner thread has moved to the next one
+		EventChunk*		next = ( EventChunk* )Sys_InterlockedCompareExchangePointer( ( void** )&chunk->next, nullptr, nullptr );
+		if ( !next )
+		{
+			break;
+		}
+
+		delete chunk;
+		InThreadBuffer->readChunk		= next;
+		InThreadBuffer->numReadEvents	= 0;
+	}
+}
+
+/*
+==================
+CProfiler::SetThreadName
+==================
+*/
+void CProfiler::SetThreadName( uint32 InThreadId, const tchar* InName )
+{
+	CScopeLock		scopeLock( mutex );
+	threadNames[InThreadId] = InName;
+}
+
+/*
+==================
+CProfiler::SetShowStats
+==================
+*/
+void CProfiler::SetShowStats( bool InIsShowStats )
+{
+	Assert( IsInGameThread() );
+	bShowStats = InIsShowStats;
+	UpdateEnabled();
+}
+
+/*
+==================
+CProfiler::UpdateEnabled
+==================
+*/
+void CProfiler::UpdateEnabled()
+{
+	Sys_InterlockedExchange( &bEnabled, bShowStats || bCapturing ? 1 : 0 );
+}
+
+/*
+==================
+CProfiler::BeginCapture
+==================
+*/
+void CProfiler::BeginCapture()
+{
+	Assert( IsInGameThread() );
+	if ( bCapturing )
+	{
+		return;
+	}
+
+	capturedEvents.clear();
+	captureStartCycles	= Sys_Cycles();
+	bCapturing			= true;
+	bCaptureFull		= false;
+	UpdateEnabled();
+}
+
+/*
+==================
+CProfiler::EndCapture
+==================
+*/
+bool CProfiler::EndCapture( const std::wstring& InPath )
+{
+	Assert( IsInGameThread() );
+	if ( !bCapturing )
+	{
+		return false;
+	}
+
+	// Gather scopes which have been recorded since the last frame
+	EndFrame();
+	bCapturing = false;
+	UpdateEnabled();
+
+	// Names of scopes are converted once
+	std::unordered_map<const ProfilerStatDesc*, std::string>		statNames;
+	auto		GetStatName = [&]( const ProfilerStatDesc* InStat ) -> const std::string&
+	{
+		auto	it = statNames.find( InStat );
+		if ( it == statNames.end() )
+		{
+			std::string		name = std::string( "\"name\":\"" ) + JsonEscape( InStat->name ) + "\",\"cat\":\"" + JsonEscape( InStat->group ) + "\"";
+			it = statNames.insert( std::make_pair( InStat, name ) ).first;
+		}
+		return it->second;
+	};
+
+	// Build Chrome trace JSON, times are in microseconds
+	const double	microsecondsPerCycle = g_SecondsPerCycle * 1000000.0;
+	std::string		json = "{\"traceEvents\":[";
+	char			buffer[128];
+	bool			bFirstEntry = true;
+	auto			AddSeparator = [&]()
+	{
+		json += bFirstEntry ? "\n" : ",\n";
+		bFirstEntry = false;
+	};
+
+	{
+		CScopeLock		scopeLock( mutex );
+		for ( auto it = threadNames.begin(), itEnd = threadNames.end(); it != itEnd; ++it )
+		{
+			AddSeparator();
+			json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + std::to_string( it->first ) + ",\"args\":{\"name\":\"" + JsonEscape( it->second.c_str() ) + "\"}}";
+		}
+	}
+
+	for ( uint32 index = 0, count = capturedEvents.size(); index < count; ++index )
+	{
+		const CapturedEvent&	capturedEvent = capturedEvents[index];
+		const Event&			event = capturedEvent.event;
+		if ( event.startCycles < captureStartCycles )
+		{
+			continue;
+		}
+
+		snprintf( buffer, sizeof( buffer ), ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", capturedEvent.threadId, ( event.startCycles - captureStartCycles ) * microsecondsPerCycle, ( event.endCycles - event.startCycles ) * microsecondsPerCycle );
+		AddSeparator();
+		json += "{";
+		json += GetStatName( event.stat );
+		json += buffer;
+	}
+	json += "\n]}\n";
+	capturedEvents.clear();
+	capturedEvents.shrink_to_fit();
+
+	// Save the capture
+	CArchive*		archive = g_FileSystem->CreateFileWriter( InPath );
+	if ( !archive )
+	{
+		Warnf( TEXT( "Failed to save profiler capture to '%s'\n" ), InPath.c_str() );
+		return false;
+	}
+
+	archive->Serialize( ( void* )json.data(), json.size() );
+	delete archive;
+	Logf( TEXT( "Profiler capture saved to '%s'\n" ), InPath.c_str() );
+	return true;
+}
+
+/*
+==================
+CProfiler::EndFrame
+==================
+*/
+void CProfiler::EndFrame()
+{
+	Assert( IsInGameThread() );
+	uint64		frameEndCycles	= Sys_Cycles();
+	double		frameTime		= ( frameEndCycles - frameStartCycles ) * g_SecondsPerCycle * 1000.0;
+	frameStartCycles			= frameEndCycles;
+	if ( !IsEnabled() )
+	{
+		return;
+	}
+
+	// Gather recorded scopes of all threads
+	std::vector<ThreadBuffer*>		buffers;
+	{
+		CScopeLock		scopeLock( mutex );
+		buffers = threadBuffers;
+	}
+
+	FrameStats										frameStats;
+	std::unordered_map<const tchar*, uint64>		groupTimes;
+	frameStats.frameTime = frameTime;
+	for ( uint32 index = 0, count = buffers.size(); index < count; ++index )
+	{
+		ThreadBuffer*	threadBuffer = buffers[index];
+		GatherEvents( threadBuffer );
+		if ( tempEvents.empty() )
+		{
+			continue;
+		}
+
+		// Copy scopes into the capture
+		if ( bCapturing )
+		{
+			if ( capturedEvents.size() + tempEvents.size() <= PROFILER_MAX_CAPTURED_EVENTS )
+			{
+				for ( uint32 eventIndex = 0, numEvents = tempEvents.size(); eventIndex < numEvents; ++eventIndex )
+				{
+					capturedEvents.push_back( CapturedEvent{ tempEvents[eventIndex], threadBuffer->threadId } );
+				}
+			}
+			else if ( !bCaptureFull )
+			{
+				Warnf( TEXT( "Profiler capture is full, scopes aren't recorded anymore\n" ) );
+				bCaptureFull = true;
+			}
+		}
+
+		if ( bShowStats )
+		{
+			frameStats.threads.push_back( ThreadStats() );
+			ThreadStats&	threadStats = frameStats.threads.back();
+			threadStats.threadId = threadBuffer->threadId;
+			{
+				CScopeLock		scopeLock( mutex );
+				auto			itName = threadNames.find( threadStats.threadId );
+				threadStats.threadName = itName != threadNames.end() ? itName->second : L_Sprintf( TEXT( "Thread %u" ), threadStats.threadId );
+			}
+			AggregateEvents( tempEvents, threadStats, groupTimes );
+		}
+		tempEvents.clear();
+	}
+
+	// Convert times of groups to ms
+	if ( bShowStats )
+	{
+		for ( auto it = groupTimes.begin(), itEnd = groupTimes.end(); it != itEnd; ++it )
+		{
+			frameStats.groups.push_back( GroupStats{ it->first, it->second * g_SecondsPerCycle * 1000.0 } );
+		}
+		std::sort( frameStats.groups.begin(), frameStats.groups.end(), []( const GroupStats& InA, const GroupStats& InB ) { return InA.time > InB.time; } );
+
+		CScopeLock		scopeLock( frameStatsMutex );
+		lastFrameStats = std::move( frameStats );
+	}
+}
+
+/*
+==================
+CProfiler::AggregateEvents
+==================
+*/
+void CProfiler::AggregateEvents( std::vector<Event>& InEvents, ThreadStats& OutThreadStats, std::unordered_map<const tchar*, uint64>& InOutGroupTimes )
+{
+	// Sort scopes by start, so a parent goes before its children
+	std::sort( InEvents.begin(), InEvents.end(), []( const Event& InA, const Event& InB )
+			   {
+				   return InA.startCycles != InB.startCycles ? InA.startCycles < InB.startCycles : InA.endCycles > InB.endCycles;
+			   } );
+
+	// The root node of the thread
+	std::vector<Node>&		nodes = OutThreadStats.nodes;
+	nodes.push_back( Node{ nullptr, 0, 0.0, INDEX_NONE, INDEX_NONE } );
+
+	// Stack of open scopes, a scope is a child of the nearest scope which contains it
+	struct StackItem
+	{
+		uint32				nodeIndex;
+		uint64				endCycles;
+		const tchar*		group;
+	};
+	std::vector<StackItem>		stack;
+	std::vector<uint64>			nodeCycles( 1, 0 );
+	for ( uint32 index = 0, count = InEvents.size(); index < count; ++index )
+	{
+		const Event&	event = InEvents[index];
+		while ( !stack.empty() && stack.back().endCycles <= event.startCycles )
+		{
+			stack.pop_back();
+		}
+
+		// Find node of the scope among children of the parent, calls of the same scope are merged
+		uint32		parentIndex = !stack.empty() ? stack.back().nodeIndex : 0;
+		uint32		nodeIndex	= nodes[parentIndex].firstChild;
+		uint32		lastIndex	= INDEX_NONE;
+		while ( nodeIndex != INDEX_NONE && nodes[nodeIndex].stat != event.stat )
+		{
+			lastIndex = nodeIndex;
+			nodeIndex = nodes[nodeIndex].nextSibling;
+		}
+
+		if ( nodeIndex == INDEX_NONE )
+		{
+			nodeIndex = nodes.size();
+			nodes.push_back( Node{ event.stat, 0, 0.0, INDEX_NONE, INDEX_NONE } );
+			nodeCycles.push_back( 0 );
+			if ( lastIndex != INDEX_NONE )
+			{
+				nodes[lastIndex].nextSibling = nodeIndex;
+			}
+			else
+			{
+				nodes[parentIndex].firstChild = nodeIndex;
+			}
+		}
+
+		++nodes[nodeIndex].numCalls;
+		nodeCycles[nodeIndex] += event.endCycles - event.startCycles;
+
+		// Time of the group is counted only by the outermost scope of the group
+		const tchar*	group			= InternGroup( event.stat );
+		bool			bNestedInGroup	= false;
+		for ( uint32 stackIndex = 0, stackSize = stack.size(); stackIndex < stackSize && !bNestedInGroup; ++stackIndex )
+		{
+			bNestedInGroup = stack[stackIndex].group == group;
+		}
+
+		if ( !bNestedInGroup )
+		{
+			InOutGroupTimes[group] += event.endCycles - event.startCycles;
+		}
+		stack.push_back( StackItem{ nodeIndex, event.endCycles, group } );
+	}
+
+	for ( uint32 index = 1, count = nodes.size(); index < count; ++index )
+	{
+		nodes[index].time = nodeCycles[index] * g_SecondsPerCycle * 1000.0;
+	}
+}
+
+/*
+==================
+CProfiler::InternGroup
+==================
+*/
+const tchar* CProfiler::InternGroup( const ProfilerStatDesc* InStat )
+{
+	auto	itStat = statGroups.find( InStat );
+	if ( itStat != statGroups.end() )
+	{
+		return itStat->second;
+	}
+
+	// The same group literal may have different addresses in different modules, so groups are matched by name
+	auto	itGroup = groupNames.find( InStat->group );
+	if ( itGroup == groupNames.end() )
+	{
+		itGroup = groupNames.insert( std::make_pair( std::wstring( InStat->group ), InStat->group ) ).first;
+	}
+
+	statGroups.insert( std::make_pair( InStat, itGroup->second ) );
+	return itGroup->second;
+}
+
+/*
+==================
+CProfiler::GetLastFrameStats
+==================
+*/
+void CProfiler::GetLastFrameStats( FrameStats& OutFrameStats )
+{
+	CScopeLock		scopeLock( frameStatsMutex );
+	OutFrameStats = lastFrameStats;
+}
+#endif // ENABLE_PROFILER
@@ -0,0 +1,530 @@
+#include "Logger/LoggerMacros.h"
+#include "Misc/Misc.h"
+#include "System/ThreadPool.h"
+
+/* Key of the ParallelFor work item which the current thread is processing, 0 if it doesn't process any */
+static thread_local uint64		s_CurrentWorkItemKey = 0;
+
+/* Number of ParallelFor calls made by the current work item, they give keys to nested calls */
+static thread_local uint32		s_NumNestedParallelFors = 0;
+
+/* Number of ParallelFor calls made by the game thread, they give keys to its calls */
+static uint32					s_NumGameThreadParallelFors = 0;
+
+/**
+ * @ingroup Core
+ * @brief Task of ParallelFor which is executed on a worker thread
+ * Tasks are kept in the pool of the thread pool and reused by next calls of ParallelFor
+ */
+class CParallelForTask : public CThreadPoolTask
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CParallelForTask()
+		: nextFreeTask( nullptr )
+		, num( 0 )
+		, batchSize( 1 )
+		, callback( nullptr )
+		, function( nullptr )
+		, nextIndex( nullptr )
+		, callKey( 0 )
+	{}
+
+	/**
+	 * @brief Set up the task for a call of ParallelFor
+	 *
+	 * @param InNum				Number of indices
+	 * @param InBatchSize		Number of indices which one thread takes at a time
+	 * @param InCallback		Callback which calls the function object
+	 * @param InFunction		Pointer to the function object
+	 * @param InOutNextIndex	Shared counter of the next index to process
+	 * @param InCallKey			Key of the call, 0 if work items don't need keys
+	 */
+	FORCEINLINE void Setup( uint32 InNum, uint32 InBatchSize, CThreadPool::ParallelForCallback_t InCallback, const void* InFunction, volatile int32* InOutNextIndex, uint64 InCallKey )
+	{
+		num			= InNum;
+		batchSize	= InBatchSize;
+		callback	= InCallback;
+		function	= InFunction;
+		nextIndex	= InOutNextIndex;
+		callKey		= InCallKey;
+	}
+
+	/**
+	 * @brief Do work
+	 */
+	virtual void DoWork() override
+	{
+		Process( num, batchSize, callback, function, nextIndex, callKey );
+	}
+
+	/**
+	 * @brief Process batches of indices until all of them are taken
+	 *
+	 * @param InNum				Number of indices
+	 * @param InBatchSize		Number of indices which one thread takes at a time
+	 * @param InCallback		Callback which calls the function object
+	 * @param InFunction		Pointer to the function object
+	 * @param InOutNextIndex	Shared counter of the next index to process
+	 * @param InCallKey			Key of the call, 0 if work items don't need keys
+	 */
+	static FORCEINLINE void Process( uint32 InNum, uint32 InBatchSize, CThreadPool::ParallelForCallback_t InCallback, const void* InFunction, volatile int32* InOutNextIndex, uint64 InCallKey )
+	{
+		const uint64	parentWorkItemKey		= s_CurrentWorkItemKey;
+		const uint32	parentNumNestedCalls	= s_NumNestedParallelFors;
+		while ( true )
+		{
+			uint32	startIndex = Sys_InterlockedAdd( InOutNextIndex, InBatchSize );
+			if ( startIndex >= InNum )
+			{
+				break;
+			}
+
+			for ( uint32 index = startIndex, endIndex = Min( startIndex + InBatchSize, InNum ); index < endIndex; ++index )
+			{
+				s_CurrentWorkItemKey	= InCallKey != 0 ? ( InCallKey | index ) : 0;
+				s_NumNestedParallelFors = 0;
+				InCallback( InFunction, index );
+			}
+		}
+
+		s_CurrentWorkItemKey	= parentWorkItemKey;
+		s_NumNestedParallelFors = parentNumNestedCalls;
+	}
+
+	CParallelForTask*	nextFreeTask;		/**< Next task in the list of free tasks or tasks taken by one call of ParallelFor */
+
+private:
+	uint32									num;			/**< Number of indices */
+	uint32									batchSize;		/**< Number of indices which one thread takes at a time */
+	CThreadPool::ParallelForCallback_t		callback;		/**< Callback which calls the function object */
+	const void*								function;		/**< Pointer to the function object */
+	volatile int32*							nextIndex;		/**< Shared counter of the next index to process */
+	uint64									callKey;		/**< Key of the call, 0 if work items don't need keys */
+};
+
+/*
+==================
+CThreadPoolTask::CThreadPoolTask
+==================
+*/
+CThreadPoolTask::CThreadPoolTask()
+	: bIsDone( 1 )
+	, doneEvent( new CEvent( true ) )
+	, nextQueuedTask( nullptr )
+{
+	doneEvent->Trigger();
+}
+
+/*
+==================
+CThreadPoolTask::~CThreadPoolTask
+==================
+*/
+CThreadPoolTask::~CThreadPoolTask()
+{
+	AssertMsg( IsDone(), TEXT( "Thread pool task is destroyed before it was done" ) );
+	delete doneEvent;
+}
+
+/*
+==================
+CThreadPoolTask::Reset
+==================
+*/
+void CThreadPoolTask::Reset()
+{
+	AssertMsg( IsDone(), TEXT( "Thread pool task is already in the queue" ) );
+	doneEvent->Reset();
+	Sys_InterlockedExchange( &bIsDone, 0 );
+}
+
+/*
+==================
+CThreadPoolTask::Execute
+==================
+*/
+void CThreadPoolTask::Execute()
+{
+	DoWork();
+	Sys_InterlockedExchange( &bIsDone, 1 );
+	doneEvent->Trigger();
+}
+
+
+/*
+==================
+CThreadPool::CWorker::CWorker
+==================
+*/
+CThreadPool::CWorker::CWorker( CThreadPool* InThreadPool, uint32 InIndex )
+	: threadPool( InThreadPool )
+	, index( InIndex )
+{}
+
+/*
+==================
+CThreadPool::CWorker::Init
+==================
+*/
+bool CThreadPool::CWorker::Init()
+{
+	threadPool->threadIds[index] = Sys_GetCurrentThreadId();
+	return true;
+}
+
+/*
+==================
+CThreadPool::CWorker::Run
+==================
+*/
+uint32 CThreadPool::CWorker::Run()
+{
+	while ( true )
+	{
+		// Wait until a new task will be added or the pool will be stopped
+		threadPool->workSemaphore->Wait();
+		if ( threadPool->bIsStopping )
+		{
+			break;
+		}
+
+		// The task may be retracted by its owner, in this case we just go to wait again
+		CThreadPoolTask*	task = threadPool->PopTask();
+		if ( task )
+		{
+			task->Execute();
+		}
+	}
+
+	return 0;
+}
+
+/*
+==================
+CThreadPool::CWorker::Stop
+==================
+*/
+void CThreadPool::CWorker::Stop()
+{}
+
+/*
+==================
+CThreadPool::CWorker::Exit
+==================
+*/
+void CThreadPool::CWorker::Exit()
+{}
+
+
+/*
+==================
+CThreadPool::CThreadPool
+==================
+*/
+CThreadPool::CThreadPool()
+	: bIsStopping( 0 )
+	, workSemaphore( nullptr )
+	, queueHead( nullptr )
+	, queueTail( nullptr )
+	, freeParallelForTasks( nullptr )
+{}
+
+/*
+==================
+CThreadPool::~CThreadPool
+==================
+*/
+CThreadPool::~CThreadPool()
+{
+	Shutdown();
+}
+
+/*
+==================
+CThreadPool::Init
+==================
+*/
+void CThreadPool::Init( uint32 InNumThreads, const tchar* InThreadName /* = TEXT( "PoolThread" ) */, EThreadPriority InThreadPriority /* = TP_Normal */ )
+{
+	Assert( threads.empty() && !workSemaphore );
+	bIsStopping		= 0;
+	workSemaphore	= new CSemaphore( 0, 0x7FFFFFFF );
+	threadIds.resize( InNumThreads, ( uint32 )-1 );
+
+	for ( uint32 index = 0; index < InNumThreads; ++index )
+	{
+		CWorker*			worker = new CWorker( this, index );
+		CRunnableThread*	thread = CRunnableThread::Create( worker, L_Sprintf( TEXT( "%s%i" ), InThreadName, index ).c_str(), false, false, 0, InThreadPriority );
+		Assert( thread );
+
+		workers.push_back( worker );
+		threads.push_back( thread );
+	}
+
+	Logf( TEXT( "Thread pool '%s' started with %i worker threads\n" ), InThreadName, InNumThreads );
+}
+
+/*
+==================
+CThreadPool::Shutdown
+==================
+*/
+void CThreadPool::Shutdown()
+{
+	if ( !workSemaphore )
+	{
+		return;
+	}
+
+	// Wake up all worker threads and wait when they will exit
+	Sys_InterlockedExchange( &bIsStopping, 1 );
+	if ( !threads.empty() )
+	{
+		workSemaphore->Post( threads.size() );
+	}
+
+	for ( uint32 index = 0, count = threads.size(); index < count; ++index )
+	{
+		threads[index]->WaitForCompletion();
+		delete threads[index];
+		delete workers[index];
+	}
+	threads.clear();
+	workers.clear();
+	threadIds.clear();
+
+	// Execute left tasks on the calling thread, so nobody will wait them forever
+	for ( CThreadPoolTask* task = PopTask(); task; task = PopTask() )
+	{
+		task->Execute();
+	}
+
+	// Delete free helper tasks of ParallelFor
+	while ( freeParallelForTasks )
+	{
+		CParallelForTask*	task = freeParallelForTasks;
+		freeParallelForTasks = task->nextFreeTask;
+		delete task;
+	}
+
+	delete workSemaphore;
+	workSemaphore = nullptr;
+}
+
+/*
+==================
+CThreadPool::AddTask
+==================
+*/
+void CThreadPool::AddTask( CThreadPoolTask* InTask )
+{
+	Assert( InTask );
+	InTask->Reset();
+
+	// If we don't have worker threads then execute the task right now
+	if ( threads.empty() )
+	{
+		InTask->Execute();
+		return;
+	}
+
+	{
+		CScopeLock		scopeLock( mutex );
+		InTask->nextQueuedTask = nullptr;
+		if ( queueTail )
+		{
+			queueTail->nextQueuedTask = InTask;
+		}
+		else
+		{
+			queueHead = InTask;
+		}
+		queueTail = InTask;
+	}
+	workSemaphore->Signal();
+}
+
+/*
+==================
+CThreadPool::RetractTask
+==================
+*/
+bool CThreadPool::RetractTask( CThreadPoolTask* InTask )
+{
+	CScopeLock			scopeLock( mutex );
+	CThreadPoolTask*	prevTask = nullptr;
+	for ( CThreadPoolTask* task = queueHead; task; prevTask = task, task = task->nextQueuedTask )
+	{
+		if ( task == InTask )
+		{
+			if ( prevTask )
+			{
+				prevTask->nextQueuedTask = task->nextQueuedTask;
+			}
+			else
+			{
+				queueHead = task->nextQueuedTask;
+			}
+
+			if ( queueTail == task )
+			{
+				queueTail = prevTask;
+			}
+			task->nextQueuedTask = nullptr;
+
+			// Nobody will execute the task, so mark it as done
+			Sys_InterlockedExchange( &InTask->bIsDone, 1 );
+			InTask->doneEvent->Trigger();
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+==================
+CThreadPool::PopTask
+==================
+*/
+CThreadPoolTask* CThreadPool::PopTask()
+{
+	CScopeLock			scopeLock( mutex );
+	CThreadPoolTask*	task = queueHead;
+	if ( task )
+	{
+		queueHead = task->nextQueuedTask;
+		if ( !queueHead )
+		{
+			queueTail = nullptr;
+		}
+		task->nextQueuedTask = nullptr;
+	}
+	return task;
+}
+
+/*
+==================
+CThreadPool::ParallelForInternal
+==================
+*/
+void CThreadPool::ParallelForInternal( uint32 InNum, ParallelForCallback_t InCallback, const void* InFunction, uint32 InBatchSize, bool InIsForceSingleThread )
+{
+	if ( InNum == 0 )
+	{
+		return;
+	}
+
+	// Process all indices on the calling thread if we can't or don't want to use worker threads
+	InBatchSize = Max<uint32>( InBatchSize, 1 );
+	uint32		numBatches = ( InNum + InBatchSize - 1 ) / InBatchSize;
+	if ( InIsForceSingleThread || threads.empty() || numBatches == 1 )
+	{
+		for ( uint32 index = 0; index < InNum; ++index )
+		{
+			InCallback( InFunction, index );
+		}
+		return;
+	}
+
+	// Keys of work items don't depend on which thread processes them. Calls of the game thread are numbered in their order,
+	// nested calls are numbered within the work item which makes them. The low 32 bits of the key are the index of the item
+	uint64		callKey = 0;
+	if ( s_CurrentWorkItemKey != 0 )
+	{
+		callKey = FastHash( ++s_NumNestedParallelFors, s_CurrentWorkItemKey ) & 0xFFFFFFFF00000000ull;
+	}
+	else if ( IsInGameThread() )
+	{
+		callKey = ( uint64 )( ++s_NumGameThreadParallelFors ) << 32;
+	}
+
+	// Take helper tasks from the pool, new ones are created only when the pool runs out of them
+	volatile int32		nextIndex = 0;
+	uint32				numTasks = Min<uint32>( threads.size(), numBatches - 1 );
+	CParallelForTask*	tasks = nullptr;
+	{
+		CScopeLock		scopeLock( mutex );
+		for ( uint32 index = 0; index < numTasks; ++index )
+		{
+			CParallelForTask*	task = freeParallelForTasks;
+			if ( task )
+			{
+				freeParallelForTasks = task->nextFreeTask;
+			}
+			else
+			{
+				task = new CParallelForTask();
+			}
+
+			task->nextFreeTask	= tasks;
+			tasks				= task;
+		}
+	}
+
+	// Kick off helper tasks, the calling thread will do its part of work too
+	for ( CParallelForTask* task = tasks; task; task = task->nextFreeTask )
+	{
+		task->Setup( InNum, InBatchSize, InCallback, InFunction, &nextIndex, callKey );
+		AddTask( task );
+	}
+
+	CParallelForTask::Process( InNum, InBatchSize, InCallback, InFunction, &nextIndex, callKey );
+
+	// All indices are taken, so helper tasks which still in the queue have nothing to do.
+	// Retract them (it's important when we are called from a worker thread and the pool is busy) and wait others
+	CParallelForTask*	lastTask = nullptr;
+	for ( CParallelForTask* task = tasks; task; task = task->nextFreeTask )
+	{
+		if ( !RetractTask( task ) )
+		{
+			task->Wait();
+		}
+		lastTask = task;
+	}
+
+	// Return helper tasks into the pool
+	CScopeLock		scopeLock( mutex );
+	lastTask->nextFreeTask	= freeParallelForTasks;
+	freeParallelForTasks	= tasks;
+}
+
+/*
+==================
+CThreadPool::GetCurrentWorkItemKey
+==================
+*/
+uint64 CThreadPool::GetCurrentWorkItemKey()
+{
+	return s_CurrentWorkItemKey;
+}
+
+/*
+==================
+CThreadPool::IsInWorkerThread
+==================
+*/
+bool CThreadPool::IsInWorkerThread() const
+{
+	return GetCurrentWorkerIndex() != INDEX_NONE;
+}
+
+/*
+==================
+CThreadPool::GetCurrentWorkerIndex
+==================
+*/
+uint32 CThreadPool::GetCurrentWorkerIndex() const
+{
+	uint32		currentThreadId = Sys_GetCurrentThreadId();
+	for ( uint32 index = 0, count = threadIds.size(); index < count; ++index )
+	{
+		if ( threadIds[index] == currentThreadId )
+		{
+			return index;
+		}
+	}
+	return INDEX_NONE;
+}
@@ -27,6 +27,19 @@
  */
 DECLARE_MULTICAST_DELEGATE( COnActorDestroyed, class AActor* );
 
+/**
+ * @ingroup Engine
+ * @brief Tick groups of actors
+ * Groups are ticked one after another in CWorld::Tick
+ */
+enum ETickingGroup
+{
+	TG_PrePhysics,			/**< Ticked before physics simulation. Default group */
+	TG_DuringPhysics,		/**< May be ticked concurrently with physics simulation and don't see its results of this frame. Access to physics waits for the simulation, so actors of this group are always ticked on the game thread */
+	TG_PostPhysics,			/**< Ticked after physics simulation, actors see its results */
+	TG_Max					/**< Number of tick groups */
+};
+
 /**
  * @ingroup Engine
  * @brief Base class of all actors in world
@@ -50,6 +63,12 @@ public:
 	 */
 	virtual void BeginDestroy() override;
 
+	/**
+	 * @brief Can the object be grouped into a GC cluster
+	 * @return Return TRUE if the object can be in a GC cluster, otherwise returns FALSE
+	 */
+	virtual bool CanBeInCluster() const override;
+
 	/**
 	 * @brief Overridable native event for when play begins for this actor
 	 */
@@ -96,9 +115,88 @@ public:
 
 	/**
 	 * @brief Sync actor to physics body
+	 * @note Physics isn't thread safe, so it's always called on the game thread after the actor is ticked
 	 */
 	void SyncPhysics();
 
+	/**
+	 * @brief Add tick prerequisite actor
+	 * The actor will be ticked after the prerequisite one if they are in the same tick group. Prerequisites from
+	 * earlier groups are always ticked before, prerequisites from later groups are ignored
+	 *
+	 * @param InPrerequisiteActor	Prerequisite actor
+	 */
+	void AddTickPrerequisiteActor( AActor* InPrerequisiteActor );
+
+	/**
+	 * @brief Remove tick prerequisite actor
+	 * @param InPrerequisiteActor	Prerequisite actor
+	 */
+	void RemoveTickPrerequisiteActor( AActor* InPrerequisiteActor );
+
+	/**
+	 * @brief Add tick prerequisite component
+	 * Components are ticked by their owner, so the owner of the component becomes the prerequisite actor
+	 *
+	 * @param InPrerequisiteComponent	Prerequisite component
+	 */
+	void AddTickPrerequisiteComponent( CActorComponent* InPrerequisiteComponent );
+
+	/**
+	 * @brief Remove tick prerequisite component
+	 * @param InPrerequisiteComponent	Prerequisite component
+	 */
+	void RemoveTickPrerequisiteComponent( CActorComponent* InPrerequisiteComponent );
+
+	/**
+	 * @brief Get tick prerequisites
+	 * @return Return array of prerequisite actors
+	 */
+	FORCEINLINE const std::vector<AActor*>& GetTickPrerequisites() const
+	{
+		return tickPrerequisites;
+	}
+
+	/**
+	 * @brief Set tick group
+	 * @param InTickGroup	Tick group
+	 */
+	FORCEINLINE void SetTickGroup( ETickingGroup InTickGroup )
+	{
+		tickGroup = InTickGroup;
+	}
+
+	/**
+	 * @brief Get tick group
+	 * @return Return tick group of the actor
+	 */
+	FORCEINLINE ETickingGroup GetTickGroup() const
+	{
+		return tickGroup;
+	}
+
+	/**
+	 * @brief Set whether the actor is allowed to tick on any thread
+	 * Such actors are ticked on worker threads in parallel with each other, so their tick must not spawn or destroy actors,
+	 * touch physics, audio, rendering or other actors except tick prerequisites. It's ignored for TG_DuringPhysics,
+	 * because physics can be waited for only from the game thread
+	 *
+	 * @param InIsAllowTickOnAnyThread	Is allowed to tick on any thread
+	 */
+	FORCEINLINE void SetAllowTickOnAnyThread( bool InIsAllowTickOnAnyThread )
+	{
+		bAllowTickOnAnyThread = InIsAllowTickOnAnyThread;
+	}
+
+	/**
+	 * @brief Is the actor allowed to tick on any thread
+	 * @return Return TRUE if the actor is allowed to tick on any thread, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsAllowTickOnAnyThread() const
+	{
+		return bAllowTickOnAnyThread && tickGroup != TG_DuringPhysics;
+	}
+
 #if WITH_EDITOR
 	/**
 	 * @brief Get path to icon of actor for exploer level in WorldEd
@@ -479,16 +577,26 @@ private:
 	 */
 	CWorld* GetWorld_Uncached() const;
 
+	/**
+	 * @brief Remove this actor from tick prerequisites of other actors and drop its own prerequisites
+	 * Called when the actor is destroyed, so no one keeps a pointer to it
+	 */
+	void ResetTickPrerequisites();
+
 	bool										bIsStatic;				/**< Is static actor */
 	bool										bNeedReinitCollision;	/**< Is need reinit collision component */
 	bool										bActorIsBeingDestroyed;	/**< Actor is being destroyed */
 	bool										bBeginPlay;				/**< Is begin play for this actor */
 	bool										bVisibility;			/**< Is actor visibility */
+	bool										bAllowTickOnAnyThread;	/**< Is allowed to tick on any thread */
 
 #if WITH_EDITOR
 	bool										bSelected;				/**< Is selected this actor */
 #endif // WITH_EDITOR
 
+	ETickingGroup								tickGroup;				/**< Tick group */
+	std::vector<AActor*>						tickPrerequisites;		/**< Actors which must be ticked before this one */
+	std::vector<AActor*>						tickDependents;			/**< Actors which have this one as a tick prerequisite */
 	class CWorld*								worldPrivate;			/**< Pointer to world where this actor is */
 	std::vector<CActorComponent*>				ownedComponents;		/**< Owned components */
 	mutable COnActorDestroyed					onActorDestroyed;		/**< Called event when actor is destroyed */
@@ -29,6 +29,12 @@ public:
 	 */
 	CActorComponent();
 
+	/**
+	 * @brief Can the object be grouped into a GC cluster
+	 * @return Return TRUE if the object can be in a GC cluster, otherwise returns FALSE
+	 */
+	virtual bool CanBeInCluster() const override;
+
 	/**
 	 * Begins Play for the component.
 	 * Called when the owning Actor begins play or when the component is created if the Actor has already begun play.
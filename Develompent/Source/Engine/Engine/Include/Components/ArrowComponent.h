@@ -26,11 +26,12 @@ public:
 	CArrowComponent();
 
 	/**
-	 * @brief Adds mesh batches for draw in scene
+	 * @brief Prepare the primitive for adding to draw lists
 	 *
 	 * @param InSceneView Current view of scene
+	 * @return Return TRUE if the primitive has instances to add by AddToDrawList, otherwise returns FALSE
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual bool PrepareDrawList( const class CSceneView& InSceneView ) override;
 
 	/**
 	 * @brief Set length
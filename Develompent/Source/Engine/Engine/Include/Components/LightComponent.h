@@ -11,8 +11,10 @@
 
 #include "Misc/RefCountPtr.h"
 #include "Math/Color.h"
+#include "Math/Box.h"
 #include "Components/SceneComponent.h"
 #include "Actors/Actor.h"
+#include "Render/RenderingThread.h"
 
 /**
  * @ingroup Engine
@@ -27,6 +29,33 @@ enum ELightType
 	LT_Num				/**< Number of light types */
 };
 
+/**
+ * @ingroup Engine
+ * Parameters of light which are used by the rendering thread
+ */
+struct LightRenderParameters
+{
+	/**
+	 * @brief Constructor
+	 */
+	LightRenderParameters()
+		: bEnabled( false )
+		, lightColor( CColor::white )
+		, intensivity( 0.f )
+		, radius( 0.f )
+		, height( 0.f )
+		, cutoff( 0.f )
+	{}
+
+	bool			bEnabled;		/**< Is enabled the light component */
+	CColor			lightColor;		/**< Light color */
+	float			intensivity;	/**< Intensivity */
+	CTransform		transform;		/**< Transform of the light in world space */
+	float			radius;			/**< Radius of point and spot lights */
+	float			height;			/**< Height of spot lights */
+	float			cutoff;			/**< Cutoff of spot lights */
+};
+
 /**
  * @ingroup Engine
  * Component of base light
@@ -50,6 +79,14 @@ public:
 	 */
 	virtual void BeginDestroy() override;
 
+	/**
+	 * @brief Called to check if the object is ready for FinishDestroy
+	 * The rendering thread may still use the component in frames in flight, so it waits for the fence which is begun in BeginDestroy
+	 *
+	 * @return Return TRUE if the object's asynchronous cleanup has completed and it is ready for FinishDestroy to be called
+	 */
+	virtual bool IsReadyForFinishDestroy() const override;
+
 	/**
 	 * @brief Called when the owning Actor is spawned
 	 */
@@ -60,6 +97,20 @@ public:
 	 */
 	virtual void Destroyed() override;
 
+#if WITH_EDITOR
+	/**
+	 * @brief Function called by the editor when property is changed
+	 * @param InPropertyChangedEvenet    Property changed event
+	 */
+	virtual void PostEditChangeProperty( const PropertyChangedEvenet& InPropertyChangedEvenet ) override;
+#endif // WITH_EDITOR
+
+	/**
+	 * @brief Mark render state as dirty
+	 * Sends the current bound box and parameters to the rendering thread, which updates the light's location in the spatial index
+	 */
+	void MarkRenderStateDirty();
+
 	/**
 	 * @brief Set enable the light component
 	 * @param InEnabled		Is enabled the light component
@@ -67,6 +118,7 @@ public:
 	FORCEINLINE void SetEnabled( bool InEnabled )
 	{
 		bEnabled = InEnabled;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -76,6 +128,7 @@ public:
 	FORCEINLINE void SetLightColor( const CColor& InLightColor )
 	{
 		lightColor = InLightColor;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -85,6 +138,7 @@ public:
 	FORCEINLINE void SetIntensivity( float InIntensivity )
 	{
 		intensivity = InIntensivity;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -104,6 +158,22 @@ public:
 	 */
 	virtual ELightType GetLightType() const;
 
+	/**
+	 * @brief Get bound box of the light influence in world space
+	 * Need override the method by child for culling the light. By default returns invalid box, so the light is always visible
+	 *
+	 * @return Return bound box of the light influence
+	 */
+	virtual CBox GetBoundBox() const;
+
+	/**
+	 * @brief Get parameters of the light for rendering
+	 * Need override the method by child for adding its own parameters
+	 *
+	 * @param OutParameters		Output parameters of the light
+	 */
+	virtual void GetRenderParameters( LightRenderParameters& OutParameters ) const;
+
 	/**
 	 * @brief Is enabled
 	 * @return Return TRUE if the light component is enabled
@@ -131,11 +201,40 @@ public:
 		return intensivity;
 	}
 
+	/**
+	 * @brief Get parameters of the light which are used by the rendering thread
+	 * @note Must be called only from the rendering thread
+	 *
+	 * @return Return parameters of the light for rendering
+	 */
+	FORCEINLINE const LightRenderParameters& GetRenderParameters_RenderThread() const
+	{
+		return renderParameters;
+	}
+
+	/**
+	 * @brief Is enabled for rendering
+	 * @note Must be called only from the rendering thread
+	 *
+	 * @return Return TRUE if the light component is enabled for rendering
+	 */
+	FORCEINLINE bool IsEnabled_RenderThread() const
+	{
+		return renderParameters.bEnabled && ( GetOwner() ? GetOwner()->IsVisibility() : true );
+	}
+
 protected:
-	bool				bEnabled;		/**< Is enabled the light component */
-	class CScene*		scene;			/**< The current scene where the primitive is located  */
-	CColor				lightColor;		/**< Light color */
-	float				intensivity;	/**< intensivity */
+	/**
+	 * @brief Called when transform of the component in world space has been changed
+	 */
+	virtual void OnTransformChanged() override;
+
+	bool						bEnabled;			/**< Is enabled the light component */
+	class CScene*				scene;				/**< The current scene where the primitive is located  */
+	CRenderFence				detachFence;		/**< Fence which is passed when the rendering thread doesn't use the light anymore */
+	CColor						lightColor;			/**< Light color */
+	float						intensivity;		/**< intensivity */
+	LightRenderParameters		renderParameters;	/**< Parameters of the light which are used for rendering. Owned by the rendering thread, it's sent by the scene */
 };
 
 #endif // !LIGHTCOMPONENT_H
\ No newline at end of file
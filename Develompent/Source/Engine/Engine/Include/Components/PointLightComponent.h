@@ -39,6 +39,7 @@ public:
 	FORCEINLINE void SetRadius( float InRadius )
 	{
 		radius = InRadius;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -49,6 +50,18 @@ public:
 	 */
 	virtual ELightType GetLightType() const override;
 
+	/**
+	 * @brief Get bound box of the light influence in world space
+	 * @return Return bound box of the light influence
+	 */
+	virtual CBox GetBoundBox() const override;
+
+	/**
+	 * @brief Get parameters of the light for rendering
+	 * @param OutParameters		Output parameters of the light
+	 */
+	virtual void GetRenderParameters( LightRenderParameters& OutParameters ) const override;
+
 	/**
 	 * @brief Get radius
 	 * @return Return radius
@@ -13,6 +13,7 @@
 #include "System/PhysicsBodySetup.h"
 #include "System/PhysicsBodyInstance.h"
 #include "Components/SceneComponent.h"
+#include "Render/RenderingThread.h"
 
 /**
  * @ingroup Engine
@@ -37,6 +38,14 @@ public:
 	 */
 	virtual void BeginDestroy() override;
 
+	/**
+	 * @brief Called to check if the object is ready for FinishDestroy
+	 * The rendering thread may still use the component in frames in flight, so it waits for the fence which is begun in BeginDestroy
+	 *
+	 * @return Return TRUE if the object's asynchronous cleanup has completed and it is ready for FinishDestroy to be called
+	 */
+	virtual bool IsReadyForFinishDestroy() const override;
+
 	/**
 	 * Function called every frame on this ActorComponent. Override this function to implement custom logic to be executed every frame.
 	 *
@@ -44,12 +53,24 @@ public:
 	 */
 	virtual void TickComponent( float InDeltaTime );
 
+	/**
+	 * @brief Prepare the primitive for adding to draw lists
+	 * Called for each visible primitive on the thread which builds the view before AddToDrawList. Here the primitive updates
+	 * links to draw lists of the scene and does other work which isn't thread safe (e.g. adds debug lines)
+	 *
+	 * @param InSceneView Current view of scene
+	 * @return Return TRUE if the primitive has instances to add by AddToDrawList, otherwise returns FALSE
+	 */
+	virtual bool PrepareDrawList( const class CSceneView& InSceneView );
+
 	/**
 	 * @brief Adds mesh batches for draw in scene
+	 * @note Called from worker threads, the primitive must add instances only into InOutInstanceBuffer and must not change the scene
 	 * 
-     * @param InSceneView Current view of scene
+     * @param InSceneView			Current view of scene
+	 * @param InOutInstanceBuffer	Buffer of mesh instances
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView );
+	virtual void AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const;
 
 	/**
 	 * @brief Called when the owning Actor is spawned
@@ -101,6 +122,26 @@ public:
 	 */
 	bool IsVisibility() const;
 
+#if WITH_EDITOR
+	/**
+	 * @brief Function called by the editor when property is changed
+	 * @param InPropertyChangedEvenet    Property changed event
+	 */
+	virtual void PostEditChangeProperty( const PropertyChangedEvenet& InPropertyChangedEvenet ) override;
+#endif // WITH_EDITOR
+
+	/**
+	 * @brief Update bound box in world space
+	 * Override this function to calculate bound box of the primitive from renderTransform. Called by the scene on the rendering thread when bounds are dirty
+	 */
+	virtual void UpdateBounds();
+
+	/**
+	 * @brief Mark bound box as dirty
+	 * Sends the current transform to the rendering thread. The scene will update the bound box and the primitive's location in the spatial index on the next built view
+	 */
+	void MarkBoundsDirty();
+
 	/**
 	 * @brief Get bound box
 	 * @return Return bound box
@@ -148,21 +189,32 @@ public:
 
 protected:
 	/**
-	 * @brief Adds a draw policy link in SDGs
+	 * @brief Called when transform of the component in world space has been changed
+	 */
+	virtual void OnTransformChanged() override;
+
+	/**
+	 * @brief Adds a draw policy link in SDGs of renderScene
+	 * @note Called from the rendering thread
 	 */
 	virtual void LinkDrawList();
 
 	/**
-	 * @brief Removes a draw policy link from SDGs
+	 * @brief Removes a draw policy link from SDGs of renderScene
+	 * @note Called from the rendering thread
 	 */
 	virtual void UnlinkDrawList();
 
 	bool						bVisibility;					/**< Is primitive visibility */
 	bool						bIsDirtyDrawingPolicyLink;		/**< Is dirty drawing policy link. If flag equal true - need update drawing policy link */
-	CBox						boundbox;						/**< Bound box */
+	bool						bIsDirtyBounds;					/**< Is dirty bound box. If flag equal true - the primitive is in queue of the scene to update bounds. Owned by the rendering thread */
+	CBox						boundbox;						/**< Bound box. Owned by the rendering thread */
 	PhysicsBodySetupRef_t		bodySetup;						/**< Physics body setup */
 	CPhysicsBodyInstance		bodyInstance;					/**< Physics body instance */	
 	class CScene*				scene;							/**< The current scene where the primitive is located  */
+	class CScene*				renderScene;					/**< The scene whose draw lists the primitive is linked to. Owned by the rendering thread */
+	CTransform					renderTransform;				/**< Transform of the component in world space which is used for rendering. Owned by the rendering thread, it's sent by the scene */
+	CRenderFence				detachFence;					/**< Fence which is passed when the rendering thread doesn't use the primitive anymore */
 };
 
 #endif // !PRIMITIVECOMPONENT_H
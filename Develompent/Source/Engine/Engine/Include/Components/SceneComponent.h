@@ -112,7 +112,7 @@ public:
 		if ( InLocation != GetRelativeLocation() )
 		{
 			relativeLocation		= InLocation;
-			bDityComponentToWorld	= true;
+			MarkComponentToWorldDirty();
 		}
 	}
 
@@ -127,7 +127,7 @@ public:
 		if ( !newRelativeRotation.Equals( GetRelativeRotation() ) )
 		{
 			relativeRotation		= newRelativeRotation;
-			bDityComponentToWorld	= true;
+			MarkComponentToWorldDirty();
 			relativeRotationCache.QuatToRotator( InRotation );
 		}
 	}
@@ -142,7 +142,7 @@ public:
 		if ( !InRotation.Equals( GetRelativeRotation() ) )
 		{
 			relativeRotation		= InRotation;
-			bDityComponentToWorld	= true;
+			MarkComponentToWorldDirty();
 			relativeRotationCache.RotatorToQuat( InRotation );
 		}
 	}
@@ -157,7 +157,7 @@ public:
 		if ( InScale != GetRelativeScale() )
 		{
 			relativeScale			= InScale;
-			bDityComponentToWorld	= true;
+			MarkComponentToWorldDirty();
 		}
 	}
 
@@ -266,7 +266,20 @@ public:
 		return attachChildren;
 	}
 
+protected:
+	/**
+	 * @brief Called when transform of the component in world space has been changed
+	 * Override this function to update data which depends on the transform (e.g. bounds in the scene)
+	 */
+	virtual void OnTransformChanged();
+
 private:
+	/**
+	 * @brief Mark component to world transform as dirty
+	 * Also marks all attached children, because their world transform depends on us
+	 */
+	void MarkComponentToWorldDirty();
+
 	/**
 	 * @brief Update component to world
 	 */
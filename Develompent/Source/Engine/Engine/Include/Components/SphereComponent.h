@@ -39,11 +39,20 @@ public:
 	virtual void UpdateBodySetup() override;
 
 	/**
-	 * @brief Adds mesh batches for draw in scene
+	 * @brief Prepare the primitive for adding to draw lists
 	 *
 	 * @param InSceneView Current view of scene
+	 * @return Return TRUE if the primitive has instances to add by AddToDrawList, otherwise returns FALSE
+	 */
+	virtual bool PrepareDrawList( const class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Adds mesh batches for draw in scene
+	 *
+	 * @param InSceneView			Current view of scene
+	 * @param InOutInstanceBuffer	Buffer of mesh instances
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual void AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const override;
 
 #if WITH_EDITOR
 	/**
@@ -52,6 +52,7 @@ public:
 	{
 		radius = InRadius;
 		bNeedUpdateCutoff = true;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -62,6 +63,7 @@ public:
 	{
 		height = InHeight;
 		bNeedUpdateCutoff = true;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -72,6 +74,18 @@ public:
 	 */
 	virtual ELightType GetLightType() const override;
 
+	/**
+	 * @brief Get bound box of the light influence in world space
+	 * @return Return bound box of the light influence
+	 */
+	virtual CBox GetBoundBox() const override;
+
+	/**
+	 * @brief Get parameters of the light for rendering
+	 * @param OutParameters		Output parameters of the light
+	 */
+	virtual void GetRenderParameters( LightRenderParameters& OutParameters ) const override;
+
 	/**
 	 * @brief Get radius
 	 * @return Return radius
@@ -50,11 +50,25 @@ public:
     CSpriteComponent();
 
 	/**
-	 * @brief Adds mesh batches for draw in scene
+	 * @brief Prepare the primitive for adding to draw lists
 	 *
 	 * @param InSceneView Current view of scene
+	 * @return Return TRUE if the primitive has instances to add by AddToDrawList, otherwise returns FALSE
+	 */
+	virtual bool PrepareDrawList( const class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Adds mesh batches for draw in scene
+	 *
+	 * @param InSceneView			Current view of scene
+	 * @param InOutInstanceBuffer	Buffer of mesh instances
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const override;
+
+	/**
+	 * @brief Update bound box in world space
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual void UpdateBounds() override;
 
 	/**
 	 * @brief Serialize component
@@ -84,6 +98,7 @@ public:
     FORCEINLINE void SetType( ESpriteType InType )
     {
         type = InType;
+        MarkBoundsDirty();
     }
 
     /**
@@ -122,6 +137,7 @@ public:
 	{
 		sprite->SetSpriteSize( InSpriteSize );
 		bIsDirtyDrawingPolicyLink = true;
+		MarkBoundsDirty();
 	}
 
 	/**
@@ -43,11 +43,25 @@ public:
 	virtual void PostLoad() override;
 
 	/**
-	 * @brief Adds mesh batches for draw in scene
+	 * @brief Prepare the primitive for adding to draw lists
 	 *
 	 * @param InSceneView Current view of scene
+	 * @return Return TRUE if the primitive has instances to add by AddToDrawList, otherwise returns FALSE
+	 */
+	virtual bool PrepareDrawList( const class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Adds mesh batches for draw in scene
+	 *
+	 * @param InSceneView			Current view of scene
+	 * @param InOutInstanceBuffer	Buffer of mesh instances
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual void AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const override;
+
+	/**
+	 * @brief Update bound box in world space
+	 */
+	virtual void UpdateBounds() override;
 
     /**
      * @brief Set material
@@ -66,7 +80,7 @@ public:
 		}
 	
 		overrideMaterials[InIndex] = material;
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty();
     }
 
 	/**
@@ -88,7 +102,8 @@ public:
 				}
 			}
 		}
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty();
+		MarkBoundsDirty();
 	}
 
 	/**
@@ -131,9 +146,17 @@ private:
 	 */
 	virtual void UnlinkDrawList() override;
 
+	/**
+	 * @brief Mark render state as dirty
+	 * Sends the static mesh and override materials to the rendering thread, which relinks the draw lists on the next built view
+	 */
+	void MarkRenderStateDirty();
+
 	TAssetHandle<CStaticMesh>								staticMesh;						/**< Static mesh */
-	TAssetHandle<CStaticMesh>								drawStaticMesh;					/**< Static mesh which drawing now */
+	TAssetHandle<CStaticMesh>								drawStaticMesh;					/**< Static mesh which drawing now. Owned by the rendering thread */
 	std::vector< TAssetHandle<CMaterial> >					overrideMaterials;				/**< Override materials */
+	TAssetHandle<CStaticMesh>								renderStaticMesh;				/**< Static mesh which is used for rendering. Owned by the rendering thread, it's sent by MarkRenderStateDirty */
+	std::vector< TAssetHandle<CMaterial> >					renderOverrideMaterials;		/**< Override materials which are used for rendering. Owned by the rendering thread, it's sent by MarkRenderStateDirty */
 	TSharedPtr<CStaticMesh::ElementDrawingPolicyLink>		elementDrawingPolicyLink;		/**< Element drawing policy link of current static mesh */
 };
 
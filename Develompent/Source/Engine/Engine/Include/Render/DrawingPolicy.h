@@ -14,6 +14,36 @@
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Core.h"
 
+/**
+ * @ingroup Engine
+ * @brief Key to sort drawing policies by render state
+ * Drawing policies with equal bound shader state are placed next to each other, inside them policies with equal material and so on
+ */
+struct MeshDrawingPolicySortKey
+{
+	/**
+	 * @brief Overrload operator <
+	 */
+	FORCEINLINE bool operator<( const MeshDrawingPolicySortKey& InOther ) const
+	{
+		if ( boundShaderStateKey != InOther.boundShaderStateKey )
+		{
+			return boundShaderStateKey < InOther.boundShaderStateKey;
+		}
+
+		if ( materialKey != InOther.materialKey )
+		{
+			return materialKey < InOther.materialKey;
+		}
+
+		return vertexFactoryKey < InOther.vertexFactoryKey;
+	}
+
+	uint64		boundShaderStateKey;	/**< Key of bound shader state (vertex declaration and shaders) */
+	uint64		materialKey;			/**< Key of material. Textures are bound by material parameters, so it's the key of textures too */
+	uint64		vertexFactoryKey;		/**< Key of vertex factory (vertex streams) */
+};
+
 /**
  * @ingroup Engine
  * The base mesh drawing policy.  Subclasses are used to draw meshes with type-specific context variables.
@@ -86,6 +116,12 @@ public:
 	 */
 	virtual uint64 GetTypeHash() const;
 
+	/**
+	 * @brief Get key to sort drawing policies by render state
+	 * @return Return sort key of the drawing policy
+	 */
+	virtual MeshDrawingPolicySortKey GetSortKey() const;
+
 	/**
 	 * @brief Compare drawing policy
 	 * 
@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef FRAMEALLOCATOR_H
+#define FRAMEALLOCATOR_H
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/LinearAllocator.h"
+#include "Render/RenderingThread.h"
+
+/**
+ * @ingroup Engine
+ * @brief Number of buffers in the frame allocator, one per frame in flight plus the frame which the game thread is filling
+ */
+#define FRAME_ALLOCATOR_NUM_BUFFERS		( RENDER_MAX_FRAMES_IN_FLIGHT + 1 )
+
+/**
+ * @ingroup Engine
+ * @brief Allocator of transient data which lives one frame
+ *
+ * The allocator has a linear allocator per frame in flight. The game thread fills a frame while the rendering thread
+ * renders one of the previous ones, so both threads allocate from the buffer of the frame they are working on.
+ * A buffer is reset when the game thread begins a new frame with it, at this moment the rendering thread is done with it
+ */
+class CFrameAllocator
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CFrameAllocator();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CFrameAllocator();
+
+	/**
+	 * @brief Get instance of the frame allocator
+	 * @return Return instance of the frame allocator
+	 */
+	static FORCEINLINE CFrameAllocator& Get()
+	{
+		static CFrameAllocator	s_FrameAllocator;
+		return s_FrameAllocator;
+	}
+
+	/**
+	 * @brief Begin a new frame on the game thread
+	 * Waits until the rendering thread finishes the frame which used the same buffer, resets the buffer
+	 * and sends to the rendering thread a command to begin the frame too
+	 */
+	void BeginFrame();
+
+	/**
+	 * @brief Begin a frame on the rendering thread
+	 * @note Called by the render command which is sent in BeginFrame
+	 *
+	 * @param InFrameNumber		Number of the frame
+	 */
+	void BeginRenderingFrame( uint32 InFrameNumber );
+
+	/**
+	 * @brief Get allocator of the frame on the game thread
+	 * @return Return allocator of the frame which the game thread is filling
+	 */
+	CLinearAllocator& GetGameThreadAllocator();
+
+	/**
+	 * @brief Get allocator of the frame on the rendering thread
+	 * @note Memory can be allocated from worker threads too, but the allocator must be got on the rendering thread
+	 * @return Return allocator of the frame which the rendering thread is rendering
+	 */
+	CLinearAllocator& GetRenderingThreadAllocator();
+
+private:
+	CLinearAllocator*		buffers[FRAME_ALLOCATOR_NUM_BUFFERS];		/**< Allocators of frames in flight */
+	CRenderFence			fences[FRAME_ALLOCATOR_NUM_BUFFERS];		/**< Fences which are passed when the rendering thread doesn't use the buffer anymore */
+	uint32					gameFrameNumber;							/**< Number of the frame on the game thread */
+	volatile int32			renderingFrameNumber;						/**< Number of the frame on the rendering thread */
+};
+
+/**
+ * @ingroup Engine
+ * @brief STL allocator which allocates from the frame allocator of the rendering thread
+ * @note Use it only for containers which are created and destroyed on the rendering thread within one frame
+ */
+template<typename TType>
+class TRenderFrameAllocator
+{
+public:
+	typedef TType		value_type;
+
+	/**
+	 * @brief Constructor
+	 */
+	TRenderFrameAllocator() = default;
+
+	/**
+	 * @brief Constructor of copy from allocator of other type
+	 */
+	template<typename TOtherType>
+	TRenderFrameAllocator( const TRenderFrameAllocator<TOtherType>& )
+	{}
+
+	/**
+	 * @brief Allocate memory for elements
+	 *
+	 * @param InNum		Number of elements
+	 * @return Return pointer to allocated memory
+	 */
+	FORCEINLINE TType* allocate( std::size_t InNum )
+	{
+		return ( TType* )CFrameAllocator::Get().GetRenderingThreadAllocator().Allocate( InNum * sizeof( TType ), alignof( TType ) );
+	}
+
+	/**
+	 * @brief Free memory of elements, it does nothing because memory is released at once when the frame ends
+	 */
+	FORCEINLINE void deallocate( TType* InPtr, std::size_t InNum )
+	{}
+
+	/**
+	 * @brief Overload operator ==
+	 */
+	template<typename TOtherType>
+	FORCEINLINE bool operator==( const TRenderFrameAllocator<TOtherType>& ) const
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Overload operator !=
+	 */
+	template<typename TOtherType>
+	FORCEINLINE bool operator!=( const TRenderFrameAllocator<TOtherType>& ) const
+	{
+		return false;
+	}
+};
+
+#endif // !FRAMEALLOCATOR_H
@@ -9,8 +9,22 @@
 #ifndef FRUSTUM_H
 #define FRUSTUM_H
 
+#include <vector>
+
 #include "Math/Math.h"
 #include "Math/Box.h"
+#include "Render/PackedBounds.h"
+
+/**
+ * @ingroup Engine
+ * Enumeration of result of testing box with frustum
+ */
+enum EFrustumIntersection
+{
+	FI_Outside,		/**< Box is outside of frustum */
+	FI_Intersect,	/**< Box intersects frustum */
+	FI_Inside		/**< Box is fully inside of frustum */
+};
 
 /**
  * @ingroup Engine
@@ -107,6 +121,43 @@ public:
 		return IsIn( InBox.GetMin(), InBox.GetMax() );
 	}
 
+	/**
+	 * Classify box against frustum
+	 * Useful for hierarchical culling: if the box is fully inside then nothing inside of it needs to be tested
+	 *
+	 * @param InCenter	Center of box
+	 * @param InExtents	Half size of box
+	 * @return Return whether the box is outside, intersects or fully inside of frustum
+	 */
+	FORCEINLINE EFrustumIntersection Intersect( const Vector& InCenter, const Vector& InExtents ) const
+	{
+		EFrustumIntersection	result = FI_Inside;
+		for ( uint32 index = 0; index < 6; ++index )
+		{
+			float	distance	= planes[ index ].x * InCenter.x + planes[ index ].y * InCenter.y + planes[ index ].z * InCenter.z + planes[ index ].w;
+			float	pushOut		= Math::Abs( planes[ index ].x ) * InExtents.x + Math::Abs( planes[ index ].y ) * InExtents.y + Math::Abs( planes[ index ].z ) * InExtents.z;
+			if ( distance + pushOut <= 0.f )
+			{
+				return FI_Outside;
+			}
+			else if ( distance - pushOut <= 0.f )
+			{
+				result = FI_Intersect;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Test array of boxes with frustum
+	 * Boxes are tested in groups by SIMD instructions if it is supported by platform
+	 *
+	 * @param InBounds				Packed bounds of boxes
+	 * @param OutVisibilityMask		Output visibility mask. Bit N of word N / 32 is set if box with index N is in frustum
+	 */
+	void CullBoxes( const CPackedBounds& InBounds, std::vector<uint32>& OutVisibilityMask ) const;
+
 	/**
 	 * Is sphere in frustum
 	 * 
@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PACKEDBOUNDS_H
+#define PACKEDBOUNDS_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+
+/**
+ * @ingroup Engine
+ * Number of boxes in one SIMD lane group. Arrays of packed bounds are always padded to it
+ */
+#define PACKEDBOUNDS_GROUP_SIZE			4
+
+/**
+ * @ingroup Engine
+ * Half size of invalid boxes. Such boxes are never culled
+ */
+#define PACKEDBOUNDS_INVALID_EXTENT		1.0e30f
+
+/**
+ * @ingroup Engine
+ * @brief Array of axis aligned boxes in structure of arrays layout
+ *
+ * Boxes are stored as center and half size (extents) split by components. This layout
+ * allows to test several boxes at one time with SIMD instructions (see CFrustum::CullBoxes)
+ */
+class CPackedBounds
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CPackedBounds()
+		: numBoxes( 0 )
+	{}
+
+	/**
+	 * @brief Add box
+	 *
+	 * @param InBox		Box
+	 * @return Return index of the added box
+	 */
+	FORCEINLINE uint32 Add( const CBox& InBox )
+	{
+		uint32		index = numBoxes++;
+		if ( numBoxes > centerX.size() )
+		{
+			Resize( Align( numBoxes, PACKEDBOUNDS_GROUP_SIZE ) );
+		}
+
+		Set( index, InBox );
+		return index;
+	}
+
+	/**
+	 * @brief Set box
+	 *
+	 * @param InIndex	Index of the box
+	 * @param InBox		Box
+	 */
+	FORCEINLINE void Set( uint32 InIndex, const CBox& InBox )
+	{
+		Assert( InIndex < numBoxes );
+		if ( InBox.IsValid() )
+		{
+			const Vector&	min = InBox.GetMin();
+			const Vector&	max = InBox.GetMax();
+			centerX[InIndex]	= ( min.x + max.x ) * 0.5f;
+			centerY[InIndex]	= ( min.y + max.y ) * 0.5f;
+			centerZ[InIndex]	= ( min.z + max.z ) * 0.5f;
+			extentX[InIndex]	= ( max.x - min.x ) * 0.5f;
+			extentY[InIndex]	= ( max.y - min.y ) * 0.5f;
+			extentZ[InIndex]	= ( max.z - min.z ) * 0.5f;
+		}
+		else
+		{
+			centerX[InIndex]	= centerY[InIndex] = centerZ[InIndex] = 0.f;
+			extentX[InIndex]	= extentY[InIndex] = extentZ[InIndex] = PACKEDBOUNDS_INVALID_EXTENT;
+		}
+	}
+
+	/**
+	 * @brief Remove box by replacing it with the last one
+	 * @param InIndex	Index of the box
+	 */
+	FORCEINLINE void RemoveSwap( uint32 InIndex )
+	{
+		Assert( InIndex < numBoxes );
+		uint32		lastIndex = --numBoxes;
+		if ( InIndex != lastIndex )
+		{
+			centerX[InIndex]	= centerX[lastIndex];
+			centerY[InIndex]	= centerY[lastIndex];
+			centerZ[InIndex]	= centerZ[lastIndex];
+			extentX[InIndex]	= extentX[lastIndex];
+			extentY[InIndex]	= extentY[lastIndex];
+			extentZ[InIndex]	= extentZ[lastIndex];
+		}
+	}
+
+	/**
+	 * @brief Remove all boxes
+	 */
+	FORCEINLINE void Clear()
+	{
+		numBoxes = 0;
+		Resize( 0 );
+	}
+
+	/**
+	 * @brief Get number of boxes
+	 * @return Return number of boxes
+	 */
+	FORCEINLINE uint32 GetNum() const
+	{
+		return numBoxes;
+	}
+
+	/**
+	 * @brief Get X components of centers
+	 * @return Return pointer to X components of centers. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetCentersX() const
+	{
+		return centerX.data();
+	}
+
+	/**
+	 * @brief Get Y components of centers
+	 * @return Return pointer to Y components of centers. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetCentersY() const
+	{
+		return centerY.data();
+	}
+
+	/**
+	 * @brief Get Z components of centers
+	 * @return Return pointer to Z components of centers. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetCentersZ() const
+	{
+		return centerZ.data();
+	}
+
+	/**
+	 * @brief Get X components of extents
+	 * @return Return pointer to X components of extents. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetExtentsX() const
+	{
+		return extentX.data();
+	}
+
+	/**
+	 * @brief Get Y components of extents
+	 * @return Return pointer to Y components of extents. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetExtentsY() const
+	{
+		return extentY.data();
+	}
+
+	/**
+	 * @brief Get Z components of extents
+	 * @return Return pointer to Z components of extents. The array is padded to PACKEDBOUNDS_GROUP_SIZE
+	 */
+	FORCEINLINE const float* GetExtentsZ() const
+	{
+		return extentZ.data();
+	}
+
+private:
+	/**
+	 * @brief Resize all arrays
+	 * @param InSize	New size
+	 */
+	FORCEINLINE void Resize( uint32 InSize )
+	{
+		centerX.resize( InSize, 0.f );
+		centerY.resize( InSize, 0.f );
+		centerZ.resize( InSize, 0.f );
+		extentX.resize( InSize, 0.f );
+		extentY.resize( InSize, 0.f );
+		extentZ.resize( InSize, 0.f );
+	}
+
+	uint32					numBoxes;	/**< Number of boxes */
+	std::vector<float>		centerX;	/**< X components of centers */
+	std::vector<float>		centerY;	/**< Y components of centers */
+	std::vector<float>		centerZ;	/**< Z components of centers */
+	std::vector<float>		extentX;	/**< X components of extents */
+	std::vector<float>		extentY;	/**< Y components of extents */
+	std::vector<float>		extentZ;	/**< Z components of extents */
+};
+
+#endif // !PACKEDBOUNDS_H
@@ -0,0 +1,172 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef RENDERCOMMANDLIST_H
+#define RENDERCOMMANDLIST_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/Threading.h"
+
+/**
+ * @ingroup Engine
+ * @brief List of recorded render commands
+ *
+ * Worker threads of the thread pool can't write into the global render command buffer, so render commands
+ * sent from them are recorded into the list of the worker (see GetRenderCommandListForCurrentThread).
+ * Each command is recorded with the key of the ParallelFor work item which sends it (see CThreadPool::GetCurrentWorkItemKey).
+ * All lists are submitted to the rendering thread by the game thread in SubmitRenderCommandLists
+ */
+class CRenderCommandList
+{
+public:
+	/**
+	 * @brief A reference to an allocated chunk of the command list
+	 * While the context is alive the list is locked
+	 */
+	class CAllocationContext
+	{
+	public:
+		/**
+		 * @brief Upon construction, AllocationContext allocates a chunk from the command list
+		 *
+		 * @param InCommandList		The command list to allocate from
+		 * @param InAllocationSize	The size of the allocation to make
+		 */
+		CAllocationContext( CRenderCommandList& InCommandList, uint32 InAllocationSize );
+
+		/**
+		 * @brief Upon destruction, the command list is unlocked
+		 */
+		~CAllocationContext();
+
+		/**
+		 * @brief Get allocation
+		 * @return Return pointer to start allocation
+		 */
+		FORCEINLINE void* GetAllocation() const
+		{
+			return allocation;
+		}
+
+	private:
+		CRenderCommandList&		commandList;	/**< Reference to command list */
+		void*					allocation;		/**< Allocated memory */
+	};
+
+	/**
+	 * @brief Constructor
+	 */
+	CRenderCommandList();
+
+	/**
+	 * @brief Destructor
+	 * @note Recorded commands which haven't been executed are destroyed without execution
+	 */
+	~CRenderCommandList();
+
+	/**
+	 * @brief Execute all recorded commands in the order they were recorded and clear the list
+	 * @note Must be called from the rendering thread
+	 */
+	void Execute();
+
+	/**
+	 * @brief Move recorded commands to the end of another list
+	 * @param InOutDestList		Destination list
+	 */
+	void MoveTo( CRenderCommandList& InOutDestList );
+
+	/**
+	 * @brief Sort recorded commands by keys of work items, commands of one work item keep their order
+	 */
+	void SortByWorkItems();
+
+	/**
+	 * @brief Is the list empty
+	 * @return Return TRUE if there are no recorded commands, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return commands.empty();
+	}
+
+private:
+	/**
+	 * @brief Chunk of memory with recorded commands
+	 */
+	struct Chunk
+	{
+		byte*		data;		/**< Data of the chunk */
+		uint32		size;		/**< Size of the chunk */
+		uint32		usedSize;	/**< Size of the chunk occupied by commands */
+	};
+
+	/**
+	 * @brief Recorded command
+	 */
+	struct Command
+	{
+		uint64						workItemKey;	/**< Key of the work item which recorded the command */
+		class CRenderCommand*		command;		/**< Command in one of chunks */
+	};
+
+	/**
+	 * @brief Destroy recorded commands and free memory
+	 * @param InIsExecute	If TRUE commands are executed before destroying
+	 */
+	void Flush( bool InIsExecute );
+
+	CMutex					mutex;		/**< Mutex of the list, it's contended only when the game thread submits the list */
+	std::vector<Chunk>		chunks;		/**< Chunks with recorded commands */
+	std::vector<Command>	commands;	/**< Recorded commands in order of execution */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Get render command list of the current thread
+ * @note A returned list must be used by CRenderCommandList::CAllocationContext, its destruction finishes the recording
+ * @return Return command list of the current worker thread of the thread pool or of the game thread while it processes a work item of ParallelFor.
+ * Otherwise or if recording isn't allowed returns NULL
+ */
+CRenderCommandList* GetRenderCommandListForCurrentThread();
+
+/**
+ * @ingroup Engine
+ * @brief Create command lists of worker threads
+ * @note Called by StartRenderingThread
+ */
+void InitRenderCommandLists();
+
+/**
+ * @ingroup Engine
+ * @brief Stop recording into command lists of worker threads and wait for recordings in progress
+ * After that render commands of worker threads are sent directly into the render command buffer
+ * @note Called by StopRenderingThread
+ */
+void StopRecordingRenderCommandLists();
+
+/**
+ * @ingroup Engine
+ * @brief Destroy command lists of worker threads, commands which haven't been submitted are dropped
+ * @note Called by StopRenderingThread after StopRecordingRenderCommandLists
+ */
+void DestroyRenderCommandLists();
+
+/**
+ * @ingroup Engine
+ * @brief Submit command lists of all worker threads to the rendering thread
+ * @note Must be called from the game thread. Commands are submitted in order of keys of ParallelFor work items which recorded them,
+ * commands of one work item in order of recording. Commands recorded outside of work items go first in order of worker threads.
+ * Commands which are recorded by different work items must not depend on each other
+ */
+void SubmitRenderCommandLists();
+
+#endif // !RENDERCOMMANDLIST_H
@@ -11,6 +11,13 @@
 
 #include "Containers/RingBuffer.h"
 #include "System/Threading.h"
+#include "Render/RenderCommandList.h"
+
+/**
+ * @ingroup Engine
+ * @brief Max number of frames which the game thread may run ahead of the rendering thread
+ */
+#define RENDER_MAX_FRAMES_IN_FLIGHT		3
 
 /**
  * @ingroup Engine
@@ -103,6 +110,26 @@ public:
 	 */
 	FORCEINLINE void operator delete( void* InPtr, const CRingBuffer::CAllocationContext& InAllocation )
 	{}
+
+	/**
+	 * Overrload operator of new
+	 *
+	 * @param[in] InSize Size
+	 * @param[in] InAllocation Allocation context in render command list
+	 */
+	FORCEINLINE void* operator new( size_t InSize, const CRenderCommandList::CAllocationContext& InAllocation )
+	{
+		return InAllocation.GetAllocation();
+	}
+
+	/**
+	 * Overrload operator of delete
+	 *
+	 * @param[in] InPtr Pointer to data
+	 * @param[in] InAllocation Allocation context in render command list
+	 */
+	FORCEINLINE void operator delete( void* InPtr, const CRenderCommandList::CAllocationContext& InAllocation )
+	{}
 };
 
 /**
@@ -154,13 +181,21 @@ private:
 /**
  * @ingroup Engine
  * Send render command to render thread
+ * If it's called from a worker thread of the thread pool or from a work item of ParallelFor on the game thread the command
+ * is recorded into the command list of the thread and will be sent to render thread by SubmitRenderCommandLists
  * 
  * @param[in] InTypeName Type name of render command
  * @param[in] InParam Parameters of render command
  */
 #define SEND_RENDER_COMMAND( InTypeName, InParam ) \
 	{ \
-		if ( g_IsThreadedRendering && !IsInRenderingThread() ) \
+		CRenderCommandList*		InTypeName##CommandList = nullptr; \
+		if ( g_IsThreadedRendering && !IsInRenderingThread() && ( InTypeName##CommandList = GetRenderCommandListForCurrentThread() ) ) \
+		{ \
+			CRenderCommandList::CAllocationContext	allocationContext( *InTypeName##CommandList, sizeof( InTypeName ) ); \
+			new( allocationContext ) InTypeName InParam; \
+		} \
+		else if ( g_IsThreadedRendering && !IsInRenderingThread() ) \
 		{ \
 			CRingBuffer::CAllocationContext			allocationContext( g_RenderCommandBuffer, sizeof( InTypeName ) ); \
 			if ( allocationContext.GetAllocatedSize() < sizeof( InTypeName ) ) \
@@ -454,6 +489,67 @@ void StartRenderingThread();
  */
 void StopRenderingThread();
 
+/**
+ * @ingroup Engine
+ * @brief Fence of rendering commands
+ *
+ * The fence is passed when the rendering thread has executed all commands which were enqueued before BeginFence.
+ * Unlike FlushRenderingCommands it doesn't stall the game thread at once, so the game thread can keep working
+ * on the next frames and wait for the fence only when it gets too far ahead
+ */
+class CRenderFence
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CRenderFence();
+
+	/**
+	 * @brief Constructor of copy, the new fence isn't pending
+	 */
+	CRenderFence( const CRenderFence& InOther );
+
+	/**
+	 * @brief Destructor
+	 * Waits until the fence is passed, the rendering thread signals the event of the fence
+	 */
+	~CRenderFence();
+
+	/**
+	 * @brief Overload operator =, state of the fence isn't copied
+	 */
+	FORCEINLINE CRenderFence& operator=( const CRenderFence& InOther )
+	{
+		return *this;
+	}
+
+	/**
+	 * @brief Add a fence command to the rendering command queue
+	 * @note Must be called only from the game thread. The fence must live until it's passed
+	 */
+	void BeginFence();
+
+	/**
+	 * @brief Is the fence passed
+	 * @return Return TRUE if the rendering thread has executed all commands enqueued before the last BeginFence, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsFenceComplete() const
+	{
+		// Without the rendering thread commands aren't queued, so nothing can be in flight
+		return !g_IsThreadedRendering || numPendingFences == 0;
+	}
+
+	/**
+	 * @brief Wait until the fence is passed
+	 */
+	void Wait() const;
+
+private:
+	volatile int32		numPendingFences;		/**< Number of fence commands which the rendering thread hasn't executed yet */
+	CEvent*				completedEvent;			/**< Manual reset event which is triggered when a fence command is passed, created by the first BeginFence */
+};
+
 /**
  * @ingroup Engine
  * Flush rendering commands
@@ -462,6 +558,12 @@ FORCEINLINE void FlushRenderingCommands()
 {
 	if ( !IsInRenderingThread() && g_RenderFrameFinished )
 	{
+		// Commands recorded by worker threads must be executed too
+		if ( IsInGameThread() )
+		{
+			SubmitRenderCommandLists();
+		}
+
 		// Mark of flushed rendering commands
 		UNIQUE_RENDER_COMMAND( CFlushedRenderCommands,
 							   {
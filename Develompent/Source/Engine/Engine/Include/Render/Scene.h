@@ -12,6 +12,7 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <algorithm>
 
 #include "Math/Math.h"
 #include "Math/Color.h"
@@ -21,10 +22,12 @@
 #include "Render/SceneHitProxyRendering.h"
 #include "Render/DepthRendering.h"
 #include "Render/Frustum.h"
+#include "Render/SceneOctree.h"
 #include "Render/HitProxies.h"
 #include "Render/BatchedSimpleElements.h"
 #include "Render/RenderingThread.h"
 #include "Render/DynamicMeshBuilder.h"
+#include "Render/FrameAllocator.h"
 #include "Components/CameraComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/LightComponent.h"
@@ -259,7 +262,7 @@ struct MeshBatch
 	 * Constructor
 	 */
 	FORCEINLINE MeshBatch()
-		: baseVertexIndex( 0 ), firstIndex( 0 ), numPrimitives( 0 ), numInstances( 0 )
+		: baseVertexIndex( 0 ), firstIndex( 0 ), numPrimitives( 0 ), numInstances( 0 ), instances( nullptr )
 	{}
 
 	/**
@@ -302,7 +305,7 @@ struct MeshBatch
 	uint32										firstIndex;			/**< First index */
 	uint32										numPrimitives;		/**< Number primitives to render */
 	mutable uint32								numInstances;		/**< Number instances of mesh */
-	mutable std::vector< MeshInstance >		instances;			/**< Array of mesh instances */
+	mutable MeshInstance*						instances;			/**< Array of mesh instances, it's allocated from the frame allocator */
 };
 
 /**
@@ -310,9 +313,39 @@ struct MeshBatch
  */
 typedef std::unordered_set< MeshBatch, MeshBatch::MeshBatchKeyFunc >		MeshBatchList_t;
 
+/**
+ * @ingroup Engine
+ * @brief Statistics of drawing mesh draw lists
+ */
+struct MeshDrawListStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	MeshDrawListStats()
+		: bEnabled( false )
+		, numDrawingPolicies( 0 )
+		, numStateChanges( 0 )
+		, numAvoidedStateChanges( 0 )
+	{}
+
+	bool		bEnabled;					/**< Is statistics gathered for the current view (r_drawliststats) */
+	uint32		numDrawingPolicies;			/**< Number of drawn drawing policies */
+	uint32		numStateChanges;			/**< Number of changes of bound shader state, material or vertex factory between drawing policies */
+	uint32		numAvoidedStateChanges;		/**< Number of state changes avoided by sorting compared with drawing in hash order */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of drawing mesh draw lists of the current view
+ */
+extern MeshDrawListStats		g_MeshDrawListStats;
+
 /**
  * @ingroup Engine
  * @brief Draw list of scene for mesh type
+ * Drawing policies are drawn in order of their sort keys (see MeshDrawingPolicySortKey), so draws with the same
+ * render state go one after another. The order is kept up to date when drawing policy links are added or removed
  */
 template< typename TDrawingPolicyType, bool InAllowWireframe = true >
 class CMeshDrawList
@@ -374,6 +407,7 @@ public:
 
 		mutable MeshBatchList_t					meshBatchList;			/**< Mesh batch list */
 		mutable TDrawingPolicyType				drawingPolicy;			/**< Drawing policy */
+		MeshDrawingPolicySortKey				sortKey;				/**< Sort key of the drawing policy */
 
 #if WITH_EDITOR
 		CColor									wireframeColor;			/**< Wireframe color */
@@ -450,10 +484,14 @@ public:
 		// Get drawing policy link in std::set
 		MapDrawData_t::iterator		it = meshes.find( InDrawingPolicyLink );
 
-		// If drawing policy link is not exist - we insert
+		// If drawing policy link is not exist - we insert it and place in sorted order
 		if ( it == meshes.end() )
 		{
 			it = meshes.insert( InDrawingPolicyLink ).first;
+
+			DrawingPolicyLink*		drawingPolicyLink = ( *it ).GetPtr();
+			drawingPolicyLink->sortKey = drawingPolicyLink->drawingPolicy.GetSortKey();
+			sortedMeshes.insert( std::upper_bound( sortedMeshes.begin(), sortedMeshes.end(), drawingPolicyLink, DrawingPolicySortFunc() ), drawingPolicyLink );
 		}
 
 		// Return drawing policy link in SDG
@@ -470,7 +508,21 @@ public:
 		Assert( InDrawingPolicyLink );
 		if ( InDrawingPolicyLink->GetRefCount() <= 2 )
 		{
-			meshes.erase( InDrawingPolicyLink );
+			// Find the link in sorted order, links with equal sort keys are next to each other
+			MapDrawData_t::iterator		it = meshes.find( InDrawingPolicyLink );
+			if ( it != meshes.end() )
+			{
+				DrawingPolicyLink*		drawingPolicyLink = ( *it ).GetPtr();
+				auto					itSorted = std::lower_bound( sortedMeshes.begin(), sortedMeshes.end(), drawingPolicyLink, DrawingPolicySortFunc() );
+				while ( itSorted != sortedMeshes.end() && *itSorted != drawingPolicyLink )
+				{
+					++itSorted;
+				}
+
+				Assert( itSorted != sortedMeshes.end() );
+				sortedMeshes.erase( itSorted );
+				meshes.erase( it );
+			}
 		}
 
 		InDrawingPolicyLink = nullptr;
@@ -487,10 +539,35 @@ public:
 			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
 			{
 				itMeshBatch->numInstances = 0;
-				itMeshBatch->instances.clear();
+				itMeshBatch->instances = nullptr;
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	/**
+	 * @brief Copy instances of mesh batches into memory of other frame
+	 * Used to keep instances of a frozen frame alive when buffers of the frame allocator are reset
+	 *
+	 * @param InFrameAllocator	Allocator of the current frame
+	 */
+	FORCEINLINE void RelocateInstances( CLinearAllocator& InFrameAllocator )
+	{
+		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		{
+			DrawingPolicyLinkRef_t		drawingPolicyLink = *it;
+			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
+			{
+				if ( itMeshBatch->instances )
+				{
+					MeshInstance*	instances = InFrameAllocator.AllocateArray<MeshInstance>( itMeshBatch->numInstances );
+					Memory::Memcpy( instances, itMeshBatch->instances, itMeshBatch->numInstances * sizeof( MeshInstance ) );
+					itMeshBatch->instances = instances;
+				}
 			}
 		}
 	}
+#endif // WITH_EDITOR
 
 	/**
 	 * @brief Get number items in list
@@ -517,10 +594,13 @@ public:
 		bool													bWireframe = InAllowWireframe && ( InSceneView.GetShowFlags() & SHOW_Wireframe );
 #endif // WITH_EDITOR
 
-		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		const bool					bGatherStats			= g_MeshDrawListStats.bEnabled;
+		const DrawingPolicyLink*	prevDrawingPolicyLink	= nullptr;
+		uint32						numStateChanges			= 0;
+		for ( uint32 index = 0, count = sortedMeshes.size(); index < count; ++index )
 		{
 			bool						bIsInitedRenderState	= false;
-			DrawingPolicyLinkRef_t		drawingPolicyLink		= *it;
+			DrawingPolicyLink*			drawingPolicyLink		= sortedMeshes[index];
 			CMeshDrawingPolicy*			drawingPolicy			= nullptr;
 
 #if WITH_EDITOR
@@ -556,16 +636,105 @@ public:
 					drawingPolicy->SetRenderState( InDeviceContext );
 					drawingPolicy->SetShaderParameters( InDeviceContext );
 					bIsInitedRenderState = true;
+
+					if ( bGatherStats )
+					{
+						++g_MeshDrawListStats.numDrawingPolicies;
+						numStateChanges			+= GetNumStateChanges( prevDrawingPolicyLink, drawingPolicyLink );
+						prevDrawingPolicyLink	= drawingPolicyLink;
+					}
 				}
 
 				// Draw mesh batch
 				drawingPolicy->Draw( InDeviceContext, *itMeshBatch, InSceneView );
 			}
 		}
+
+		if ( !bGatherStats )
+		{
+			return;
+		}
+
+		// Count state changes which we would have if we drew in hash order as before
+		uint32		numHashOrderStateChanges = 0;
+		prevDrawingPolicyLink = nullptr;
+		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		{
+			const DrawingPolicyLink*	drawingPolicyLink = ( *it ).GetPtr();
+			if ( drawingPolicyLink->drawingPolicy.IsValid() && IsHaveInstances( drawingPolicyLink ) )
+			{
+				numHashOrderStateChanges += GetNumStateChanges( prevDrawingPolicyLink, drawingPolicyLink );
+				prevDrawingPolicyLink = drawingPolicyLink;
+			}
+		}
+
+		g_MeshDrawListStats.numStateChanges += numStateChanges;
+		if ( numHashOrderStateChanges > numStateChanges )
+		{
+			g_MeshDrawListStats.numAvoidedStateChanges += numHashOrderStateChanges - numStateChanges;
+		}
 	}
 
 private:
-	MapDrawData_t		meshes;						/**< Map of meshes sorted by materials for draw */
+	/**
+	 * @brief Functions to compare drawing policy links by sort keys
+	 */
+	struct DrawingPolicySortFunc
+	{
+		/**
+		 * @brief Compare drawing policy links
+		 *
+		 * @param InA First drawing policy link
+		 * @param InB Second drawing policy link
+		 * @return Return TRUE if InA must be drawn before InB, otherwise returns FALSE
+		 */
+		FORCEINLINE bool operator()( const DrawingPolicyLink* InA, const DrawingPolicyLink* InB ) const
+		{
+			return InA->sortKey < InB->sortKey;
+		}
+	};
+
+	/**
+	 * @brief Is drawing policy link has instances to draw
+	 *
+	 * @param InDrawingPolicyLink	Drawing policy link
+	 * @return Return TRUE if any mesh batch of the link has instances, otherwise returns FALSE
+	 */
+	static FORCEINLINE bool IsHaveInstances( const DrawingPolicyLink* InDrawingPolicyLink )
+	{
+		for ( MeshBatchList_t::const_iterator itMeshBatch = InDrawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = InDrawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
+		{
+			if ( itMeshBatch->numInstances > 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Get number of state changes between two drawing policy links
+	 *
+	 * @param InPrevDrawingPolicyLink	Previous drawn drawing policy link, may be NULL
+	 * @param InDrawingPolicyLink		Next drawing policy link
+	 * @return Return number of changed states (bound shader state, material and vertex factory)
+	 */
+	static FORCEINLINE uint32 GetNumStateChanges( const DrawingPolicyLink* InPrevDrawingPolicyLink, const DrawingPolicyLink* InDrawingPolicyLink )
+	{
+		if ( !InPrevDrawingPolicyLink )
+		{
+			return 3;
+		}
+
+		const MeshDrawingPolicySortKey&		prevSortKey = InPrevDrawingPolicyLink->sortKey;
+		const MeshDrawingPolicySortKey&		sortKey		= InDrawingPolicyLink->sortKey;
+		return	( prevSortKey.boundShaderStateKey != sortKey.boundShaderStateKey ? 1 : 0 ) + 
+				( prevSortKey.materialKey != sortKey.materialKey ? 1 : 0 ) + 
+				( prevSortKey.vertexFactoryKey != sortKey.vertexFactoryKey ? 1 : 0 );
+	}
+
+	MapDrawData_t						meshes;			/**< Set of unique drawing policy links */
+	std::vector<DrawingPolicyLink*>		sortedMeshes;	/**< Drawing policy links sorted by sort keys, the order of drawing */
 };
 
 /**
@@ -639,6 +808,17 @@ struct HitProxyLayer
 		hitProxyDrawList.Clear();
 	}
 
+#if WITH_EDITOR
+	/**
+	 * @brief Copy instances of mesh batches into memory of other frame
+	 * @param InFrameAllocator	Allocator of the current frame
+	 */
+	FORCEINLINE void RelocateInstances( CLinearAllocator& InFrameAllocator )
+	{
+		hitProxyDrawList.RelocateInstances( InFrameAllocator );
+	}
+#endif // WITH_EDITOR
+
 	/**
 	 * @brief Is empty
 	 * @return Return TRUE if layer is empty, else return FALSE
@@ -700,6 +880,95 @@ FORCEINLINE const tchar* GetSceneSDGName( ESceneDepthGroup SDG )
 }
 #endif // SHIPPING_BUILD
 
+/**
+ * @ingroup Engine
+ * @brief Buffer of mesh instances gathered by one task while building a view
+ *
+ * Mesh batches of the scene are shared by all primitives, so primitives add instances into the buffer
+ * and the buffers are merged into mesh batches per scene depth group after gathering
+ */
+class CMeshInstanceBuffer
+{
+public:
+	/**
+	 * @brief Add instance of mesh batch
+	 *
+	 * @param InSDGType		SDG where the mesh batch is linked to
+	 * @param InMeshBatch	Mesh batch
+	 * @param InInstance	Instance of mesh batch
+	 */
+	FORCEINLINE void AddInstance( ESceneDepthGroup InSDGType, const MeshBatch* InMeshBatch, const MeshInstance& InInstance )
+	{
+		Assert( InSDGType < SDG_Max && InMeshBatch );
+		instances[InSDGType].push_back( Instance{ InMeshBatch, InInstance } );
+	}
+
+	/**
+	 * @brief Count gathered instances of SDG in its mesh batches
+	 * @note Must be called for all buffers before MergeInstances, so arrays of instances are allocated once
+	 *
+	 * @param InSDGType		SDG type
+	 */
+	FORCEINLINE void CountInstances( ESceneDepthGroup InSDGType ) const
+	{
+		Assert( InSDGType < SDG_Max );
+		const std::vector<Instance>&	sdgInstances = instances[InSDGType];
+		for ( uint32 index = 0, count = sdgInstances.size(); index < count; ++index )
+		{
+			Assert( !sdgInstances[index].meshBatch->instances );
+			++sdgInstances[index].meshBatch->numInstances;
+		}
+	}
+
+	/**
+	 * @brief Add gathered instances of SDG into its mesh batches
+	 *
+	 * @param InSDGType			SDG type
+	 * @param InFrameAllocator	Allocator of the current frame
+	 */
+	FORCEINLINE void MergeInstances( ESceneDepthGroup InSDGType, CLinearAllocator& InFrameAllocator ) const
+	{
+		Assert( InSDGType < SDG_Max );
+		const std::vector<Instance>&	sdgInstances = instances[InSDGType];
+		for ( uint32 index = 0, count = sdgInstances.size(); index < count; ++index )
+		{
+			const Instance&		instance = sdgInstances[index];
+			const MeshBatch*	meshBatch = instance.meshBatch;
+
+			// On the first instance allocate array of all counted instances and fill it from the beginning
+			if ( !meshBatch->instances )
+			{
+				meshBatch->instances	= InFrameAllocator.AllocateArray<MeshInstance>( meshBatch->numInstances );
+				meshBatch->numInstances = 0;
+			}
+			meshBatch->instances[meshBatch->numInstances++] = instance.instance;
+		}
+	}
+
+	/**
+	 * @brief Remove all instances, the memory is kept for the next view
+	 */
+	FORCEINLINE void Clear()
+	{
+		for ( uint32 index = 0; index < SDG_Max; ++index )
+		{
+			instances[index].clear();
+		}
+	}
+
+private:
+	/**
+	 * @brief Instance of mesh batch
+	 */
+	struct Instance
+	{
+		const MeshBatch*		meshBatch;		/**< Mesh batch */
+		MeshInstance			instance;		/**< Instance */
+	};
+
+	std::vector<Instance>		instances[SDG_Max];		/**< Gathered instances per SDG */
+};
+
 /**
  * @ingroup Engine
  * @brief Scene depth group
@@ -730,6 +999,30 @@ struct SceneDepthGroup
 #endif // ENABLE_HITPROXY
 	}
 
+#if WITH_EDITOR
+	/**
+	 * @brief Copy instances of mesh batches into memory of other frame
+	 * Used to keep instances of a frozen frame alive when buffers of the frame allocator are reset
+	 *
+	 * @param InFrameAllocator	Allocator of the current frame
+	 */
+	FORCEINLINE void RelocateInstances( CLinearAllocator& InFrameAllocator )
+	{
+		gizmoDrawList.RelocateInstances( InFrameAllocator );
+		dynamicMeshElements.RelocateInstances( InFrameAllocator );
+		staticMeshDrawList.RelocateInstances( InFrameAllocator );
+		spriteDrawList.RelocateInstances( InFrameAllocator );
+		depthDrawList.RelocateInstances( InFrameAllocator );
+
+#if ENABLE_HITPROXY
+		for ( uint32 index = 0; index < HPL_Num; ++index )
+		{
+			hitProxyLayers[ index ].RelocateInstances( InFrameAllocator );
+		}
+#endif // ENABLE_HITPROXY
+	}
+#endif // WITH_EDITOR
+
 	/**
 	 * @brief Is empty
 	 * @return Return TRUE if SDG is empty, else return FALSE
@@ -845,6 +1138,9 @@ public:
 /**
  * @ingroup Engine
  * @brief Main of scene manager containing all primitive components
+ * @note Draw lists, the spatial index, transforms of primitives, static meshes with their materials and parameters of lights for rendering
+ * are owned by the rendering thread, the game thread changes them only by render commands. Sprite and sphere components still share
+ * their sprites, materials and sizes with the rendering thread, so frames in flight must stay at 1 until they are moved to render commands too
  */
 class CScene : public CBaseScene
 {
@@ -887,8 +1183,24 @@ public:
 	 */
 	virtual void RemoveLight( class CLightComponent* InLight ) override;
 
+	/**
+	 * @brief Send the current transform of primitive to the rendering thread
+	 * Bounds of the primitive will be updated in the spatial index on the next built view
+	 *
+	 * @param InPrimitive Primitive component
+	 */
+	void UpdatePrimitiveBounds( class CPrimitiveComponent* InPrimitive );
+
+	/**
+	 * @brief Send the current bounds and parameters of light to the rendering thread
+	 *
+	 * @param InLight Light component
+	 */
+	void UpdateLight( class CLightComponent* InLight );
+
 	/**
 	 * @brief Clear scene
+	 * @note Flushes the rendering thread
 	 */
 	virtual void Clear() override;
 
@@ -929,14 +1241,23 @@ public:
 	}
 
 	/**
-	 * @brief Get list of visible lights on the current frame
-	 * @return Return list of visible lights
+	 * @brief Get array of visible lights on the current frame
+	 * @return Return array of visible lights
 	 */
-	FORCEINLINE const std::list<CLightComponent*>& GetVisibleLights() const
+	FORCEINLINE CLightComponent* const* GetVisibleLights() const
 	{
 		return frame.visibleLights;
 	}
 
+	/**
+	 * @brief Get number of visible lights on the current frame
+	 * @return Return number of visible lights
+	 */
+	FORCEINLINE uint32 GetNumVisibleLights() const
+	{
+		return frame.numVisibleLights;
+	}
+
 	/**
 	 * @brief Set current exposure of the scene
 	 * @paran InExposure		New exposure
@@ -950,19 +1271,64 @@ public:
 	virtual float GetExposure() const override;
 
 private:
+	/**
+	 * @brief Link primitive to draw lists
+	 * @note Called from the rendering thread
+	 *
+	 * @param InPrimitive Primitive component
+	 */
+	void AddPrimitive_RenderThread( class CPrimitiveComponent* InPrimitive );
+
+	/**
+	 * @brief Unlink primitive from draw lists and remove it from the spatial index
+	 * @note Called from the rendering thread
+	 *
+	 * @param InPrimitive Primitive component
+	 */
+	void RemovePrimitive_RenderThread( class CPrimitiveComponent* InPrimitive );
+
+	/**
+	 * @brief Set transform of primitive for rendering and queue update of its bounds
+	 * @note Called from the rendering thread
+	 *
+	 * @param InPrimitive	Primitive component
+	 * @param InTransform	Transform of the primitive in world space
+	 */
+	void UpdatePrimitiveBounds_RenderThread( class CPrimitiveComponent* InPrimitive, const CTransform& InTransform );
+
+	/**
+	 * @brief Update bounds of dirty primitives in the spatial index
+	 */
+	void UpdateDirtyBounds();
+
 	/**
 	 * @brief One frame of the scene
 	 */
 	struct SceneFrame
 	{
+		/**
+		 * @brief Constructor
+		 */
+		SceneFrame()
+			: visibleLights( nullptr )
+			, numVisibleLights( 0 )
+		{}
+
 		SceneDepthGroup						SDGs[SDG_Max];		/**< Scene depth groups */
-		std::list<CLightComponent*>			visibleLights;		/**< List of visible lights */
+		CLightComponent**					visibleLights;		/**< Array of visible lights, it's allocated from the frame allocator */
+		uint32								numVisibleLights;	/**< Number of visible lights */
 	};
 	
 	float									exposure;			/**< Current exposure of the scene */
 	SceneFrame								frame;				/**< Scene frame */
-	std::list<CPrimitiveComponent*>			primitives;			/**< List of primitives on scene */
-	std::list<CLightComponent*>				lights;				/**< List of lights on scene */
+	std::list<CPrimitiveComponent*>			primitives;			/**< List of primitives on scene. Owned by the game thread */
+	std::list<CLightComponent*>				lights;				/**< List of lights on scene. Owned by the game thread */
+	TSceneOctree<CPrimitiveComponent*>		primitiveOctree;	/**< Spatial index of primitives. Owned by the rendering thread */
+	TSceneOctree<CLightComponent*>			lightOctree;		/**< Spatial index of lights. Owned by the rendering thread */
+	std::vector<CPrimitiveComponent*>		dirtyPrimitives;	/**< Primitives which bounds need to update in the spatial index. Owned by the rendering thread */
+	std::vector<CPrimitiveComponent*>		tempPrimitives;		/**< Temporary array of primitives which passed frustum culling */
+	std::vector<CLightComponent*>			tempLights;			/**< Temporary array of lights which passed frustum culling */
+	std::vector<CMeshInstanceBuffer>		tempInstanceBuffers;	/**< Temporary buffers of mesh instances per batch of primitives */
 };
 
 //
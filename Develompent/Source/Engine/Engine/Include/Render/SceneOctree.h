@@ -0,0 +1,369 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SCENEOCTREE_H
+#define SCENEOCTREE_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+#include "Render/Frustum.h"
+#include "Render/PackedBounds.h"
+#include "EngineDefines.h"
+
+/**
+ * @ingroup Engine
+ * Default half size of the root node of scene octree
+ */
+#define SCENEOCTREE_DEFAULT_ROOT_EXTENT		HALF_WORLD_MAX
+
+/**
+ * @ingroup Engine
+ * Default maximum depth of scene octree
+ */
+#define SCENEOCTREE_DEFAULT_MAX_DEPTH		12
+
+/**
+ * @ingroup Engine
+ * @brief Loose octree for fast culling of scene elements
+ *
+ * Each element is stored in the deepest node which tight bounds contain the center of the element
+ * and which half size isn't less than the half size of the element. Node bounds are loosened twice,
+ * so the element always fits into the loose bounds of its node. Elements with invalid bounds and elements
+ * outside of the root node are stored in the root node, which is never culled. Bounds of elements
+ * in each node are kept in CPackedBounds, so elements of a node are culled at one time by CFrustum::CullBoxes
+ */
+template<typename TElementType>
+class TSceneOctree
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InRootExtent	Half size of the root node
+	 * @param InMaxDepth	Maximum depth of the octree
+	 */
+	TSceneOctree( float InRootExtent = SCENEOCTREE_DEFAULT_ROOT_EXTENT, uint32 InMaxDepth = SCENEOCTREE_DEFAULT_MAX_DEPTH )
+		: rootExtent( InRootExtent )
+		, maxDepth( InMaxDepth )
+	{
+		Clear();
+	}
+
+	/**
+	 * @brief Add a new element or update bounds of already added element
+	 *
+	 * @param InElement		Element
+	 * @param InBounds		Bounds of the element in world space
+	 */
+	void UpdateElement( TElementType InElement, const CBox& InBounds )
+	{
+		auto	itElement = elementIds.find( InElement );
+		if ( itElement != elementIds.end() )
+		{
+			// If the element still fits into its node then we just update its bounds
+			ElementId&		elementId = itElement->second;
+			if ( FindNodeIndex( InBounds, false ) == elementId.nodeIndex )
+			{
+				nodes[elementId.nodeIndex].bounds.Set( elementId.elementIndex, InBounds );
+				return;
+			}
+
+			RemoveElement( InElement );
+		}
+
+		uint32		nodeIndex = FindNodeIndex( InBounds, true );
+		Node&		node = nodes[nodeIndex];
+		elementIds[InElement] = ElementId{ nodeIndex, node.bounds.Add( InBounds ) };
+		node.elements.push_back( InElement );
+	}
+
+	/**
+	 * @brief Remove element
+	 * @param InElement		Element
+	 */
+	void RemoveElement( TElementType InElement )
+	{
+		auto	itElement = elementIds.find( InElement );
+		if ( itElement == elementIds.end() )
+		{
+			return;
+		}
+
+		// Remove the element from the node by swapping with the last one
+		ElementId		elementId = itElement->second;
+		Node&			node = nodes[elementId.nodeIndex];
+		elementIds.erase( itElement );
+		if ( elementId.elementIndex != node.elements.size() - 1 )
+		{
+			node.elements[elementId.elementIndex] = node.elements.back();
+			elementIds[node.elements[elementId.elementIndex]].elementIndex = elementId.elementIndex;
+		}
+		node.elements.pop_back();
+		node.bounds.RemoveSwap( elementId.elementIndex );
+
+		// Free empty nodes
+		PruneNode( elementId.nodeIndex );
+	}
+
+	/**
+	 * @brief Remove all elements
+	 */
+	void Clear()
+	{
+		nodes.clear();
+		freeNodes.clear();
+		elementIds.clear();
+		AllocateNode( Math::vectorZero, rootExtent, INDEX_NONE );
+	}
+
+	/**
+	 * @brief Find all elements which bounds intersect frustum
+	 *
+	 * @param InFrustum		Frustum
+	 * @param OutElements	Output array of visible elements
+	 */
+	void FindVisibleElements( const CFrustum& InFrustum, std::vector<TElementType>& OutElements ) const
+	{
+		// Root node is never culled because it contains elements outside of the world and elements with invalid bounds
+		struct StackEntry
+		{
+			uint32		nodeIndex;		/**< Node index */
+			bool		bFullyInside;	/**< Is the node fully inside of frustum */
+		};
+
+		std::vector<StackEntry>		stack;
+		std::vector<uint32>			visibilityMask;
+		stack.reserve( maxDepth * 8 );
+		stack.push_back( StackEntry{ 0, false } );
+		while ( !stack.empty() )
+		{
+			StackEntry		entry = stack.back();
+			stack.pop_back();
+
+			// Add elements of the node. If the node is fully inside of frustum then all of them are visible,
+			// otherwise test the packed bounds of the elements with frustum at one time
+			const Node&		node = nodes[entry.nodeIndex];
+			if ( entry.bFullyInside )
+			{
+				OutElements.insert( OutElements.end(), node.elements.begin(), node.elements.end() );
+			}
+			else if ( !node.elements.empty() )
+			{
+				InFrustum.CullBoxes( node.bounds, visibilityMask );
+				for ( uint32 wordIndex = 0, numWords = visibilityMask.size(); wordIndex < numWords; ++wordIndex )
+				{
+					uint32		word = visibilityMask[wordIndex];
+					for ( uint32 bitIndex = 0; word != 0; ++bitIndex, word >>= 1 )
+					{
+						if ( word & 1 )
+						{
+							OutElements.push_back( node.elements[wordIndex * 32 + bitIndex] );
+						}
+					}
+				}
+			}
+
+			// Go into children
+			for ( uint32 childIndex = 0; childIndex < 8; ++childIndex )
+			{
+				uint32		childNodeIndex = node.children[childIndex];
+				if ( childNodeIndex == INDEX_NONE )
+				{
+					continue;
+				}
+
+				// Test loose bounds of the child node
+				bool	bChildFullyInside = entry.bFullyInside;
+				if ( !bChildFullyInside )
+				{
+					const Node&				childNode = nodes[childNodeIndex];
+					const float				looseExtent = childNode.extent * 2.f;
+					EFrustumIntersection	intersection = InFrustum.Intersect( childNode.center, Vector( looseExtent, looseExtent, looseExtent ) );
+					if ( intersection == FI_Outside )
+					{
+						continue;
+					}
+					bChildFullyInside = intersection == FI_Inside;
+				}
+
+				stack.push_back( StackEntry{ childNodeIndex, bChildFullyInside } );
+			}
+		}
+	}
+
+	/**
+	 * @brief Get number of elements
+	 * @return Return number of elements in the octree
+	 */
+	FORCEINLINE uint32 GetNumElements() const
+	{
+		return elementIds.size();
+	}
+
+	/**
+	 * @brief Get number of nodes
+	 * @return Return number of used nodes in the octree
+	 */
+	FORCEINLINE uint32 GetNumNodes() const
+	{
+		return nodes.size() - freeNodes.size();
+	}
+
+private:
+	/**
+	 * @brief Location of the element in the octree
+	 */
+	struct ElementId
+	{
+		uint32		nodeIndex;		/**< Node index */
+		uint32		elementIndex;	/**< Element index in the node */
+	};
+
+	/**
+	 * @brief Node of the octree
+	 */
+	struct Node
+	{
+		Vector						center;			/**< Center of the node */
+		float						extent;			/**< Half size of tight bounds of the node */
+		uint32						parentIndex;	/**< Parent node index */
+		uint32						numChildren;	/**< Number of children */
+		uint32						children[8];	/**< Children node indices */
+		std::vector<TElementType>	elements;		/**< Elements in the node */
+		CPackedBounds				bounds;			/**< Packed bounds of the elements, indices are the same as in elements */
+	};
+
+	/**
+	 * @brief Find node index for bounds
+	 *
+	 * @param InBounds			Bounds
+	 * @param InIsCreateNodes	Is need create missing nodes
+	 * @return Return node index where the bounds must be stored. If InIsCreateNodes is FALSE and a needed node doesn't exist returns INDEX_NONE
+	 */
+	uint32 FindNodeIndex( const CBox& InBounds, bool InIsCreateNodes )
+	{
+		if ( !InBounds.IsValid() )
+		{
+			return 0;
+		}
+
+		const Vector	center		= ( InBounds.GetMin() + InBounds.GetMax() ) * 0.5f;
+		const Vector	extents		= ( InBounds.GetMax() - InBounds.GetMin() ) * 0.5f;
+		const float		maxExtent	= Max( extents.x, Max( extents.y, extents.z ) );
+
+		// Elements outside of the world are stored in the root node
+		if ( Math::Abs( center.x ) > rootExtent || Math::Abs( center.y ) > rootExtent || Math::Abs( center.z ) > rootExtent )
+		{
+			return 0;
+		}
+
+		uint32		nodeIndex = 0;
+		for ( uint32 depth = 0; depth < maxDepth; ++depth )
+		{
+			// Stop when the element doesn't fit into loose bounds of children
+			const float		childExtent = nodes[nodeIndex].extent * 0.5f;
+			if ( maxExtent > childExtent )
+			{
+				break;
+			}
+
+			const Vector&	nodeCenter = nodes[nodeIndex].center;
+			uint32			childIndex = ( center.x >= nodeCenter.x ? 1 : 0 ) | ( center.y >= nodeCenter.y ? 2 : 0 ) | ( center.z >= nodeCenter.z ? 4 : 0 );
+			uint32			childNodeIndex = nodes[nodeIndex].children[childIndex];
+			if ( childNodeIndex == INDEX_NONE )
+			{
+				if ( !InIsCreateNodes )
+				{
+					return INDEX_NONE;
+				}
+
+				Vector		childCenter( nodeCenter.x + ( childIndex & 1 ? childExtent : -childExtent ),
+										 nodeCenter.y + ( childIndex & 2 ? childExtent : -childExtent ),
+										 nodeCenter.z + ( childIndex & 4 ? childExtent : -childExtent ) );
+				childNodeIndex = AllocateNode( childCenter, childExtent, nodeIndex );
+				nodes[nodeIndex].children[childIndex] = childNodeIndex;
+				++nodes[nodeIndex].numChildren;
+			}
+			nodeIndex = childNodeIndex;
+		}
+
+		return nodeIndex;
+	}
+
+	/**
+	 * @brief Allocate node
+	 *
+	 * @param InCenter		Center of the node
+	 * @param InExtent		Half size of the node
+	 * @param InParentIndex	Parent node index
+	 * @return Return index of allocated node
+	 */
+	uint32 AllocateNode( const Vector& InCenter, float InExtent, uint32 InParentIndex )
+	{
+		uint32		nodeIndex;
+		if ( !freeNodes.empty() )
+		{
+			nodeIndex = freeNodes.back();
+			freeNodes.pop_back();
+		}
+		else
+		{
+			nodeIndex = nodes.size();
+			nodes.push_back( Node() );
+		}
+
+		Node&		node = nodes[nodeIndex];
+		node.center			= InCenter;
+		node.extent			= InExtent;
+		node.parentIndex	= InParentIndex;
+		node.numChildren	= 0;
+		for ( uint32 index = 0; index < 8; ++index )
+		{
+			node.children[index] = INDEX_NONE;
+		}
+		node.elements.clear();
+		node.bounds.Clear();
+		return nodeIndex;
+	}
+
+	/**
+	 * @brief Free empty nodes up to the root
+	 * @param InNodeIndex	Node index
+	 */
+	void PruneNode( uint32 InNodeIndex )
+	{
+		uint32		nodeIndex = InNodeIndex;
+		while ( nodeIndex != 0 && nodes[nodeIndex].elements.empty() && nodes[nodeIndex].numChildren == 0 )
+		{
+			Node&		parentNode = nodes[nodes[nodeIndex].parentIndex];
+			for ( uint32 index = 0; index < 8; ++index )
+			{
+				if ( parentNode.children[index] == nodeIndex )
+				{
+					parentNode.children[index] = INDEX_NONE;
+					--parentNode.numChildren;
+					break;
+				}
+			}
+
+			freeNodes.push_back( nodeIndex );
+			nodeIndex = nodes[nodeIndex].parentIndex;
+		}
+	}
+
+	float												rootExtent;		/**< Half size of the root node */
+	uint32												maxDepth;		/**< Maximum depth of the octree */
+	std::vector<Node>									nodes;			/**< Nodes. The first one is the root */
+	std::vector<uint32>									freeNodes;		/**< Indices of free nodes */
+	std::unordered_map<TElementType, ElementId>			elementIds;		/**< Map of element to its location in the octree */
+};
+
+#endif // !SCENEOCTREE_H
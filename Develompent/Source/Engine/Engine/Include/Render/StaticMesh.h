@@ -390,6 +390,8 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const StaticMeshSurface&
 	return InArchive;
 }
 
+DECLARE_BITWISE_SERIALIZABLE( StaticMeshSurface )
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, TAssetHandle<CStaticMesh>& InValue )
 {
 	TAssetHandle<CAsset>	asset = InValue;
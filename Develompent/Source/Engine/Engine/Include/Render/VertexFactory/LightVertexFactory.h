@@ -10,17 +10,37 @@
 #define LIGHTVERTEXFACTORY_H
 
 #include <vector>
+#include <list>
 
 #include "Math/Math.h"
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 #include "Render/RenderUtils.h"
+#include "Render/FrameAllocator.h"
 
 #include "Components/LightComponent.h"
 #include "Components/PointLightComponent.h"
 #include "Components/SpotLightComponent.h"
 #include "Components/DirectionalLightComponent.h"
 
+/**
+ * @ingroup Engine
+ * @brief Typedef of list of point lights to render, it's allocated from the frame allocator
+ */
+typedef std::list< CPointLightComponent*, TRenderFrameAllocator<CPointLightComponent*> >					PointLightList_t;
+
+/**
+ * @ingroup Engine
+ * @brief Typedef of list of spot lights to render, it's allocated from the frame allocator
+ */
+typedef std::list< CSpotLightComponent*, TRenderFrameAllocator<CSpotLightComponent*> >					SpotLightList_t;
+
+/**
+ * @ingroup Engine
+ * @brief Typedef of list of directional lights to render, it's allocated from the frame allocator
+ */
+typedef std::list< CDirectionalLightComponent*, TRenderFrameAllocator<CDirectionalLightComponent*> >		DirectionalLightList_t;
+
 /**
  * @ingroup Engine
  * @brief Vertex type for light render
@@ -120,7 +140,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CPointLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const PointLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Set the l2w transform shader
@@ -132,7 +152,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CSpotLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const SpotLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Set the l2w transform shader
@@ -144,7 +164,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CDirectionalLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const DirectionalLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 };
 
 /**
@@ -195,7 +215,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CPointLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const PointLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Setup instancing for spot lights
@@ -206,7 +226,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CSpotLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const SpotLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Setup instancing for directional lights
@@ -217,7 +237,7 @@ public:
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CDirectionalLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const DirectionalLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Get type hash
@@ -137,4 +137,14 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const StaticMeshVertexTyp
 	return InArchive;
 }
 
+/**
+ * @ingroup Engine
+ * @brief StaticMeshVertexType is serialized field by field, so arrays of it can be serialized at one time only if it has no padding
+ */
+template<>
+struct TIsBitwiseSerializable<StaticMeshVertexType>
+{
+	static constexpr bool	value = sizeof( StaticMeshVertexType ) == sizeof( Vector4D ) * 4 + sizeof( Vector2D );
+};
+
 #endif // !STATICMESHVERTEXFACTORY_H
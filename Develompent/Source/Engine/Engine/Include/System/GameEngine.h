@@ -12,6 +12,7 @@
 #include "System/BaseEngine.h"
 #include "Render/Viewport.h"
 #include "Render/GameViewportClient.h"
+#include "Render/RenderingThread.h"
 
 /**
  * @ingroup Engine
@@ -79,8 +80,11 @@ public:
 	}
 
 private:
-	CViewport				viewport;			/**< Viewport */
-	CGameViewportClient		viewportClient;		/**< Viewport client */
+	CViewport				viewport;										/**< Viewport */
+	CGameViewportClient		viewportClient;									/**< Viewport client */
+	CRenderFence			frameFences[RENDER_MAX_FRAMES_IN_FLIGHT];		/**< Fences of frames which the rendering thread may render */
+	uint32					maxFramesInFlight;								/**< Max number of frames which the game thread may run ahead of the rendering thread */
+	uint32					frameIndex;										/**< Index of the current frame, it selects a fence of the frame */
 };
 
 #endif // !GAMEENGINE_H
\ No newline at end of file
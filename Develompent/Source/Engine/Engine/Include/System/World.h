@@ -43,6 +43,12 @@ public:
 	 */
 	virtual void BeginDestroy() override;
 
+	/**
+	 * @brief Can the object be grouped into a GC cluster
+	 * @return Return TRUE if the object can be in a GC cluster, otherwise returns FALSE
+	 */
+	virtual bool CanBeInCluster() const override;
+
 	/**
 	 * @brief Do any object-specific cleanup required immediately after loading an object
 	 * @note This is not called for newly-created objects, and by default will always execute on the game thread
@@ -61,6 +67,7 @@ public:
 
 	/**
 	 * Update world
+	 * Ticks actors by tick groups (see ETickingGroup) and steps physics simulation between them
 	 * 
 	 * @param[in] InDeltaTime The time since the last tick
 	 */
@@ -111,7 +118,7 @@ public:
 	}
 
 	/**
-	 * Trace a ray against the world using a specific channel and return the first blocking hit
+	 * Trace a ray against the world using a specific channel and return the closest blocking hit
 	 * 
 	 * @param OutHitResult Hit result
 	 * @param InStart Start ray
@@ -125,6 +132,46 @@ public:
 		return g_PhysicsScene.LineTraceSingleByChannel( OutHitResult, InStart, InEnd, InTraceChannel, InCollisionQueryParams );
 	}
 
+	/**
+	 * Sweep a box against the world using a specific channel and return the closest blocking hit
+	 *
+	 * @param OutHitResult Hit result
+	 * @param InStart Start location of the box center
+	 * @param InEnd End location of the box center
+	 * @param InBoxExtent Half extent of the box
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if a blocking hit is found, else false
+	 */
+	FORCEINLINE bool SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam )
+	{
+		return g_PhysicsScene.SweepSingleByChannel( OutHitResult, InStart, InEnd, InBoxExtent, InTraceChannel, InCollisionQueryParams );
+	}
+
+	/**
+	 * Test a box against the world using a specific channel and return all overlapped bodies
+	 *
+	 * @param OutOverlaps Array of overlaps
+	 * @param InLocation Location of the box center
+	 * @param InBoxExtent Half extent of the box
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if any overlap is found, else false
+	 */
+	FORCEINLINE bool OverlapMultiByChannel( std::vector<HitResult>& OutOverlaps, const Vector& InLocation, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam )
+	{
+		return g_PhysicsScene.OverlapMultiByChannel( OutOverlaps, InLocation, InBoxExtent, InTraceChannel, InCollisionQueryParams );
+	}
+
+	/**
+	 * Execute a batch of scene queries, large batches are executed in parallel on worker threads
+	 * @param InOutQueries Array of queries, results are written into them
+	 */
+	FORCEINLINE void ExecuteQueryBatch( std::vector<SceneQuery>& InOutQueries )
+	{
+		g_PhysicsScene.ExecuteQueryBatch( InOutQueries );
+	}
+
 #if ENABLE_HITPROXY
 	/**
 	 * Update hit proxies id in all actors
@@ -231,11 +278,28 @@ private:
 	 */
 	void DestroyActor( AActor* InActor, bool InIsIgnorePlaying );
 
+	/**
+	 * Tick actors of a tick group
+	 * Actors are ticked in waves, each wave contains actors which prerequisites are already ticked. Actors of a wave which
+	 * are allowed to tick on any thread are ticked in parallel on worker threads of the thread pool, others on the game thread.
+	 * After that all actors of the group are synced to physics on the game thread, or after the simulation if it's running
+	 *
+	 * @param InTickGroup	Tick group
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	void TickGroup( ETickingGroup InTickGroup, float InDeltaTime );
+
+	/**
+	 * End physics simulation and sync actors which have been ticked while it was running
+	 */
+	void EndPhysicsSimulation();
+
 	bool						isBeginPlay;					/**< Is started gameplay */
 	float						timeSinceLastPendingKillPurge;	/**< Time since last pending kill purge (in seconds) */
 	class CBaseScene*			scene;							/**< Scene manager */
 	std::vector<AActor*>		actors;							/**< Array actors in world */
 	std::vector<AActor*>		actorsToDestroy;				/**< Array actors which need destroy after tick */
+	std::vector<AActor*>		actorsToSyncPhysics;			/**< Array actors which need sync to physics after the simulation */
 
 #if WITH_EDITOR
 	std::vector<AActor*>		selectedActors;					/**< Array of selected actors */
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Misc/EngineGlobals.h"
 #include "System/World.h"
 #include "Actors/Actor.h"
@@ -16,11 +18,13 @@ AActor::AActor()
 	, bActorIsBeingDestroyed( false )
 	, bBeginPlay( false )
 	, bVisibility( true )
+	, bAllowTickOnAnyThread( false )
 
 #if WITH_EDITOR
 	, bSelected( false )
 #endif // WITH_EDITOR
 
+	, tickGroup( TG_PrePhysics )
 	, worldPrivate( nullptr )
 {}
 
@@ -33,6 +37,18 @@ void AActor::BeginDestroy()
 {
 	Super::BeginDestroy();
 	ResetOwnedComponents();
+	ResetTickPrerequisites();
+}
+
+/*
+==================
+AActor::CanBeInCluster
+==================
+*/
+bool AActor::CanBeInCluster() const
+{
+	// Components and tick prerequisites are added at runtime
+	return false;
 }
 
 /*
@@ -93,14 +109,6 @@ void AActor::Tick( float InDeltaTime )
 	{
 		ownedComponents[ index ]->TickComponent( InDeltaTime );
 	}
-
-	// Reinit collision if need
-	if ( bNeedReinitCollision )
-	{
-		TermPhysics();
-		InitPhysics();
-		bNeedReinitCollision = false;
-	}
 }
 
 /*
@@ -199,12 +207,111 @@ AActor::SyncPhysics
 */
 void AActor::SyncPhysics()
 {
+	// Reinit collision if need
+	if ( bNeedReinitCollision )
+	{
+		TermPhysics();
+		InitPhysics();
+		bNeedReinitCollision = false;
+	}
+
 	if ( collisionComponent )
 	{
 		collisionComponent->SyncComponentToPhysics();
 	}
 }
 
+/*
+==================
+AActor::AddTickPrerequisiteActor
+==================
+*/
+void AActor::AddTickPrerequisiteActor( AActor* InPrerequisiteActor )
+{
+	if ( !InPrerequisiteActor || InPrerequisiteActor == this )
+	{
+		return;
+	}
+
+	for ( uint32 index = 0, count = tickPrerequisites.size(); index < count; ++index )
+	{
+		if ( tickPrerequisites[index] == InPrerequisiteActor )
+		{
+			return;
+		}
+	}
+	tickPrerequisites.push_back( InPrerequisiteActor );
+	InPrerequisiteActor->tickDependents.push_back( this );
+}
+
+/*
+==================
+AActor::RemoveTickPrerequisiteActor
+==================
+*/
+void AActor::RemoveTickPrerequisiteActor( AActor* InPrerequisiteActor )
+{
+	for ( uint32 index = 0, count = tickPrerequisites.size(); index < count; ++index )
+	{
+		if ( tickPrerequisites[index] == InPrerequisiteActor )
+		{
+			std::vector<AActor*>&	dependents = InPrerequisiteActor->tickDependents;
+			dependents.erase( std::find( dependents.begin(), dependents.end(), this ) );
+			tickPrerequisites.erase( tickPrerequisites.begin() + index );
+			return;
+		}
+	}
+}
+
+/*
+==================
+AActor::ResetTickPrerequisites
+==================
+*/
+void AActor::ResetTickPrerequisites()
+{
+	for ( uint32 index = 0, count = tickPrerequisites.size(); index < count; ++index )
+	{
+		std::vector<AActor*>&	dependents = tickPrerequisites[index]->tickDependents;
+		dependents.erase( std::find( dependents.begin(), dependents.end(), this ) );
+	}
+
+	for ( uint32 index = 0, count = tickDependents.size(); index < count; ++index )
+	{
+		std::vector<AActor*>&	prerequisites = tickDependents[index]->tickPrerequisites;
+		prerequisites.erase( std::find( prerequisites.begin(), prerequisites.end(), this ) );
+	}
+
+	tickPrerequisites.clear();
+	tickDependents.clear();
+}
+
+/*
+==================
+AActor::AddTickPrerequisiteComponent
+==================
+*/
+void AActor::AddTickPrerequisiteComponent( CActorComponent* InPrerequisiteComponent )
+{
+	if ( InPrerequisiteComponent )
+	{
+		AddTickPrerequisiteActor( InPrerequisiteComponent->GetOwner() );
+	}
+}
+
+/*
+==================
+AActor::RemoveTickPrerequisiteComponent
+==================
+*/
+void AActor::RemoveTickPrerequisiteComponent( CActorComponent* InPrerequisiteComponent )
+{
+	if ( InPrerequisiteComponent )
+	{
+		RemoveTickPrerequisiteActor( InPrerequisiteComponent->GetOwner() );
+	}
+}
+
 #if WITH_EDITOR
 
 /*
@@ -234,6 +341,9 @@ CActorComponent* AActor::CreateComponent( CClass* InClass, const CName& InName,
 	bool					bIsASceneComponent	= IsA<CSceneComponent>( component );
 	Assert( component );
 
+	// The actor may be already traversed by incremental reachability analysis
+	CObjectGC::Get().WriteBarrier( this, component );
+
 	// If created component is a CSceneComponent and RootComponent not setted - set it!
 	if ( !rootComponent && bIsASceneComponent )
 	{
@@ -274,8 +384,9 @@ void AActor::AddOwnedComponent( class CActorComponent* InComponent )
 		}
 	}
 
-	// Add component
+	// Add component. The actor may be already traversed by incremental reachability analysis
 	InComponent->Rename( nullptr, this );
+	CObjectGC::Get().WriteBarrier( this, InComponent );
 	ownedComponents.push_back( InComponent );
 }
 
@@ -20,6 +20,17 @@ CActorComponent::CActorComponent()
 	worldPrivate( nullptr )
 {}
 
+/*
+==================
+CActorComponent::CanBeInCluster
+==================
+*/
+bool CActorComponent::CanBeInCluster() const
+{
+	// Components are attached and get their assets at runtime
+	return false;
+}
+
 /*
 ==================
 CActorComponent::BeginPlay
@@ -16,19 +16,19 @@ CArrowComponent::CArrowComponent()
 
 /*
 ==================
-CArrowComponent::AddToDrawList
+CArrowComponent::PrepareDrawList
 ==================
 */
-void CArrowComponent::AddToDrawList( const class CSceneView& InSceneView )
+bool CArrowComponent::PrepareDrawList( const class CSceneView& InSceneView )
 {
 #if WITH_EDITOR
 	CScene*				scene				= ( CScene* )g_World->GetScene();
 	float				oneThirdLength		= length / 10.f;
-	const CTransform&	componentTransform	= GetComponentTransform();
+	const CTransform&	componentTransform	= renderTransform;
 	Vector				direction			= componentTransform.GetUnitAxis( A_Forward );
 
 	// Arrow body
-	Vector		start	= GetComponentLocation();
+	Vector		start	= componentTransform.GetLocation();
 	Vector		end		= start + direction * length;
 	scene->GetSDG( SDG_WorldEdForeground ).simpleElements.AddLine( start, end, CColor::red );
 
@@ -50,4 +50,7 @@ void CArrowComponent::AddToDrawList( const class CSceneView& InSceneView )
 	end = arrowBase - componentTransform.GetUnitAxis( A_Up ) * 2.f;
 	scene->GetSDG( SDG_WorldEdForeground ).simpleElements.AddLine( start, end, CColor::red );
 #endif // WITH_EDITOR
+
+	// Arrow consists of debug lines only
+	return false;
 }
\ No newline at end of file
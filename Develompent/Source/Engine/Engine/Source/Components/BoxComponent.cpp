@@ -40,7 +40,7 @@ CBoxComponent::DrawDebugComponent
 */
 void CBoxComponent::DrawDebugComponent()
 {
-	boundbox = CBox::BuildAABB( GetComponentLocation() + size / 2.f, size / 2.f );
+	boundbox = CBox::BuildAABB( renderTransform.GetLocation() + size / 2.f, size / 2.f );
 	DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_COLLISION );
 }
 #endif // WITH_EDITOR
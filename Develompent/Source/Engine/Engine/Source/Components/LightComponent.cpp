@@ -29,6 +29,17 @@ void CLightComponent::BeginDestroy()
 	{
 		scene->RemoveLight( this );
 	}
+	detachFence.BeginFence();
+}
+
+/*
+==================
+CLightComponent::IsReadyForFinishDestroy
+==================
+*/
+bool CLightComponent::IsReadyForFinishDestroy() const
+{
+	return Super::IsReadyForFinishDestroy() && detachFence.IsFenceComplete();
 }
 
 /*
@@ -65,6 +76,44 @@ void CLightComponent::Destroyed()
 	GetWorld()->GetScene()->RemoveLight( this );
 }
 
+#if WITH_EDITOR
+/*
+==================
+CLightComponent::PostEditChangeProperty
+==================
+*/
+void CLightComponent::PostEditChangeProperty( const PropertyChangedEvenet& InPropertyChangedEvenet )
+{
+	// Radius, height and etc of the light affect its bounds and parameters for rendering
+	MarkRenderStateDirty();
+	Super::PostEditChangeProperty( InPropertyChangedEvenet );
+}
+#endif // WITH_EDITOR
+
+/*
+==================
+CLightComponent::MarkRenderStateDirty
+==================
+*/
+void CLightComponent::MarkRenderStateDirty()
+{
+	if ( scene )
+	{
+		scene->UpdateLight( this );
+	}
+}
+
+/*
+==================
+CLightComponent::OnTransformChanged
+==================
+*/
+void CLightComponent::OnTransformChanged()
+{
+	Super::OnTransformChanged();
+	MarkRenderStateDirty();
+}
+
 /*
 ==================
 CLightComponent::GetLightType
@@ -73,4 +122,27 @@ CLightComponent::GetLightType
 ELightType CLightComponent::GetLightType() const
 {
 	return LT_Unknown;
+}
+
+/*
+==================
+CLightComponent::GetBoundBox
+==================
+*/
+CBox CLightComponent::GetBoundBox() const
+{
+	return CBox();
+}
+
+/*
+==================
+CLightComponent::GetRenderParameters
+==================
+*/
+void CLightComponent::GetRenderParameters( LightRenderParameters& OutParameters ) const
+{
+	OutParameters.bEnabled		= bEnabled;
+	OutParameters.lightColor	= lightColor;
+	OutParameters.intensivity	= intensivity;
+	OutParameters.transform		= GetComponentTransform();
 }
\ No newline at end of file
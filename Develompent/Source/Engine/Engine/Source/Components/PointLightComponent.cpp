@@ -48,4 +48,25 @@ CPointLightComponent::GetLightType
 ELightType CPointLightComponent::GetLightType() const
 {
 	return LT_Point;
+}
+
+/*
+==================
+CPointLightComponent::GetBoundBox
+==================
+*/
+CBox CPointLightComponent::GetBoundBox() const
+{
+	return CBox::BuildAABB( GetComponentLocation(), Vector( radius, radius, radius ) );
+}
+
+/*
+==================
+CPointLightComponent::GetRenderParameters
+==================
+*/
+void CPointLightComponent::GetRenderParameters( LightRenderParameters& OutParameters ) const
+{
+	Super::GetRenderParameters( OutParameters );
+	OutParameters.radius	= radius;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Components/PrimitiveComponent.h"
 #include "Misc/EngineGlobals.h"
+#include "Misc/PhysicsGlobals.h"
 #include "System/World.h"
 #include "Actors/Actor.h"
 #include "Render/Scene.h"
@@ -13,8 +14,10 @@ CPrimitiveComponent::CPrimitiveComponent
 */
 CPrimitiveComponent::CPrimitiveComponent()
 	: bIsDirtyDrawingPolicyLink( true )
+	, bIsDirtyBounds( false )
 	, bVisibility( true )
 	, scene( nullptr )
+	, renderScene( nullptr )
 {}
 
 /*
@@ -29,6 +32,17 @@ void CPrimitiveComponent::BeginDestroy()
 	{
 		scene->RemovePrimitive( this );
 	}
+	detachFence.BeginFence();
+}
+
+/*
+==================
+CPrimitiveComponent::IsReadyForFinishDestroy
+==================
+*/
+bool CPrimitiveComponent::IsReadyForFinishDestroy() const
+{
+	return Super::IsReadyForFinishDestroy() && detachFence.IsFenceComplete();
 }
 
 /*
@@ -96,14 +110,70 @@ CPrimitiveComponent::UnlinkDrawList
 void CPrimitiveComponent::UnlinkDrawList()
 {}
 
+/*
+==================
+CPrimitiveComponent::PrepareDrawList
+==================
+*/
+bool CPrimitiveComponent::PrepareDrawList( const class CSceneView& InSceneView )
+{
+	return false;
+}
+
 /*
 ==================
 CPrimitiveComponent::AddToDrawList
 ==================
 */
-void CPrimitiveComponent::AddToDrawList( const class CSceneView& InSceneView )
+void CPrimitiveComponent::AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const
+{}
+
+#if WITH_EDITOR
+/*
+==================
+CPrimitiveComponent::PostEditChangeProperty
+==================
+*/
+void CPrimitiveComponent::PostEditChangeProperty( const PropertyChangedEvenet& InPropertyChangedEvenet )
+{
+	// Any property may affect bounds of the primitive (mesh, sprite size, etc)
+	MarkBoundsDirty();
+	Super::PostEditChangeProperty( InPropertyChangedEvenet );
+}
+#endif // WITH_EDITOR
+
+/*
+==================
+CPrimitiveComponent::UpdateBounds
+==================
+*/
+void CPrimitiveComponent::UpdateBounds()
 {}
 
+/*
+==================
+CPrimitiveComponent::MarkBoundsDirty
+==================
+*/
+void CPrimitiveComponent::MarkBoundsDirty()
+{
+	if ( scene )
+	{
+		scene->UpdatePrimitiveBounds( this );
+	}
+}
+
+/*
+==================
+CPrimitiveComponent::OnTransformChanged
+==================
+*/
+void CPrimitiveComponent::OnTransformChanged()
+{
+	Super::OnTransformChanged();
+	MarkBoundsDirty();
+}
+
 /*
 ==================
 CPrimitiveComponent::InitPrimitivePhysics
@@ -131,8 +201,9 @@ void CPrimitiveComponent::SyncComponentToPhysics()
 		AActor*		actorOwner = GetOwner();
 		Assert( actorOwner );
 
+		// The simulation is stepped with a fixed time step, so the body is interpolated between the last two steps to move smoothly
 		CTransform		oldTransform = actorOwner->GetActorTransform();
-		CTransform		newTransform = bodyInstance.GetLEWorldTransform();
+		CTransform		newTransform = bodyInstance.GetInterpolatedLEWorldTransform( g_PhysicsEngine.GetInterpolationAlpha() );
 
 #if ENGINE_2D
 		// For 2D game we copy to new transform Z coord (in 2D this is layer)
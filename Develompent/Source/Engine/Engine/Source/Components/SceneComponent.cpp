@@ -39,7 +39,7 @@ void CSceneComponent::PostEditChangeProperty( const PropertyChangedEvenet& InPro
 	CProperty*		changedProperty = InPropertyChangedEvenet.property;
 	if ( changedProperty->GetCName() == TEXT( "Location" ) || changedProperty->GetCName() == TEXT( "Rotation" ) || changedProperty->GetCName() == TEXT( "Scale" ) )
 	{
-		bDityComponentToWorld = true;
+		MarkComponentToWorldDirty();
 	}
 	Super::PostEditChangeProperty( InPropertyChangedEvenet );
 }
@@ -86,6 +86,7 @@ void CSceneComponent::SetupAttachment( CSceneComponent* InParent )
 
 	attachParent = InParent;
 	InParent->attachChildren.push_back( this );
+	MarkComponentToWorldDirty();
 }
 
 /*
@@ -126,6 +127,7 @@ void CSceneComponent::DetachFromParent( bool InIsMaintainWorldPosition /* = fals
 		}
 
 		attachParent = nullptr;
+		OnTransformChanged();
 	}
 }
 
@@ -144,6 +146,31 @@ const CTransform& CSceneComponent::GetComponentTransform() const
 	return componentToWorld;
 }
 
+/*
+==================
+CSceneComponent::OnTransformChanged
+==================
+*/
+void CSceneComponent::OnTransformChanged()
+{}
+
+/*
+==================
+CSceneComponent::MarkComponentToWorldDirty
+==================
+*/
+void CSceneComponent::MarkComponentToWorldDirty()
+{
+	bDityComponentToWorld = true;
+	OnTransformChanged();
+
+	// Mark child components
+	for ( uint32 index = 0, count = attachChildren.size(); index < count; ++index )
+	{
+		attachChildren[index]->MarkComponentToWorldDirty();
+	}
+}
+
 /*
 ==================
 CSceneComponent::UpdateComponentToWorld
@@ -64,15 +64,15 @@ void CSphereComponent::UpdateBodySetup()
 
 /*
 ==================
-CSphereComponent::AddToDrawList
+CSphereComponent::PrepareDrawList
 ==================
 */
-void CSphereComponent::AddToDrawList( const class CSceneView& InSceneView )
+bool CSphereComponent::PrepareDrawList( const class CSceneView& InSceneView )
 {
 	// If primitive is empty - exit from method
 	if ( !bIsDirtyDrawingPolicyLink && meshBatchLinks.empty() )
 	{
-		return;
+		return false;
 	}
 
 	// If drawing policy link is dirty - we update it
@@ -82,15 +82,24 @@ void CSphereComponent::AddToDrawList( const class CSceneView& InSceneView )
 		LinkDrawList();
 	}
 
+	return !meshBatchLinks.empty();
+}
+
+/*
+==================
+CSphereComponent::AddToDrawList
+==================
+*/
+void CSphereComponent::AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const
+{
 	// Add to mesh batch new instance
-	CTransform				transform = GetComponentTransform();
+	CTransform				transform = renderTransform;
 	transform.SetScale( Vector( radius, radius, radius ) );
 
+	const Matrix			transformMatrix = transform.ToMatrix();
 	for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
 	{
-		const MeshBatch*	meshBatchLink = meshBatchLinks[index];
-		++meshBatchLink->numInstances;
-		meshBatchLink->instances.push_back( MeshInstance{ transform.ToMatrix() } );
+		InOutInstanceBuffer.AddInstance( SDGLevel, meshBatchLinks[index], MeshInstance{ transformMatrix } );
 	}
 }
 
@@ -101,7 +110,7 @@ CSphereComponent::LinkDrawList
 */
 void CSphereComponent::LinkDrawList()
 {
-	Assert( scene );
+	Assert( renderScene );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( drawingPolicyLink )
@@ -110,7 +119,7 @@ void CSphereComponent::LinkDrawList()
 	}
 
 	SDGLevel = pendingSDGLevel;
-	SceneDepthGroup&				SDG = scene->GetSDG( SDGLevel );
+	SceneDepthGroup&				SDG = renderScene->GetSDG( SDGLevel );
 
 	// Generate mesh batch of sprite
 	MeshBatch			            meshBatch;
@@ -137,8 +146,8 @@ CSphereComponent::UnlinkDrawList
 */
 void CSphereComponent::UnlinkDrawList()
 {
-	Assert( scene );
-	SceneDepthGroup&	SDG = scene->GetSDG( SDGLevel );
+	Assert( renderScene );
+	SceneDepthGroup&	SDG = renderScene->GetSDG( SDGLevel );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( drawingPolicyLink  )
@@ -85,4 +85,29 @@ CSpotLightComponent::GetLightType
 ELightType CSpotLightComponent::GetLightType() const
 {
 	return LT_Spot;
+}
+
+/*
+==================
+CSpotLightComponent::GetBoundBox
+==================
+*/
+CBox CSpotLightComponent::GetBoundBox() const
+{
+	// The cone of the light is inside of a sphere around the light with radius equal to the slant height of the cone
+	const float		slantHeight = Math::Sqrt( radius * radius + height * height );
+	return CBox::BuildAABB( GetComponentLocation(), Vector( slantHeight, slantHeight, slantHeight ) );
+}
+
+/*
+==================
+CSpotLightComponent::GetRenderParameters
+==================
+*/
+void CSpotLightComponent::GetRenderParameters( LightRenderParameters& OutParameters ) const
+{
+	Super::GetRenderParameters( OutParameters );
+	OutParameters.radius	= radius;
+	OutParameters.height	= height;
+	OutParameters.cutoff	= GetCutoff();
 }
\ No newline at end of file
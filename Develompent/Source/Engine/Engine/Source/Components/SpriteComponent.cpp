@@ -125,12 +125,12 @@ void CSpriteComponent::CalcTransformationMatrix( const class CSceneView& InScene
 #if WITH_EDITOR
 	if ( bGizmo )
 	{
-		transform = CTransform( GetComponentLocation() );
+		transform = CTransform( renderTransform.GetLocation() );
 	}
 	else
 #endif // WITH_EDITOR
 	{
-		transform = GetComponentTransform();
+		transform = renderTransform;
 	}
 
     if ( type == ST_Static )
@@ -175,7 +175,7 @@ CSpriteComponent::LinkDrawList
 */
 void CSpriteComponent::LinkDrawList()
 {
-    Assert( scene );
+    Assert( renderScene );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( drawingPolicyLink
@@ -190,7 +190,7 @@ void CSpriteComponent::LinkDrawList()
 	// If sprite is valid - add to scene draw policy link
 	if ( sprite )
 	{
-		SceneDepthGroup&               SDG = scene->GetSDG( 
+		SceneDepthGroup&               SDG = renderScene->GetSDG( 
 #if WITH_EDITOR
 			bGizmo ? SDG_WorldEdForeground :
 #endif // WITH_EDITOR
@@ -239,8 +239,8 @@ CSpriteComponent::UnlinkDrawList
 */
 void CSpriteComponent::UnlinkDrawList()
 {
-    Assert( scene );
-	SceneDepthGroup&		SDGWorld = scene->GetSDG( SDG_World );
+    Assert( renderScene );
+	SceneDepthGroup&		SDGWorld = renderScene->GetSDG( SDG_World );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( drawingPolicyLink )
@@ -271,15 +271,15 @@ void CSpriteComponent::UnlinkDrawList()
 
 /*
 ==================
-CSpriteComponent::AddToDrawList
+CSpriteComponent::PrepareDrawList
 ==================
 */
-void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
+bool CSpriteComponent::PrepareDrawList( const class CSceneView& InSceneView )
 {
 	// If primitive is empty - exit from method
 	if ( !bIsDirtyDrawingPolicyLink && meshBatchLinks.empty() )
 	{
-		return;
+		return false;
 	}
 
 	// If drawing policy link is dirty - we update it
@@ -294,89 +294,121 @@ void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 		else
 		{
 			UnlinkDrawList();
-			return;
+			return false;
 		}	
 	}
 
+	// Draw wireframe box if owner actor is selected (only for WorldEd)
+#if WITH_EDITOR
+	AActor*		owner = GetOwner();
+	if ( !bGizmo && owner ? owner->IsSelected() : false )
+	{
+		DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_SPRITE );
+	}
+#endif // WITH_EDITOR
+
+	return !meshBatchLinks.empty();
+}
+
+/*
+==================
+CSpriteComponent::AddToDrawList
+==================
+*/
+void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const
+{
 	// Calculate transform matrix
 	AActor*		owner = GetOwner();
 	Matrix		transformMatrix;
 	CalcTransformationMatrix( InSceneView, transformMatrix );
 
-    // Add to mesh batch new instance
-	for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
-	{
-		const MeshBatch*	meshBatchLink = meshBatchLinks[ index ];	
-		++meshBatchLink->numInstances;
-		meshBatchLink->instances.resize( meshBatchLink->numInstances );
+	// Gizmo sprites are linked to foreground of WorldEd
+	ESceneDepthGroup	SDGType = 
+#if WITH_EDITOR
+		bGizmo ? SDG_WorldEdForeground :
+#endif // WITH_EDITOR
+		SDG_World;
 
-		MeshInstance&		instanceMesh = meshBatchLink->instances[ meshBatchLink->numInstances - 1 ];
-		instanceMesh.transformMatrix	 = transformMatrix;
+    // Add to mesh batch new instance
+	MeshInstance		instanceMesh;
+	instanceMesh.transformMatrix	= transformMatrix;
 
 #if ENABLE_HITPROXY
-		instanceMesh.hitProxyId		= owner ? owner->GetHitProxyId() : CHitProxyId();
+	instanceMesh.hitProxyId			= owner ? owner->GetHitProxyId() : CHitProxyId();
 #endif // ENABLE_HITPROXY
 
 #if WITH_EDITOR
-		instanceMesh.bSelected		= owner ? owner->IsSelected() : false;
+	instanceMesh.bSelected			= owner ? owner->IsSelected() : false;
 #endif // WITH_EDITOR
+
+	for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
+	{
+		InOutInstanceBuffer.AddInstance( SDGType, meshBatchLinks[ index ], instanceMesh );
+	}
+}
+
+/*
+==================
+CSpriteComponent::UpdateBounds
+==================
+*/
+void CSpriteComponent::UpdateBounds()
+{
+	// Rotating sprites are turned to the camera, so we take a sphere around them
+	if ( type != ST_Static )
+	{
+		const Vector	halfSize	= renderTransform.GetScale() * Vector( GetSpriteSize() / 2.f, 0.f );
+		const float		radius		= Math::LengthVector( halfSize );
+		boundbox = CBox::BuildAABB( renderTransform.GetLocation(), Vector( radius, radius, radius ) );
+		return;
 	}
 
-    // Update AABB
+	Vector			minLocation = Vector( -1.f, -1.f, 0.f ) * Vector( GetSpriteSize() / 2.f, 1.f );
+	Vector			maxLocation = Vector( 1.f, 1.f, 0.f ) * Vector( GetSpriteSize() / 2.f, 1.f );
+	Vector			verteces[8] =
+	{
+		Vector{ minLocation.x, minLocation.y, minLocation.z },
+		Vector{ maxLocation.x, minLocation.y, minLocation.z },
+		Vector{ maxLocation.x, maxLocation.y, minLocation.z },
+		Vector{ minLocation.x, maxLocation.y, minLocation.z },
+		Vector{ minLocation.x, minLocation.y, maxLocation.z },
+		Vector{ maxLocation.x, minLocation.y, maxLocation.z },
+		Vector{ maxLocation.x, maxLocation.y, maxLocation.z },
+		Vector{ minLocation.x, maxLocation.y, maxLocation.z },
+	};
+
+	const Quaternion	rotation	= renderTransform.GetRotation();
+	const Vector		scale		= renderTransform.GetScale();
+	minLocation = maxLocation = rotation * ( scale * verteces[0] );
+	for ( uint32 index = 1; index < 8; ++index )
 	{
-		Vector			minLocation = Vector( -1.f, -1.f, 0.f ) * Vector( GetSpriteSize() / 2.f, 1.f );
-		Vector			maxLocation = Vector( 1.f, 1.f, 0.f ) * Vector( GetSpriteSize() / 2.f, 1.f );
-		Vector			verteces[8] =
+		Vector		vertex = rotation * ( scale * verteces[index] );
+		if ( minLocation.x > vertex.x )
 		{
-			Vector{ minLocation.x, minLocation.y, minLocation.z },
-			Vector{ maxLocation.x, minLocation.y, minLocation.z },
-			Vector{ maxLocation.x, maxLocation.y, minLocation.z },
-			Vector{ minLocation.x, maxLocation.y, minLocation.z },
-			Vector{ minLocation.x, minLocation.y, maxLocation.z },
-			Vector{ maxLocation.x, minLocation.y, maxLocation.z },
-			Vector{ maxLocation.x, maxLocation.y, maxLocation.z },
-			Vector{ minLocation.x, maxLocation.y, maxLocation.z },
-		};
-
-		minLocation = maxLocation = GetComponentQuat() * ( GetComponentScale() * verteces[0] );
-		for ( uint32 index = 0; index < 7; ++index )
+			minLocation.x = vertex.x;
+		}
+		if ( minLocation.y > vertex.y )
+		{
+			minLocation.y = vertex.y;
+		}
+		if ( minLocation.z > vertex.z )
 		{
-			Vector		vertex = GetComponentQuat() * ( GetComponentScale() * verteces[index] );
-			if ( minLocation.x > vertex.x )
-			{
-				minLocation.x = vertex.x;
-			}
-			if ( minLocation.y > vertex.y )
-			{
-				minLocation.y = vertex.y;
-			}
-			if ( minLocation.z > vertex.z )
-			{
-				minLocation.z = vertex.z;
-			}
-
-			if ( maxLocation.x < vertex.x )
-			{
-				maxLocation.x = vertex.x;
-			}
-			if ( maxLocation.y < vertex.y )
-			{
-				maxLocation.y = vertex.y;
-			}
-			if ( maxLocation.z < vertex.z )
-			{
-				maxLocation.z = vertex.z;
-			}
+			minLocation.z = vertex.z;
 		}
 
-		boundbox = CBox::BuildAABB( GetComponentLocation(), minLocation, maxLocation );
+		if ( maxLocation.x < vertex.x )
+		{
+			maxLocation.x = vertex.x;
+		}
+		if ( maxLocation.y < vertex.y )
+		{
+			maxLocation.y = vertex.y;
+		}
+		if ( maxLocation.z < vertex.z )
+		{
+			maxLocation.z = vertex.z;
+		}
 	}
 
-	// Draw wireframe box if owner actor is selected (only for WorldEd)
-#if WITH_EDITOR
-	if ( !bGizmo && owner ? owner->IsSelected() : false )
-	{
-		DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_SPRITE );
-	}
-#endif // WITH_EDITOR
+	boundbox = CBox::BuildAABB( renderTransform.GetLocation(), minLocation, maxLocation );
 }
@@ -37,7 +37,8 @@ CStaticMeshComponent::PostLoad
 void CStaticMeshComponent::PostLoad()
 {
 	Super::PostLoad();
-	bIsDirtyDrawingPolicyLink = true;
+	MarkRenderStateDirty();
+	MarkBoundsDirty();
 }
 
 #if WITH_EDITOR
@@ -69,7 +70,7 @@ void CStaticMeshComponent::PostEditChangeProperty( const PropertyChangedEvenet&
 		}
 		
 		// Mark about we need remake drawing policy links
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty();
 	}
 	Super::PostEditChangeProperty( InPropertyChangedEvenet );
 }
@@ -82,7 +83,7 @@ CStaticMeshComponent::LinkDrawList
 */
 void CStaticMeshComponent::LinkDrawList()
 {
-	Assert( scene );
+	Assert( renderScene );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( elementDrawingPolicyLink )
@@ -91,11 +92,11 @@ void CStaticMeshComponent::LinkDrawList()
 	}
 
 	// If static mesh is valid - add to scene draw policy link
-	drawStaticMesh = staticMesh;
+	drawStaticMesh = renderStaticMesh;
 	TSharedPtr<CStaticMesh>		staticMeshRef = drawStaticMesh.ToSharedPtr();
 	if ( staticMeshRef )
 	{
-		elementDrawingPolicyLink = staticMeshRef->LinkDrawList( scene->GetSDG( SDG_World ), overrideMaterials );
+		elementDrawingPolicyLink = staticMeshRef->LinkDrawList( renderScene->GetSDG( SDG_World ), renderOverrideMaterials );
 	}
 }
 
@@ -106,7 +107,7 @@ CStaticMeshComponent::UnlinkDrawList
 */
 void CStaticMeshComponent::UnlinkDrawList()
 {
-	Assert( scene );
+	Assert( renderScene );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( elementDrawingPolicyLink )
@@ -114,7 +115,7 @@ void CStaticMeshComponent::UnlinkDrawList()
 		TSharedPtr<CStaticMesh>		staticMeshRef = drawStaticMesh.ToSharedPtr();
 		if ( staticMeshRef )
 		{
-			staticMeshRef->UnlinkDrawList( scene->GetSDG( SDG_World ), elementDrawingPolicyLink );
+			staticMeshRef->UnlinkDrawList( renderScene->GetSDG( SDG_World ), elementDrawingPolicyLink );
 		}
 		else
 		{
@@ -127,15 +128,34 @@ void CStaticMeshComponent::UnlinkDrawList()
 
 /*
 ==================
-CStaticMeshComponent::AddToDrawList
+CStaticMeshComponent::MarkRenderStateDirty
+==================
+*/
+void CStaticMeshComponent::MarkRenderStateDirty()
+{
+	// The rendering thread may link draw lists in frames in flight, so it gets own copies of the mesh and materials
+	UNIQUE_RENDER_COMMAND_THREEPARAMETER( CUpdateStaticMeshRenderStateCommand,
+										  CStaticMeshComponent*, staticMeshComponent, this,
+										  TAssetHandle<CStaticMesh>, mesh, staticMesh,
+										  std::vector< TAssetHandle<CMaterial> >, materials, overrideMaterials,
+										  {
+											  staticMeshComponent->renderStaticMesh				= mesh;
+											  staticMeshComponent->renderOverrideMaterials		= materials;
+											  staticMeshComponent->bIsDirtyDrawingPolicyLink	= true;
+										  } );
+}
+
+/*
+==================
+CStaticMeshComponent::PrepareDrawList
 ==================
 */
-void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
+bool CStaticMeshComponent::PrepareDrawList( const class CSceneView& InSceneView )
 {
 	// If primitive is empty - exit from method
 	if ( !bIsDirtyDrawingPolicyLink && !elementDrawingPolicyLink )
 	{
-		return;
+		return false;
 	}
 
 	// If drawing policy link is dirty - we update it
@@ -144,21 +164,38 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 		bIsDirtyDrawingPolicyLink = false;
 		
 		LinkDrawList();
-		if ( !staticMesh.IsAssetValid() )
+		if ( !renderStaticMesh.IsAssetValid() || !elementDrawingPolicyLink )
 		{
-			return;
+			return false;
 		}
 	}
 
+	// Draw wireframe box if owner actor is selected (only for WorldEd)
+#if WITH_EDITOR
+	AActor*		owner = GetOwner();
+	if ( boundbox.IsValid() && ( owner ? owner->IsSelected() : false ) )
+	{
+		DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_STATIC_MESH );
+	}
+#endif // WITH_EDITOR
+
+	return true;
+}
+
+/*
+==================
+CStaticMeshComponent::AddToDrawList
+==================
+*/
+void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView, class CMeshInstanceBuffer& InOutInstanceBuffer ) const
+{
 	AActor*		owner = GetOwner();
 
 	// Add to mesh batch new instance
-	const Matrix				transformationMatrix = GetComponentTransform().ToMatrix();
+	const Matrix				transformationMatrix = renderTransform.ToMatrix();
 	for ( uint32 index = 0, count = elementDrawingPolicyLink->meshBatchLinks.size(); index < count; ++index )
 	{
-		const MeshBatch*		meshBatch = elementDrawingPolicyLink->meshBatchLinks[ index ];
-		++meshBatch->numInstances;
-		meshBatch->instances.push_back( MeshInstance{ transformationMatrix 
+		InOutInstanceBuffer.AddInstance( SDG_World, elementDrawingPolicyLink->meshBatchLinks[ index ], MeshInstance{ transformationMatrix 
 #if ENABLE_HITPROXY
 										, owner ? owner->GetHitProxyId() : CHitProxyId()
 #endif // ENABLE_HITPROXY
@@ -168,64 +205,70 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 #endif // WITH_EDITOR
 										} );
 	}
+}
+
+/*
+==================
+CStaticMeshComponent::UpdateBounds
+==================
+*/
+void CStaticMeshComponent::UpdateBounds()
+{
+	// If static mesh isn't valid then we can't build AABB
+	TSharedPtr<CStaticMesh>		staticMeshRef = renderStaticMesh.ToSharedPtr();
+	if ( !staticMeshRef )
+	{
+		boundbox.Clear();
+		return;
+	}
 
 	// Build AABB
-	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
-	if ( staticMeshRef )
+	Vector			minLocation = staticMeshRef->GetBoundingBox().GetMin();
+	Vector			maxLocation = staticMeshRef->GetBoundingBox().GetMax();
+	Vector			verteces[8] =
 	{
-		Vector			minLocation = staticMeshRef->GetBoundingBox().GetMin();
-		Vector			maxLocation = staticMeshRef->GetBoundingBox().GetMax();
-		Vector			verteces[8] =
+		Vector{ minLocation.x, minLocation.y, minLocation.z },
+		Vector{ maxLocation.x, minLocation.y, minLocation.z },
+		Vector{ maxLocation.x, maxLocation.y, minLocation.z },
+		Vector{ minLocation.x, maxLocation.y, minLocation.z },
+		Vector{ minLocation.x, minLocation.y, maxLocation.z },
+		Vector{ maxLocation.x, minLocation.y, maxLocation.z },
+		Vector{ maxLocation.x, maxLocation.y, maxLocation.z },
+		Vector{ minLocation.x, maxLocation.y, maxLocation.z },
+	};
+
+	const Quaternion	rotation	= renderTransform.GetRotation();
+	const Vector		scale		= renderTransform.GetScale();
+	minLocation = maxLocation	= rotation * ( scale * verteces[0] );
+	for ( uint32 index = 1; index < 8; ++index )
+	{
+		Vector		vertex		= rotation * ( scale * verteces[index] );
+		if ( minLocation.x > vertex.x )
 		{
-			Vector{ minLocation.x, minLocation.y, minLocation.z },
-			Vector{ maxLocation.x, minLocation.y, minLocation.z },
-			Vector{ maxLocation.x, maxLocation.y, minLocation.z },
-			Vector{ minLocation.x, maxLocation.y, minLocation.z },
-			Vector{ minLocation.x, minLocation.y, maxLocation.z },
-			Vector{ maxLocation.x, minLocation.y, maxLocation.z },
-			Vector{ maxLocation.x, maxLocation.y, maxLocation.z },
-			Vector{ minLocation.x, maxLocation.y, maxLocation.z },
-		};
-
-		minLocation = maxLocation	= GetComponentQuat() * ( GetComponentScale() * verteces[0] );
-		for ( uint32 index = 0; index < 7; ++index )
+			minLocation.x = vertex.x;
+		}
+		if ( minLocation.y > vertex.y )
 		{
-			Vector		vertex		= GetComponentQuat() * ( GetComponentScale() * verteces[index] );
-			if ( minLocation.x > vertex.x )
-			{
-				minLocation.x = vertex.x;
-			}
-			if ( minLocation.y > vertex.y )
-			{
-				minLocation.y = vertex.y;
-			}
-			if ( minLocation.z > vertex.z )
-			{
-				minLocation.z = vertex.z;
-			}
-
-			if ( maxLocation.x < vertex.x )
-			{
-				maxLocation.x = vertex.x;
-			}
-			if ( maxLocation.y < vertex.y )
-			{
-				maxLocation.y = vertex.y;
-			}
-			if ( maxLocation.z < vertex.z )
-			{
-				maxLocation.z = vertex.z;
-			}
+			minLocation.y = vertex.y;
+		}
+		if ( minLocation.z > vertex.z )
+		{
+			minLocation.z = vertex.z;
 		}
 
-		boundbox = CBox::BuildAABB( GetComponentLocation(), minLocation, maxLocation );
-
-		// Draw wireframe box if owner actor is selected (only for WorldEd)
-#if WITH_EDITOR
-		if ( owner ? owner->IsSelected() : false )
+		if ( maxLocation.x < vertex.x )
 		{
-			DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_STATIC_MESH );
+			maxLocation.x = vertex.x;
+		}
+		if ( maxLocation.y < vertex.y )
+		{
+			maxLocation.y = vertex.y;
+		}
+		if ( maxLocation.z < vertex.z )
+		{
+			maxLocation.z = vertex.z;
 		}
-#endif // WITH_EDITOR
 	}
+
+	boundbox = CBox::BuildAABB( renderTransform.GetLocation(), minLocation, maxLocation );
 }
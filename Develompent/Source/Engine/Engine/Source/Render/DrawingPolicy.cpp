@@ -149,6 +149,20 @@ uint64 CMeshDrawingPolicy::GetTypeHash() const
 	return hash;
 }
 
+/*
+==================
+CMeshDrawingPolicy::GetSortKey
+==================
+*/
+MeshDrawingPolicySortKey CMeshDrawingPolicy::GetSortKey() const
+{
+	MeshDrawingPolicySortKey	sortKey;
+	sortKey.boundShaderStateKey = FastHash( pixelShader, FastHash( vertexShader, vertexFactory ? vertexFactory->GetType()->GetHash() : 0 ) );
+	sortKey.materialKey			= FastHash( material.ToSharedPtr().Get() );
+	sortKey.vertexFactoryKey	= vertexFactory ? vertexFactory->GetTypeHash() : 0;
+	return sortKey;
+}
+
 /*
 ==================
 CMeshDrawingPolicy::GetBoundShaderState
@@ -71,6 +71,11 @@ void CDynamicMeshBuilder::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI,
 	AssertMsg( vertexFactory && vertexBufferRHI, TEXT( "Before draw dynamic mesh need call CDynamicMeshBuilder::Build" ) );
 	
 	// Init mesh batch
+	MeshInstance	meshInstance{ InLocalToWorld, 
+#if ENABLE_HITPROXY
+								  hitProxyId 
+#endif // ENABLE_HITPROXY
+								};
 	MeshBatch		meshBatch;
 	meshBatch.indexBufferRHI	= indexBufferRHI;
 	meshBatch.baseVertexIndex	= 0;
@@ -78,11 +83,7 @@ void CDynamicMeshBuilder::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI,
 	meshBatch.numInstances		= 1;
 	meshBatch.numPrimitives		= numPrimitives;
 	meshBatch.primitiveType		= PT_TriangleList;
-	meshBatch.instances.push_back( MeshInstance{ InLocalToWorld, 
-#if ENABLE_HITPROXY
-								   hitProxyId 
-#endif // ENABLE_HITPROXY
-								   }  );
+	meshBatch.instances			= &meshInstance;
 
 	// Draw mesh
 	if ( InDrawingPolicy.IsValid() )
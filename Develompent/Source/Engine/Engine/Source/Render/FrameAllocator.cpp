@@ -0,0 +1,93 @@
+#include "Misc/CoreGlobals.h"
+#include "Render/FrameAllocator.h"
+#include "Render/RenderingThread.h"
+
+/* Initial size of a buffer of the frame allocator, in bytes. Buffers grow if a frame needs more */
+#define FRAME_ALLOCATOR_BUFFER_SIZE		( 1024 * 1024 )
+
+/*
+==================
+CFrameAllocator::CFrameAllocator
+==================
+*/
+CFrameAllocator::CFrameAllocator()
+	: gameFrameNumber( 0 )
+	, renderingFrameNumber( 0 )
+{
+	for ( uint32 index = 0; index < FRAME_ALLOCATOR_NUM_BUFFERS; ++index )
+	{
+		buffers[index] = new CLinearAllocator( FRAME_ALLOCATOR_BUFFER_SIZE );
+	}
+}
+
+/*
+==================
+CFrameAllocator::~CFrameAllocator
+==================
+*/
+CFrameAllocator::~CFrameAllocator()
+{
+	for ( uint32 index = 0; index < FRAME_ALLOCATOR_NUM_BUFFERS; ++index )
+	{
+		delete buffers[index];
+	}
+}
+
+/*
+==================
+CFrameAllocator::BeginFrame
+==================
+*/
+void CFrameAllocator::BeginFrame()
+{
+	Assert( IsInGameThread() );
+	++gameFrameNumber;
+
+	// The buffer of the new frame was used FRAME_ALLOCATOR_NUM_BUFFERS frames ago. The rendering thread is done with it
+	// when it has passed the fence after the beginning of the next frame. Usually the fence is already passed,
+	// because the frame fence of the engine doesn't let the game thread run more than RENDER_MAX_FRAMES_IN_FLIGHT frames ahead
+	const uint32	bufferIndex = gameFrameNumber % FRAME_ALLOCATOR_NUM_BUFFERS;
+	fences[bufferIndex].Wait();
+	buffers[bufferIndex]->Reset();
+
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CBeginRenderingFrameCommand, uint32, frameNumber, gameFrameNumber,
+										{
+											CFrameAllocator::Get().BeginRenderingFrame( frameNumber );
+										} );
+
+	// Once the rendering thread has begun this frame, it doesn't use the buffer of the previous one
+	fences[( gameFrameNumber - 1 ) % FRAME_ALLOCATOR_NUM_BUFFERS].BeginFence();
+}
+
+/*
+==================
+CFrameAllocator::BeginRenderingFrame
+==================
+*/
+void CFrameAllocator::BeginRenderingFrame( uint32 InFrameNumber )
+{
+	Assert( IsInRenderingThread() );
+	Sys_InterlockedExchange( &renderingFrameNumber, InFrameNumber );
+}
+
+/*
+==================
+CFrameAllocator::GetGameThreadAllocator
+==================
+*/
+CLinearAllocator& CFrameAllocator::GetGameThreadAllocator()
+{
+	Assert( IsInGameThread() );
+	return *buffers[gameFrameNumber % FRAME_ALLOCATOR_NUM_BUFFERS];
+}
+
+/*
+==================
+CFrameAllocator::GetRenderingThreadAllocator
+==================
+*/
+CLinearAllocator& CFrameAllocator::GetRenderingThreadAllocator()
+{
+	Assert( IsInRenderingThread() );
+	return *buffers[( uint32 )renderingFrameNumber % FRAME_ALLOCATOR_NUM_BUFFERS];
+}
@@ -0,0 +1,94 @@
+#include "Render/Frustum.h"
+
+#if PLATFORM_SUPPORTS_SSE
+	#include <xmmintrin.h>
+#endif // PLATFORM_SUPPORTS_SSE
+
+/*
+==================
+CFrustum::CullBoxes
+==================
+*/
+void CFrustum::CullBoxes( const CPackedBounds& InBounds, std::vector<uint32>& OutVisibilityMask ) const
+{
+	const uint32	numBoxes	= InBounds.GetNum();
+	const uint32	numWords	= ( numBoxes + 31 ) / 32;
+	OutVisibilityMask.assign( numWords, 0 );
+	if ( numBoxes == 0 )
+	{
+		return;
+	}
+
+	const float*	centersX	= InBounds.GetCentersX();
+	const float*	centersY	= InBounds.GetCentersY();
+	const float*	centersZ	= InBounds.GetCentersZ();
+	const float*	extentsX	= InBounds.GetExtentsX();
+	const float*	extentsY	= InBounds.GetExtentsY();
+	const float*	extentsZ	= InBounds.GetExtentsZ();
+
+	// A box is outside of a plane if its center is behind the plane further than projected extents of the box.
+	// This is the same test as checking all eight corners of the box, but it doesn't need to build them
+#if PLATFORM_SUPPORTS_SSE
+	static_assert( PACKEDBOUNDS_GROUP_SIZE == 4, "SSE path expects groups of four boxes" );
+
+	// Splat planes into registers once
+	const __m128	signMask = _mm_set1_ps( -0.f );
+	__m128			planesX[6], planesY[6], planesZ[6], planesW[6];
+	__m128			absPlanesX[6], absPlanesY[6], absPlanesZ[6];
+	for ( uint32 index = 0; index < 6; ++index )
+	{
+		planesX[index]		= _mm_set1_ps( planes[index].x );
+		planesY[index]		= _mm_set1_ps( planes[index].y );
+		planesZ[index]		= _mm_set1_ps( planes[index].z );
+		planesW[index]		= _mm_set1_ps( planes[index].w );
+		absPlanesX[index]	= _mm_andnot_ps( signMask, planesX[index] );
+		absPlanesY[index]	= _mm_andnot_ps( signMask, planesY[index] );
+		absPlanesZ[index]	= _mm_andnot_ps( signMask, planesZ[index] );
+	}
+
+	const __m128	zero = _mm_setzero_ps();
+	for ( uint32 boxIndex = 0; boxIndex < numBoxes; boxIndex += PACKEDBOUNDS_GROUP_SIZE )
+	{
+		const __m128	centerX = _mm_loadu_ps( centersX + boxIndex );
+		const __m128	centerY = _mm_loadu_ps( centersY + boxIndex );
+		const __m128	centerZ = _mm_loadu_ps( centersZ + boxIndex );
+		const __m128	extentX = _mm_loadu_ps( extentsX + boxIndex );
+		const __m128	extentY = _mm_loadu_ps( extentsY + boxIndex );
+		const __m128	extentZ = _mm_loadu_ps( extentsZ + boxIndex );
+
+		int32			visibleBits = 0xF;
+		for ( uint32 index = 0; index < 6 && visibleBits; ++index )
+		{
+			__m128		distance	= _mm_add_ps( _mm_add_ps( _mm_mul_ps( centerX, planesX[index] ), _mm_mul_ps( centerY, planesY[index] ) ),
+												  _mm_add_ps( _mm_mul_ps( centerZ, planesZ[index] ), planesW[index] ) );
+			__m128		pushOut		= _mm_add_ps( _mm_add_ps( _mm_mul_ps( extentX, absPlanesX[index] ), _mm_mul_ps( extentY, absPlanesY[index] ) ),
+												  _mm_mul_ps( extentZ, absPlanesZ[index] ) );
+			visibleBits &= _mm_movemask_ps( _mm_cmpgt_ps( _mm_add_ps( distance, pushOut ), zero ) );
+		}
+
+		OutVisibilityMask[boxIndex / 32] |= ( uint32 )visibleBits << ( boxIndex % 32 );
+	}
+
+	// Clear bits of padding boxes in the last word
+	if ( numBoxes % 32 != 0 )
+	{
+		OutVisibilityMask[numWords - 1] &= ( 1u << ( numBoxes % 32 ) ) - 1;
+	}
+#else
+	for ( uint32 boxIndex = 0; boxIndex < numBoxes; ++boxIndex )
+	{
+		bool	bVisible = true;
+		for ( uint32 index = 0; index < 6 && bVisible; ++index )
+		{
+			float	distance	= planes[index].x * centersX[boxIndex] + planes[index].y * centersY[boxIndex] + planes[index].z * centersZ[boxIndex] + planes[index].w;
+			float	pushOut		= Math::Abs( planes[index].x ) * extentsX[boxIndex] + Math::Abs( planes[index].y ) * extentsY[boxIndex] + Math::Abs( planes[index].z ) * extentsZ[boxIndex];
+			bVisible = distance + pushOut > 0.f;
+		}
+
+		if ( bVisible )
+		{
+			OutVisibilityMask[boxIndex / 32] |= 1u << ( boxIndex % 32 );
+		}
+	}
+#endif // PLATFORM_SUPPORTS_SSE
+}
@@ -36,7 +36,7 @@ public:
 	 * @param InSceneView				Scene view
 	 */
 	template<class TShaderClass>
-	static void DrawPointLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const std::list<CPointLightComponent*>* InLights, const class CSceneView& InSceneView )
+	static void DrawPointLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const PointLightList_t* InLights, const class CSceneView& InSceneView )
 	{
 		// If vertex factory not support instancig - draw without it
 		if ( !InVertexFactory->SupportsInstancing() )
@@ -71,7 +71,7 @@ public:
 	 * @param InSceneView				Scene view
 	 */
 	template<class TShaderClass>
-	static void DrawSpotLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const std::list<CSpotLightComponent*>* InLights, const class CSceneView& InSceneView )
+	static void DrawSpotLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const SpotLightList_t* InLights, const class CSceneView& InSceneView )
 	{
 		// If vertex factory not support instancig - draw without it
 		if ( !InVertexFactory->SupportsInstancing() )
@@ -106,7 +106,7 @@ public:
 	 * @param InSceneView				Scene view
 	 */
 	template<class TShaderClass>
-	static void DrawDirectionalLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const std::list<CDirectionalLightComponent*>* InLights, const class CSceneView& InSceneView )
+	static void DrawDirectionalLights( class CBaseDeviceContextRHI* InDeviceContextRHI, CVertexFactory* InVertexFactory, TShaderClass* InLightingVertexShader, const DirectionalLightList_t* InLights, const class CSceneView& InSceneView )
 	{
 		// If vertex factory not support instancig - draw without it
 		if ( !InVertexFactory->SupportsInstancing() )
@@ -305,7 +305,7 @@ public:
 	 * @param InLights			List of point lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<CPointLightComponent*>* InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const PointLightList_t* InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( GLightSphereMesh.GetVertexFactory(), InDepthBias );
 
@@ -330,7 +330,7 @@ public:
 private:
 	TLightingVertexShader<LT_Point>*				lightingVertexShader;		/**< Point light vertex shader */
 	TLightingPixelShader<LT_Point>*					lightingPixelShader;		/**< Point light pixel shader */
-	const std::list<CPointLightComponent*>*			pointLightComponents;		/**< List of point light components */
+	const PointLightList_t*							pointLightComponents;		/**< List of point light components */
 };
 
 /**
@@ -347,7 +347,7 @@ public:
 	 * @param InLights			List of spot lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<CSpotLightComponent*>* InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const SpotLightList_t* InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( GLightConeMesh.GetVertexFactory(), InDepthBias );
 
@@ -372,7 +372,7 @@ public:
 private:
 	TLightingVertexShader<LT_Spot>*				lightingVertexShader;		/**< Spot light vertex shader */
 	TLightingPixelShader<LT_Spot>*				lightingPixelShader;		/**< Spot light pixel shader */
-	const std::list<CSpotLightComponent*>*		spotLightComponents;		/**< List of spot light components */
+	const SpotLightList_t*						spotLightComponents;		/**< List of spot light components */
 };
 
 /**
@@ -389,7 +389,7 @@ public:
 	 * @param InLights			List of directional lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<CDirectionalLightComponent*>* InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const DirectionalLightList_t* InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( GLightQuadMesh.GetVertexFactory(), InDepthBias );
 
@@ -442,7 +442,7 @@ public:
 private:
 	TLightingVertexShader<LT_Directional>*				lightingVertexShader;			/**< Directional light vertex shader */
 	TLightingPixelShader<LT_Directional>*				lightingPixelShader;			/**< Directional light pixel shader */
-	const std::list<CDirectionalLightComponent*>*		directionalLightComponents;		/**< List of directional light components */
+	const DirectionalLightList_t*						directionalLightComponents;		/**< List of directional light components */
 };
 
 /**
@@ -469,7 +469,7 @@ public:
 	 * @param InLights			List of point lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<CPointLightComponent*>* InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const PointLightList_t* InLights, float InDepthBias = 0.f )
 	{
 		CBaseStencilLightingDrawingPolicy::Init( GLightSphereMesh.GetVertexFactory(), InDepthBias );
 
@@ -493,7 +493,7 @@ public:
 
 private:
 	TDepthOnlyLightingVertexShader<LT_Point>*		lightingVertexShader;		/**< Depth only point light vertex shader */
-	const std::list<CPointLightComponent*>*			pointLightComponents;		/**< List of point light components */
+	const PointLightList_t*							pointLightComponents;		/**< List of point light components */
 };
 
 /**
@@ -510,7 +510,7 @@ public:
 	 * @param InLights			List of spot lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<CSpotLightComponent*>* InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const SpotLightList_t* InLights, float InDepthBias = 0.f )
 	{
 		CBaseStencilLightingDrawingPolicy::Init( GLightConeMesh.GetVertexFactory(), InDepthBias );
 
@@ -534,7 +534,7 @@ public:
 
 private:
 	TDepthOnlyLightingVertexShader<LT_Spot>*	lightingVertexShader;		/**< Depth only spot light vertex shader */
-	const std::list<CSpotLightComponent*>*		spotLightComponents;		/**< List of spot light components */
+	const SpotLightList_t*						spotLightComponents;		/**< List of spot light components */
 };
 
 
@@ -559,16 +559,16 @@ void CSceneRenderer::RenderLights( class CBaseDeviceContextRHI* InDeviceContext
 	g_SceneRenderTargets.BeginRenderingSceneColorHDR( InDeviceContext );
 	InDeviceContext->ClearSurface( g_SceneRenderTargets.GetSceneColorHDRSurface(), sceneView->GetBackgroundColor() );
 
-	std::list<CPointLightComponent*>			pointLightComponents;
-	std::list<CSpotLightComponent*>			spotLightComponents;
-	std::list<CDirectionalLightComponent*>		directionalLightComponents;
+	PointLightList_t			pointLightComponents;
+	SpotLightList_t				spotLightComponents;
+	DirectionalLightList_t		directionalLightComponents;
 
 	// Separating light components by type
 	{
-		const std::list<CLightComponent*>&				lightComponents = scene->GetVisibleLights();
-		for ( auto it = lightComponents.begin(), itEnd = lightComponents.end(); it != itEnd; ++it )
+		CLightComponent* const*		lightComponents = scene->GetVisibleLights();
+		for ( uint32 index = 0, count = scene->GetNumVisibleLights(); index < count; ++index )
 		{
-			CLightComponent*		lightComponent = *it;
+			CLightComponent*		lightComponent = lightComponents[index];
 			switch ( lightComponent->GetLightType() )
 			{
 			case LT_Point:			pointLightComponents.push_back( ( CPointLightComponent* )lightComponent );		break;
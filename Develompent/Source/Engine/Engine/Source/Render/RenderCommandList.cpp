@@ -0,0 +1,265 @@
+#include <vector>
+#include <algorithm>
+
+#include "Misc/Template.h"
+#include "System/Memory.h"
+#include "Render/RenderCommandList.h"
+#include "Render/RenderingThread.h"
+#include "System/ThreadPool.h"
+
+//
+// Definitions
+//
+
+/* Default size of one chunk of a render command list, in bytes */
+#define RENDER_COMMAND_LIST_CHUNK_SIZE		( 64 * 1024 )
+
+/* Alignment of each command in a render command list, in bytes */
+#define RENDER_COMMAND_LIST_ALIGNMENT		16
+
+//
+// Globals
+//
+
+/* Command lists of worker threads, the index is the index of the worker in the thread pool. The last one is the list of the game thread */
+static std::vector<CRenderCommandList*>		s_WorkerRenderCommandLists;
+
+/* Not zero if worker threads are allowed to record into their command lists */
+static volatile int32						s_bAllowRecording = 0;
+
+/* Number of recordings in progress, each of them is started by GetRenderCommandListForCurrentThread */
+static volatile int32						s_NumActiveRecordings = 0;
+
+/*
+==================
+CRenderCommandList::CAllocationContext::CAllocationContext
+==================
+*/
+CRenderCommandList::CAllocationContext::CAllocationContext( CRenderCommandList& InCommandList, uint32 InAllocationSize )
+	: commandList( InCommandList )
+{
+	commandList.mutex.Lock();
+
+	// Allocate a new chunk if there isn't enough space in the last one
+	const uint32	alignedAllocationSize = Align( InAllocationSize, RENDER_COMMAND_LIST_ALIGNMENT );
+	if ( commandList.chunks.empty() || commandList.chunks.back().size - commandList.chunks.back().usedSize < alignedAllocationSize )
+	{
+		Chunk		chunk;
+		chunk.size		= Max<uint32>( RENDER_COMMAND_LIST_CHUNK_SIZE, alignedAllocationSize );
+		chunk.data		= ( byte* )Memory::Malloc( chunk.size, RENDER_COMMAND_LIST_ALIGNMENT );
+		chunk.usedSize	= 0;
+		commandList.chunks.push_back( chunk );
+	}
+
+	Chunk&		chunk = commandList.chunks.back();
+	allocation = chunk.data + chunk.usedSize;
+	chunk.usedSize += alignedAllocationSize;
+
+	// The command is ordered by the work item which records it, not by the thread
+	commandList.commands.push_back( Command{ CThreadPool::GetCurrentWorkItemKey(), ( CRenderCommand* )allocation } );
+}
+
+/*
+==================
+CRenderCommandList::CAllocationContext::~CAllocationContext
+==================
+*/
+CRenderCommandList::CAllocationContext::~CAllocationContext()
+{
+	commandList.mutex.Unlock();
+
+	// The recording is finished, the list can be destroyed from now on
+	Sys_InterlockedDecrement( &s_NumActiveRecordings );
+}
+
+/*
+==================
+CRenderCommandList::CRenderCommandList
+==================
+*/
+CRenderCommandList::CRenderCommandList()
+{}
+
+/*
+==================
+CRenderCommandList::~CRenderCommandList
+==================
+*/
+CRenderCommandList::~CRenderCommandList()
+{
+	Flush( false );
+}
+
+/*
+==================
+CRenderCommandList::Execute
+==================
+*/
+void CRenderCommandList::Execute()
+{
+	Assert( IsInRenderingThread() );
+	Flush( true );
+}
+
+/*
+==================
+CRenderCommandList::MoveTo
+==================
+*/
+void CRenderCommandList::MoveTo( CRenderCommandList& InOutDestList )
+{
+	CScopeLock		scopeLock( &mutex );
+	CScopeLock		destScopeLock( &InOutDestList.mutex );
+	InOutDestList.chunks.insert( InOutDestList.chunks.end(), chunks.begin(), chunks.end() );
+	InOutDestList.commands.insert( InOutDestList.commands.end(), commands.begin(), commands.end() );
+	chunks.clear();
+	commands.clear();
+}
+
+/*
+==================
+CRenderCommandList::SortByWorkItems
+==================
+*/
+void CRenderCommandList::SortByWorkItems()
+{
+	// Stable sort keeps the order of commands of one work item, they are recorded by one thread
+	CScopeLock		scopeLock( &mutex );
+	std::stable_sort( commands.begin(), commands.end(), []( const Command& InA, const Command& InB )
+					  {
+						  return InA.workItemKey < InB.workItemKey;
+					  } );
+}
+
+/*
+==================
+CRenderCommandList::Flush
+==================
+*/
+void CRenderCommandList::Flush( bool InIsExecute )
+{
+	CScopeLock		scopeLock( &mutex );
+	for ( uint32 index = 0, count = commands.size(); index < count; ++index )
+	{
+		CRenderCommand*		command = commands[index].command;
+		if ( InIsExecute )
+		{
+			command->Execute();
+		}
+		command->~CRenderCommand();
+	}
+
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		Memory::Free( chunks[index].data );
+	}
+	chunks.clear();
+	commands.clear();
+}
+
+/*
+==================
+GetRenderCommandListForCurrentThread
+==================
+*/
+CRenderCommandList* GetRenderCommandListForCurrentThread()
+{
+	// The game thread records commands only while it processes a work item of ParallelFor, so they are ordered with
+	// commands of the other items. Otherwise its commands go directly into the render command buffer
+	const bool		bIsGameThread = IsInGameThread();
+	if ( bIsGameThread && !CThreadPool::GetCurrentWorkItemKey() )
+	{
+		return nullptr;
+	}
+
+	// Register the recording before checking whether it's allowed, so StopRecordingRenderCommandLists either sees it or we see the stop
+	Sys_InterlockedIncrement( &s_NumActiveRecordings );
+	const uint32	listIndex = bIsGameThread ? s_WorkerRenderCommandLists.size() - 1 : CThreadPool::Get().GetCurrentWorkerIndex();
+	if ( s_bAllowRecording && listIndex < s_WorkerRenderCommandLists.size() )
+	{
+		return s_WorkerRenderCommandLists[listIndex];
+	}
+
+	Sys_InterlockedDecrement( &s_NumActiveRecordings );
+	return nullptr;
+}
+
+/*
+==================
+InitRenderCommandLists
+==================
+*/
+void InitRenderCommandLists()
+{
+	Assert( IsInGameThread() && s_WorkerRenderCommandLists.empty() );
+	s_WorkerRenderCommandLists.resize( CThreadPool::Get().GetNumThreads() + 1 );
+	for ( uint32 index = 0, count = s_WorkerRenderCommandLists.size(); index < count; ++index )
+	{
+		s_WorkerRenderCommandLists[index] = new CRenderCommandList();
+	}
+	Sys_InterlockedExchange( &s_bAllowRecording, 1 );
+}
+
+/*
+==================
+StopRecordingRenderCommandLists
+==================
+*/
+void StopRecordingRenderCommandLists()
+{
+	Assert( IsInGameThread() );
+	Sys_InterlockedExchange( &s_bAllowRecording, 0 );
+
+	// Wait for worker threads which are recording a command right now
+	while ( s_NumActiveRecordings > 0 )
+	{
+		Sys_Sleep( 0.f );
+	}
+}
+
+/*
+==================
+DestroyRenderCommandLists
+==================
+*/
+void DestroyRenderCommandLists()
+{
+	Assert( IsInGameThread() && !s_bAllowRecording && !s_NumActiveRecordings );
+	for ( uint32 index = 0, count = s_WorkerRenderCommandLists.size(); index < count; ++index )
+	{
+		delete s_WorkerRenderCommandLists[index];
+	}
+	s_WorkerRenderCommandLists.clear();
+}
+
+/*
+==================
+SubmitRenderCommandLists
+==================
+*/
+void SubmitRenderCommandLists()
+{
+	Assert( IsInGameThread() );
+
+	// Gather commands of all workers in one list, so they are executed by one render command. Commands are sorted
+	// by keys of work items which recorded them, so the order doesn't depend on which worker took which work item
+	CRenderCommandList		gatheredList;
+	for ( uint32 index = 0, count = s_WorkerRenderCommandLists.size(); index < count; ++index )
+	{
+		s_WorkerRenderCommandLists[index]->MoveTo( gatheredList );
+	}
+
+	if ( gatheredList.IsEmpty() )
+	{
+		return;
+	}
+	gatheredList.SortByWorkItems();
+
+	CRenderCommandList*		submitList = new CRenderCommandList();
+	gatheredList.MoveTo( *submitList );
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CExecuteRenderCommandListCommand, CRenderCommandList*, commandList, submitList,
+										{
+											commandList->Execute();
+											delete commandList;
+										} );
+}
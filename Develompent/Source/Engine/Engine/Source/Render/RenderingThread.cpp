@@ -4,6 +4,7 @@
 #include "Logger/LoggerMacros.h"
 #include "Render/RenderingThread.h"
 #include "System/TickableObject.h"
+#include "System/Profiler.h"
 
 //
 // Definitions
@@ -12,6 +13,9 @@
 /* The size of the rendering command buffer, in bytes */
 #define RENDERING_COMMAND_BUFFER_SIZE			( 1024 * 1024 )
 
+/* Max time in milliseconds which the rendering thread sleeps waiting for commands, rendering tickables are ticked at least so often */
+#define RENDERING_THREAD_IDLE_WAIT_TIME			16
+
 //
 // Globals
 //
@@ -106,6 +110,94 @@ const char* CSkipRenderCommand::DescribeCommandChar() const
 	return "CSkipRenderCommand";
 }
 
+/*
+==================
+CRenderFence::CRenderFence
+==================
+*/
+CRenderFence::CRenderFence()
+	: numPendingFences( 0 )
+	, completedEvent( nullptr )
+{}
+
+/*
+==================
+CRenderFence::CRenderFence
+==================
+*/
+CRenderFence::CRenderFence( const CRenderFence& InOther )
+	: numPendingFences( 0 )
+	, completedEvent( nullptr )
+{}
+
+/*
+==================
+CRenderFence::~CRenderFence
+==================
+*/
+CRenderFence::~CRenderFence()
+{
+	if ( !IsFenceComplete() )
+	{
+		Wait();
+	}
+	delete completedEvent;
+}
+
+/*
+==================
+CRenderFence::BeginFence
+==================
+*/
+void CRenderFence::BeginFence()
+{
+	Assert( IsInGameThread() );
+	if ( !g_IsThreadedRendering )
+	{
+		return;
+	}
+
+	// Commands recorded by worker threads must be passed by the fence too
+	SubmitRenderCommandLists();
+
+	// Each fence has its own event, so passing of other fences doesn't wake up waiters of this one.
+	// The event is reset before the command is enqueued, so the last pending command always triggers it after that
+	if ( !completedEvent )
+	{
+		completedEvent = new CEvent( true, nullptr );
+	}
+	completedEvent->Reset();
+
+	// The fence is triggered before it's decremented, because a waiter may destroy the fence once it's complete
+	Sys_InterlockedIncrement( &numPendingFences );
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CRenderFenceCommand,
+										CRenderFence*, renderFence, this,
+										{
+											renderFence->completedEvent->Trigger();
+											Sys_InterlockedDecrement( &renderFence->numPendingFences );
+										} );
+}
+
+/*
+==================
+CRenderFence::Wait
+==================
+*/
+void CRenderFence::Wait() const
+{
+	Assert( !IsInRenderingThread() );
+	if ( IsFenceComplete() )
+	{
+		return;
+	}
+
+	SCOPED_PROFILER( TEXT( "Render" ), TEXT( "WaitForRenderFence" ) );
+	while ( !IsFenceComplete() )
+	{
+		completedEvent->Wait();
+	}
+}
+
 
 /*
 ==================
@@ -150,6 +242,12 @@ uint32 CRenderingThread::Run()
 
 		// Tick tickable objects
 		TickRenderingTickables();
+
+		// Sleep till the game thread enqueues new commands instead of spinning
+		if ( g_IsThreadedRendering )
+		{
+			g_RenderCommandBuffer.WaitForRead( RENDERING_THREAD_IDLE_WAIT_TIME );
+		}
 	}
 
 	return 0;
@@ -203,6 +301,9 @@ void StartRenderingThread()
 
 		// Create a synchronize mechanism for FlushRenderingCommands()
 		g_RenderFrameFinished = new CEvent( false, TEXT( "RenderFrameFinished" ) );
+
+		// Create command lists for worker threads of the thread pool
+		InitRenderCommandLists();
 	}
 }
 
@@ -227,8 +328,15 @@ void StopRenderingThread()
 			// Rendering thread must be valid
 			Assert( s_RenderingThread );
 
-			// Turn off the threaded rendering flag
+			// Stop recording render commands on worker threads and wait until they release their lists,
+			// after that the lists can be safely submitted and destroyed
+			StopRecordingRenderCommandLists();
+			SubmitRenderCommandLists();
+			DestroyRenderCommandLists();
+
+			// Turn off the threaded rendering flag and wake up the rendering thread if it waits for commands
 			g_IsThreadedRendering = false;
+			g_RenderCommandBuffer.WakeUpReader();
 
 			//Reset the rendering thread id
 			g_RenderingThreadId = 0;
@@ -236,6 +344,10 @@ void StopRenderingThread()
 			// Wait for the rendering thread to return
 			s_RenderingThread->WaitForCompletion();
 
+			const CRingBuffer::Stats&	stats = g_RenderCommandBuffer.GetStats();
+			Logf( TEXT( "Render command buffer: %i enqueue stalls (%f ms), rendering thread idle %f ms\n" ), stats.numWriteStalls, stats.writeStallTime, stats.readIdleTime );
+			g_RenderCommandBuffer.ResetStats();
+
 			// Destroy the rendering thread objects
 			delete g_RenderFrameFinished;
 			s_RenderingThread			= nullptr;
@@ -1,7 +1,17 @@
+#include <algorithm>
+
 #include "Math/Math.h"
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
 #include "System/ConVar.h"
+#include "System/ThreadPool.h"
+#include "System/Profiler.h"
+
+/* Number of primitives which one task adds to draw lists while building a view */
+#define BUILD_VIEW_PRIMITIVES_BATCH_SIZE		512
+
+/* Statistics of drawing mesh draw lists of the current view */
+MeshDrawListStats		g_MeshDrawListStats;
 
 #if WITH_EDITOR
 /**
@@ -151,8 +161,16 @@ void CScene::AddPrimitive( class CPrimitiveComponent* InPrimitive )
 	}
 
 	InPrimitive->scene = this;
-	InPrimitive->LinkDrawList();
 	primitives.push_back( InPrimitive );
+
+	// Draw lists are used by the rendering thread, so the primitive is linked to them there
+	UNIQUE_RENDER_COMMAND_TWOPARAMETER( CAddPrimitiveCommand,
+										CScene*, scene, this,
+										CPrimitiveComponent*, primitiveComponent, InPrimitive,
+										{
+											scene->AddPrimitive_RenderThread( primitiveComponent );
+										} );
+	UpdatePrimitiveBounds( InPrimitive );
 }
 
 /*
@@ -166,9 +184,16 @@ void CScene::RemovePrimitive( class CPrimitiveComponent* InPrimitive )
 	{
 		if ( *it == InPrimitive )
 		{
-			InPrimitive->UnlinkDrawList();
 			InPrimitive->scene = nullptr;
 			primitives.erase( it );
+
+			// The command is enqueued before the fence which the primitive begins in BeginDestroy, so the primitive is alive until it's executed
+			UNIQUE_RENDER_COMMAND_TWOPARAMETER( CRemovePrimitiveCommand,
+												CScene*, scene, this,
+												CPrimitiveComponent*, primitiveComponent, InPrimitive,
+												{
+													scene->RemovePrimitive_RenderThread( primitiveComponent );
+												} );
 			return;
 		}
 	}
@@ -196,6 +221,7 @@ void CScene::AddLight( class CLightComponent* InLight )
 
 	InLight->scene = this;
 	lights.push_back( InLight );
+	UpdateLight( InLight );
 }
 
 /*
@@ -211,11 +237,126 @@ void CScene::RemoveLight( class CLightComponent* InLight )
 		{
 			InLight->scene = nullptr;
 			lights.erase( it );
+
+			UNIQUE_RENDER_COMMAND_TWOPARAMETER( CRemoveLightCommand,
+												CScene*, scene, this,
+												CLightComponent*, lightComponent, InLight,
+												{
+													scene->lightOctree.RemoveElement( lightComponent );
+												} );
 			return;
 		}
 	}
 }
 
+/*
+==================
+CScene::UpdatePrimitiveBounds
+==================
+*/
+void CScene::UpdatePrimitiveBounds( class CPrimitiveComponent* InPrimitive )
+{
+	Assert( InPrimitive && InPrimitive->scene == this );
+
+	// The transform is taken here, so it isn't updated lazily by the rendering thread while the game thread changes it
+	UNIQUE_RENDER_COMMAND_THREEPARAMETER( CUpdatePrimitiveBoundsCommand,
+										  CScene*, scene, this,
+										  CPrimitiveComponent*, primitiveComponent, InPrimitive,
+										  CTransform, transform, InPrimitive->GetComponentTransform(),
+										  {
+											  scene->UpdatePrimitiveBounds_RenderThread( primitiveComponent, transform );
+										  } );
+}
+
+/*
+==================
+CScene::UpdateLight
+==================
+*/
+void CScene::UpdateLight( class CLightComponent* InLight )
+{
+	Assert( InLight && InLight->scene == this );
+
+	// Parameters are taken here, so the rendering thread doesn't read them while the game thread changes them
+	LightRenderParameters		parameters;
+	InLight->GetRenderParameters( parameters );
+	UNIQUE_RENDER_COMMAND_FOURPARAMETER( CUpdateLightCommand,
+										 CScene*, scene, this,
+										 CLightComponent*, lightComponent, InLight,
+										 CBox, boundBox, InLight->GetBoundBox(),
+										 LightRenderParameters, renderParameters, parameters,
+										 {
+											 lightComponent->renderParameters = renderParameters;
+											 scene->lightOctree.UpdateElement( lightComponent, boundBox );
+										 } );
+}
+
+/*
+==================
+CScene::AddPrimitive_RenderThread
+==================
+*/
+void CScene::AddPrimitive_RenderThread( class CPrimitiveComponent* InPrimitive )
+{
+	InPrimitive->renderScene = this;
+	InPrimitive->LinkDrawList();
+}
+
+/*
+==================
+CScene::RemovePrimitive_RenderThread
+==================
+*/
+void CScene::RemovePrimitive_RenderThread( class CPrimitiveComponent* InPrimitive )
+{
+	InPrimitive->UnlinkDrawList();
+	InPrimitive->renderScene = nullptr;
+	primitiveOctree.RemoveElement( InPrimitive );
+	if ( InPrimitive->bIsDirtyBounds )
+	{
+		InPrimitive->bIsDirtyBounds = false;
+		dirtyPrimitives.erase( std::find( dirtyPrimitives.begin(), dirtyPrimitives.end(), InPrimitive ) );
+	}
+}
+
+/*
+==================
+CScene::UpdatePrimitiveBounds_RenderThread
+==================
+*/
+void CScene::UpdatePrimitiveBounds_RenderThread( class CPrimitiveComponent* InPrimitive, const CTransform& InTransform )
+{
+	// Commands from worker threads may be submitted after the primitive has been removed
+	if ( InPrimitive->renderScene != this )
+	{
+		return;
+	}
+
+	InPrimitive->renderTransform = InTransform;
+	if ( !InPrimitive->bIsDirtyBounds )
+	{
+		InPrimitive->bIsDirtyBounds = true;
+		dirtyPrimitives.push_back( InPrimitive );
+	}
+}
+
+/*
+==================
+CScene::UpdateDirtyBounds
+==================
+*/
+void CScene::UpdateDirtyBounds()
+{
+	for ( uint32 index = 0, count = dirtyPrimitives.size(); index < count; ++index )
+	{
+		CPrimitiveComponent*		primitiveComponent = dirtyPrimitives[index];
+		primitiveComponent->bIsDirtyBounds = false;
+		primitiveComponent->UpdateBounds();
+		primitiveOctree.UpdateElement( primitiveComponent, primitiveComponent->GetBoundBox() );
+	}
+	dirtyPrimitives.clear();
+}
+
 /*
 ==================
 CScene::Clear
@@ -223,21 +364,27 @@ CScene::Clear
 */
 void CScene::Clear()
 {
+	// Draw lists and the spatial index are owned by the rendering thread, so we wait until it's idle and clear them here
+	FlushRenderingCommands();
 	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
 	{
 		CPrimitiveComponent*		primitiveComponent = *it;
 		primitiveComponent->UnlinkDrawList();
 		primitiveComponent->scene = nullptr;
+		primitiveComponent->renderScene = nullptr;
+		primitiveComponent->bIsDirtyBounds = false;
 	}
 
 	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
 	{
-		CLightComponent*		lightComponent = *it;
-		lightComponent->scene = nullptr;
+		( *it )->scene = nullptr;
 	}
 
 	primitives.clear();
 	lights.clear();
+	primitiveOctree.Clear();
+	lightOctree.Clear();
+	dirtyPrimitives.clear();
 	exposure = g_Engine ? g_Engine->GetExposure() : 1.f;
 }
 
@@ -248,21 +395,53 @@ CScene::BuildView
 */
 void CScene::BuildView( const CSceneView& InSceneView )
 {
-	// We do nothing if r.freeze_rendering is true
+	SCOPED_PROFILER( TEXT( "Render" ), TEXT( "BuildView" ) );
+	CLinearAllocator&	frameAllocator = CFrameAllocator::Get().GetRenderingThreadAllocator();
+
+	// We do nothing if r.freeze_rendering is true, only move the frozen frame into memory of the current frame
 #if WITH_EDITOR
 	if ( CVarRFreezeRendering.GetBool() )
 	{
+		for ( uint32 index = 0; index < SDG_Max; ++index )
+		{
+			frame.SDGs[ index ].RelocateInstances( frameAllocator );
+		}
+
+		if ( frame.visibleLights )
+		{
+			CLightComponent**	visibleLights = frameAllocator.AllocateArray<CLightComponent*>( frame.numVisibleLights );
+			Memory::Memcpy( visibleLights, frame.visibleLights, frame.numVisibleLights * sizeof( CLightComponent* ) );
+			frame.visibleLights = visibleLights;
+		}
 		return;
 	}
 #endif // WITH_EDITOR
 
-	// Add to SDGs visible primitives
-	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
+	// Update spatial index by primitives which were added or moved since the last view
+	UpdateDirtyBounds();
+
+	// Prepare visible primitives. Links to draw lists are updated here, because draw lists aren't thread safe.
+	// Primitives which have instances to draw are moved to the beginning of the array
+	tempPrimitives.clear();
+	primitiveOctree.FindVisibleElements( InSceneView.GetFrustum(), tempPrimitives );
+	uint32		numDrawPrimitives = 0;
+	for ( uint32 index = 0, count = tempPrimitives.size(); index < count; ++index )
 	{
-		CPrimitiveComponent*		primitiveComponent = *it;
-		if ( primitiveComponent->IsVisibility() && InSceneView.GetFrustum().IsIn( primitiveComponent->GetBoundBox() ) )
+		CPrimitiveComponent*		primitiveComponent = tempPrimitives[index];
+
+		// Primitives without bounds always pass frustum culling, so we try to update them for the next view (e.g. asset isn't loaded yet)
+		if ( !primitiveComponent->GetBoundBox().IsValid() && !primitiveComponent->bIsDirtyBounds )
 		{
-			primitiveComponent->AddToDrawList( InSceneView );
+			primitiveComponent->bIsDirtyBounds = true;
+			dirtyPrimitives.push_back( primitiveComponent );
+		}
+
+		if ( primitiveComponent->IsVisibility() )
+		{
+			if ( primitiveComponent->PrepareDrawList( InSceneView ) )
+			{
+				tempPrimitives[numDrawPrimitives++] = primitiveComponent;
+			}
 
 #if WITH_EDITOR
 			if ( g_IsEditor )
@@ -273,13 +452,50 @@ void CScene::BuildView( const CSceneView& InSceneView )
 		}
 	}
 
+	// Gather instances of primitives on worker threads. Each batch of primitives has own buffer,
+	// so instances are merged in the same order regardless of which thread has processed the batch
+	const uint32	numBatches = ( numDrawPrimitives + BUILD_VIEW_PRIMITIVES_BATCH_SIZE - 1 ) / BUILD_VIEW_PRIMITIVES_BATCH_SIZE;
+	if ( tempInstanceBuffers.size() < numBatches )
+	{
+		tempInstanceBuffers.resize( numBatches );
+	}
+
+	CThreadPool::Get().ParallelFor( numBatches, [&]( uint32 InBatchIndex )
+									{
+										CMeshInstanceBuffer&	instanceBuffer = tempInstanceBuffers[InBatchIndex];
+										instanceBuffer.Clear();
+										for ( uint32 index = InBatchIndex * BUILD_VIEW_PRIMITIVES_BATCH_SIZE, endIndex = Min( index + BUILD_VIEW_PRIMITIVES_BATCH_SIZE, numDrawPrimitives ); index < endIndex; ++index )
+										{
+											tempPrimitives[index]->AddToDrawList( InSceneView, instanceBuffer );
+										}
+									} );
+
+	// Merge instances into mesh batches. Mesh batches of different SDGs don't overlap, so SDGs are merged in parallel.
+	// Instances are counted first, so each mesh batch gets one array from the frame allocator
+	CThreadPool::Get().ParallelFor( SDG_Max, [&]( uint32 InSDGIndex )
+									{
+										for ( uint32 batchIndex = 0; batchIndex < numBatches; ++batchIndex )
+										{
+											tempInstanceBuffers[batchIndex].CountInstances( ( ESceneDepthGroup )InSDGIndex );
+										}
+
+										for ( uint32 batchIndex = 0; batchIndex < numBatches; ++batchIndex )
+										{
+											tempInstanceBuffers[batchIndex].MergeInstances( ( ESceneDepthGroup )InSDGIndex, frameAllocator );
+										}
+									} );
+
 	// Add to scene frame visible lights
-	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
+	tempLights.clear();
+	lightOctree.FindVisibleElements( InSceneView.GetFrustum(), tempLights );
+	frame.visibleLights		= frameAllocator.AllocateArray<CLightComponent*>( tempLights.size() );
+	frame.numVisibleLights	= 0;
+	for ( uint32 index = 0, count = tempLights.size(); index < count; ++index )
 	{
-		CLightComponent*		lightComponent = *it;
-		if ( lightComponent->IsEnabled() )
+		CLightComponent*		lightComponent = tempLights[index];
+		if ( lightComponent->IsEnabled_RenderThread() )
 		{
-			frame.visibleLights.push_back( lightComponent );
+			frame.visibleLights[frame.numVisibleLights++] = lightComponent;
 
 #if WITH_EDITOR
 			if ( g_IsEditor )
@@ -312,7 +528,8 @@ void CScene::ClearView()
 		frame.SDGs[ index ].Clear();
 	}
 
-	frame.visibleLights.clear();
+	frame.visibleLights		= nullptr;
+	frame.numVisibleLights	= 0;
 }
 
 /*
@@ -17,6 +17,14 @@
 #include "Render/Texture.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
 #include "Render/SceneRenderTargets.h"
+#include "System/ConVar.h"
+#include "Logger/LoggerMacros.h"
+
+/**
+ * @ingroup Engine
+ * @brief Cvar enable/disable printing statistics of mesh draw lists
+ */
+CConVar		CVarRDrawListStats( TEXT( "r_drawliststats" ), TEXT( "0" ), TEXT( "Print statistics of mesh draw lists for every rendered view" ) );
 
 /*
 ==================
@@ -46,6 +54,8 @@ void CSceneRenderer::BeginRenderViewTarget( ViewportRHIParamRef_t InViewportRHI
 	immediateContext->ClearSurface( g_SceneRenderTargets.GetSceneColorLDRSurface(), sceneView->GetBackgroundColor() );
 
 	// Build visible view on scene
+	g_MeshDrawListStats				= MeshDrawListStats();
+	g_MeshDrawListStats.bEnabled	= CVarRDrawListStats.GetBool();
 	if ( scene )
 	{
 		scene->BuildView( *sceneView );
@@ -75,7 +85,7 @@ void CSceneRenderer::Render( ViewportRHIParamRef_t InViewportRHI )
 	bDirty |= RenderBasePass( immediateContext );
 	
 	// Render lights
-	bool		bVisibleLights = !scene->GetVisibleLights().empty();
+	bool		bVisibleLights = scene->GetNumVisibleLights() > 0;
 	if ( bDirty && bVisibleLights && showFlags & SHOW_Lights
 #if WITH_EDITOR
 		 && !( showFlags & SHOW_Wireframe )
@@ -322,6 +332,11 @@ void CSceneRenderer::FinishRenderViewTarget( ViewportRHIParamRef_t InViewportRHI
 		scene->ClearView();
 	}
 
+	if ( g_MeshDrawListStats.bEnabled )
+	{
+		Logf( TEXT( "Mesh draw lists: %i drawing policies, %i state changes, %i state changes avoided by sorting\n" ), g_MeshDrawListStats.numDrawingPolicies, g_MeshDrawListStats.numStateChanges, g_MeshDrawListStats.numAvoidedStateChanges );
+	}
+
 	CBaseDeviceContextRHI*					immediateContext	= g_RHI->GetImmediateContext();
 	Texture2DRHIRef_t						sceneColorTexture	= g_SceneRenderTargets.GetSceneColorLDRTexture();
 	const uint32							sceneColorSizeX		= sceneColorTexture->GetSizeX();
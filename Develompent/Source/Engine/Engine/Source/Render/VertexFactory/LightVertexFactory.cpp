@@ -174,7 +174,7 @@ void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDevic
 CLightVertexShaderParameters::SetMesh
 ==================
 */
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CPointLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const PointLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	if ( !bSupportsInstancing )
 	{
@@ -192,7 +192,7 @@ void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDevic
 CLightVertexShaderParameters::SetMesh
 ==================
 */
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CSpotLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const SpotLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	if ( !bSupportsInstancing )
 	{
@@ -210,7 +210,7 @@ void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDevic
 CLightVertexShaderParameters::SetMesh
 ==================
 */
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CDirectionalLightComponent*>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const DirectionalLightList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	if ( !bSupportsInstancing )
 	{
@@ -258,27 +258,26 @@ void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDevice
 CLightVertexFactory::SetupInstancing
 ==================
 */
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CPointLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const PointLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	Assert( lightType == LT_Point );
 	Assert( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
 
-	std::vector<TLightInstanceBuffer<LT_Point>>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
+	TLightInstanceBuffer<LT_Point>*		instanceBuffers = CFrameAllocator::Get().GetRenderingThreadAllocator().AllocateArray<TLightInstanceBuffer<LT_Point>>( InNumInstances );
 	
 	uint32		index = 0;
 	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
 	{
 		TLightInstanceBuffer<LT_Point>&		instanceBuffer		= instanceBuffers[index];
-		CPointLightComponent*				pointLightComponent = *it;
-		instanceBuffer.instanceLocalToWorld						= pointLightComponent->GetComponentTransform().ToMatrix();
-		instanceBuffer.lightColor								= pointLightComponent->GetLightColor();
-		instanceBuffer.intensivity								= pointLightComponent->GetIntensivity();
-		instanceBuffer.position									= pointLightComponent->GetComponentLocation();
-		instanceBuffer.radius									= pointLightComponent->GetRadius();
+		const LightRenderParameters&		lightParameters		= ( *it )->GetRenderParameters_RenderThread();
+		instanceBuffer.instanceLocalToWorld						= lightParameters.transform.ToMatrix();
+		instanceBuffer.lightColor								= lightParameters.lightColor;
+		instanceBuffer.intensivity								= lightParameters.intensivity;
+		instanceBuffer.position									= lightParameters.transform.GetLocation();
+		instanceBuffer.radius									= lightParameters.radius;
 	}
 
-	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances );
+	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers, sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances );
 }
 
 /*
@@ -286,34 +285,33 @@ void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDevice
 CLightVertexFactory::SetupInstancing
 ==================
 */
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CSpotLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const SpotLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	Assert( lightType == LT_Spot );
 	Assert( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
 
-	std::vector<TLightInstanceBuffer<LT_Spot>>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
+	TLightInstanceBuffer<LT_Spot>*		instanceBuffers = CFrameAllocator::Get().GetRenderingThreadAllocator().AllocateArray<TLightInstanceBuffer<LT_Spot>>( InNumInstances );
 
 	uint32		index = 0;
 	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
 	{
 		TLightInstanceBuffer<LT_Spot>&			instanceBuffer		= instanceBuffers[index];
-		CSpotLightComponent*					spotLightComponent	= *it;
-		CTransform								spotTransform		= spotLightComponent->GetComponentTransform();
+		const LightRenderParameters&			lightParameters		= ( *it )->GetRenderParameters_RenderThread();
+		CTransform								spotTransform		= lightParameters.transform;
 		Vector									direction			= spotTransform.GetUnitAxis( A_Forward );
 		spotTransform.SetRotation( Math::LookAtQuatenrion( spotTransform.GetLocation(), spotTransform.GetLocation() + direction, spotTransform.GetUnitAxis( A_Up ), Math::vectorUp ) );
 
 		instanceBuffer.instanceLocalToWorld							= spotTransform.ToMatrix();
-		instanceBuffer.lightColor									= spotLightComponent->GetLightColor();
-		instanceBuffer.intensivity									= spotLightComponent->GetIntensivity();
-		instanceBuffer.position										= spotLightComponent->GetComponentLocation();
-		instanceBuffer.radius										= spotLightComponent->GetRadius();
-		instanceBuffer.height										= spotLightComponent->GetHeight();
-		instanceBuffer.cutoff										= spotLightComponent->GetCutoff();
+		instanceBuffer.lightColor									= lightParameters.lightColor;
+		instanceBuffer.intensivity									= lightParameters.intensivity;
+		instanceBuffer.position										= lightParameters.transform.GetLocation();
+		instanceBuffer.radius										= lightParameters.radius;
+		instanceBuffer.height										= lightParameters.height;
+		instanceBuffer.cutoff										= lightParameters.cutoff;
 		instanceBuffer.direction									= direction;
 	}
 
-	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances );
+	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers, sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances );
 }
 
 /*
@@ -321,25 +319,24 @@ void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDevice
 CLightVertexFactory::SetupInstancing
 ==================
 */
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<CDirectionalLightComponent*>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const DirectionalLightList_t& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	Assert( lightType == LT_Directional );
 	Assert( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
 
-	std::vector<TLightInstanceBuffer<LT_Directional>>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
+	TLightInstanceBuffer<LT_Directional>*		instanceBuffers = CFrameAllocator::Get().GetRenderingThreadAllocator().AllocateArray<TLightInstanceBuffer<LT_Directional>>( InNumInstances );
 
 	uint32		index = 0;
 	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
 	{
 		TLightInstanceBuffer<LT_Directional>&			instanceBuffer				= instanceBuffers[index];
-		CDirectionalLightComponent*						directionalLightComponent	= *it;
-		instanceBuffer.lightColor													= directionalLightComponent->GetLightColor();
-		instanceBuffer.intensivity													= directionalLightComponent->GetIntensivity();
-		instanceBuffer.direction													= -directionalLightComponent->GetComponentTransform().GetUnitAxis( A_Forward );
+		const LightRenderParameters&					lightParameters				= ( *it )->GetRenderParameters_RenderThread();
+		instanceBuffer.lightColor													= lightParameters.lightColor;
+		instanceBuffer.intensivity													= lightParameters.intensivity;
+		instanceBuffer.direction													= -lightParameters.transform.GetUnitAxis( A_Forward );
 	}
 
-	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances );
+	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers, sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances );
 }
 
 /*
@@ -147,10 +147,9 @@ CSpriteVertexFactory::SetupInstancing
 */
 void CSpriteVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const struct MeshBatch& InMesh, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
-	Assert( InStartInstanceID < InMesh.instances.size() && InNumInstances <= InMesh.instances.size() - InStartInstanceID );
+	Assert( InStartInstanceID < InMesh.numInstances && InNumInstances <= InMesh.numInstances - InStartInstanceID );
 	
-	std::vector<SpriteInstanceBuffer>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
+	SpriteInstanceBuffer*		instanceBuffers = CFrameAllocator::Get().GetRenderingThreadAllocator().AllocateArray<SpriteInstanceBuffer>( InNumInstances );
 	for ( uint32 index = 0; index < InNumInstances; ++index )
 	{
 		SpriteInstanceBuffer&					instanceBuffer = instanceBuffers[ index ];
@@ -166,7 +165,7 @@ void CSpriteVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDevic
 #endif // WITH_EDITOR
 	}
 
-	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( SpriteInstanceBuffer ), InNumInstances * sizeof( SpriteInstanceBuffer ), InNumInstances );
+	g_RHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers, sizeof( SpriteInstanceBuffer ), InNumInstances * sizeof( SpriteInstanceBuffer ), InNumInstances );
 }
 
 /*
@@ -20,7 +20,109 @@
 #include "Render/Shaders/BasePassShader.h"
 #include "Render/Shaders/WireframeShader.h"
 #include "Render/RenderingThread.h"
+#include "Render/FrameAllocator.h"
 #include "System/CameraManager.h"
+#include "System/Profiler.h"
+#include "System/Cvar.h"
+#include "System/AudioStreamingManager.h"
+#include "Misc/AudioGlobals.h"
+
+#if ENABLE_PROFILER
+/*
+==================
+CVarStatProfilerChanged
+==================
+*/
+static void CVarStatProfilerChanged( CConVar* InConVar )
+{
+	CProfiler::Get().SetShowStats( InConVar->GetBool() );
+}
+
+/**
+ * @ingroup Engine
+ * @brief Cvar show stats of the CPU profiler
+ * @note This console variable is exist when ENABLE_PROFILER is enabled
+ */
+CConVar		CVarStatProfiler( TEXT( "stat_profiler" ), TEXT( "0" ), TEXT( "Show stats of the CPU profiler" ), FCVAR_None, &CVarStatProfilerChanged );
+
+/*
+==================
+PrintProfilerNode
+==================
+*/
+static void PrintProfilerNode( const CProfiler::ThreadStats& InThreadStats, uint32 InNodeIndex, uint32 InDepth )
+{
+	for ( uint32 nodeIndex = InNodeIndex; nodeIndex != INDEX_NONE; nodeIndex = InThreadStats.nodes[nodeIndex].nextSibling )
+	{
+		const CProfiler::Node&		node = InThreadStats.nodes[nodeIndex];
+		Logf( TEXT( "%*s%s::%s  %.3f ms  (%u calls)\n" ), InDepth * 2, TEXT( "" ), node.stat->group, node.stat->name, node.time, node.numCalls );
+		if ( node.firstChild != INDEX_NONE )
+		{
+			PrintProfilerNode( InThreadStats, node.firstChild, InDepth + 1 );
+		}
+	}
+}
+
+/**
+ * @ingroup Engine
+ * @brief Console command to print stats of the last frame of the CPU profiler
+ */
+CON_COMMAND( profiler_dump, TEXT( "Print stats of the last frame of the CPU profiler, stat_profiler must be enabled" ), FCVAR_None )
+{
+	CProfiler::FrameStats	frameStats;
+	CProfiler::Get().GetLastFrameStats( frameStats );
+	Logf( TEXT( "Profiler: frame %.3f ms\n" ), frameStats.frameTime );
+	for ( uint32 index = 0, count = frameStats.groups.size(); index < count; ++index )
+	{
+		Logf( TEXT( "  %s  %.3f ms\n" ), frameStats.groups[index].group, frameStats.groups[index].time );
+	}
+
+	for ( uint32 index = 0, count = frameStats.threads.size(); index < count; ++index )
+	{
+		const CProfiler::ThreadStats&		threadStats = frameStats.threads[index];
+		Logf( TEXT( "Thread '%s' (%u)\n" ), threadStats.threadName.c_str(), threadStats.threadId );
+		if ( threadStats.nodes[0].firstChild != INDEX_NONE )
+		{
+			PrintProfilerNode( threadStats, threadStats.nodes[0].firstChild, 1 );
+		}
+	}
+}
+
+/**
+ * @ingroup Engine
+ * @brief Console command to begin or end a capture of the CPU profiler
+ * Usage: profiler_capture [path to Chrome trace JSON file]. The first call begins a capture, the second one saves it
+ */
+CON_COMMAND( profiler_capture, TEXT( "Begin or end a capture of the CPU profiler. Usage: profiler_capture [path to Chrome trace JSON file]" ), FCVAR_None )
+{
+	CProfiler&		profiler = CProfiler::Get();
+	if ( !profiler.IsCapturing() )
+	{
+		profiler.BeginCapture();
+		Logf( TEXT( "Profiler capture begun\n" ) );
+	}
+	else
+	{
+		profiler.EndCapture( InArgc > 1 ? InArgv[1] : TEXT( "Profiler.json" ) );
+	}
+}
+#endif // ENABLE_PROFILER
+
+/**
+ * @ingroup Engine
+ * @brief Console command to print stats of audio streams which are playing now
+ */
+CON_COMMAND( audio_streams_dump, TEXT( "Print underruns and cost of decoding of audio streams which are playing now" ), FCVAR_None )
+{
+	std::vector<AudioStreamStats>		streamStats;
+	g_AudioStreamingManager.GetStreamStats( streamStats );
+	Logf( TEXT( "Audio streams: %i, streaming threads: %i\n" ), streamStats.size(), g_AudioStreamingManager.GetNumThreads() );
+	for ( uint32 index = 0, count = streamStats.size(); index < count; ++index )
+	{
+		const AudioStreamStats&		stats = streamStats[index];
+		Logf( TEXT( "  '%s'  underruns %u  decoded chunks %u  decode avg %.3f ms  max %.3f ms\n" ), stats.name.c_str(), stats.numUnderruns, stats.numDecodedChunks, stats.numDecodedChunks > 0 ? stats.decodeTime / stats.numDecodedChunks : 0.0, stats.maxDecodeTime );
+	}
+}
 
 IMPLEMENT_CLASS( CBaseEngine )
 IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CBaseEngine )
@@ -246,12 +348,18 @@ CBaseEngine::Tick
 */
 void CBaseEngine::Tick( float InDeltaSeconds )
 {
+	// Begin a new frame for transient data of the game and rendering threads
+	CFrameAllocator::Get().BeginFrame();
+
+	// Physics simulation is stepped by the world between tick groups of actors
 	if ( g_World )
 	{
 		g_World->Tick( InDeltaSeconds );
 	}
 	g_UIEngine->Tick( InDeltaSeconds );
-	g_PhysicsEngine.Tick( InDeltaSeconds );
+
+	// Send render commands recorded by worker threads while ticking
+	SubmitRenderCommandLists();
 }
 
 /*
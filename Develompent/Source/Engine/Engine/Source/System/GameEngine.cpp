@@ -23,6 +23,8 @@ CGameEngine::CGameEngine
 ==================
 */
 CGameEngine::CGameEngine()
+	: maxFramesInFlight( 1 )
+	, frameIndex( 0 )
 {}
 
 /*
@@ -50,6 +52,14 @@ void CGameEngine::Init()
 	g_Window->SetFullscreen( bFullscreen );
 	viewport.SetViewportClient( &viewportClient );
 	viewport.Update( false, windowWidth, windowHeight, g_Window->GetHandle() );
+
+	// Number of frames which the game thread may run ahead of the rendering thread.
+	// With one frame the game thread waits for the previous frame before it draws the next one
+	const CJsonValue*	configMaxFramesInFlight = CConfig::Get().GetValue( CT_Engine, TEXT( "Engine.Engine" ), TEXT( "MaxFramesInFlight" ) );
+	if ( configMaxFramesInFlight )
+	{
+		maxFramesInFlight = Clamp( ( uint32 )configMaxFramesInFlight->GetInt( 1 ), ( uint32 )1, ( uint32 )RENDER_MAX_FRAMES_IN_FLIGHT );
+	}
 }
 
 /*
@@ -62,11 +72,15 @@ void CGameEngine::Tick( float InDeltaSeconds )
 	Super::Tick( InDeltaSeconds );
 	viewport.Tick( InDeltaSeconds );
 
-	// Wait while render thread is rendering of the frame
-	FlushRenderingCommands();
+	// Wait while the rendering thread is more than maxFramesInFlight frames behind. The fence was begun
+	// maxFramesInFlight frames ago, so the rendering thread works on the next frames while we draw this one
+	CRenderFence&		frameFence = frameFences[frameIndex % maxFramesInFlight];
+	frameFence.Wait();
 
 	// Draw frame
 	viewport.Draw();
+	frameFence.BeginFence();
+	++frameIndex;
 }
 
 /*
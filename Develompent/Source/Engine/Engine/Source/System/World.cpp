@@ -1,3 +1,5 @@
+#include <unordered_map>
+
 #include "Misc/CoreGlobals.h"
 #include "Misc/EngineGlobals.h"
 #include "Misc/PhysicsGlobals.h"
@@ -8,7 +10,11 @@
 #include "System/World.h"
 #include "Logger/LoggerMacros.h"
 #include "Render/Scene.h"
+#include "Render/RenderingThread.h"
 #include "Reflection/ObjectPackage.h"
+#include "System/ThreadPool.h"
+#include "System/PhysicsEngine.h"
+#include "System/Profiler.h"
 
 #if WITH_EDITOR
 #include "WorldEd.h"
@@ -16,6 +22,9 @@
 
 IMPLEMENT_CLASS( CWorld )
 
+// Number of actors which one worker thread takes at a time when actors are ticked in parallel
+#define WORLD_TICK_ACTORS_BATCH_SIZE		8
+
 /*
 ==================
 CWorld::CWorld
@@ -52,6 +61,17 @@ void CWorld::BeginDestroy()
 	delete scene;
 }
 
+/*
+==================
+CWorld::CanBeInCluster
+==================
+*/
+bool CWorld::CanBeInCluster() const
+{
+	// Actors are spawned and destroyed at runtime
+	return false;
+}
+
 /*
 ==================
 CWorld::BeginPlay
@@ -113,15 +133,43 @@ CWorld::Tick
 */
 void CWorld::Tick( float InDeltaTime )
 {
-	// Tick all actors (only if play is begin)
+	SCOPED_PROFILER( TEXT( "World" ), TEXT( "Tick" ) );
+
+	// With deferred results the simulation has been running since the end of the previous tick, fetch its results now
+	const bool		bDeferredPhysicsResults = g_PhysicsEngine.IsDeferredResults();
+	if ( bDeferredPhysicsResults )
+	{
+		EndPhysicsSimulation();
+	}
+
+	// Tick actors before physics simulation (only if play is begin)
 	if ( HasBegunPlay() )
 	{
-		for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
-		{
-			AActor* actor = actors[index];
-			actor->Tick( InDeltaTime );
-			actor->SyncPhysics();
-		}
+		TickGroup( TG_PrePhysics, InDeltaTime );
+	}
+
+	// Begin physics simulation. In async mode it runs in the thread pool while actors of TG_DuringPhysics are ticked
+	if ( !bDeferredPhysicsResults )
+	{
+		SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "BeginSimulation" ) );
+		g_PhysicsEngine.BeginSimulation( InDeltaTime );
+	}
+
+	if ( HasBegunPlay() )
+	{
+		TickGroup( TG_DuringPhysics, InDeltaTime );
+	}
+
+	// Sync point, actors of TG_PostPhysics need results of physics simulation
+	if ( !bDeferredPhysicsResults )
+	{
+		EndPhysicsSimulation();
+	}
+
+	// Tick actors which need results of physics simulation
+	if ( HasBegunPlay() )
+	{
+		TickGroup( TG_PostPhysics, InDeltaTime );
 	}
 
 	// Destroy actors if need
@@ -135,16 +183,34 @@ void CWorld::Tick( float InDeltaTime )
 		actorsToDestroy.clear();
 	}
 
+	// With deferred results the simulation overlaps the rest of the frame: viewport, UI and rendering work
+	if ( bDeferredPhysicsResults )
+	{
+		SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "BeginSimulation" ) );
+		g_PhysicsEngine.BeginSimulation( InDeltaTime );
+	}
+
 	// Collect and purge garbage
 	CObjectGC&		objectGC = CObjectGC::Get();
 	timeSinceLastPendingKillPurge += InDeltaTime;
-	if ( !objectGC.IsIncrementalPurgePending() && ( timeSinceLastPendingKillPurge > objectGC.GetTimeBetweenPurgingGarbage() ) && objectGC.GetTimeBetweenPurgingGarbage() > 0.f )
+	if ( !objectGC.IsIncrementalPurgePending() && ( objectGC.IsIncrementalMarkPending() || ( timeSinceLastPendingKillPurge > objectGC.GetTimeBetweenPurgingGarbage() && objectGC.GetTimeBetweenPurgingGarbage() > 0.f ) ) )
 	{
 		// We don't collect garbage while any packages are saving
 		if ( !CObjectPackage::IsSavingPackage() )
 		{
-			objectGC.CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
-			timeSinceLastPendingKillPurge = 0.f;
+			// Incremental reachability analysis spreads the mark over several frames, the editor always does the full one
+			if ( objectGC.IsIncrementalReachabilityAnalysis() && !g_IsEditor )
+			{
+				if ( objectGC.IncrementalCollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS ) )
+				{
+					timeSinceLastPendingKillPurge = 0.f;
+				}
+			}
+			else
+			{
+				objectGC.CollectGarbage( GARBAGE_COLLECTION_KEEPFLAGS, false );
+				timeSinceLastPendingKillPurge = 0.f;
+			}
 		}
 	}
 	else
@@ -153,6 +219,164 @@ void CWorld::Tick( float InDeltaTime )
 	}
 }
 
+/*
+==================
+CWorld::EndPhysicsSimulation
+==================
+*/
+void CWorld::EndPhysicsSimulation()
+{
+	{
+		SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "EndSimulation" ) );
+		g_PhysicsEngine.EndSimulation();
+	}
+
+	// Sync actors which have been ticked while physics simulation was running
+	for ( uint32 index = 0, count = actorsToSyncPhysics.size(); index < count; ++index )
+	{
+		actorsToSyncPhysics[index]->SyncPhysics();
+	}
+	actorsToSyncPhysics.clear();
+}
+
+/*
+==================
+CWorld::TickGroup
+==================
+*/
+void CWorld::TickGroup( ETickingGroup InTickGroup, float InDeltaTime )
+{
+	SCOPED_PROFILER( TEXT( "World" ), TEXT( "TickGroup" ) );
+
+	// Collect actors of the group. Actors spawned while ticking will be ticked in the next frame
+	std::vector<AActor*>	groupActors;
+	for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
+	{
+		AActor*		actor = actors[index];
+		if ( actor->GetTickGroup() == InTickGroup && !actor->IsPendingKillPending() )
+		{
+			groupActors.push_back( actor );
+		}
+	}
+
+	const uint32	numActors = groupActors.size();
+	if ( numActors == 0 )
+	{
+		return;
+	}
+
+	// Build graph of prerequisites. Prerequisites which aren't in this group are ignored,
+	// actors of earlier groups are already ticked and pointers to destroyed actors are never dereferenced
+	std::unordered_map<AActor*, uint32>		actorIndices;
+	std::vector<int32>						numPendingPrerequisites( numActors, 0 );
+	std::vector<std::vector<uint32>>		dependents( numActors );
+	actorIndices.reserve( numActors );
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		actorIndices[groupActors[index]] = index;
+	}
+
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		const std::vector<AActor*>&		prerequisites = groupActors[index]->GetTickPrerequisites();
+		for ( uint32 prerequisiteIndex = 0, numPrerequisites = prerequisites.size(); prerequisiteIndex < numPrerequisites; ++prerequisiteIndex )
+		{
+			auto	itPrerequisite = actorIndices.find( prerequisites[prerequisiteIndex] );
+			if ( itPrerequisite != actorIndices.end() )
+			{
+				++numPendingPrerequisites[index];
+				dependents[itPrerequisite->second].push_back( index );
+			}
+		}
+	}
+
+	// Tick actors wave by wave
+	std::vector<uint32>		wave;
+	std::vector<uint32>		nextWave;
+	std::vector<uint32>		anyThreadActors;
+	std::vector<bool>		tickedActors( numActors, false );
+	uint32					numTickedActors = 0;
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		if ( numPendingPrerequisites[index] == 0 )
+		{
+			wave.push_back( index );
+		}
+	}
+
+	while ( numTickedActors < numActors )
+	{
+		// All remaining actors wait for each other, so there is a cycle in prerequisites. Break it by ticking the first one
+		if ( wave.empty() )
+		{
+			for ( uint32 index = 0; index < numActors; ++index )
+			{
+				if ( !tickedActors[index] )
+				{
+					Warnf( TEXT( "Cycle in tick prerequisites of actor '%s', it's ticked ignoring them\n" ), groupActors[index]->GetName().c_str() );
+					wave.push_back( index );
+					break;
+				}
+			}
+		}
+
+		// Actors allowed to tick on any thread are ticked in parallel, others one by one on the game thread
+		anyThreadActors.clear();
+		for ( uint32 index = 0, count = wave.size(); index < count; ++index )
+		{
+			AActor*		actor = groupActors[wave[index]];
+			if ( actor->IsAllowTickOnAnyThread() )
+			{
+				anyThreadActors.push_back( wave[index] );
+			}
+			else
+			{
+				actor->Tick( InDeltaTime );
+			}
+		}
+
+		// Without the rendering thread render commands are executed right away on the sending thread, and they change
+		// state of the scene which isn't thread safe. So in this case all actors are ticked on the game thread
+		CThreadPool::Get().ParallelFor( anyThreadActors.size(), [&]( uint32 InIndex )
+										{
+											groupActors[anyThreadActors[InIndex]]->Tick( InDeltaTime );
+										}, WORLD_TICK_ACTORS_BATCH_SIZE, !g_IsThreadedRendering );
+
+		// Release dependents of ticked actors
+		nextWave.clear();
+		for ( uint32 index = 0, count = wave.size(); index < count; ++index )
+		{
+			uint32		actorIndex = wave[index];
+			tickedActors[actorIndex] = true;
+			++numTickedActors;
+
+			const std::vector<uint32>&		actorDependents = dependents[actorIndex];
+			for ( uint32 dependentIndex = 0, numDependents = actorDependents.size(); dependentIndex < numDependents; ++dependentIndex )
+			{
+				uint32		dependent = actorDependents[dependentIndex];
+				if ( --numPendingPrerequisites[dependent] == 0 && !tickedActors[dependent] )
+				{
+					nextWave.push_back( dependent );
+				}
+			}
+		}
+		wave.swap( nextWave );
+	}
+
+	// Sync actors to physics bodies. Physics isn't thread safe, so it's done on the game thread.
+	// While physics simulation is running actors are synced after it
+	if ( g_PhysicsEngine.IsSimulating() )
+	{
+		actorsToSyncPhysics.insert( actorsToSyncPhysics.end(), groupActors.begin(), groupActors.end() );
+		return;
+	}
+
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		groupActors[index]->SyncPhysics();
+	}
+}
+
 /*
 ==================
 CWorld::Serialize
@@ -235,10 +459,12 @@ void CWorld::CleanupWorld()
 	}
 #endif // WITH_EDITOR
 
+	g_PhysicsEngine.WaitForSimulation();
 	g_PhysicsScene.RemoveAllBodies();
 	scene->Clear();
 	actors.clear();
 	actorsToDestroy.clear();
+	actorsToSyncPhysics.clear();
 
 #if WITH_EDITOR
 	selectedActors.clear();
@@ -271,6 +497,8 @@ AActor* CWorld::SpawnActor( class CClass* InClass, const Vector& InLocation, con
 		actor->InitPhysics();
 	}
 
+	// The world may be already traversed by incremental reachability analysis
+	CObjectGC::Get().WriteBarrier( this, actor );
 	actors.push_back( actor );
 	
 	// Broadcast event of spawned actor
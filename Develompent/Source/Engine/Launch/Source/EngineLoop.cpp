@@ -10,11 +10,13 @@
 #include "System/BaseWindow.h"
 #include "System/Config.h"
 #include "System/Threading.h"
+#include "System/ThreadPool.h"
 #include "System/InputSystem.h"
 #include "System/Package.h"
 #include "System/AudioEngine.h"
 #include "Misc/StringConv.h"
 #include "Reflection/ObjectGC.h"
+#include "Reflection/AsyncPackageLoader.h"
 #include "Reflection/ObjectIterator.h"
 #include "Reflection/ObjectGlobals.h"
 #include "Math/Color.h"
@@ -35,6 +37,7 @@
 #include "System/Cvar.h"
 #include "System/Name.h"
 #include "System/System.h"
+#include "System/Profiler.h"
 #include "LEBuild.h"
 
 #if USE_THEORA_CODEC
@@ -205,6 +208,7 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 {
 	g_GameThreadId = Sys_GetCurrentThreadId();
 	g_GameName = ANSI_TO_TCHAR( GAMENAME );
+	PROFILER_THREAD_NAME( g_GameThreadId, TEXT( "GameThread" ) );
 
 	g_CommandLine.Init( InCmdLine );
 	CName::StaticInit();
@@ -227,10 +231,33 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 
 	g_Log->Init();
 	int32		result = Sys_PlatformPreInit();
+
+	// Serialize logs in a background thread, so heavy logging doesn't stall the game and rendering threads.
+	// Only in game, commandlets and the editor log window expect messages to be printed at once on the calling thread
+	if ( g_IsGame )
+	{
+		const CJsonValue*	configAsyncLogging		= CConfig::Get().GetValue( CT_Engine, TEXT( "Core.System" ), TEXT( "AsyncLogging" ) );
+		if ( configAsyncLogging && configAsyncLogging->GetBool() )
+		{
+			const CJsonValue*	configLogQueueSize	= CConfig::Get().GetValue( CT_Engine, TEXT( "Core.System" ), TEXT( "LogQueueSize" ) );
+			g_Log->StartAsync( configLogQueueSize ? configLogQueueSize->GetInt( 4096 ) : 4096 );
+		}
+	}
 	
 	// Initialize the system
 	CSystem::Get().Init();
 
+	// Start worker threads of the thread pool. By default we reserve cores for the game and rendering threads
+	{
+		const CJsonValue*	configNumWorkerThreads	= CConfig::Get().GetValue( CT_Engine, TEXT( "Core.System" ), TEXT( "NumWorkerThreads" ) );
+		int32				numWorkerThreads		= configNumWorkerThreads ? configNumWorkerThreads->GetInt( -1 ) : -1;
+		if ( numWorkerThreads < 0 )
+		{
+			numWorkerThreads = Max<int32>( ( int32 )Sys_GetNumberOfCores() - 2, 1 );
+		}
+		CThreadPool::Get().Init( numWorkerThreads );
+	}
+
 	// Initialize CObject system
 	CObject::StaticInit();
 
@@ -383,9 +410,10 @@ int32 CEngineLoop::Init()
 	{
 		Sys_SetSplashText( STT_StartupProgress, L_Sprintf( TEXT( "Loading map '%s'..." ), map.c_str() ).c_str() );
 
+		// Relative path of the map is relative to cooked content of the game (see CCookPackagesCommandlet)
 		std::wstring		error;
 		bool				bAbsolutePath = L_IsAbsolutePath( map );
-		bool				successed = g_Engine->LoadMap( !bAbsolutePath ? L_Sprintf( TEXT( "%s" ) PATH_SEPARATOR TEXT( "%s" ), g_CookedDir.c_str(), map.c_str() ) : map, error );
+		bool				successed = g_Engine->LoadMap( !bAbsolutePath ? L_Sprintf( TEXT( "%s" ) PATH_SEPARATOR TEXT( "%s" ) PATH_SEPARATOR TEXT( "Content" ) PATH_SEPARATOR TEXT( "%s" ), g_CookedDir.c_str(), g_GameName.c_str(), map.c_str() ) : map, error );
 		if ( !successed )
 		{
 			Sys_Error( TEXT( "Failed loading map '%s'. Error: %s" ), map.c_str(), error.c_str() );
@@ -447,14 +475,27 @@ void CEngineLoop::Tick()
 
 	Sys_UpdateTimeAndHandleMaxTickRate();
 
-	// Update package manager
-	g_PackageManager->Tick();
-	
-	// Update engine
-	g_Engine->Tick( g_DeltaTime );
+	{
+		SCOPED_PROFILER( TEXT( "Engine" ), TEXT( "Frame" ) );
+
+		// Update package manager
+		g_PackageManager->Tick();
+
+		// Create objects of async loading packages
+		{
+			SCOPED_PROFILER( TEXT( "Loading" ), TEXT( "ProcessAsyncLoading" ) );
+			CAsyncPackageLoader::Get().ProcessAsyncLoading( true );
+		}
+
+		// Update engine
+		g_Engine->Tick( g_DeltaTime );
+
+		// Reset input events after game frame
+		g_InputSystem->ResetEvents();
+	}
 
-	// Reset input events after game frame
-	g_InputSystem->ResetEvents();
+	// Aggregate scopes of the frame, it must be outside of any profiled scope
+	PROFILER_END_FRAME();
 }
 
 /*
@@ -481,6 +522,7 @@ void CEngineLoop::Exit()
 	g_RHI->Destroy();
 
 	g_Window->Close();
+	CThreadPool::Get().Shutdown();
 	CObject::CleanupLinkerMap();
 	CObject::StaticExit();
 	CSystem::Get().Shutdown();
@@ -160,6 +160,45 @@ struct CollisionQueryParams
 	static CollisionQueryParams	defaultQueryParam;				/**< Static variable for default data to be used without reconstructing everytime */
 };
 
+/**
+ * @ingroup Physics
+ * @brief Enumeration of scene query types
+ */
+enum ESceneQueryType
+{
+	SQT_LineTrace,		/**< Trace a ray and find the closest blocking hit */
+	SQT_Sweep,			/**< Sweep a box and find the closest blocking hit */
+	SQT_Overlap			/**< Test a box for overlap and find any overlapped body */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Scene query in a batch
+ */
+struct SceneQuery
+{
+	/**
+	 * @brief Constructor
+	 */
+	SceneQuery()
+		: type( SQT_LineTrace )
+		, start( Math::vectorZero )
+		, end( Math::vectorZero )
+		, boxExtent( Math::vectorZero )
+		, traceChannel( CC_WorldStatic )
+		, bHit( false )
+	{}
+
+	ESceneQueryType					type;			/**< Type of the query */
+	Vector							start;			/**< Start of the ray or the box, location of the box for overlap */
+	Vector							end;			/**< End of the ray or the box, ignored for overlap */
+	Vector							boxExtent;		/**< Half extent of the box for sweep and overlap */
+	ECollisionChannel				traceChannel;	/**< Trace channel */
+	CollisionQueryParams			queryParams;	/**< Collision query params */
+	bool							bHit;			/**< Output: is a hit found */
+	HitResult						hitResult;		/**< Output: hit result */
+};
+
 //
 // Serialize
 //
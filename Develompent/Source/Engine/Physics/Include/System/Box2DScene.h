@@ -12,6 +12,7 @@
 #if WITH_BOX2D
 #include <box2d/box2d.h>
 #include <vector>
+#include <unordered_map>
 
 #include "Math/Math.h"
 #include "Misc/PhysicsTypes.h"
@@ -19,7 +20,11 @@
 
 /**
  * @ingroup Physics
- * @brief Class of PhysX scene
+ * @brief Class of Box2D scene
+ *
+ * Scene queries don't go over all bodies. Each collision channel has its own dynamic AABB tree with proxies of fixtures,
+ * a query visits only fixtures of the channel which bounds are touched by it. Proxies of moving bodies are updated after
+ * each step of the simulation. Queries only read the trees, so they can run in parallel on several threads
  */
 class CBox2DScene
 {
@@ -46,6 +51,12 @@ public:
 	 */
 	void Tick( float InDeltaTime );
 
+	/**
+	 * @brief Save current transforms of bodies as transforms of the previous step
+	 * @note Called before the last step of the simulation in the frame, transforms of bodies are interpolated between these steps
+	 */
+	void SavePreviousTransforms();
+
 	/**
 	 * @brief Shutdown scene
 	 */
@@ -66,17 +77,10 @@ public:
 	/**
 	 * @brief Remove all bodies from scene
 	 */
-	FORCEINLINE void RemoveAllBodies()
-	{
-		bodies.clear();
-		for ( uint32 index = 0; index < CC_Max; ++index )
-		{
-			fixturesMap[ index ].clear();
-		}
-	}
+	void RemoveAllBodies();
 
 	/**
-	 * Trace a ray against the world using a specific channel and return the first blocking hit
+	 * Trace a ray against the world using a specific channel and return the closest blocking hit
 	 *
 	 * @param OutHitResult Hit result
 	 * @param InStart Start ray
@@ -87,6 +91,40 @@ public:
 	 */
 	bool LineTraceSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
 
+	/**
+	 * Sweep a box against the world using a specific channel and return the closest blocking hit
+	 * @note Bodies which the box overlaps at the start aren't hit, use OverlapMultiByChannel for them
+	 *
+	 * @param OutHitResult Hit result
+	 * @param InStart Start location of the box center
+	 * @param InEnd End location of the box center
+	 * @param InBoxExtent Half extent of the box
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if a blocking hit is found, else false
+	 */
+	bool SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * Test a box against the world using a specific channel and return all overlapped bodies
+	 *
+	 * @param OutOverlaps Array of overlaps, impact point of each overlap is location of the body
+	 * @param InLocation Location of the box center
+	 * @param InBoxExtent Half extent of the box
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if any overlap is found, else false
+	 */
+	bool OverlapMultiByChannel( std::vector<HitResult>& OutOverlaps, const Vector& InLocation, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * Execute a batch of scene queries
+	 * Large batches are split into parts which are executed in parallel on worker threads of the thread pool
+	 *
+	 * @param InOutQueries Array of queries, results are written into them
+	 */
+	void ExecuteQueryBatch( std::vector<SceneQuery>& InOutQueries );
+
 	/**
 	 * @brief Get Box2D world
 	 * @return Return Box2D world
@@ -97,9 +135,51 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Proxy of a fixture child in the tree of its collision channel
+	 */
+	struct QueryProxy
+	{
+		class CPhysicsBodyInstance*		bodyInstance;		/**< Body instance */
+		b2Fixture*						bx2Fixture;			/**< Fixture */
+		int32							childIndex;			/**< Index of the child shape */
+		int32							proxyId;			/**< ID of the proxy in the tree */
+		ECollisionChannel				collisionChannel;	/**< Collision channel of the fixture */
+	};
+
+	/**
+	 * @brief Update bounds of proxies of moving bodies
+	 * @param InDeltaTime Time of the step, bounds are enlarged by displacement of bodies in it
+	 */
+	void UpdateQueryProxies( float InDeltaTime );
+
+	/**
+	 * @brief Destroy proxies of a body
+	 * @param InProxies Proxies of the body
+	 */
+	void DestroyQueryProxies( const std::vector< QueryProxy >& InProxies );
+
+	/**
+	 * @brief Fill hit result by a proxy
+	 *
+	 * @param OutHitResult Hit result
+	 * @param InProxy Hit proxy
+	 * @param InNormal Normal of the hit in Box2D space
+	 * @param InPoint Point of the hit in Box2D space
+	 * @param InCollisionQueryParams Collision query params
+	 */
+	void FillHitResult( HitResult& OutHitResult, const QueryProxy* InProxy, const b2Vec2& InNormal, const b2Vec2& InPoint, const CollisionQueryParams& InCollisionQueryParams ) const;
+
+	/**
+	 * @brief Execute a scene query
+	 * @param InOutQuery Query, the result is written into it
+	 */
+	void ExecuteQuery( SceneQuery& InOutQuery );
+
 	b2World*																		bx2World;						/**< Box2D world */
 	std::vector< class CPhysicsBodyInstance* >										bodies;							/**< Array of bodies on scene */
-	std::unordered_map< class CPhysicsBodyInstance*, std::vector< b2Fixture* > >	fixturesMap[ CC_Max ];			/**< Map of fixtures each collision channel */
+	std::unordered_map< class CPhysicsBodyInstance*, std::vector< QueryProxy > >	queryProxies;					/**< Proxies of fixtures of each body, the trees point to them */
+	b2DynamicTree																	queryTrees[ CC_Max ];			/**< Dynamic AABB tree of fixtures each collision channel */
 };
 #endif // WITH_BOX2D
 
@@ -43,6 +43,12 @@ public:
 	 */
 	void Tick( float InDeltaTime );
 
+	/**
+	 * @brief Save current transforms of bodies as transforms of the previous step
+	 * @note Called before the last step of the simulation in the frame, transforms of bodies are interpolated between these steps
+	 */
+	void SavePreviousTransforms();
+
 	/**
 	 * @brief Shutdown scene
 	 */
@@ -9,12 +9,14 @@
 #ifndef PHYSICSBODYINSTANCE_H
 #define PHYSICSBODYINSTANCE_H
 
+#include "Misc/PhysicsGlobals.h"
 #include "System/PhysicsEngine.h"
 #include "System/PhysicsBodySetup.h"
 
 /**
  * @ingroup Physics
  * @brief Container for a physics representation of an object
+ * @note Accessors of the body wait for the physics simulation if it's running (see CPhysicsEngine::WaitForSimulation)
  */
 class CPhysicsBodyInstance
 {
@@ -51,6 +53,7 @@ public:
 	 */
 	FORCEINLINE void AddAngularImpulse( const Vector& InAngularImpulse, bool InIsWake )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::AddAngularImpulse( handle, InAngularImpulse, InIsWake );
 	}
 
@@ -62,6 +65,7 @@ public:
 	 */
 	FORCEINLINE void AddImpulse( const Vector& InImpulse, bool InIsWake )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::AddImpulse( handle, InImpulse, InIsWake );
 	}
 
@@ -74,6 +78,7 @@ public:
 	 */
 	FORCEINLINE void AddImpulseAtLocation( const Vector& InImpulse, const Vector& InLocation, bool InIsWake )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::AddImpulseAtLocation( handle, InImpulse, InLocation, InIsWake );
 	}
 
@@ -85,6 +90,7 @@ public:
 	 */
 	FORCEINLINE void AddForce( const Vector& InForce, bool InIsWake )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::AddForce( handle, InForce, InIsWake );
 	}
 
@@ -97,6 +103,7 @@ public:
 	 */
 	FORCEINLINE void AddForceAtLocation( const Vector& InForce, const Vector& InLocation, bool InIsWake )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::AddForceAtLocation( handle, InForce, InLocation, InIsWake );
 	}
 
@@ -108,6 +115,7 @@ public:
 	 */
 	FORCEINLINE void SetLinearVelocity( const Vector& InVelocity, bool InIsAddToCurrent = false )
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		CPhysicsInterface::SetLinearVelocity( handle, InVelocity, InIsAddToCurrent );
 	}
 
@@ -185,9 +193,24 @@ public:
 	 */
 	FORCEINLINE CTransform GetLEWorldTransform() const
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		return CPhysicsInterface::GetTransform( handle );
 	}
 
+	/**
+	 * @brief Get LE world transform interpolated between the last two steps of the simulation
+	 *
+	 * @param InAlpha	Alpha between the previous step (0) and the last one (1)
+	 * @return Return interpolated LE world transform
+	 */
+	CTransform GetInterpolatedLEWorldTransform( float InAlpha ) const;
+
+	/**
+	 * @brief Save current transform of the body as transform of the previous step
+	 * @note Called by the physics scene before the last step of the simulation in the frame
+	 */
+	void SavePreviousTransform();
+
 	/**
 	 * @brief Get body setup
 	 * @return Return body setup
@@ -203,6 +226,7 @@ public:
 	 */
 	FORCEINLINE Vector GetLinearVelocity()
 	{
+		g_PhysicsEngine.WaitForSimulation();
 		return CPhysicsInterface::GetLinearVelocity( handle );
 	}
 
@@ -298,6 +322,7 @@ private:
 	class CPrimitiveComponent*	ownerComponent;		/**< PrimitiveComponent containing this body */	
 	PhysicsBodySetupRef_t		bodySetup;			/**< Body setup */
 	PhysicsActorHandle_t		handle;				/**< Handle to physics actor */
+	CTransform					previousTransform;	/**< Transform of the body on the previous step of the simulation */
 };
 
 #endif // !PHYSICSBODYINSTANCE_H
\ No newline at end of file
@@ -14,11 +14,21 @@
 
 #include "Logger/LoggerMacros.h"
 #include "System/PhysicsMaterial.h"
+#include "System/ThreadPool.h"
 #include "Core.h"
 
 /**
  * @ingroup Physics
  * @brief Main class of physics engine
+ *
+ * The simulation is stepped with a fixed time step. Time of frames is accumulated and the scene is stepped as many times
+ * as whole steps fit into it, but not more than max number of substeps per frame, so a hitch doesn't produce a huge step
+ * or a spiral of steps. Transforms of bodies are interpolated between the last two steps by the remaining time.
+ *
+ * In async mode the steps of a frame run as a task in the thread pool between BeginSimulation and EndSimulation,
+ * so game work proceeds in parallel with them. With deferred results the world begins the simulation at the end of its tick
+ * and ends it at the beginning of the next one, so the simulation overlaps the rest of the frame at the cost of one frame latency. Physics isn't thread safe, so while the simulation runs only the game
+ * thread may touch physics, it waits for the simulation first (see WaitForSimulation)
  */
 class CPhysicsEngine
 {
@@ -40,11 +50,80 @@ public:
 
 	/**
 	 * @brief Tick engine
+	 * Steps the simulation and waits for its results
 	 * 
 	 * @param InDeltaTime The time since the last tick
 	 */
 	void Tick( float InDeltaTime );
 
+	/**
+	 * @brief Begin simulation of a frame
+	 * In async mode steps of the simulation are run in the thread pool, otherwise they are run right here
+	 * @note Must be called from the game thread
+	 *
+	 * @param InDeltaTime The time since the last tick
+	 */
+	void BeginSimulation( float InDeltaTime );
+
+	/**
+	 * @brief End simulation of a frame
+	 * It's the sync point, after it results of the simulation are available
+	 * @note Must be called from the game thread
+	 */
+	void EndSimulation();
+
+	/**
+	 * @brief Wait for the simulation if it's running
+	 * If the task of the simulation hasn't been started yet, the simulation is run on the calling thread
+	 * @note Must be called from the game thread before touching physics while the simulation may run
+	 */
+	void WaitForSimulation();
+
+	/**
+	 * @brief Is the simulation running
+	 * @return Return TRUE if the simulation has been begun and isn't waited yet, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsSimulating() const
+	{
+		return bSimulating;
+	}
+
+	/**
+	 * @brief Is async simulation enabled
+	 * @return Return TRUE if steps of the simulation run in the thread pool, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsAsyncSimulation() const
+	{
+		return bAsyncSimulation;
+	}
+
+	/**
+	 * @brief Are results of the simulation deferred to the next frame
+	 * @return Return TRUE if the simulation is async and it's ended at the beginning of the next frame, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsDeferredResults() const
+	{
+		return bAsyncSimulation && bDeferredResults;
+	}
+
+	/**
+	 * @brief Get alpha to interpolate transforms of bodies between the last two steps
+	 * @return Return alpha in range [0, 1], it's 1 if the simulation isn't stepped with a fixed time step
+	 */
+	FORCEINLINE float GetInterpolationAlpha() const
+	{
+		return interpolationAlpha;
+	}
+
+	/**
+	 * @brief Get fixed time step of the simulation
+	 * @return Return fixed time step in seconds, 0 if the simulation is stepped by time of frames
+	 */
+	FORCEINLINE float GetFixedTimeStep() const
+	{
+		return fixedTimeStep;
+	}
+
 	/**
 	 * @brief Shutdown engine
 	 */
@@ -78,6 +157,34 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Task which runs steps of the simulation in the thread pool
+	 */
+	class CSimulationTask : public CThreadPoolTask
+	{
+	public:
+		/**
+		 * @brief Do work
+		 */
+		virtual void DoWork() override;
+	};
+
+	/**
+	 * @brief Run pending steps of the simulation
+	 */
+	void StepSimulation();
+
+	bool																bAsyncSimulation;				/**< Are steps of the simulation run in the thread pool */
+	bool																bDeferredResults;				/**< Are results of the async simulation fetched at the beginning of the next frame */
+	bool																bSimulating;					/**< Is the simulation running */
+	uint32																numPendingSteps;				/**< Number of steps to run by the simulation */
+	float																pendingStepTime;				/**< Time of each pending step */
+	float																pendingInterpolationAlpha;		/**< Interpolation alpha which is applied when the simulation is ended */
+	CSimulationTask														simulationTask;					/**< Task of the simulation */
+	float																fixedTimeStep;					/**< Fixed time step of the simulation in seconds, 0 if the simulation is stepped by time of frames */
+	uint32																maxSubsteps;					/**< Max number of steps of the simulation per frame */
+	float																accumulatedTime;				/**< Time which hasn't been simulated yet */
+	float																interpolationAlpha;				/**< Alpha to interpolate transforms of bodies between the last two steps */
 	TAssetHandle<CPhysicsMaterial>										defaultPhysMaterial;			/**< Default physics material */
 	mutable std::unordered_map< std::wstring,  CollisionProfile >		collisionProfiles;				/**< Collision profiles map */
 };
@@ -1,11 +1,21 @@
 #if WITH_BOX2D
+#include <box2d/b2_distance.h>
+
 #include "Misc/PhysicsGlobals.h"
 #include "System/PhysicsEngine.h"
 #include "System/PhysicsBodyInstance.h"
 #include "System/Box2DScene.h"
 #include "System/PhysicsMaterial.h"
+#include "System/Profiler.h"
+#include "System/ThreadPool.h"
 #include "Components/PrimitiveComponent.h"
 
+/* Number of queries of a batch which one thread takes at a time */
+#define BOX2D_QUERY_BATCH_SIZE			16
+
+/* Min number of queries in a batch to execute it in parallel */
+#define BOX2D_MIN_PARALLEL_QUERIES		64
+
 /*
 ==================
 CBox2DScene::CBox2DScene
@@ -44,6 +54,20 @@ CBox2DScene::Tick
 void CBox2DScene::Tick( float InDeltaTime )
 {
 	bx2World->Step( InDeltaTime, 8, 3 );
+	UpdateQueryProxies( InDeltaTime );
+}
+
+/*
+==================
+CBox2DScene::SavePreviousTransforms
+==================
+*/
+void CBox2DScene::SavePreviousTransforms()
+{
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		bodies[ index ]->SavePreviousTransform();
+	}
 }
 
 /*
@@ -53,6 +77,7 @@ CBox2DScene::Shutdown
 */
 void CBox2DScene::Shutdown()
 {
+	RemoveAllBodies();
 	if ( bx2World )
 	{
 		delete bx2World;
@@ -69,12 +94,33 @@ void CBox2DScene::AddBody( class CPhysicsBodyInstance* InBodyInstance )
 {
 	bodies.push_back( InBodyInstance );
 
+	// Create proxies of all fixtures in trees of their collision channels. The array isn't changed after that,
+	// so the trees can point to its elements
 	PhysicsActorHandleBox2D		actorHandle = InBodyInstance->GetActorHandle();
+	std::vector< QueryProxy >&	proxies		= queryProxies[ InBodyInstance ];
+	Assert( proxies.empty() );
 	for ( b2Fixture* bx2Fixture = actorHandle.bx2Body->GetFixtureList(); bx2Fixture; bx2Fixture = bx2Fixture->GetNext() )
 	{
 		PhysicsShapeHandleBox2D*	shapeHandle = ( PhysicsShapeHandleBox2D* )bx2Fixture->GetUserData().pointer;
 		Assert( shapeHandle );
-		fixturesMap[ shapeHandle->collisionProfile->objectType ][ InBodyInstance ].push_back( bx2Fixture );
+		for ( int32 childIndex = 0, numChildren = bx2Fixture->GetShape()->GetChildCount(); childIndex < numChildren; ++childIndex )
+		{
+			QueryProxy		proxy;
+			proxy.bodyInstance		= InBodyInstance;
+			proxy.bx2Fixture		= bx2Fixture;
+			proxy.childIndex		= childIndex;
+			proxy.proxyId			= b2_nullNode;
+			proxy.collisionChannel	= shapeHandle->collisionProfile->objectType;
+			proxies.push_back( proxy );
+		}
+	}
+
+	for ( uint32 index = 0, count = proxies.size(); index < count; ++index )
+	{
+		QueryProxy&		proxy = proxies[ index ];
+		b2AABB			bx2AABB;
+		proxy.bx2Fixture->GetShape()->ComputeAABB( &bx2AABB, proxy.bx2Fixture->GetBody()->GetTransform(), proxy.childIndex );
+		proxy.proxyId = queryTrees[ proxy.collisionChannel ].CreateProxy( bx2AABB, &proxy );
 	}
 }
 
@@ -90,10 +136,12 @@ void CBox2DScene::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
 		CPhysicsBodyInstance*		bodyInstance = bodies[ index ];
 		if ( bodyInstance == InBodyInstance )
 		{
-			// Remove all fixtures from collision channel map
-			for ( uint32 index = 0; index < CC_Max; ++index )
+			// Remove all fixtures from trees of collision channels
+			auto	itProxies = queryProxies.find( InBodyInstance );
+			if ( itProxies != queryProxies.end() )
 			{
-				fixturesMap[ index ].erase( InBodyInstance );
+				DestroyQueryProxies( itProxies->second );
+				queryProxies.erase( itProxies );
 			}
 
 			bodies.erase( bodies.begin() + index );
@@ -102,6 +150,92 @@ void CBox2DScene::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
 	}
 }
 
+/*
+==================
+CBox2DScene::RemoveAllBodies
+==================
+*/
+void CBox2DScene::RemoveAllBodies()
+{
+	for ( auto it = queryProxies.begin(), itEnd = queryProxies.end(); it != itEnd; ++it )
+	{
+		DestroyQueryProxies( it->second );
+	}
+
+	queryProxies.clear();
+	bodies.clear();
+}
+
+/*
+==================
+CBox2DScene::DestroyQueryProxies
+==================
+*/
+void CBox2DScene::DestroyQueryProxies( const std::vector< QueryProxy >& InProxies )
+{
+	for ( uint32 index = 0, count = InProxies.size(); index < count; ++index )
+	{
+		const QueryProxy&	proxy = InProxies[ index ];
+		queryTrees[ proxy.collisionChannel ].DestroyProxy( proxy.proxyId );
+	}
+}
+
+/*
+==================
+CBox2DScene::UpdateQueryProxies
+==================
+*/
+void CBox2DScene::UpdateQueryProxies( float InDeltaTime )
+{
+	for ( auto it = queryProxies.begin(), itEnd = queryProxies.end(); it != itEnd; ++it )
+	{
+		std::vector< QueryProxy >&	proxies = it->second;
+		if ( proxies.empty() )
+		{
+			continue;
+		}
+
+		// Static and sleeping bodies don't move
+		b2Body*		bx2Body = proxies[ 0 ].bx2Fixture->GetBody();
+		if ( bx2Body->GetType() == b2_staticBody || !bx2Body->IsAwake() )
+		{
+			continue;
+		}
+
+		// The tree reinserts a proxy only when it leaves its enlarged bounds, the displacement predicts the direction of moving
+		const b2Transform&	bx2Transform	= bx2Body->GetTransform();
+		const b2Vec2		bx2Displacement = InDeltaTime * bx2Body->GetLinearVelocity();
+		for ( uint32 index = 0, count = proxies.size(); index < count; ++index )
+		{
+			QueryProxy&		proxy = proxies[ index ];
+			b2AABB			bx2AABB;
+			proxy.bx2Fixture->GetShape()->ComputeAABB( &bx2AABB, bx2Transform, proxy.childIndex );
+			queryTrees[ proxy.collisionChannel ].MoveProxy( proxy.proxyId, bx2AABB, bx2Displacement );
+		}
+	}
+}
+
+/*
+==================
+CBox2DScene::FillHitResult
+==================
+*/
+void CBox2DScene::FillHitResult( HitResult& OutHitResult, const QueryProxy* InProxy, const b2Vec2& InNormal, const b2Vec2& InPoint, const CollisionQueryParams& InCollisionQueryParams ) const
+{
+	OutHitResult.component		= InProxy->bodyInstance->GetOwnerComponent();
+	OutHitResult.actor			= OutHitResult.component->GetOwner();
+	OutHitResult.impactNormal	= Vector( B2LEVector( InNormal ), 0.f );
+	OutHitResult.impactPoint	= Vector( B2LEVector( InPoint ) * BOX2D_SCALE, 0.f );
+
+	// If need return physics material
+	if ( InCollisionQueryParams.bReturnPhysicalMaterial )
+	{
+		PhysicsShapeHandleBox2D*		shapeHandle = ( PhysicsShapeHandleBox2D* )InProxy->bx2Fixture->GetUserData().pointer;
+		Assert( shapeHandle );
+		OutHitResult.physMaterial	= shapeHandle->physMaterial.ToSharedPtr();
+	}
+}
+
 /*
 ==================
 CBox2DScene::LineTraceSingleByChannel
@@ -109,41 +243,230 @@ CBox2DScene::LineTraceSingleByChannel
 */
 bool CBox2DScene::LineTraceSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
 {
+	// The Box2D world mustn't be queried while it's stepped
+	g_PhysicsEngine.WaitForSimulation();
+
 	// Ray cast input
 	b2RayCastInput				bx2RayCastInput;
 	bx2RayCastInput.p1			= LE2BVector( ( Vector2D )InStart / BOX2D_SCALE );
 	bx2RayCastInput.p2			= LE2BVector( ( Vector2D )InEnd / BOX2D_SCALE );
 	bx2RayCastInput.maxFraction = 1;
 
-	// Check every fixture of every collision channel to find closet
-	const std::unordered_map< CPhysicsBodyInstance*, std::vector< b2Fixture* > >&		fixturesOnCollisionChannel = fixturesMap[ InTraceChannel ];
-	for ( auto it = fixturesOnCollisionChannel.begin(), itEnd = fixturesOnCollisionChannel.end(); it != itEnd; ++it )
+	// Ray cast fixtures which bounds are crossed by the ray, each hit clips the ray, so the closest one is left at the end
+	struct RayCastQuery
+	{
+		float RayCastCallback( const b2RayCastInput& InInput, int32 InProxyId )
+		{
+			const QueryProxy*	proxy = ( const QueryProxy* )tree->GetUserData( InProxyId );
+			b2RayCastOutput		bx2RayCastOutput;
+			if ( !proxy->bx2Fixture->RayCast( &bx2RayCastOutput, InInput, proxy->childIndex ) )
+			{
+				return InInput.maxFraction;
+			}
+
+			hitProxy	= proxy;
+			output		= bx2RayCastOutput;
+			return bx2RayCastOutput.fraction;
+		}
+
+		const b2DynamicTree*	tree;
+		const QueryProxy*		hitProxy;
+		b2RayCastOutput			output;
+	};
+
+	RayCastQuery		callback;
+	callback.tree		= &queryTrees[ InTraceChannel ];
+	callback.hitProxy	= nullptr;
+	callback.tree->RayCast( &callback, bx2RayCastInput );
+	if ( !callback.hitProxy )
+	{
+		return false;
+	}
+
+	FillHitResult( OutHitResult, callback.hitProxy, callback.output.normal, bx2RayCastInput.p1 + callback.output.fraction * ( bx2RayCastInput.p2 - bx2RayCastInput.p1 ), InCollisionQueryParams );
+	return true;
+}
+
+/*
+==================
+CBox2DScene::SweepSingleByChannel
+==================
+*/
+bool CBox2DScene::SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	// The Box2D world mustn't be queried while it's stepped
+	g_PhysicsEngine.WaitForSimulation();
+
+	b2PolygonShape		bx2Box;
+	b2Transform			bx2StartTransform( LE2BVector( ( Vector2D )InStart / BOX2D_SCALE ), b2Rot( 0.f ) );
+	b2Vec2				bx2Translation = LE2BVector( ( Vector2D )InEnd / BOX2D_SCALE ) - bx2StartTransform.p;
+	bx2Box.SetAsBox( InBoxExtent.x / BOX2D_SCALE, InBoxExtent.y / BOX2D_SCALE );
+
+	// Bounds of the whole sweep
+	b2AABB		bx2SweepAABB;
+	bx2Box.ComputeAABB( &bx2SweepAABB, bx2StartTransform, 0 );
+	bx2SweepAABB.lowerBound = b2Min( bx2SweepAABB.lowerBound, bx2SweepAABB.lowerBound + bx2Translation );
+	bx2SweepAABB.upperBound = b2Max( bx2SweepAABB.upperBound, bx2SweepAABB.upperBound + bx2Translation );
+
+	// Cast the box against fixtures which bounds are touched by the sweep and take the closest hit
+	struct SweepQuery
+	{
+		bool QueryCallback( int32 InProxyId )
+		{
+			const QueryProxy*	proxy = ( const QueryProxy* )tree->GetUserData( InProxyId );
+			b2ShapeCastInput	bx2ShapeCastInput;
+			b2ShapeCastOutput	bx2ShapeCastOutput;
+			bx2ShapeCastInput.proxyA.Set( proxy->bx2Fixture->GetShape(), proxy->childIndex );
+			bx2ShapeCastInput.proxyB.Set( box, 0 );
+			bx2ShapeCastInput.transformA	= proxy->bx2Fixture->GetBody()->GetTransform();
+			bx2ShapeCastInput.transformB	= startTransform;
+			bx2ShapeCastInput.translationB	= translation;
+			if ( b2ShapeCast( &bx2ShapeCastOutput, &bx2ShapeCastInput ) && ( !hitProxy || bx2ShapeCastOutput.lambda < output.lambda ) )
+			{
+				hitProxy	= proxy;
+				output		= bx2ShapeCastOutput;
+			}
+			return true;
+		}
+
+		const b2DynamicTree*	tree;
+		const b2PolygonShape*	box;
+		b2Transform				startTransform;
+		b2Vec2					translation;
+		const QueryProxy*		hitProxy;
+		b2ShapeCastOutput		output;
+	};
+
+	SweepQuery			callback;
+	callback.tree			= &queryTrees[ InTraceChannel ];
+	callback.box			= &bx2Box;
+	callback.startTransform	= bx2StartTransform;
+	callback.translation	= bx2Translation;
+	callback.hitProxy		= nullptr;
+	callback.tree->Query( &callback, bx2SweepAABB );
+	if ( !callback.hitProxy )
+	{
+		return false;
+	}
+
+	FillHitResult( OutHitResult, callback.hitProxy, callback.output.normal, callback.output.point, InCollisionQueryParams );
+	return true;
+}
+
+/*
+==================
+CBox2DScene::OverlapMultiByChannel
+==================
+*/
+bool CBox2DScene::OverlapMultiByChannel( std::vector<HitResult>& OutOverlaps, const Vector& InLocation, const Vector& InBoxExtent, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	// The Box2D world mustn't be queried while it's stepped
+	g_PhysicsEngine.WaitForSimulation();
+
+	b2PolygonShape		bx2Box;
+	b2Transform			bx2Transform( LE2BVector( ( Vector2D )InLocation / BOX2D_SCALE ), b2Rot( 0.f ) );
+	b2AABB				bx2AABB;
+	bx2Box.SetAsBox( InBoxExtent.x / BOX2D_SCALE, InBoxExtent.y / BOX2D_SCALE );
+	bx2Box.ComputeAABB( &bx2AABB, bx2Transform, 0 );
+
+	// Test the box against fixtures which bounds are touched by it
+	struct OverlapQuery
 	{
-		for ( uint32 index = 0, count = it->second.size(); index < count; ++index )
+		bool QueryCallback( int32 InProxyId )
 		{
-			b2RayCastOutput			bx2RayCastOutput;
-			b2Fixture*				bx2Fixture = it->second[ index ];
-			if ( bx2Fixture->RayCast( &bx2RayCastOutput, bx2RayCastInput, 0 ) )
+			const QueryProxy*	proxy = ( const QueryProxy* )tree->GetUserData( InProxyId );
+			if ( b2TestOverlap( proxy->bx2Fixture->GetShape(), proxy->childIndex, box, 0, proxy->bx2Fixture->GetBody()->GetTransform(), transform ) )
 			{
-				// Fill hit result
-				OutHitResult.component		= it->first->GetOwnerComponent();
-				OutHitResult.actor			= OutHitResult.component->GetOwner();
-				OutHitResult.impactNormal	= Vector( B2LEVector( bx2RayCastOutput.normal ), 0.f );
-				OutHitResult.impactPoint	= Vector( B2LEVector( bx2RayCastInput.p1 + bx2RayCastOutput.fraction * ( bx2RayCastInput.p2 - bx2RayCastInput.p1 ) ) * BOX2D_SCALE, 0.f );
-
-				// If need return physics material
-				if ( InCollisionQueryParams.bReturnPhysicalMaterial )
-				{
-					PhysicsShapeHandleBox2D*		shapeHandle = ( PhysicsShapeHandleBox2D* )bx2Fixture->GetUserData().pointer;
-					Assert( shapeHandle );
-					OutHitResult.physMaterial	= shapeHandle->physMaterial.ToSharedPtr();
-				}
-
-				return true;
+				overlapProxies.push_back( proxy );
 			}
+			return true;
+		}
+
+		const b2DynamicTree*				tree;
+		const b2PolygonShape*				box;
+		b2Transform							transform;
+		std::vector< const QueryProxy* >	overlapProxies;
+	};
+
+	OverlapQuery		callback;
+	callback.tree		= &queryTrees[ InTraceChannel ];
+	callback.box		= &bx2Box;
+	callback.transform	= bx2Transform;
+	callback.tree->Query( &callback, bx2AABB );
+
+	// A body is reported once even if several its fixtures are overlapped
+	const uint32	firstOverlap = OutOverlaps.size();
+	for ( uint32 index = 0, count = callback.overlapProxies.size(); index < count; ++index )
+	{
+		const QueryProxy*	proxy = callback.overlapProxies[ index ];
+		bool				bAlreadyAdded = false;
+		for ( uint32 overlapIndex = firstOverlap, numOverlaps = OutOverlaps.size(); overlapIndex < numOverlaps && !bAlreadyAdded; ++overlapIndex )
+		{
+			bAlreadyAdded = OutOverlaps[ overlapIndex ].component == proxy->bodyInstance->GetOwnerComponent();
+		}
+
+		if ( !bAlreadyAdded )
+		{
+			OutOverlaps.push_back( HitResult() );
+			FillHitResult( OutOverlaps.back(), proxy, b2Vec2( 0.f, 0.f ), proxy->bx2Fixture->GetBody()->GetPosition(), InCollisionQueryParams );
 		}
 	}
 
-	return false;
+	return OutOverlaps.size() > firstOverlap;
+}
+
+/*
+==================
+CBox2DScene::ExecuteQuery
+==================
+*/
+void CBox2DScene::ExecuteQuery( SceneQuery& InOutQuery )
+{
+	switch ( InOutQuery.type )
+	{
+	case SQT_LineTrace:
+		InOutQuery.bHit = LineTraceSingleByChannel( InOutQuery.hitResult, InOutQuery.start, InOutQuery.end, InOutQuery.traceChannel, InOutQuery.queryParams );
+		break;
+
+	case SQT_Sweep:
+		InOutQuery.bHit = SweepSingleByChannel( InOutQuery.hitResult, InOutQuery.start, InOutQuery.end, InOutQuery.boxExtent, InOutQuery.traceChannel, InOutQuery.queryParams );
+		break;
+
+	case SQT_Overlap:
+	{
+		std::vector<HitResult>		overlaps;
+		InOutQuery.bHit = OverlapMultiByChannel( overlaps, InOutQuery.start, InOutQuery.boxExtent, InOutQuery.traceChannel, InOutQuery.queryParams );
+		if ( InOutQuery.bHit )
+		{
+			InOutQuery.hitResult = overlaps[ 0 ];
+		}
+		break;
+	}
+
+	default:
+		AssertMsg( false, TEXT( "Unknown scene query type %i" ), InOutQuery.type );
+		InOutQuery.bHit = false;
+		break;
+	}
+}
+
+/*
+==================
+CBox2DScene::ExecuteQueryBatch
+==================
+*/
+void CBox2DScene::ExecuteQueryBatch( std::vector<SceneQuery>& InOutQueries )
+{
+	SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "ExecuteQueryBatch" ) );
+
+	// Wait for the simulation once for the whole batch, after that queries only read the trees
+	g_PhysicsEngine.WaitForSimulation();
+
+	// Small batches are cheaper to execute on the calling thread than to hand out to workers
+	const uint32	numQueries = InOutQueries.size();
+	CThreadPool::Get().ParallelFor( numQueries, [&]( uint32 InIndex )
+									{
+										ExecuteQuery( InOutQueries[ InIndex ] );
+									}, BOX2D_QUERY_BATCH_SIZE, numQueries < BOX2D_MIN_PARALLEL_QUERIES );
 }
 #endif // WITH_BOX2D
\ No newline at end of file
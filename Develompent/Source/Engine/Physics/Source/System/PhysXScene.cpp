@@ -54,6 +54,19 @@ void CPhysXScene::Tick( float InDeltaTime )
 	pxScene->fetchResults( true );
 }
 
+/*
+==================
+CPhysXScene::SavePreviousTransforms
+==================
+*/
+void CPhysXScene::SavePreviousTransforms()
+{
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		bodies[ index ]->SavePreviousTransform();
+	}
+}
+
 /*
 ==================
 CPhysXScene::Shutdown
@@ -35,6 +35,8 @@ CPhysicsBodyInstance::InitBody
 */
 void CPhysicsBodyInstance::InitBody( CPhysicsBodySetup* InBodySetup, const CTransform& InTransform, CPrimitiveComponent* InPrimComp )
 {
+	// Bodies can't be created while the simulation is running
+	g_PhysicsEngine.WaitForSimulation();
 	bDirty = false;
 
 	// If body is inited - terminate body for reinit
@@ -44,8 +46,9 @@ void CPhysicsBodyInstance::InitBody( CPhysicsBodySetup* InBodySetup, const CTran
 	}
 
 	Assert( InBodySetup );
-	ownerComponent	= InPrimComp;
-	bodySetup		= InBodySetup;
+	ownerComponent		= InPrimComp;
+	bodySetup			= InBodySetup;
+	previousTransform	= InTransform;
 
 	ActorCreationParams	params;
 	params.bStatic			= bStatic;
@@ -91,6 +94,7 @@ void CPhysicsBodyInstance::TermBody()
 	}
 
 	// Remove from scene
+	g_PhysicsEngine.WaitForSimulation();
 	g_PhysicsScene.RemoveBody( this );
 
 	// Release resource
@@ -98,4 +102,33 @@ void CPhysicsBodyInstance::TermBody()
 	ownerComponent = nullptr;
 	bodySetup = nullptr;
 	bDirty = false;
+}
+
+/*
+==================
+CPhysicsBodyInstance::GetInterpolatedLEWorldTransform
+==================
+*/
+CTransform CPhysicsBodyInstance::GetInterpolatedLEWorldTransform( float InAlpha ) const
+{
+	CTransform		transform = GetLEWorldTransform();
+	if ( !bStatic && InAlpha < 1.f )
+	{
+		transform.Blend( previousTransform, transform, InAlpha );
+	}
+	return transform;
+}
+
+/*
+==================
+CPhysicsBodyInstance::SavePreviousTransform
+==================
+*/
+void CPhysicsBodyInstance::SavePreviousTransform()
+{
+	// It's called by the simulation itself, so we mustn't wait for it
+	if ( !bStatic )
+	{
+		previousTransform = CPhysicsInterface::GetTransform( handle );
+	}
 }
\ No newline at end of file
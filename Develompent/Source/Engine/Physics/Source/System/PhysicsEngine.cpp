@@ -4,8 +4,15 @@
 #include "System/Config.h"
 #include "System/PhysicsEngine.h"
 #include "System/Package.h"
+#include "System/Profiler.h"
 #include "PhysicsInterface.h"
 
+/* Default number of steps of the simulation per second */
+#define PHYSICS_DEFAULT_STEP_RATE		60
+
+/* Default max number of steps of the simulation per frame */
+#define PHYSICS_DEFAULT_MAX_SUBSTEPS	4
+
 /*
 ==================
 TextToECollisionChannel
@@ -61,6 +68,16 @@ CPhysicsEngine::CPhysicsEngine
 ==================
 */
 CPhysicsEngine::CPhysicsEngine()
+	: bAsyncSimulation( false )
+	, bDeferredResults( false )
+	, bSimulating( false )
+	, numPendingSteps( 0 )
+	, pendingStepTime( 0.f )
+	, pendingInterpolationAlpha( 1.f )
+	, fixedTimeStep( 1.f / PHYSICS_DEFAULT_STEP_RATE )
+	, maxSubsteps( PHYSICS_DEFAULT_MAX_SUBSTEPS )
+	, accumulatedTime( 0.f )
+	, interpolationAlpha( 1.f )
 {}
 
 /*
@@ -86,6 +103,33 @@ void CPhysicsEngine::Init()
 	// Init physics scene
 	g_PhysicsScene.Init();
 
+	// Load settings of the fixed time step. Step rate 0 means the simulation is stepped by time of frames
+	{
+		const CJsonValue*		configStepRate = CConfig::Get().GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "StepRate" ) );
+		const CJsonValue*		configMaxSubsteps = CConfig::Get().GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "MaxSubsteps" ) );
+		if ( configStepRate )
+		{
+			float	stepRate = configStepRate->GetNumber();
+			fixedTimeStep = stepRate > 0.f ? 1.f / stepRate : 0.f;
+		}
+
+		if ( configMaxSubsteps )
+		{
+			maxSubsteps = Max( configMaxSubsteps->GetInt( PHYSICS_DEFAULT_MAX_SUBSTEPS ), 1 );
+		}
+		accumulatedTime		= 0.f;
+		interpolationAlpha	= 1.f;
+	}
+
+	// Async simulation needs worker threads, without them the task would be run right away anyway
+	{
+		const CJsonValue*		configAsyncSimulation = CConfig::Get().GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "AsyncSimulation" ) );
+		bAsyncSimulation = configAsyncSimulation && configAsyncSimulation->GetBool() && CThreadPool::Get().GetNumThreads() > 0;
+
+		const CJsonValue*		configDeferredResults = CConfig::Get().GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "DeferredResults" ) );
+		bDeferredResults = configDeferredResults && configDeferredResults->GetBool();
+	}
+
 	// Load default physics material
 	{
 		// Loading default material from packages only when we in game
@@ -207,7 +251,127 @@ CPhysicsEngine::Tick
 */
 void CPhysicsEngine::Tick( float InDeltaTime )
 {
-	g_PhysicsScene.Tick( InDeltaTime );
+	BeginSimulation( InDeltaTime );
+	EndSimulation();
+}
+
+/*
+==================
+CPhysicsEngine::BeginSimulation
+==================
+*/
+void CPhysicsEngine::BeginSimulation( float InDeltaTime )
+{
+	Assert( IsInGameThread() && !bSimulating );
+	if ( fixedTimeStep <= 0.f )
+	{
+		numPendingSteps				= 1;
+		pendingStepTime				= InDeltaTime;
+		pendingInterpolationAlpha	= 1.f;
+	}
+	else
+	{
+		// Count whole steps which fit into the accumulated time. If the frame is too long, time beyond the max
+		// number of substeps is dropped, so the simulation slows down instead of stalling next frames even more
+		accumulatedTime += InDeltaTime;
+		numPendingSteps = ( uint32 )( accumulatedTime / fixedTimeStep );
+		if ( numPendingSteps > maxSubsteps )
+		{
+			numPendingSteps	= maxSubsteps;
+			accumulatedTime	= numPendingSteps * fixedTimeStep;
+		}
+
+		accumulatedTime				-= numPendingSteps * fixedTimeStep;
+		pendingStepTime				= fixedTimeStep;
+		pendingInterpolationAlpha	= Clamp( accumulatedTime / fixedTimeStep, 0.f, 1.f );
+	}
+
+	if ( numPendingSteps == 0 )
+	{
+		return;
+	}
+
+	bSimulating = true;
+	if ( bAsyncSimulation )
+	{
+		CThreadPool::Get().AddTask( &simulationTask );
+	}
+	else
+	{
+		StepSimulation();
+		bSimulating = false;
+	}
+}
+
+/*
+==================
+CPhysicsEngine::EndSimulation
+==================
+*/
+void CPhysicsEngine::EndSimulation()
+{
+	Assert( IsInGameThread() );
+	WaitForSimulation();
+
+	// Bodies are synced with the new interpolation alpha only after the simulation has moved them
+	interpolationAlpha = pendingInterpolationAlpha;
+}
+
+/*
+==================
+CPhysicsEngine::WaitForSimulation
+==================
+*/
+void CPhysicsEngine::WaitForSimulation()
+{
+	if ( !bSimulating )
+	{
+		return;
+	}
+
+	AssertMsg( IsInGameThread(), TEXT( "Physics can't be touched from other threads while the simulation is running" ) );
+	SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "WaitForSimulation" ) );
+
+	// If no worker has taken the task yet, it's faster to run the simulation here than to wait for a worker
+	if ( CThreadPool::Get().RetractTask( &simulationTask ) )
+	{
+		StepSimulation();
+	}
+	else
+	{
+		simulationTask.Wait();
+	}
+	bSimulating = false;
+}
+
+/*
+==================
+CPhysicsEngine::StepSimulation
+==================
+*/
+void CPhysicsEngine::StepSimulation()
+{
+	SCOPED_PROFILER( TEXT( "Physics" ), TEXT( "StepSimulation" ) );
+	for ( uint32 index = 0; index < numPendingSteps; ++index )
+	{
+		// Bodies are interpolated between the last two steps, so transforms are saved only before the last one
+		if ( fixedTimeStep > 0.f && index == numPendingSteps - 1 )
+		{
+			g_PhysicsScene.SavePreviousTransforms();
+		}
+
+		g_PhysicsScene.Tick( pendingStepTime );
+	}
+}
+
+/*
+==================
+CPhysicsEngine::CSimulationTask::DoWork
+==================
+*/
+void CPhysicsEngine::CSimulationTask::DoWork()
+{
+	g_PhysicsEngine.StepSimulation();
 }
 
 /*
@@ -217,6 +381,9 @@ CPhysicsEngine::Shutdown
 */
 void CPhysicsEngine::Shutdown()
 {
+	// The simulation mustn't run while the scene is destroyed
+	WaitForSimulation();
+
 	// Free allocated memory
 	g_PhysicsScene.Shutdown();
 	defaultPhysMaterial.Reset();
@@ -47,6 +47,11 @@ public:
      */
     virtual void Serialize( const tchar* InMessage, ELogType InLogType );
 
+    /**
+     * @brief Flush of output device
+     */
+    virtual void Flush() override;
+
     /**
      * @brief Closes output device and cleans up
      *
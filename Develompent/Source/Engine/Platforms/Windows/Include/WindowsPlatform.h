@@ -23,6 +23,7 @@
 #undef PLATFORM_USE__ALIGNED_MALLOC
 #undef PLATFORM_IS_STD_MALLOC_THREADSAFE
 #undef PLATFORM_SUPPORTS_MIMALLOC
+#undef PLATFORM_SUPPORTS_SSE
 #undef VARARGS
 #undef CDECL
 #undef STDCALL
@@ -50,6 +51,9 @@
 // If we on 64 bit platform then it is supports mimalloc
 #define PLATFORM_SUPPORTS_MIMALLOC                  PLATFORM_64BIT
 
+// All x86 and x64 processors which are supported by Windows have SSE
+#define PLATFORM_SUPPORTS_SSE                       1
+
 #if SHIPPING_BUILD && !PLATFORM_DOXYGEN
     #define Sys_IsDebuggerPresent()	                false
     #define Sys_DebugBreak()
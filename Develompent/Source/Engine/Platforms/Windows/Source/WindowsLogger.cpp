@@ -29,6 +29,23 @@ static const uint16 s_LogColors[] =
 	0x2				// LC_Green
 };
 
+/* Unhandled exception filter which was installed before ours */
+static LPTOP_LEVEL_EXCEPTION_FILTER		s_PrevUnhandledExceptionFilter = nullptr;
+
+/*
+==================
+LogUnhandledExceptionFilter
+==================
+*/
+static LONG WINAPI LogUnhandledExceptionFilter( EXCEPTION_POINTERS* InExceptionInfo )
+{
+	// Queued messages are lost when the process dies, so we write them before the crash handler runs.
+	// We don't log anything here, because the heap may be corrupted
+	g_Log->FlushAsync();
+	g_Log->Flush();
+	return s_PrevUnhandledExceptionFilter ? s_PrevUnhandledExceptionFilter( InExceptionInfo ) : EXCEPTION_CONTINUE_SEARCH;
+}
+
 /*
 ==================
 CWindowsLogger::CWindowsLogger
@@ -93,6 +110,8 @@ void CWindowsLogger::Init()
 		archiveLogs->SetType( AT_TextFile );
 		Logf( TEXT( "Opened log file '%s'\n" ), logFile.c_str() );
 	}
+
+	s_PrevUnhandledExceptionFilter = SetUnhandledExceptionFilter( LogUnhandledExceptionFilter );
 #endif // !NO_LOGGING
 }
 
@@ -103,6 +122,13 @@ CWindowsLogger::TearDown
 */
 void CWindowsLogger::TearDown()
 {
+#if !NO_LOGGING
+	SetUnhandledExceptionFilter( s_PrevUnhandledExceptionFilter );
+	s_PrevUnhandledExceptionFilter = nullptr;
+#endif // !NO_LOGGING
+
+	// Write all queued messages before the log file is closed
+	StopAsync();
 	Show( false );
 
 	if ( archiveLogs )
@@ -144,6 +170,19 @@ void CWindowsLogger::ResetTextColor()
 #endif // !NO_LOGGING
 }
 
+/*
+==================
+CWindowsLogger::Flush
+==================
+*/
+void CWindowsLogger::Flush()
+{
+	if ( archiveLogs )
+	{
+		archiveLogs->Flush();
+	}
+}
+
 /*
 ==================
 CWindowsLogger::Serialize
@@ -186,11 +225,14 @@ void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType )
 	}
 #endif // WITH_EDITOR
 
-	// Serialize log to file
+	// Serialize log to file. In asynchronous mode the log thread flushes it once per batch of messages
 	if ( archiveLogs )
 	{
 		*archiveLogs << TCHAR_TO_ANSI( finalMessage.c_str() );
-		archiveLogs->Flush();
+		if ( !IsAsync() )
+		{
+			archiveLogs->Flush();
+		}
 	}
 
 	// Print message to debug output
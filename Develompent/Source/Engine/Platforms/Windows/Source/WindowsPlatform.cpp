@@ -302,6 +302,23 @@ std::wstring Sys_GetUserName()
 	return result;
 }
 
+/*
+==================
+Sys_GetNumberOfCores
+==================
+*/
+uint32 Sys_GetNumberOfCores()
+{
+	static uint32	numberOfCores = 0;
+	if ( !numberOfCores )
+	{
+		SYSTEM_INFO		systemInfo;
+		GetSystemInfo( &systemInfo );
+		numberOfCores = Max<uint32>( systemInfo.dwNumberOfProcessors, 1 );
+	}
+	return numberOfCores;
+}
+
 /*
 ==================
 Sys_SetClipboardText
@@ -369,6 +386,18 @@ double Sys_Seconds()
 	return cycles.QuadPart * g_SecondsPerCycle + 16777216.0;
 }
 
+/*
+==================
+Sys_Cycles
+==================
+*/
+uint64 Sys_Cycles()
+{
+	LARGE_INTEGER		cycles;
+	QueryPerformanceCounter( &cycles );
+	return cycles.QuadPart;
+}
+
 #if WITH_EDITOR
 #include <commdlg.h>
 #include "Windows/FileDialog.h"
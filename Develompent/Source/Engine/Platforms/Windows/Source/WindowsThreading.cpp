@@ -2,6 +2,7 @@
 #include "System/Threading.h"
 #include "WindowsThreading.h"
 #include "Misc/StringConv.h"
+#include "System/Profiler.h"
 
 /**
  * Code setting the thread name for use in the debugger.
@@ -215,6 +216,7 @@ bool CWindowsRunnableThread::CreateInternal( CRunnable* InRunnable, const tchar*
 		// Let the thread start up, then set the name for debug purposes
 		threadInitSyncEvent->Wait( INFINITE );
 		SetThreadName( handle, InThreadName ? TCHAR_TO_ANSI( InThreadName ) : "Unnamed LE" );
+		PROFILER_THREAD_NAME( threadID, InThreadName ? InThreadName : TEXT( "Unnamed LE" ) );
 	}
 
 	// Cleanup the sync event
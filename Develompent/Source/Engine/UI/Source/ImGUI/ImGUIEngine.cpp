@@ -16,6 +16,7 @@
 #include "ImGUI/ImGuizmo.h"
 #include "Misc/UIGlobals.h"
 #include "System/Cvar.h"
+#include "System/Profiler.h"
 
 #if !SHIPPING_BUILD
 /**
@@ -818,6 +819,66 @@ void CImGUIEngine::CloseWindow( ImGuiViewport* InViewport )
 	}
 }
 
+#if ENABLE_PROFILER
+/*
+==================
+DrawProfilerNode
+==================
+*/
+static void DrawProfilerNode( const CProfiler::ThreadStats& InThreadStats, uint32 InNodeIndex )
+{
+	for ( uint32 nodeIndex = InNodeIndex; nodeIndex != INDEX_NONE; nodeIndex = InThreadStats.nodes[nodeIndex].nextSibling )
+	{
+		const CProfiler::Node&		node = InThreadStats.nodes[nodeIndex];
+		ImGui::PushID( nodeIndex );
+		bool	bOpened = ImGui::TreeNodeEx( "##Node", node.firstChild != INDEX_NONE ? ImGuiTreeNodeFlags_DefaultOpen : ImGuiTreeNodeFlags_Leaf, "%s  %.3f ms  (%u)", TCHAR_TO_ANSI( node.stat->name ), node.time, node.numCalls );
+		if ( bOpened )
+		{
+			if ( node.firstChild != INDEX_NONE )
+			{
+				DrawProfilerNode( InThreadStats, node.firstChild );
+			}
+			ImGui::TreePop();
+		}
+		ImGui::PopID();
+	}
+}
+
+/*
+==================
+DrawProfilerWindow
+==================
+*/
+static void DrawProfilerWindow()
+{
+	CProfiler::FrameStats	frameStats;
+	CProfiler::Get().GetLastFrameStats( frameStats );
+	if ( ImGui::Begin( "Profiler" ) )
+	{
+		ImGui::Text( "Frame: %.3f ms", frameStats.frameTime );
+		if ( ImGui::CollapsingHeader( "Groups", ImGuiTreeNodeFlags_DefaultOpen ) )
+		{
+			for ( uint32 index = 0, count = frameStats.groups.size(); index < count; ++index )
+			{
+				ImGui::Text( "%s: %.3f ms", TCHAR_TO_ANSI( frameStats.groups[index].group ), frameStats.groups[index].time );
+			}
+		}
+
+		for ( uint32 index = 0, count = frameStats.threads.size(); index < count; ++index )
+		{
+			const CProfiler::ThreadStats&		threadStats = frameStats.threads[index];
+			ImGui::PushID( threadStats.threadId );
+			if ( ImGui::CollapsingHeader( TCHAR_TO_ANSI( threadStats.threadName.c_str() ), ImGuiTreeNodeFlags_DefaultOpen ) && threadStats.nodes[0].firstChild != INDEX_NONE )
+			{
+				DrawProfilerNode( threadStats, threadStats.nodes[0].firstChild );
+			}
+			ImGui::PopID();
+		}
+	}
+	ImGui::End();
+}
+#endif // ENABLE_PROFILER
+
 /*
 ==================
 CImGUIEngine::EndDraw
@@ -840,6 +901,14 @@ void CImGUIEngine::EndDraw()
 	}
 #endif // !SHIPPING_BUILD
 
+	// Draw stats of the CPU profiler if it need
+#if ENABLE_PROFILER
+	if ( CProfiler::Get().IsShowStats() )
+	{
+		DrawProfilerWindow();
+	}
+#endif // ENABLE_PROFILER
+
 	ImGui::Render();
 	Sys_ImGUIEndDrawing();
 
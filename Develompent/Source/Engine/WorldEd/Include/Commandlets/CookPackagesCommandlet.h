@@ -9,11 +9,32 @@
 #ifndef COOKPACKAGESCOMMANDLET_H
 #define COOKPACKAGESCOMMANDLET_H
 
+#include <vector>
+#include <unordered_map>
+
+#include "Misc/Guid.h"
 #include "Commandlets/BaseCommandlet.h"
 
+/**
+ * @ingroup WorldEd
+ * Version of the cook manifest file. Increase it when the cooking output changes, so the next cook will be full
+ */
+#define COOK_MANIFEST_VERSION		2
+
  /**
   * @ingroup WorldEd
   * @brief Commandlet for cooking packages
+  *
+  * Cooks asset packages (*.pak) and object packages (maps, classes) from content directories into the cooked directory
+  * of the platform and writes the table of contents. The cook is incremental: the manifest of the last cook stores
+  * content hashes and dependencies of packages, and packages whose content and dependencies have not changed are skipped.
+  * Asset packages are cooked on worker threads of the thread pool. If the target platform selects a codec for an asset type
+  * (see 'Compression' in section 'Editor.CookPackages' of the editor config), packages with such assets are saved again
+  * on the game thread to recompress their bulk data. Cooked packages keep their path relative to the base directory
+  * (e.g. Engine/Content/..., Game/Content/...).
+  *
+  * Usage: -commandlet=CookPackages [-full]
+  *	-full	Ignore the manifest of the last cook and cook all packages
   */
 class CCookPackagesCommandlet : public CBaseCommandlet
 {
@@ -27,6 +48,127 @@ public:
 	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
 	 */
 	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * @brief Package to cook
+	 */
+	struct CookPackage
+	{
+		/**
+		 * @brief Constructor
+		 */
+		CookPackage()
+			: bIsAssetPackage( false )
+			, bIsDirty( false )
+			, bIsFailed( false )
+			, bIsNeedRecompress( false )
+			, contentHash( 0 )
+		{}
+
+		std::wstring				sourcePath;			/**< Path to the source package */
+		std::wstring				cookedPath;			/**< Path to the cooked package */
+		bool						bIsAssetPackage;	/**< Is asset package (*.pak), otherwise it's object package */
+		bool						bIsDirty;			/**< Is the package need to be cooked */
+		bool						bIsFailed;			/**< Is cooking of the package failed */
+		bool						bIsNeedRecompress;	/**< Is asset package has assets which bulk data need to be recompressed with codec of the target platform */
+		uint64						contentHash;		/**< Hash of the source package content and settings of the cook */
+		CGuid						guid;				/**< GUID of asset package */
+		std::wstring				name;				/**< Name of asset package */
+		std::wstring				error;				/**< Error message */
+		std::vector<std::wstring>	dependencies;		/**< Source paths of packages this package depends on */
+	};
+
+	/**
+	 * @brief Entry of the cook manifest
+	 */
+	struct CookManifestEntry
+	{
+		uint64						contentHash;	/**< Hash of the source package content and settings of the cook at the time of cook */
+		std::wstring				cookedPath;		/**< Path to the cooked package */
+		std::vector<std::wstring>	dependencies;	/**< Source paths of packages the package depended on */
+	};
+
+	/**
+	 * @brief Typedef of cook manifest. Key is source path of the package
+	 */
+	typedef std::unordered_map<std::wstring, CookManifestEntry>		CookManifest_t;
+
+	/**
+	 * @brief Collect all source packages in content directories
+	 */
+	void CollectPackages();
+
+	/**
+	 * @brief Calculate hash of settings which change the cooking output
+	 * Includes version of packages, CookEditorContent and codecs of the target platform
+	 * @return Return hash of the cook settings
+	 */
+	uint64 HashCookSettings() const;
+
+	/**
+	 * @brief Calculate content hashes of all packages and read headers of asset packages
+	 * Executed on worker threads of the thread pool
+	 */
+	void HashPackages();
+
+	/**
+	 * @brief Resolve which packages need to be cooked
+	 * A package is dirty if its content has changed, it has never been cooked or any of its dependencies is dirty.
+	 * Dirty state is propagated until nothing changes, so cycles of dependencies are resolved too
+	 */
+	void ResolveDirtyPackages();
+
+	/**
+	 * @brief Cook asset package
+	 * Thread safe, it doesn't touch the package manager. Assets are copied as is, only editor assets are stripped
+	 *
+	 * @param InOutPackage	Package to cook
+	 */
+	void CookAssetPackage( CookPackage& InOutPackage ) const;
+
+	/**
+	 * @brief Collect dependencies of asset package
+	 * Must be called from the game thread because it loads the package through the package manager
+	 *
+	 * @param InOutPackage	Package
+	 */
+	void CollectAssetPackageDependencies( CookPackage& InOutPackage ) const;
+
+	/**
+	 * @brief Recompress bulk data of asset package with codecs selected by the target platform per asset type
+	 * Must be called from the game thread because it loads the package through the package manager
+	 *
+	 * @param InOutPackage	Package
+	 */
+	void RecompressAssetPackage( CookPackage& InOutPackage ) const;
+
+	/**
+	 * @brief Cook object package and collect its dependencies
+	 * Must be called from the game thread because it loads the package through the object system
+	 *
+	 * @param InOutPackage	Package to cook
+	 */
+	void CookObjectPackage( CookPackage& InOutPackage ) const;
+
+	/**
+	 * @brief Serialize the cook manifest
+	 *
+	 * @param InIsSave		Is need to save the manifest, otherwise it will be loaded
+	 * @return Return TRUE if the manifest was serialized, otherwise returns FALSE
+	 */
+	bool SerializeManifest( bool InIsSave );
+
+	/**
+	 * @brief Write table of contents of the cooked packages
+	 * @return Return TRUE if the table of contents was written, otherwise returns FALSE
+	 */
+	bool WriteTOC() const;
+
+	std::vector<CookPackage>						packages;		/**< Packages to cook */
+	std::unordered_map<std::wstring, uint32>		packageIndices;	/**< Map of source path to index of package */
+	CookManifest_t									manifest;		/**< Manifest of the last cook */
+	uint64											settingsHash;	/**< Hash of the cook settings, see HashCookSettings */
 };
 
-#endif // !COOKPACKAGESCOMMANDLET_H
\ No newline at end of file
+#endif // !COOKPACKAGESCOMMANDLET_H
@@ -10,6 +10,7 @@
 #define WINDOWSTARGETPLATFORM_H
 
 #include "System/BaseTargetPlatform.h"
+#include "System/Package.h"
 
  /**
   * @ingroup WorldEd
@@ -18,6 +19,12 @@
 class CWindowsTargetPlatform : public CBaseTargetPlatform
 {
 public:
+	/**
+	 * @brief Constructor
+	 * Reads codecs from section 'Editor.CookPackages' of the editor config
+	 */
+	CWindowsTargetPlatform();
+
 	/**
 	 * @brief Get singleton instance
 	 * @return Return singleton instance
@@ -27,6 +34,24 @@ public:
 		static CWindowsTargetPlatform	s_WindowsTargetPlatform;
 		return s_WindowsTargetPlatform;
 	}
+
+	/**
+	 * @brief Get compression flags for bulk data of assets
+	 *
+	 * @param InAssetType	Asset type (see EAssetType)
+	 * @return Return compression flags for bulk data of the asset type. If CF_None, bulk data keeps own compression flags
+	 */
+	virtual ECompressionFlags GetAssetCompressionFlags( uint32 InAssetType ) const override;
+
+	/**
+	 * @brief Get compression flags for object packages (maps, classes)
+	 * @return Return compression flags for object packages
+	 */
+	virtual ECompressionFlags GetObjectPackageCompressionFlags() const override;
+
+private:
+	ECompressionFlags		assetCompressionFlags[AT_Count];	/**< Compression flags for bulk data of each asset type */
+	ECompressionFlags		objectPackageCompressionFlags;		/**< Compression flags for object packages */
 };
 
 #endif // !WINDOWSTARGETPLATFORM_H
\ No newline at end of file
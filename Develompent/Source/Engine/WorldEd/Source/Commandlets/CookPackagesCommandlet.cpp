@@ -1,9 +1,118 @@
+#include <unordered_set>
+
+#include "Logger/LoggerMacros.h"
+#include "Misc/FileTools.h"
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/TableOfContents.h"
 #include "Reflection/Class.h"
+#include "Reflection/ObjectPackage.h"
+#include "Reflection/LinkerLoad.h"
+#include "Reflection/ObjectGC.h"
+#include "Reflection/ObjectGlobals.h"
+#include "System/System.h"
+#include "System/ThreadPool.h"
+#include "System/PackageFileCache.h"
+#include "System/Package.h"
+#include "System/BaseFileSystem.h"
+#include "System/MemoryArchive.h"
+#include "System/World.h"
+#include "TargetPlatforms/WindowsTargetPlatform.h"
 #include "Commandlets/CookPackagesCommandlet.h"
 
 IMPLEMENT_CLASS( CCookPackagesCommandlet )
 IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CCookPackagesCommandlet )
 
+/** Collect garbage after was loaded N packages */
+#define COLLECT_GARBAGE_AFTER_LOADED_PACKAGES		30
+
+/** Name of the cook manifest file in the cooked directory */
+#define COOK_MANIFEST_FILENAME						TEXT( "CookManifest.bin" )
+
+/*
+==================
+ReadFileToBuffer
+==================
+*/
+static bool ReadFileToBuffer( const std::wstring& InPath, std::vector<byte>& OutData )
+{
+	CArchive*	archive = g_FileSystem->CreateFileReader( InPath );
+	if ( !archive )
+	{
+		return false;
+	}
+
+	OutData.resize( archive->GetSize() );
+	if ( !OutData.empty() )
+	{
+		archive->Serialize( OutData.data(), OutData.size() );
+	}
+	delete archive;
+	return true;
+}
+
+/*
+==================
+SerializeAssetPackageHeader
+==================
+*/
+static bool SerializeAssetPackageHeader( CArchive& InArchive, CGuid& InOutGuid, std::wstring& InOutName )
+{
+	// See CPackage::SerializeHeader
+	if ( InArchive.Ver() < VER_NamePackage )
+	{
+		return false;
+	}
+
+	uint32		packageFileTag = PACKAGE_FILE_TAG;
+	InArchive << packageFileTag;
+	if ( packageFileTag != PACKAGE_FILE_TAG )
+	{
+		return false;
+	}
+
+	InArchive << InOutGuid;
+	InArchive << InOutName;
+	return true;
+}
+
+/*
+==================
+IsEditorOnlyAsset
+==================
+*/
+static bool IsEditorOnlyAsset( std::vector<byte>& InAssetData, uint32 InVersion )
+{
+	if ( InVersion < VER_AssetOnlyEditor || InAssetData.empty() )
+	{
+		return false;
+	}
+
+	// Data of each asset begins with fields of CAsset, see CAsset::Serialize
+	CMemoryReading	reader( InAssetData );
+	std::wstring	name;
+	std::wstring	sourceFile;
+	CGuid			guid;
+	bool			bOnlyEditor = false;
+	reader.SetVer( InVersion );
+	reader.SetType( AT_Package );
+
+	reader << name;
+	if ( InVersion >= VER_GUIDAssets )
+	{
+		reader << guid;
+	}
+
+	if ( InVersion >= VER_AssetSourceFiles )
+	{
+		reader << sourceFile;
+	}
+
+	reader << bOnlyEditor;
+	return bOnlyEditor;
+}
+
 /*
 ==================
 CCookPackagesCommandlet::Main
@@ -11,8 +120,658 @@ CCookPackagesCommandlet::Main
 */
 bool CCookPackagesCommandlet::Main( const CCommandLine& InCommandLine )
 {
-	g_IsCooker = true;
-	g_IsCooker = false;
-	AssertMsg( false, TEXT( "Need implement" ) );
+	double		startTime		= Sys_Seconds();
+	bool		bIsFullCook		= InCommandLine.HasParam( TEXT( "full" ) );
+	Logf( TEXT( "Cooking packages to '%s'%s\n" ), g_CookedDir.c_str(), bIsFullCook ? TEXT( " (full cook)" ) : TEXT( "" ) );
+
+	// Create the target platform here, so worker threads don't race for reading its config.
+	// Settings of the cook are part of hashes of packages, so changing them cooks packages again
+	CWindowsTargetPlatform::Get();
+	settingsHash = HashCookSettings();
+
+	// Collect all source packages and calculate hashes of their content
+	CollectPackages();
+	HashPackages();
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		const CookPackage&		package = packages[index];
+		if ( package.bIsFailed )
+		{
+			Errorf( TEXT( "Failed to read package '%s': %s\n" ), package.sourcePath.c_str(), package.error.c_str() );
+		}
+	}
+
+	// Load the manifest of the last cook
+	manifest.clear();
+	if ( !bIsFullCook && !SerializeManifest( false ) )
+	{
+		Logf( TEXT( "Manifest of the last cook not found, all packages will be cooked\n" ) );
+	}
+
+	// Fill table of contents with source asset packages, so references between them are resolved while cooking
+	g_TableOfContents.Clear();
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		const CookPackage&		package = packages[index];
+		if ( package.bIsAssetPackage && !package.bIsFailed )
+		{
+			g_TableOfContents.AddEntry( package.guid, package.name, package.sourcePath );
+		}
+	}
+
+	// Find packages which need to be cooked
+	std::vector<uint32>		dirtyAssetPackages;
+	std::vector<uint32>		dirtyObjectPackages;
+	uint32					numUpToDate = 0;
+	ResolveDirtyPackages();
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		if ( packages[index].bIsFailed )
+		{
+			continue;
+		}
+
+		if ( !packages[index].bIsDirty )
+		{
+			++numUpToDate;
+		}
+		else if ( packages[index].bIsAssetPackage )
+		{
+			dirtyAssetPackages.push_back( index );
+		}
+		else
+		{
+			dirtyObjectPackages.push_back( index );
+		}
+	}
+	Logf( TEXT( "%i packages are up to date, %i asset packages and %i object packages need to be cooked\n" ), numUpToDate, dirtyAssetPackages.size(), dirtyObjectPackages.size() );
+
+	// Create output directories here, so worker threads don't race for them
+	for ( uint32 index = 0, count = dirtyAssetPackages.size(); index < count; ++index )
+	{
+		g_FileSystem->MakeDirectory( CFilename( packages[dirtyAssetPackages[index]].cookedPath ).GetPath(), true );
+	}
+
+	// Cook asset packages in parallel. They are copied without going through the package manager
+	CThreadPool::Get().ParallelFor( dirtyAssetPackages.size(), [&]( uint32 InIndex )
+									{
+										CookAssetPackage( packages[dirtyAssetPackages[InIndex]] );
+									} );
+
+	// Collect dependencies of cooked asset packages. Loading of assets must be done from the game thread
+	for ( uint32 index = 0, count = dirtyAssetPackages.size(); index < count; ++index )
+	{
+		CookPackage&	package = packages[dirtyAssetPackages[index]];
+		if ( package.bIsFailed )
+		{
+			Errorf( TEXT( "Failed to cook '%s': %s\n" ), package.sourcePath.c_str(), package.error.c_str() );
+			continue;
+		}
+
+		CollectAssetPackageDependencies( package );
+		if ( package.bIsNeedRecompress )
+		{
+			RecompressAssetPackage( package );
+			if ( package.bIsFailed )
+			{
+				Errorf( TEXT( "Failed to cook '%s': %s\n" ), package.sourcePath.c_str(), package.error.c_str() );
+				continue;
+			}
+		}
+		Logf( TEXT( "Cooked '%s'\n" ), package.sourcePath.c_str() );
+
+		if ( ( index + 1 ) % COLLECT_GARBAGE_AFTER_LOADED_PACKAGES == 0 )
+		{
+			g_PackageManager->GarbageCollector();
+		}
+	}
+
+	// Cook object packages. The object system isn't thread safe, so they are cooked on the game thread one by one
+	for ( uint32 index = 0, count = dirtyObjectPackages.size(); index < count; ++index )
+	{
+		CookPackage&	package = packages[dirtyObjectPackages[index]];
+		CookObjectPackage( package );
+		if ( package.bIsFailed )
+		{
+			Errorf( TEXT( "Failed to cook '%s': %s\n" ), package.sourcePath.c_str(), package.error.c_str() );
+		}
+		else
+		{
+			Logf( TEXT( "Cooked '%s'\n" ), package.sourcePath.c_str() );
+		}
+	}
+
+	// Delete cooked packages which sources were removed or which were cooked to another path since the last cook
+	for ( auto itEntry = manifest.begin(), itEntryEnd = manifest.end(); itEntry != itEntryEnd; ++itEntry )
+	{
+		auto	itPackageIndex = packageIndices.find( itEntry->first );
+		if ( itPackageIndex == packageIndices.end() && g_FileSystem->IsExistFile( itEntry->second.cookedPath ) )
+		{
+			Logf( TEXT( "Deleting '%s', source package was removed\n" ), itEntry->second.cookedPath.c_str() );
+			g_FileSystem->Delete( itEntry->second.cookedPath );
+		}
+		else if ( itPackageIndex != packageIndices.end() && itEntry->second.cookedPath != packages[itPackageIndex->second].cookedPath && g_FileSystem->IsExistFile( itEntry->second.cookedPath ) )
+		{
+			Logf( TEXT( "Deleting '%s', package was cooked to '%s'\n" ), itEntry->second.cookedPath.c_str(), packages[itPackageIndex->second].cookedPath.c_str() );
+			g_FileSystem->Delete( itEntry->second.cookedPath );
+		}
+	}
+
+	// Write a new manifest and table of contents. Failed packages are left out of the manifest, so they will be cooked next time
+	uint32		numFailed = 0;
+	uint32		numCooked = 0;
+	manifest.clear();
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		const CookPackage&		package = packages[index];
+		if ( package.bIsFailed )
+		{
+			++numFailed;
+			continue;
+		}
+
+		if ( package.bIsDirty )
+		{
+			++numCooked;
+		}
+
+		CookManifestEntry&		entry = manifest[package.sourcePath];
+		entry.contentHash	= package.contentHash;
+		entry.cookedPath	= package.cookedPath;
+		entry.dependencies	= package.dependencies;
+	}
+
+	bool	bResult = SerializeManifest( true ) && WriteTOC() && numFailed == 0;
+	Logf( TEXT( "Cooking finished in %.2f seconds: %i cooked, %i up to date, %i failed\n" ), Sys_Seconds() - startTime, numCooked, numUpToDate, numFailed );
+	return bResult;
+}
+
+/*
+==================
+CCookPackagesCommandlet::CollectPackages
+==================
+*/
+void CCookPackagesCommandlet::CollectPackages()
+{
+	packages.clear();
+	packageIndices.clear();
+
+	const std::vector<std::wstring>&	packagePaths = CSystem::Get().GetPackagePaths();
+	for ( uint32 pathIndex = 0, numPaths = packagePaths.size(); pathIndex < numPaths; ++pathIndex )
+	{
+		const std::wstring&			rootDir = packagePaths[pathIndex];
+		std::vector<std::wstring>	files;
+		g_FileSystem->FindFilesInDirectory( files, rootDir.c_str(), true, true );
+
+		for ( uint32 fileIndex = 0, numFiles = files.size(); fileIndex < numFiles; ++fileIndex )
+		{
+			const std::wstring&		file = files[fileIndex];
+			std::wstring			extension = CFilename( file ).GetExtension();
+			bool					bIsAssetPackage = !L_Stricmp( extension.c_str(), TEXT( "pak" ) );
+			if ( ( !bIsAssetPackage && !CSystem::Get().IsPackageExtension( extension ) ) || packageIndices.find( file ) != packageIndices.end() )
+			{
+				continue;
+			}
+
+			// Cooked package keeps the path relative to the base directory, so packages with the same path
+			// in different content directories (e.g. Engine/Content and Game/Content) don't overwrite each other
+			std::wstring	relativePath;
+			if ( !L_MakeRelativePath( file, Sys_BaseDir(), relativePath ) )
+			{
+				Warnf( TEXT( "Failed to make relative path for '%s', skipped\n" ), file.c_str() );
+				continue;
+			}
+
+			CookPackage		package;
+			package.sourcePath		= file;
+			package.cookedPath		= g_CookedDir + PATH_SEPARATOR + relativePath;
+			package.bIsAssetPackage	= bIsAssetPackage;
+
+			packageIndices[file] = packages.size();
+			packages.push_back( package );
+		}
+	}
+}
+
+/*
+==================
+CCookPackagesCommandlet::HashCookSettings
+==================
+*/
+uint64 CCookPackagesCommandlet::HashCookSettings() const
+{
+	// Version of cooked packages and whether editor content is cooked
+	uint64							hash = FastHash( ( uint32 )VER_PACKAGE_LATEST );
+	hash = FastHash( ( uint32 )g_IsCookEditorContent, hash );
+
+	// Codecs of bulk data selected by the target platform
+	const CWindowsTargetPlatform&	targetPlatform = CWindowsTargetPlatform::Get();
+	hash = FastHash( targetPlatform.GetObjectPackageCompressionFlags(), hash );
+	for ( uint32 assetType = 0; assetType < AT_Count; ++assetType )
+	{
+		hash = FastHash( targetPlatform.GetAssetCompressionFlags( assetType ), hash );
+	}
+	return hash;
+}
+
+/*
+==================
+CCookPackagesCommandlet::HashPackages
+==================
+*/
+void CCookPackagesCommandlet::HashPackages()
+{
+	CThreadPool::Get().ParallelFor( packages.size(), [&]( uint32 InIndex )
+									{
+										CookPackage&		package = packages[InIndex];
+										std::vector<byte>	data;
+										if ( !ReadFileToBuffer( package.sourcePath, data ) )
+										{
+											package.bIsFailed	= true;
+											package.error		= TEXT( "Failed to open file" );
+											return;
+										}
+										package.contentHash = FastHash( data.data(), data.size(), settingsHash );
+
+										// We need GUID and name of asset packages for table of contents
+										if ( package.bIsAssetPackage )
+										{
+											CMemoryReading	reader( data, package.sourcePath );
+											reader.SerializeHeader();
+											if ( !SerializeAssetPackageHeader( reader, package.guid, package.name ) )
+											{
+												package.bIsFailed	= true;
+												package.error		= TEXT( "Isn't asset package or version is too old" );
+											}
+										}
+									} );
+}
+
+/*
+==================
+CCookPackagesCommandlet::ResolveDirtyPackages
+==================
+*/
+void CCookPackagesCommandlet::ResolveDirtyPackages()
+{
+	std::vector<std::vector<uint32>>	dependents( packages.size() );
+	std::vector<uint32>					dirtyPackages;
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		CookPackage&	package = packages[index];
+		if ( package.bIsFailed )
+		{
+			continue;
+		}
+
+		// The package is dirty if it has never been cooked or it has been changed since the last cook
+		auto	itEntry = manifest.find( package.sourcePath );
+		if ( itEntry == manifest.end() || itEntry->second.contentHash != package.contentHash || !g_FileSystem->IsExistFile( package.cookedPath ) )
+		{
+			package.bIsDirty = true;
+			dirtyPackages.push_back( index );
+			continue;
+		}
+
+		// The package itself is up to date, but it's dirty if any of its dependencies was removed or failed
+		package.dependencies = itEntry->second.dependencies;
+		for ( uint32 dependencyIndex = 0, numDependencies = package.dependencies.size(); dependencyIndex < numDependencies; ++dependencyIndex )
+		{
+			auto	itDependency = packageIndices.find( package.dependencies[dependencyIndex] );
+			if ( itDependency == packageIndices.end() || packages[itDependency->second].bIsFailed )
+			{
+				package.bIsDirty = true;
+			}
+			else
+			{
+				dependents[itDependency->second].push_back( index );
+			}
+		}
+
+		if ( package.bIsDirty )
+		{
+			dirtyPackages.push_back( index );
+		}
+	}
+
+	// Propagate dirty state to dependents until nothing changes, a package is queued only once so cycles end here
+	while ( !dirtyPackages.empty() )
+	{
+		uint32							packageIndex = dirtyPackages.back();
+		const std::vector<uint32>&		packageDependents = dependents[packageIndex];
+		dirtyPackages.pop_back();
+		for ( uint32 index = 0, count = packageDependents.size(); index < count; ++index )
+		{
+			CookPackage&	dependent = packages[packageDependents[index]];
+			if ( !dependent.bIsDirty )
+			{
+				dependent.bIsDirty = true;
+				dirtyPackages.push_back( packageDependents[index] );
+			}
+		}
+	}
+}
+
+/*
+==================
+CCookPackagesCommandlet::CookAssetPackage
+==================
+*/
+void CCookPackagesCommandlet::CookAssetPackage( CookPackage& InOutPackage ) const
+{
+	std::vector<byte>	sourceData;
+	if ( !ReadFileToBuffer( InOutPackage.sourcePath, sourceData ) )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= TEXT( "Failed to open file" );
+		return;
+	}
+
+	CMemoryReading		reader( sourceData, InOutPackage.sourcePath );
+	CGuid				packageGuid;
+	std::wstring		packageName;
+	reader.SerializeHeader();
+	if ( !SerializeAssetPackageHeader( reader, packageGuid, packageName ) )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= TEXT( "Isn't asset package or version is too old" );
+		return;
+	}
+
+	// Cooked package keeps the version of the source one, because assets are copied as is
+	std::vector<byte>	cookedData;
+	CMemoryWriter		writer( cookedData, InOutPackage.cookedPath );
+	writer.SetVer( reader.Ver() );
+	writer.SetType( reader.Type() );
+	writer.SerializeHeader();
+	SerializeAssetPackageHeader( writer, packageGuid, packageName );
+
+	// Copy all assets except editor only ones. Layout of asset header is the same as in CPackage::Serialize
+	std::vector<byte>	assetData;
+	while ( !reader.IsEndOfFile() )
+	{
+		EAssetType		assetType;
+		std::wstring	assetName;
+		CGuid			assetGuid;
+		uint32			assetHash = 0;
+		uint32			assetSize = 0;
+
+		reader << assetType;
+		if ( reader.Ver() >= VER_AssetName_V2 )
+		{
+			reader << assetName;
+		}
+
+		if ( reader.Ver() < VER_GUIDAssets )
+		{
+			reader << assetHash;
+		}
+		else
+		{
+			reader << assetGuid;
+		}
+
+		reader << assetSize;
+		assetData.resize( assetSize );
+		if ( assetSize > 0 )
+		{
+			reader.Serialize( assetData.data(), assetSize );
+		}
+
+		if ( IsEditorOnlyAsset( assetData, reader.Ver() ) )
+		{
+			continue;
+		}
+
+		// Bulk data can't be recompressed without loading the asset, so it will be done on the game thread
+		if ( CWindowsTargetPlatform::Get().GetAssetCompressionFlags( assetType ) != CF_None )
+		{
+			InOutPackage.bIsNeedRecompress = true;
+		}
+
+		writer << assetType;
+		if ( writer.Ver() >= VER_AssetName_V2 )
+		{
+			writer << assetName;
+		}
+
+		if ( writer.Ver() < VER_GUIDAssets )
+		{
+			writer << assetHash;
+		}
+		else
+		{
+			writer << assetGuid;
+		}
+
+		writer << assetSize;
+		if ( assetSize > 0 )
+		{
+			writer.Serialize( assetData.data(), assetSize );
+		}
+	}
+
+	// Write the cooked package on the disk
+	CArchive*		archive = g_FileSystem->CreateFileWriter( InOutPackage.cookedPath );
+	if ( !archive )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= L_Sprintf( TEXT( "Failed to create file '%s'" ), InOutPackage.cookedPath.c_str() );
+		return;
+	}
+
+	archive->Serialize( cookedData.data(), cookedData.size() );
+	delete archive;
+}
+
+/*
+==================
+CCookPackagesCommandlet::CollectAssetPackageDependencies
+==================
+*/
+void CCookPackagesCommandlet::CollectAssetPackageDependencies( CookPackage& InOutPackage ) const
+{
+	InOutPackage.dependencies.clear();
+	PackageRef_t	package = g_PackageManager->LoadPackage( InOutPackage.sourcePath );
+	if ( !package )
+	{
+		return;
+	}
+
+	// Collect assets which are referenced by assets of the package
+	CAsset::SetDependentAssets_t	dependentAssets;
+	for ( uint32 index = 0, count = package->GetNumAssets(); index < count; ++index )
+	{
+		AssetInfo				assetInfo;
+		CGuid					assetGuid;
+		package->GetAssetInfo( index, assetInfo, &assetGuid );
+
+		TAssetHandle<CAsset>	asset = package->Find( assetGuid );
+		if ( asset.IsAssetValid() )
+		{
+			asset.ToSharedPtr()->GetDependentAssets( dependentAssets );
+		}
+	}
+
+	// Convert them into paths of packages
+	std::unordered_set<std::wstring>	dependencies;
+	for ( auto itAsset = dependentAssets.begin(), itAssetEnd = dependentAssets.end(); itAsset != itAssetEnd; ++itAsset )
+	{
+		TSharedPtr<AssetReference>		assetReference = itAsset->GetReference();
+		if ( !assetReference || !assetReference->guidPackage.IsValid() || assetReference->guidPackage == InOutPackage.guid )
+		{
+			continue;
+		}
+
+		std::wstring	packagePath = g_TableOfContents.GetPackagePath( assetReference->guidPackage );
+		if ( !packagePath.empty() )
+		{
+			dependencies.insert( packagePath );
+		}
+	}
+	InOutPackage.dependencies.assign( dependencies.begin(), dependencies.end() );
+}
+
+/*
+==================
+CCookPackagesCommandlet::RecompressAssetPackage
+==================
+*/
+void CCookPackagesCommandlet::RecompressAssetPackage( CookPackage& InOutPackage ) const
+{
+	// The package is saved again from loaded assets. Editor only assets are skipped and bulk data is compressed by the target platform
+	PackageRef_t	package = g_PackageManager->LoadPackage( InOutPackage.sourcePath );
+	if ( !package || !package->Save( InOutPackage.cookedPath, &CWindowsTargetPlatform::Get() ) )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= L_Sprintf( TEXT( "Failed to recompress assets into '%s'" ), InOutPackage.cookedPath.c_str() );
+	}
+}
+
+/*
+==================
+CCookPackagesCommandlet::CookObjectPackage
+==================
+*/
+void CCookPackagesCommandlet::CookObjectPackage( CookPackage& InOutPackage ) const
+{
+	// Collect garbage before loading, so asset packages loaded by previous packages will not be recorded as dependencies
+	CObjectGC::Get().CollectGarbage( OBJECT_None );
+	g_PackageManager->GarbageCollector();
+
+	InOutPackage.dependencies.clear();
+	CObjectPackage*		package = CObjectPackage::LoadPackage( nullptr, InOutPackage.sourcePath.c_str(), LOAD_None );
+	if ( !package )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= TEXT( "Failed to load package" );
+		return;
+	}
+
+	// Object packages which are imported by this one
+	std::unordered_set<std::wstring>	dependencies;
+	CLinkerLoad*						linker = package->GetLinker();
+	if ( linker )
+	{
+		const std::vector<ObjectImport>&	imports = linker->GetImports();
+		for ( uint32 index = 0, count = imports.size(); index < count; ++index )
+		{
+			std::wstring	packageFile;
+			if ( imports[index].outerIndex.IsNull() && CPackageFileCache::Get().FindPackageFile( imports[index].objectName.ToString().c_str(), packageFile ) && packageFile != InOutPackage.sourcePath )
+			{
+				dependencies.insert( packageFile );
+			}
+		}
+	}
+
+	// Asset packages which were loaded together with this one
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		const CookPackage&	otherPackage = packages[index];
+		if ( otherPackage.bIsAssetPackage && g_PackageManager->IsPackageLoaded( otherPackage.sourcePath ) )
+		{
+			dependencies.insert( otherPackage.sourcePath );
+		}
+	}
+	InOutPackage.dependencies.assign( dependencies.begin(), dependencies.end() );
+
+	// Save the cooked package
+	g_FileSystem->MakeDirectory( CFilename( InOutPackage.cookedPath ).GetPath(), true );
+	CWorld*		world = FindObject<CWorld>( package, TEXT( "TheWorld" ) );
+	if ( !CObjectPackage::SavePackage( package, world, OBJECT_None, InOutPackage.cookedPath.c_str(), SAVE_None, CWindowsTargetPlatform::Get().GetObjectPackageCompressionFlags(), &CWindowsTargetPlatform::Get() ) )
+	{
+		InOutPackage.bIsFailed	= true;
+		InOutPackage.error		= L_Sprintf( TEXT( "Failed to save package to '%s'" ), InOutPackage.cookedPath.c_str() );
+	}
+}
+
+/*
+==================
+CCookPackagesCommandlet::SerializeManifest
+==================
+*/
+bool CCookPackagesCommandlet::SerializeManifest( bool InIsSave )
+{
+	std::wstring	path = g_CookedDir + PATH_SEPARATOR + COOK_MANIFEST_FILENAME;
+	CArchive*		archive = InIsSave ? g_FileSystem->CreateFileWriter( path ) : g_FileSystem->CreateFileReader( path );
+	if ( !archive )
+	{
+		if ( InIsSave )
+		{
+			Errorf( TEXT( "Failed to write cook manifest '%s'\n" ), path.c_str() );
+		}
+		return false;
+	}
+
+	archive->SetType( AT_BinaryFile );
+	archive->SerializeHeader();
+
+	// Manifest of another version is just ignored, so all packages will be cooked again
+	uint32		version = COOK_MANIFEST_VERSION;
+	*archive << version;
+	if ( version != COOK_MANIFEST_VERSION )
+	{
+		Warnf( TEXT( "Cook manifest '%s' has version %i, but need %i. It will be ignored\n" ), path.c_str(), version, COOK_MANIFEST_VERSION );
+		delete archive;
+		return false;
+	}
+
+	uint32		numEntries = manifest.size();
+	*archive << numEntries;
+	if ( InIsSave )
+	{
+		for ( auto itEntry = manifest.begin(), itEntryEnd = manifest.end(); itEntry != itEntryEnd; ++itEntry )
+		{
+			*archive << itEntry->first;
+			*archive << itEntry->second.contentHash;
+			*archive << itEntry->second.cookedPath;
+			*archive << itEntry->second.dependencies;
+		}
+	}
+	else
+	{
+		for ( uint32 index = 0; index < numEntries; ++index )
+		{
+			std::wstring		sourcePath;
+			CookManifestEntry	entry;
+			*archive << sourcePath;
+			*archive << entry.contentHash;
+			*archive << entry.cookedPath;
+			*archive << entry.dependencies;
+			manifest[sourcePath] = entry;
+		}
+	}
+
+	delete archive;
+	return true;
+}
+
+/*
+==================
+CCookPackagesCommandlet::WriteTOC
+==================
+*/
+bool CCookPackagesCommandlet::WriteTOC() const
+{
+	CTableOfContets		tableOfContents;
+	for ( uint32 index = 0, count = packages.size(); index < count; ++index )
+	{
+		const CookPackage&	package = packages[index];
+		if ( package.bIsAssetPackage && !package.bIsFailed )
+		{
+			tableOfContents.AddEntry( package.guid, package.name, package.cookedPath );
+		}
+	}
+
+	std::wstring	path = g_CookedDir + PATH_SEPARATOR + CTableOfContets::GetNameTOC();
+	CArchive*		archive = g_FileSystem->CreateFileWriter( path );
+	if ( !archive )
+	{
+		Errorf( TEXT( "Failed to write table of contents '%s'\n" ), path.c_str() );
+		return false;
+	}
+
+	tableOfContents.Serialize( *archive );
+	delete archive;
 	return true;
-}
\ No newline at end of file
+}
@@ -0,0 +1,61 @@
+#include "Logger/LoggerMacros.h"
+#include "System/Config.h"
+#include "TargetPlatforms/WindowsTargetPlatform.h"
+
+/*
+==================
+CWindowsTargetPlatform::CWindowsTargetPlatform
+==================
+*/
+CWindowsTargetPlatform::CWindowsTargetPlatform()
+	: objectPackageCompressionFlags( CF_None )
+{
+	for ( uint32 index = 0; index < AT_Count; ++index )
+	{
+		assetCompressionFlags[index] = CF_None;
+	}
+
+	// Codecs are set per asset type, e.g. "Texture2D": "LZ4". Key "ObjectPackage" is codec of maps and classes
+	const CJsonValue*	configCompression = CConfig::Get().GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "Compression" ) );
+	const CJsonObject*	configCompressionObject = configCompression ? configCompression->GetObject() : nullptr;
+	if ( !configCompressionObject )
+	{
+		return;
+	}
+
+	for ( uint32 index = AT_FirstType; index < AT_Count; ++index )
+	{
+		std::wstring		assetTypeName = ConvertAssetTypeToText( ( EAssetType )index );
+		const CJsonValue*	configFlags = !assetTypeName.empty() ? configCompressionObject->GetValue( assetTypeName.c_str() ) : nullptr;
+		if ( configFlags )
+		{
+			assetCompressionFlags[index] = ConvertTextToCompressionFlags( configFlags->GetString() );
+		}
+	}
+
+	const CJsonValue*	configObjectPackageFlags = configCompressionObject->GetValue( TEXT( "ObjectPackage" ) );
+	if ( configObjectPackageFlags )
+	{
+		objectPackageCompressionFlags = ConvertTextToCompressionFlags( configObjectPackageFlags->GetString() );
+	}
+}
+
+/*
+==================
+CWindowsTargetPlatform::GetAssetCompressionFlags
+==================
+*/
+ECompressionFlags CWindowsTargetPlatform::GetAssetCompressionFlags( uint32 InAssetType ) const
+{
+	return InAssetType < AT_Count ? assetCompressionFlags[InAssetType] : CF_None;
+}
+
+/*
+==================
+CWindowsTargetPlatform::GetObjectPackageCompressionFlags
+==================
+*/
+ECompressionFlags CWindowsTargetPlatform::GetObjectPackageCompressionFlags() const
+{
+	return objectPackageCompressionFlags;
+}